@@ -137,6 +137,12 @@ declare namespace jsb {
     export let onClose: () => void | undefined;
     export function openURL(url: string): void;
     export function garbageCollect(): void;
+    /**
+     * @en Sets the bytes of encoded and decoded data that the images being loaded may hold, 64 MB by default.
+     * @zh 设置正在加载的图片可占用的编码与解码数据字节数，默认 64 MB。
+     */
+    export function setImageMemoryBudget(bytes: number): void;
+    export function getImageMemoryBudget(): number;
     enum AudioFormat {
         UNKNOWN,
         SIGNED_8,
@@ -193,6 +199,15 @@ declare namespace jsb {
          * @param channelID: ChannelID which should smaller than channel count, start from 0
          */
         export function getOriginalPCMBuffer (url: string, channelID: number): ArrayBuffer | undefined;
+        /**
+         * Get the memory budget of the cached audio data in bytes, 0 if there is none.
+         */
+        export function getCacheMemoryBudget (): number;
+        /**
+         * Set the memory budget of the cached audio data in bytes, the least recently used audio files that aren't playing
+         * are uncached once it's exceeded. 0 for no budget. Only the OpenAL Soft backend (Windows, Linux, OpenHarmony) has a budget.
+         */
+        export function setCacheMemoryBudget (bytes: number);
     }
 
     class NativePOD {
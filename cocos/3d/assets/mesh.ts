@@ -1012,6 +1012,36 @@ export class Mesh extends Asset {
         return true;
     }
 
+    /**
+     * @en Merge the given meshes into the current mesh, with the same result as merging them one by one.
+     * On native platforms the merged data is sized once and the meshes are transformed in parallel.
+     * @zh 合并多个网格到此网格中，结果与逐个合并相同。原生平台上合并数据只分配一次，且并行变换各网格。
+     * @param meshes @en The meshes to be merged @zh 要合并的网格
+     * @param worldMatrices @en The world matrices of the given meshes, null for none @zh 给定网格的模型变换矩阵，为空表示不变换
+     * @param validate @en Whether to validate the meshes, the ones failing validation are skipped @zh 是否验证网格顶点布局，未通过验证的网格将被跳过
+     * @returns @en whether all meshes were merged @zh 返回是否全部合并成功
+     */
+    public mergeBatch (meshes: Mesh[], worldMatrices: (Mat4 | null)[], validate?: boolean): boolean {
+        let allMerged = true;
+        for (let i = 0; i < meshes.length; i++) {
+            allMerged = this.merge(meshes[i], worldMatrices[i] ?? undefined, validate) && allMerged;
+        }
+        return allMerged;
+    }
+
+    /**
+     * @en Reorders the triangles of the indexed sub meshes to be spatially coherent and splits them into clusters,
+     * so that the parts of a large static mesh out of view or facing away are not drawn.
+     * Clusters are only culled on native platforms, it does nothing on the web.
+     * The clusters are dropped when the mesh is reset, e.g. by merging, so build them afterwards.
+     * @zh 将索引子网格的三角形按空间重新排序并分簇，使大型静态网格在视野外或背向的部分不被绘制。仅在原生平台生效。
+     * @param maxTrianglesPerCluster @en The maximum triangle count of a cluster @zh 每簇最大三角形数
+     * @returns @en Whether any sub mesh was clustered @zh 是否有子网格被分簇
+     */
+    public buildClusters (maxTrianglesPerCluster = 64): boolean {
+        return false;
+    }
+
     /**
      * @en Validation for whether the given mesh can be merged into the current mesh.
      * To pass the validation, it must satisfy either of these two requirements:
@@ -53,13 +53,13 @@ export class BatchingUtility {
      * and attach it to a new Model on `batchedRoot`.
      * The world transform of each model is guaranteed to be preserved.
      *
-     * For a more fine-grained control over the process, use `Mesh.merge` directly.
+     * For a more fine-grained control over the process, use `Mesh.merge` or `Mesh.mergeBatch` directly.
      * @zh
      * 在`staticModelRoot`下收集模型。
      * 将所有的网格静态地合并成一个（同时禁用每个组件）。
      * 并将其附加到 `batchedRoot` 上的一个新模型。
      * 每个模型的世界变换都被保证保留下来。
-     * 如果要对这个过程进行更精细的控制，可以直接使用 `Mesh.merge`。
+     * 如果要对这个过程进行更精细的控制，可以直接使用 `Mesh.merge` 或 `Mesh.mergeBatch`。
      * @param staticModelRoot root of all the static models to be batched
      * @param batchedRoot the target output node
      */
@@ -80,17 +80,23 @@ export class BatchingUtility {
             }
         }
         const batchedMesh = new Mesh();
-        const worldMat = new Mat4();
+        const meshes: Mesh[] = [];
+        const worldMatrices: Mat4[] = [];
         const rootWorldMatInv = new Mat4();
         staticModelRoot.getWorldMatrix(rootWorldMatInv);
         Mat4.invert(rootWorldMatInv, rootWorldMatInv);
         for (let i = 0; i < models.length; i++) {
             const comp = models[i];
+            const worldMat = new Mat4();
             comp.node.getWorldMatrix(worldMat);
             Mat4.multiply(worldMat, rootWorldMatInv, worldMat);
-            batchedMesh.merge(models[i].mesh!, worldMat);
+            meshes.push(comp.mesh!);
+            worldMatrices.push(worldMat);
             comp.enabled = false;
         }
+        batchedMesh.mergeBatch(meshes, worldMatrices);
+        // the batch is usually large enough for parts of it to be out of view
+        batchedMesh.buildClusters();
         const batchedModel = batchedRoot.addComponent(MeshRenderer);
         batchedModel.mesh = batchedMesh;
         batchedModel.sharedMaterials = models[0].sharedMaterials;
@@ -135,6 +135,13 @@ export class RenderScene {
      */
     get lodGroups () : readonly LODGroup[] { return this._lodGroups; }
 
+    /**
+     * @en Whether the models are updated on worker threads, only supported on native platforms.
+     * @zh 是否在工作线程上更新模型，仅原生平台支持。
+     */
+    get parallelUpdateEnabled (): boolean { return false; }
+    set parallelUpdateEnabled (val: boolean) {}
+
     private _root: Root;
     private _name = '';
     private _cameras: Camera[] = [];
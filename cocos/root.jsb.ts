@@ -99,6 +99,8 @@ rootProto.initialize = function (info: IRootInfo) {
     this._initialize(deviceManager.swapchain);
     const customJointTextureLayouts = settings.querySettings(Settings.Category.ANIMATION, 'customJointTextureLayouts') || [];
     this._dataPoolMgr?.jointTexturePool.registerCustomTextureLayouts(customJointTextureLayouts);
+    // Meshes are converted when they are loaded, so this is set before any of them is.
+    jsb.Mesh.setDataOptimizationEnabled(!!settings.querySettings(Settings.Category.RENDERING, 'meshDataOptimization'));
 };
 
 rootProto.createModel = function (ModelCtor) {
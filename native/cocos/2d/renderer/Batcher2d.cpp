@@ -26,6 +26,7 @@
 #include "2d/renderer/Batcher2d.h"
 #include "application/ApplicationManager.h"
 #include "base/TypeDef.h"
+#include "base/job-system/JobSystem.h"
 #include "core/Root.h"
 #include "editor-support/MiddlewareManager.h"
 #include "renderer/pipeline/Define.h"
@@ -33,6 +34,10 @@
 
 namespace cc {
 
+namespace {
+constexpr uint32_t PARALLEL_FILL_MIN_TASKS_PER_JOB{256};
+} // namespace
+
 Batcher2d::Batcher2d() : Batcher2d(nullptr) {
 }
 
@@ -47,13 +52,14 @@ Batcher2d::Batcher2d(Root* root)
 }
 
 Batcher2d::~Batcher2d() { // NOLINT
+    releaseRetainedRoots();
     _drawBatchPool.destroy();
 
     for (auto iter : _descriptorSetCache) {
         delete iter.second;
     }
 
-    for (auto* drawBatch : _batches) {
+    for (auto* drawBatch : _transientBatches) {
         delete drawBatch;
     }
     _attributes.clear();
@@ -71,7 +77,12 @@ Batcher2d::~Batcher2d() { // NOLINT
 }
 
 void Batcher2d::syncMeshBuffersToNative(uint16_t accId, ccstd::vector<UIMeshBuffer*>&& buffers) {
-    _meshBuffersMap[accId] = std::move(buffers);
+    auto& meshBuffers = _meshBuffersMap[accId];
+    if (meshBuffers != buffers) {
+        // retained roots refer to the mesh buffers, which may have been destroyed
+        releaseRetainedRoots();
+    }
+    meshBuffers = std::move(buffers);
 }
 
 UIMeshBuffer* Batcher2d::getMeshBuffer(uint16_t accId, uint16_t bufferId) { // NOLINT(bugprone-easily-swappable-parameters)
@@ -94,19 +105,303 @@ void Batcher2d::syncRootNodesToNative(ccstd::vector<Node*>&& rootNodes) {
 }
 
 void Batcher2d::fillBuffersAndMergeBatches() {
-    for (auto* rootNode : _rootNodeArr) {
+    const size_t rootCount = _rootNodeArr.size();
+    for (size_t i = rootCount; i < _retainedRoots.size(); ++i) {
+        releaseRetainedRoot(_retainedRoots[i]);
+    }
+    _retainedRoots.resize(rootCount);
+
+    for (size_t i = 0; i < rootCount; ++i) {
+        auto* rootNode = _rootNodeArr[i];
+        auto& retained = _retainedRoots[i];
+        if (reuseRetainedRoot(retained, rootNode)) {
+            continue;
+        }
+        const size_t batchBegin = _batches.size();
+        beginRetainedRoot(retained, rootNode);
         walk(rootNode, 1);
         generateBatch(_currEntity, _currDrawInfo);
+        // roots don't continue the batches of each other, so the batches of a root can be kept on their own
+        resetRenderStates();
+        endRetainedRoot(retained, batchBegin);
+    }
+    flushFillTasks();
+}
+
+void Batcher2d::beginRetainedRoot(RetainedRoot& root, Node* node) {
+    releaseRetainedRoot(root);
+    root.node = node;
+    root.retainable = _stencilManager->getMaskStackSize() == 0;
+    root.stencilStage = _stencilManager->getStencilStage();
+    _recordingRoot = &root;
+    _recordingEntity = -1;
+}
+
+void Batcher2d::endRetainedRoot(RetainedRoot& root, size_t batchBegin) {
+    _recordingRoot = nullptr;
+    _recordingEntity = -1;
+    if (!root.retainable) {
+        // returned to the pool in reset
+        _transientBatches.insert(_transientBatches.end(), _batches.begin() + static_cast<std::ptrdiff_t>(batchBegin), _batches.end());
+        root.entities.clear();
+        root.draws.clear();
+        root.indexRanges.clear();
+        root.batches.clear();
+        return;
+    }
+    if (root.batches.size() != _batches.size() - batchBegin) {
+        root.retainable = false;
+        endRetainedRoot(root, batchBegin);
+        return;
+    }
+    for (auto& range : root.indexRanges) {
+        range.end = range.meshBuffer->getIndexOffset();
+    }
+}
+
+bool Batcher2d::matchRetainedRoot(Node* node, const RetainedRoot& root, int32_t parentEntity, uint32_t& entityIndex, uint32_t& drawIndex) const { // NOLINT(misc-no-recursion)
+    // visits the nodes in the order of walk, without changing anything
+    if (!node->isActiveInHierarchy()) {
+        return true;
+    }
+    bool breakWalk = false;
+    int32_t thisEntity = parentEntity;
+    auto* entity = static_cast<RenderEntity*>(node->getUserData());
+    if (entity) {
+        if (entityIndex >= root.entities.size()) {
+            return false;
+        }
+        const auto& retainedEntity = root.entities[entityIndex];
+        if (retainedEntity.entity != entity || retainedEntity.parent != parentEntity ||
+            retainedEntity.enabled != entity->isEnabled() || entity->getIsMask()) {
+            return false;
+        }
+        thisEntity = static_cast<int32_t>(entityIndex++);
+        if (entity->isEnabled()) {
+            uint32_t size = entity->getRenderDrawInfosSize();
+            for (uint32_t i = 0; i < size; i++) {
+                auto* drawInfo = entity->getRenderDrawInfoAt(i);
+                if (drawIndex >= root.draws.size() || entity->getUseLocal()) {
+                    return false;
+                }
+                const auto& draw = root.draws[drawIndex++];
+                if (draw.drawInfo != drawInfo || draw.node != node || draw.entity != static_cast<uint32_t>(thisEntity) ||
+                    drawInfo->getEnumDrawInfoType() != RenderDrawInfoType::COMP || drawInfo->getIsMeshBuffer() ||
+                    draw.layer != node->getLayer() || draw.dataHash != drawInfo->getDataHash() ||
+                    draw.material != drawInfo->getMaterial() || draw.texture != drawInfo->getTexture() ||
+                    draw.sampler != drawInfo->getSampler() || draw.meshBuffer != drawInfo->getMeshBuffer() ||
+                    draw.vbBuffer != drawInfo->getVbBuffer() || draw.ibBuffer != drawInfo->getIbBuffer() ||
+                    draw.vbCount != drawInfo->getVbCount() || draw.ibCount != drawInfo->getIbCount()) {
+                    return false;
+                }
+            }
+        }
+        if (entity->getRenderEntityType() == RenderEntityType::CROSSED) {
+            breakWalk = true;
+        }
+    }
+
+    if (!breakWalk) {
+        for (const auto& child : node->getChildren()) {
+            if (!matchRetainedRoot(child, root, thisEntity, entityIndex, drawIndex)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool Batcher2d::reuseRetainedRoot(RetainedRoot& root, Node* node) {
+    if (root.node != node || !root.retainable ||
+        _stencilManager->getMaskStackSize() != 0 || _stencilManager->getStencilStage() != root.stencilStage) {
+        return false;
+    }
+    // the index data of the root is still in place if the roots before it filled the same ranges
+    for (const auto& range : root.indexRanges) {
+        if (range.meshBuffer->getIData() != range.iData || range.meshBuffer->getIndexOffset() != range.begin) {
+            return false;
+        }
+    }
+    uint32_t entityCount = 0;
+    uint32_t drawCount = 0;
+    if (!matchRetainedRoot(node, root, -1, entityCount, drawCount) ||
+        entityCount != root.entities.size() || drawCount != root.draws.size()) {
+        return false;
+    }
+
+    // same as walk, ancestors come first
+    for (const auto& retainedEntity : root.entities) {
+        auto* entity = retainedEntity.entity;
+        if (entity->getColorDirty()) {
+            float parentOpacity = retainedEntity.parent < 0 ? 1.F : root.entities[static_cast<size_t>(retainedEntity.parent)].entity->getOpacity();
+            entity->setOpacity(parentOpacity * entity->getLocalOpacity() * entity->getColorAlpha());
+            entity->setColorDirty(false);
+            entity->setVBColorDirty(true);
+        }
+    }
+    for (const auto& draw : root.draws) {
+        auto* entity = root.entities[draw.entity].entity;
+        auto* drawInfo = draw.drawInfo;
+        bool vertDirty = draw.node->getChangedFlags() || drawInfo->getVertDirty();
+        if (!vertDirty && !entity->getVBColorDirty()) {
+            continue;
+        }
+        FillTask task;
+        task.entity = entity;
+        task.drawInfo = drawInfo;
+        if (vertDirty) {
+            task.worldMatrix = &draw.node->getWorldMatrix();
+            drawInfo->setVertDirty(false);
+        }
+        task.fillColors = entity->getVBColorDirty();
+        task.indexOffset = draw.indexOffset;
+        _fillTasks.emplace_back(task);
+    }
+    for (const auto& retainedEntity : root.entities) {
+        if (retainedEntity.enabled) {
+            retainedEntity.entity->setVBColorDirty(false);
+        }
+    }
+
+    for (const auto& range : root.indexRanges) {
+        range.meshBuffer->setIndexOffset(range.end);
+    }
+    for (const auto& retainedBatch : root.batches) {
+        auto* meshBuffer = retainedBatch.meshBuffer;
+        meshBuffer->setDirty(true);
+        auto* ia = meshBuffer->requireFreeIA(getDevice());
+        if (ia == nullptr) {
+            continue;
+        }
+        ia->setFirstIndex(retainedBatch.firstIndex);
+        ia->setIndexCount(retainedBatch.indexCount);
+
+        auto* curdrawBatch = retainedBatch.batch;
+        curdrawBatch->setInputAssembler(ia);
+        // cheap if the passes didn't change since the last fill
+        curdrawBatch->fillPass(retainedBatch.material,
+                               _stencilManager->getDepthStencilState(retainedBatch.stencilStage, retainedBatch.material),
+                               _stencilManager->getStencilHash(retainedBatch.stencilStage));
+        const auto& pass = curdrawBatch->getPasses().at(0);
+        curdrawBatch->setDescriptorSet(getDescriptorSet(retainedBatch.texture, retainedBatch.sampler, pass->getLocalSetLayout()));
+        _batches.push_back(curdrawBatch);
+    }
+    return true;
+}
+
+void Batcher2d::releaseRetainedRoot(RetainedRoot& root) {
+    for (auto iter = root.batches.rbegin(); iter != root.batches.rend(); ++iter) {
+        iter->batch->clear();
+        _drawBatchPool.free(iter->batch);
+    }
+    root.node = nullptr;
+    root.retainable = false;
+    root.entities.clear();
+    root.draws.clear();
+    root.indexRanges.clear();
+    root.batches.clear();
+}
+
+void Batcher2d::releaseRetainedRoots() {
+    for (auto& root : _retainedRoots) {
+        releaseRetainedRoot(root);
+    }
+}
+
+void Batcher2d::recordRetainedDraw(RenderEntity* entity, RenderDrawInfo* drawInfo, Node* node, uint32_t indexOffset) {
+    auto& root = *_recordingRoot;
+    if (!root.retainable) {
+        return;
+    }
+    if (entity->getUseLocal() || _recordingEntity < 0) {
+        root.retainable = false;
+        return;
+    }
+    RetainedDraw draw;
+    draw.node = node;
+    draw.drawInfo = drawInfo;
+    draw.entity = static_cast<uint32_t>(_recordingEntity);
+    draw.layer = node->getLayer();
+    draw.indexOffset = indexOffset;
+    draw.dataHash = drawInfo->getDataHash();
+    draw.material = drawInfo->getMaterial();
+    draw.texture = drawInfo->getTexture();
+    draw.sampler = drawInfo->getSampler();
+    draw.meshBuffer = drawInfo->getMeshBuffer();
+    draw.vbBuffer = drawInfo->getVbBuffer();
+    draw.ibBuffer = drawInfo->getIbBuffer();
+    draw.vbCount = drawInfo->getVbCount();
+    draw.ibCount = drawInfo->getIbCount();
+    root.draws.emplace_back(draw);
+
+    // a root fills a contiguous range of each mesh buffer
+    auto iter = std::find_if(root.indexRanges.begin(), root.indexRanges.end(), [&](const auto& range) {
+        return range.meshBuffer == draw.meshBuffer;
+    });
+    if (iter == root.indexRanges.end()) {
+        RetainedIndexRange range;
+        range.meshBuffer = draw.meshBuffer;
+        range.iData = draw.meshBuffer->getIData();
+        range.begin = indexOffset;
+        root.indexRanges.emplace_back(range);
     }
 }
 
+void Batcher2d::flushFillTasks() {
+    const auto count = static_cast<uint32_t>(_fillTasks.size());
+    if (count == 0) {
+        return;
+    }
+
+    const FillTask* tasks = _fillTasks.data();
+    auto fill = [this, tasks](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            const auto& task = tasks[i];
+            if (task.worldMatrix) {
+                fillVertexBuffers(*task.worldMatrix, task.drawInfo);
+            }
+            if (task.fillColors) {
+                fillColors(task.entity, task.drawInfo);
+            }
+            fillIndexBuffers(task.drawInfo, task.indexOffset);
+        }
+    };
+
+    const uint32_t maxJobCount = (count - 1) / PARALLEL_FILL_MIN_TASKS_PER_JOB + 1;
+    const uint32_t jobCount = std::min(JobSystem::getInstance()->threadCount(), maxJobCount);
+    if (jobCount > 1) {
+        const uint32_t tasksPerJob = (count - 1) / jobCount + 1; // ceil(count / jobCount)
+        auto fillJob = [&fill, count, tasksPerJob](uint32_t job) {
+            fill(job * tasksPerJob, std::min(count, (job + 1) * tasksPerJob));
+        };
+
+        JobGraph g(JobSystem::getInstance());
+        g.createForEachIndexJob(1U, jobCount, 1U, fillJob);
+        g.run();
+        fillJob(0U);
+        g.waitForAll();
+    } else {
+        fill(0U, count);
+    }
+
+    _fillTasks.clear();
+}
+
 void Batcher2d::walk(Node* node, float parentOpacity) { // NOLINT(misc-no-recursion)
     if (!node->isActiveInHierarchy()) {
         return;
     }
     bool breakWalk = false;
+    const int32_t parentEntity = _recordingEntity;
     auto* entity = static_cast<RenderEntity*>(node->getUserData());
     if (entity) {
+        if (entity->getIsMask()) {
+            stopRetaining();
+        }
+        if (_recordingRoot && _recordingRoot->retainable) {
+            _recordingEntity = static_cast<int32_t>(_recordingRoot->entities.size());
+            _recordingRoot->entities.push_back({entity, parentEntity, entity->isEnabled()});
+        }
         if (entity->getColorDirty()) {
             float localOpacity = entity->getLocalOpacity();
             float localColorAlpha = entity->getColorAlpha();
@@ -140,6 +435,7 @@ void Batcher2d::walk(Node* node, float parentOpacity) { // NOLINT(misc-no-recurs
     if (_stencilManager->getMaskStackSize() > 0 && entity && entity->isEnabled()) {
         handlePostRender(entity);
     }
+    _recordingEntity = parentEntity;
 }
 
 void Batcher2d::handlePostRender(RenderEntity* entity) {
@@ -195,15 +491,25 @@ CC_FORCE_INLINE void Batcher2d::handleComponentDraw(RenderEntity* entity, Render
     }
 
     if (!drawInfo->getIsMeshBuffer()) {
+        FillTask task;
+        task.entity = entity;
+        task.drawInfo = drawInfo;
         if (node->getChangedFlags() || drawInfo->getVertDirty()) {
-            fillVertexBuffers(entity, drawInfo);
+            // the world matrix may be updated lazily, resolve it while still on this thread
+            task.worldMatrix = &node->getWorldMatrix();
             drawInfo->setVertDirty(false);
         }
-        if (entity->getVBColorDirty()) {
-            fillColors(entity, drawInfo);
+        task.fillColors = entity->getVBColorDirty();
+
+        UIMeshBuffer* buffer = drawInfo->getMeshBuffer();
+        task.indexOffset = buffer->getIndexOffset();
+        buffer->setIndexOffset(task.indexOffset + drawInfo->getIbCount());
+        _fillTasks.emplace_back(task);
+        if (_recordingRoot) {
+            recordRetainedDraw(entity, drawInfo, node, task.indexOffset);
         }
-
-        fillIndexBuffers(drawInfo);
+    } else {
+        stopRetaining();
     }
 
     if (isMask) {
@@ -212,6 +518,7 @@ CC_FORCE_INLINE void Batcher2d::handleComponentDraw(RenderEntity* entity, Render
 }
 
 CC_FORCE_INLINE void Batcher2d::handleModelDraw(RenderEntity* entity, RenderDrawInfo* drawInfo) {
+    stopRetaining();
     generateBatch(_currEntity, _currDrawInfo);
     resetRenderStates();
 
@@ -257,6 +564,7 @@ CC_FORCE_INLINE void Batcher2d::handleModelDraw(RenderEntity* entity, RenderDraw
 }
 
 CC_FORCE_INLINE void Batcher2d::handleMiddlewareDraw(RenderEntity* entity, RenderDrawInfo* drawInfo) {
+    stopRetaining();
     auto layer = entity->getNode()->getLayer();
     Material* material = drawInfo->getMaterial();
     auto* texture = drawInfo->getTexture();
@@ -285,6 +593,8 @@ CC_FORCE_INLINE void Batcher2d::handleMiddlewareDraw(RenderEntity* entity, Rende
 }
 
 CC_FORCE_INLINE void Batcher2d::handleSubNode(RenderEntity* entity, RenderDrawInfo* drawInfo) { // NOLINT
+    // the sub node is not part of the root
+    stopRetaining();
     if (drawInfo->getSubNode()) {
         walk(drawInfo->getSubNode(), entity->getOpacity());
     }
@@ -359,6 +669,18 @@ void Batcher2d::generateBatch(RenderEntity* entity, RenderDrawInfo* drawInfo) {
     curdrawBatch->setInputAssembler(ia);
     curdrawBatch->fillPass(_currMaterial, depthStencil, dssHash);
     const auto& pass = curdrawBatch->getPasses().at(0);
+    if (_recordingRoot && _recordingRoot->retainable && !drawInfo->getIsMeshBuffer()) {
+        RetainedBatch retainedBatch;
+        retainedBatch.batch = curdrawBatch;
+        retainedBatch.meshBuffer = drawInfo->getMeshBuffer();
+        retainedBatch.material = _currMaterial;
+        retainedBatch.texture = _currTexture;
+        retainedBatch.sampler = _currSampler;
+        retainedBatch.stencilStage = entityStage;
+        retainedBatch.firstIndex = ia->getFirstIndex();
+        retainedBatch.indexCount = ia->getIndexCount();
+        _recordingRoot->batches.emplace_back(retainedBatch);
+    }
 
     if (entity->getUseLocal()) {
         drawInfo->updateLocalDescriptorSet(entity->getRenderTransform(), pass->getLocalSetLayout());
@@ -504,10 +826,14 @@ void Batcher2d::uploadBuffers() {
 }
 
 void Batcher2d::reset() {
-    for (auto& batch : _batches) {
-        batch->clear();
-        _drawBatchPool.free(batch);
-    }
+    // free in reverse order, so the next frame allocates the same batch objects for the same run of draws
+    // and DrawBatch2D::fillPass can skip the passes which didn't change.
+    // the batches of retained roots are kept for the next frame
+    for (auto iter = _transientBatches.rbegin(); iter != _transientBatches.rend(); ++iter) {
+        (*iter)->clear();
+        _drawBatchPool.free(*iter);
+    }
+    _transientBatches.clear();
     _batches.clear();
 
     for (auto& meshRenderData : _meshRenderDrawInfo) {
@@ -537,6 +863,7 @@ void Batcher2d::reset() {
 }
 
 void Batcher2d::insertMaskBatch(RenderEntity* entity) {
+    stopRetaining();
     generateBatch(_currEntity, _currDrawInfo);
     resetRenderStates();
     createClearModel();
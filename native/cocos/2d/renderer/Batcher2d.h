@@ -32,6 +32,7 @@
 #include "base/TypeDef.h"
 #include "core/assets/Material.h"
 #include "core/memop/Pool.h"
+#include "math/MathUtil.h"
 #include "renderer/gfx-base/GFXTexture.h"
 #include "renderer/gfx-base/states/GFXSampler.h"
 #include "scene/DrawBatch2D.h"
@@ -78,34 +79,98 @@ public:
 private:
     bool _isInit = false;
 
-    inline void fillIndexBuffers(RenderDrawInfo* drawInfo) { // NOLINT(readability-convert-member-functions-to-static)
-        uint16_t* ib = drawInfo->getIDataBuffer();
+    // Vertex, color and index data of the draw infos are filled after the walk, so the walk itself only
+    // decides about batching and reserves index ranges. Every fill writes to its own buffer range.
+    struct FillTask {
+        RenderEntity* entity{nullptr};
+        RenderDrawInfo* drawInfo{nullptr};
+        const Mat4* worldMatrix{nullptr}; // nullptr if the vertices are clean
+        uint32_t indexOffset{0};
+        bool fillColors{false};
+    };
 
-        UIMeshBuffer* buffer = drawInfo->getMeshBuffer();
-        uint32_t indexOffset = buffer->getIndexOffset();
+    void flushFillTasks();
+
+    // Retained batching. A root keeps its batches and index ranges while its subtree keeps the same draw infos
+    // with the same batching attributes, later frames only refill the draw infos with dirty transforms, vertices
+    // or colors. Roots with masks, models, middleware, mesh buffer draws, sub nodes or local transforms always walk.
+    struct RetainedEntity {
+        RenderEntity* entity{nullptr};
+        int32_t parent{-1}; // closest ancestor entity, -1 if the opacity comes from the root
+        bool enabled{false};
+    };
+
+    struct RetainedDraw {
+        Node* node{nullptr};
+        RenderDrawInfo* drawInfo{nullptr};
+        uint32_t entity{0};
+        uint32_t layer{0};
+        uint32_t indexOffset{0};
+        ccstd::hash_t dataHash{0};
+        Material* material{nullptr};
+        gfx::Texture* texture{nullptr};
+        gfx::Sampler* sampler{nullptr};
+        UIMeshBuffer* meshBuffer{nullptr};
+        float* vbBuffer{nullptr};
+        uint16_t* ibBuffer{nullptr};
+        uint32_t vbCount{0};
+        uint32_t ibCount{0};
+    };
+
+    struct RetainedIndexRange {
+        UIMeshBuffer* meshBuffer{nullptr};
+        uint16_t* iData{nullptr};
+        uint32_t begin{0};
+        uint32_t end{0};
+    };
+
+    struct RetainedBatch {
+        scene::DrawBatch2D* batch{nullptr};
+        UIMeshBuffer* meshBuffer{nullptr};
+        Material* material{nullptr};
+        gfx::Texture* texture{nullptr};
+        gfx::Sampler* sampler{nullptr};
+        StencilStage stencilStage{StencilStage::DISABLED};
+        uint32_t firstIndex{0};
+        uint32_t indexCount{0};
+    };
+
+    struct RetainedRoot {
+        Node* node{nullptr};
+        bool retainable{false};
+        StencilStage stencilStage{StencilStage::DISABLED};
+        ccstd::vector<RetainedEntity> entities;
+        ccstd::vector<RetainedDraw> draws;
+        ccstd::vector<RetainedIndexRange> indexRanges;
+        ccstd::vector<RetainedBatch> batches;
+    };
+
+    void beginRetainedRoot(RetainedRoot& root, Node* node);
+    void endRetainedRoot(RetainedRoot& root, size_t batchBegin);
+    bool matchRetainedRoot(Node* node, const RetainedRoot& root, int32_t parentEntity, uint32_t& entityIndex, uint32_t& drawIndex) const;
+    bool reuseRetainedRoot(RetainedRoot& root, Node* node);
+    void releaseRetainedRoot(RetainedRoot& root);
+    void releaseRetainedRoots();
+    void recordRetainedDraw(RenderEntity* entity, RenderDrawInfo* drawInfo, Node* node, uint32_t indexOffset);
+    inline void stopRetaining() {
+        if (_recordingRoot) {
+            _recordingRoot->retainable = false;
+        }
+    }
 
+    inline void fillIndexBuffers(RenderDrawInfo* drawInfo, uint32_t indexOffset) { // NOLINT(readability-convert-member-functions-to-static)
+        uint16_t* ib = drawInfo->getIDataBuffer();
         uint16_t* indexb = drawInfo->getIbBuffer();
         uint32_t indexCount = drawInfo->getIbCount();
 
         memcpy(&ib[indexOffset], indexb, indexCount * sizeof(uint16_t));
-        indexOffset += indexCount;
-
-        buffer->setIndexOffset(indexOffset);
     }
 
-    inline void fillVertexBuffers(RenderEntity* entity, RenderDrawInfo* drawInfo) { // NOLINT(readability-convert-member-functions-to-static)
-        Node* node = entity->getNode();
-        const Mat4& matrix = node->getWorldMatrix();
-        uint8_t stride = drawInfo->getStride();
-        uint32_t size = drawInfo->getVbCount() * stride;
-        float* vbBuffer = drawInfo->getVbBuffer();
-        for (int i = 0; i < size; i += stride) {
-            Render2dLayout* curLayout = drawInfo->getRender2dLayout(i);
-            // make sure that the layout of Vec3 is three consecutive floats
-            static_assert(sizeof(Vec3) == 3 * sizeof(float));
-            // cast to reduce value copy instructions
-            reinterpret_cast<Vec3*>(vbBuffer + i)->transformMat4(curLayout->position, matrix);
-        }
+    inline void fillVertexBuffers(const Mat4& matrix, RenderDrawInfo* drawInfo) { // NOLINT(readability-convert-member-functions-to-static)
+        uint32_t strideBytes = drawInfo->getStride() * sizeof(float);
+        // positions are the first 3 floats of both the layout and the vertex
+        MathUtil::transformPositions(matrix.m, &drawInfo->getRender2dLayout(0)->position, strideBytes,
+                                     drawInfo->getVbBuffer(), strideBytes, drawInfo->getVbCount());
     }
 
     inline void setIndexRange(RenderDrawInfo* drawInfo) { // NOLINT(readability-convert-member-functions-to-static)
@@ -120,19 +185,15 @@ private:
 
     inline void fillColors(RenderEntity* entity, RenderDrawInfo* drawInfo) { // NOLINT(readability-convert-member-functions-to-static)
         Color temp = entity->getColor();
-
-        uint8_t stride = drawInfo->getStride();
-        uint32_t size = drawInfo->getVbCount() * stride;
-        float* vbBuffer = drawInfo->getVbBuffer();
-
-        uint32_t offset = 0;
-        for (int i = 0; i < size; i += stride) {
-            offset = i + 5;
-            vbBuffer[offset++] = static_cast<float>(temp.r) / 255.0F;
-            vbBuffer[offset++] = static_cast<float>(temp.g) / 255.0F;
-            vbBuffer[offset++] = static_cast<float>(temp.b) / 255.0F;
-            vbBuffer[offset++] = entity->getOpacity();
-        }
+        const float color[4] = {
+            static_cast<float>(temp.r) / 255.0F,
+            static_cast<float>(temp.g) / 255.0F,
+            static_cast<float>(temp.b) / 255.0F,
+            entity->getOpacity(),
+        };
+
+        // color starts at the 6th float of the vertex
+        MathUtil::fillStrided(color, drawInfo->getVbBuffer() + 5, drawInfo->getStride() * sizeof(float), drawInfo->getVbCount());
     }
 
     void insertMaskBatch(RenderEntity* entity);
@@ -149,8 +210,16 @@ private:
 
     // manage memory manually
     ccstd::vector<scene::DrawBatch2D*> _batches;
+    // the batches of this frame which aren't kept by a retained root
+    ccstd::vector<scene::DrawBatch2D*> _transientBatches;
     memop::Pool<scene::DrawBatch2D> _drawBatchPool;
 
+    // one per root node, kept across frames
+    ccstd::vector<RetainedRoot> _retainedRoots;
+    // weak reference, the root being walked
+    RetainedRoot* _recordingRoot{nullptr};
+    int32_t _recordingEntity{-1};
+
     // weak reference
     gfx::Device* _device{nullptr}; // use getDevice()
 
@@ -176,6 +245,8 @@ private:
     // weak reference
     ccstd::vector<RenderDrawInfo*> _meshRenderDrawInfo;
 
+    ccstd::vector<FillTask> _fillTasks;
+
     // manage memory manually
     ccstd::unordered_map<ccstd::hash_t, gfx::DescriptorSet*> _descriptorSetCache;
     gfx::DescriptorSetInfo _dsInfo;
@@ -24,18 +24,24 @@
 ****************************************************************************/
 
 #include "3d/assets/Mesh.h"
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <tuple>
 #include "3d/assets/Morph.h"
 #include "3d/assets/Skeleton.h"
 #include "3d/misc/BufferBlob.h"
+#include "application/ApplicationManager.h"
+#include "base/Scheduler.h"
+#include "base/job-system/JobSystem.h"
 #include "base/std/hash/hash.h"
 #include "core/DataView.h"
 #include "core/assets/RenderingSubMesh.h"
 #include "core/platform/Debug.h"
+#include "math/MathUtil.h"
 #include "math/Quaternion.h"
 #include "renderer/gfx-base/GFXDevice.h"
 
-#define CC_OPTIMIZE_MESH_DATA 0
-
 namespace cc {
 
 namespace {
@@ -169,7 +175,6 @@ DataWritterCallback getWriter(DataView &dataView, gfx::Format format) {
     return nullptr;
 }
 
-#if CC_OPTIMIZE_MESH_DATA
 void checkAttributesNeedConvert(const gfx::AttributeList &orignalAttributes,         // in
                                 gfx::AttributeList &attributes,                      // in-out
                                 ccstd::vector<uint32_t> &attributeIndicsNeedConvert, // in-out
@@ -213,28 +218,290 @@ void checkAttributesNeedConvert(const gfx::AttributeList &orignalAttributes,
     }
 }
 
-void convertRGBA32FToRGBA16F(const float *src, uint16_t *dst) {
-    dst[0] = utils::rawHalfAsUint16(utils::floatToHalf(src[0]));
-    dst[1] = utils::rawHalfAsUint16(utils::floatToHalf(src[1]));
-    dst[2] = utils::rawHalfAsUint16(utils::floatToHalf(src[2]));
-    dst[3] = utils::rawHalfAsUint16(utils::floatToHalf(src[3]));
+// A run of bytes of one vertex which is either copied as is or converted from floats to half floats.
+struct VertexSegment {
+    uint32_t srcOffset{0};
+    uint32_t dstOffset{0};
+    uint32_t size{0};    // bytes to copy, or floats to convert
+    uint32_t padding{0}; // bytes zeroed after the converted half floats
+    bool convert{false};
+};
+
+struct VertexBundleConversion {
+    const uint8_t *src{nullptr}; // the original vertices, in the mesh data
+    uint8_t *dst{nullptr};       // where the converted vertices are written, in the new mesh data
+    uint32_t bundle{0};
+    gfx::AttributeList attributes; // with the converted formats
+    uint32_t count{0};
+    uint32_t srcStride{0};
+    uint32_t dstStride{0};
+    uint32_t floatsPerVertex{0};
+    ccstd::vector<VertexSegment> segments;
+};
+
+constexpr uint32_t CONVERT_BLOCK_VERTICES = 256;
+constexpr uint32_t CONVERT_MIN_VERTICES_PER_JOB = 4096;
+
+void convertVertices(const VertexBundleConversion &conversion, uint32_t begin, uint32_t end) {
+    ccstd::vector<float> floats(CONVERT_BLOCK_VERTICES * conversion.floatsPerVertex);
+    ccstd::vector<uint16_t> halves(floats.size());
+
+    for (uint32_t blockBegin = begin; blockBegin < end; blockBegin += CONVERT_BLOCK_VERTICES) {
+        const uint32_t blockEnd = std::min(blockBegin + CONVERT_BLOCK_VERTICES, end);
+
+        // Gather the floats of a block first, so that the kernel runs over one contiguous array.
+        float *pFloat = floats.data();
+        for (uint32_t i = blockBegin; i < blockEnd; ++i) {
+            const uint8_t *src = conversion.src + i * conversion.srcStride;
+            for (const auto &segment : conversion.segments) {
+                if (segment.convert) {
+                    memcpy(pFloat, src + segment.srcOffset, segment.size * sizeof(float));
+                    pFloat += segment.size;
+                }
+            }
+        }
+        MathUtil::floatToHalf(floats.data(), static_cast<uint32_t>(pFloat - floats.data()), halves.data());
+
+        const uint16_t *pHalf = halves.data();
+        for (uint32_t i = blockBegin; i < blockEnd; ++i) {
+            const uint8_t *src = conversion.src + i * conversion.srcStride;
+            uint8_t *dst = conversion.dst + i * conversion.dstStride;
+            for (const auto &segment : conversion.segments) {
+                if (segment.convert) {
+                    memcpy(dst + segment.dstOffset, pHalf, segment.size * sizeof(uint16_t));
+                    memset(dst + segment.dstOffset + segment.size * sizeof(uint16_t), 0, segment.padding);
+                    pHalf += segment.size;
+                } else {
+                    memcpy(dst + segment.dstOffset, src + segment.srcOffset, segment.size);
+                }
+            }
+        }
+    }
+}
+
+uint32_t getConvertJobCount(uint32_t count) {
+    const uint32_t maxJobCount = count > 0 ? (count - 1) / CONVERT_MIN_VERTICES_PER_JOB + 1 : 1;
+    return std::min(JobSystem::getInstance()->threadCount(), maxJobCount);
+}
+
+constexpr uint32_t MERGE_MIN_VERTICES_PER_JOB = 4096;
+
+// The index size merge() picks for a merged index count.
+uint32_t getMergedIndexStride(uint32_t indexCount) {
+    if (indexCount < 256) {
+        return 1;
+    }
+    if (indexCount < 65536) {
+        return 2;
+    }
+    return 4;
+}
+
+template <typename Dst, typename Src>
+void rebaseIndices(const uint8_t *src, uint32_t count, uint32_t base, uint32_t mask, uint8_t *dst) {
+    const auto *in = reinterpret_cast<const Src *>(src);
+    auto *out = reinterpret_cast<Dst *>(dst);
+    for (uint32_t i = 0; i < count; ++i) {
+        out[i] = static_cast<Dst>((base + in[i]) & mask);
+    }
+}
+
+template <typename Dst>
+void rebaseIndices(const uint8_t *src, uint32_t srcStride, uint32_t count, uint32_t base, uint32_t mask, uint8_t *dst) {
+    switch (srcStride) {
+        case 1: rebaseIndices<Dst, uint8_t>(src, count, base, mask, dst); break;
+        case 2: rebaseIndices<Dst, uint16_t>(src, count, base, mask, dst); break;
+        default: rebaseIndices<Dst, uint32_t>(src, count, base, mask, dst); break;
+    }
 }
 
-void convertRGB32FToRGB16F(const float *src, uint16_t *dst) {
-    dst[0] = utils::rawHalfAsUint16(utils::floatToHalf(src[0]));
-    dst[1] = utils::rawHalfAsUint16(utils::floatToHalf(src[1]));
-    dst[2] = utils::rawHalfAsUint16(utils::floatToHalf(src[2]));
+// Writes base + index, truncated to truncStride bytes as merge() does when adding these indices,
+// as indices of dstStride bytes.
+void rebaseIndices(const uint8_t *src, uint32_t srcStride, uint32_t count, uint32_t base, uint32_t truncStride, uint8_t *dst, uint32_t dstStride) {
+    const uint32_t mask = truncStride >= 4 ? 0xFFFFFFFFU : (1U << (truncStride * 8)) - 1;
+    switch (dstStride) {
+        case 1: rebaseIndices<uint8_t>(src, srcStride, count, base, mask, dst); break;
+        case 2: rebaseIndices<uint16_t>(src, srcStride, count, base, mask, dst); break;
+        default: rebaseIndices<uint32_t>(src, srcStride, count, base, mask, dst); break;
+    }
 }
 
-void convertRG32FToRG16F(const float *src, uint16_t *dst) {
-    dst[0] = utils::rawHalfAsUint16(utils::floatToHalf(src[0]));
-    dst[1] = utils::rawHalfAsUint16(utils::floatToHalf(src[1]));
+// Uploads the indices of a view, narrowed if the index buffer was created with 16-bit indices.
+void uploadIndices(gfx::Buffer *indexBuffer, const uint8_t *ib, const Mesh::IBufferView &view) {
+    if (view.stride != indexBuffer->getStride()) {
+        uint32_t ib16BitLength = view.length >> 1;
+        auto *ib16Bit = static_cast<uint16_t *>(CC_MALLOC(ib16BitLength));
+        const auto *ib32Bit = reinterpret_cast<const uint32_t *>(ib);
+        for (uint32_t j = 0, len = view.count; j < len; ++j) {
+            ib16Bit[j] = ib32Bit[j];
+        }
+
+        indexBuffer->update(ib16Bit, ib16BitLength);
+        CC_FREE(ib16Bit);
+    } else {
+        indexBuffer->update(ib);
+    }
 }
 
-#endif // #if CC_OPTIMIZE_MESH_DATA
+// Spreads the lower 10 bits so that there are 2 zero bits between each, for 30-bit Morton codes.
+uint32_t spreadBits(uint32_t v) {
+    v &= 0x3FFU;
+    v = (v | (v << 16U)) & 0x030000FFU;
+    v = (v | (v << 8U)) & 0x0300F00FU;
+    v = (v | (v << 4U)) & 0x030C30C3U;
+    v = (v | (v << 2U)) & 0x09249249U;
+    return v;
+}
+
+using MortonKeys = ccstd::vector<std::pair<uint32_t, uint32_t>>;
+
+// Splits a sorted range of Morton keys at the highest differing bit until the ranges fit in a cluster,
+// so that every cluster stays within one node of the implicit octree instead of straddling two.
+void splitMortonRange(const MortonKeys &keys, uint32_t first, uint32_t last, uint32_t maxTriangles, ccstd::vector<std::pair<uint32_t, uint32_t>> &ranges) {
+    if (last - first <= maxTriangles) {
+        ranges.emplace_back(first, last);
+        return;
+    }
+    const uint32_t diff = keys[first].first ^ keys[last - 1].first;
+    if (diff == 0) {
+        for (; first < last; first += maxTriangles) {
+            ranges.emplace_back(first, std::min(first + maxTriangles, last));
+        }
+        return;
+    }
+    uint32_t bit = 1U << 31U;
+    while (!(diff & bit)) {
+        bit >>= 1U;
+    }
+    const auto split = std::partition_point(keys.begin() + first, keys.begin() + last, [bit](const auto &key) {
+        return !(key.first & bit);
+    });
+    const auto mid = static_cast<uint32_t>(split - keys.begin());
+    splitMortonRange(keys, first, mid, maxTriangles, ranges);
+    splitMortonRange(keys, mid, last, maxTriangles, ranges);
+}
+
+// Sorts the triangles along a Morton curve of their centroids so that consecutive triangles are close in space,
+// then splits them into clusters of at most maxTriangles with bounds and normal cones.
+template <typename T>
+bool clusterTriangles(uint8_t *data, uint32_t indexCount, const float *positions, uint32_t positionStride, uint32_t vertexCount,
+                      uint32_t maxTriangles, ccstd::vector<IMeshCluster> &clusters) {
+    auto *indices = reinterpret_cast<T *>(data);
+    const uint32_t triangleCount = indexCount / 3;
+    if (triangleCount == 0) {
+        return false;
+    }
+    for (uint32_t i = 0; i < triangleCount * 3; ++i) {
+        if (indices[i] >= vertexCount) {
+            return false;
+        }
+    }
+
+    const auto getPosition = [&](uint32_t index) {
+        const float *p = positions + static_cast<size_t>(index) * positionStride;
+        return Vec3{p[0], p[1], p[2]};
+    };
+
+    ccstd::vector<Vec3> centroids(triangleCount);
+    Vec3 minPos{std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    Vec3 maxPos{-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max()};
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        auto &centroid = centroids[t];
+        centroid = getPosition(indices[t * 3]) + getPosition(indices[t * 3 + 1]) + getPosition(indices[t * 3 + 2]);
+        centroid *= 1.F / 3.F;
+        Vec3::min(minPos, centroid, &minPos);
+        Vec3::max(maxPos, centroid, &maxPos);
+    }
+
+    const Vec3 extent = maxPos - minPos;
+    const float scale = 1023.F / std::max(std::max(extent.x, extent.y), std::max(extent.z, MATH_EPSILON));
+    MortonKeys keys(triangleCount);
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        const Vec3 cell = (centroids[t] - minPos) * scale;
+        const uint32_t key = spreadBits(static_cast<uint32_t>(cell.x)) |
+                             (spreadBits(static_cast<uint32_t>(cell.y)) << 1U) |
+                             (spreadBits(static_cast<uint32_t>(cell.z)) << 2U);
+        keys[t] = {key, t};
+    }
+    std::sort(keys.begin(), keys.end());
+
+    ccstd::vector<T> sorted(triangleCount * 3);
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        memcpy(&sorted[t * 3], &indices[keys[t].second * 3], sizeof(T) * 3);
+    }
+    memcpy(indices, sorted.data(), sizeof(T) * sorted.size());
+
+    ccstd::vector<std::pair<uint32_t, uint32_t>> ranges;
+    splitMortonRange(keys, 0, triangleCount, maxTriangles, ranges);
+
+    ccstd::vector<Vec3> normals;
+    normals.reserve(maxTriangles);
+    for (const auto &range : ranges) {
+        const uint32_t first = range.first;
+        const uint32_t last = range.second;
+        IMeshCluster cluster;
+        cluster.firstIndex = first * 3;
+        cluster.indexCount = (last - first) * 3;
+
+        Vec3 clusterMin{std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+        Vec3 clusterMax{-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max()};
+        Vec3 normalSum;
+        normals.clear();
+        for (uint32_t t = first; t < last; ++t) {
+            const Vec3 a = getPosition(indices[t * 3]);
+            const Vec3 b = getPosition(indices[t * 3 + 1]);
+            const Vec3 c = getPosition(indices[t * 3 + 2]);
+            for (const auto *v : {&a, &b, &c}) {
+                Vec3::min(clusterMin, *v, &clusterMin);
+                Vec3::max(clusterMax, *v, &clusterMax);
+            }
+            Vec3 normal;
+            Vec3::cross(b - a, c - a, &normal);
+            const float length = normal.length();
+            if (length > 0.F) {
+                normal *= 1.F / length;
+                normalSum += normal;
+                normals.emplace_back(normal);
+            }
+        }
+        cluster.center = (clusterMin + clusterMax) * 0.5F;
+        cluster.halfExtents = (clusterMax - clusterMin) * 0.5F;
+
+        float radiusSquared = 0.F;
+        for (uint32_t i = cluster.firstIndex; i < cluster.firstIndex + cluster.indexCount; ++i) {
+            radiusSquared = std::max(radiusSquared, getPosition(indices[i]).distanceSquared(cluster.center));
+        }
+        cluster.radius = std::sqrt(radiusSquared);
+
+        // the cone is useless when the triangles face too many directions
+        const float sumLength = normalSum.length();
+        if (sumLength > 0.F) {
+            cluster.coneAxis = normalSum * (1.F / sumLength);
+            float minDot = 1.F;
+            for (const auto &normal : normals) {
+                minDot = std::min(minDot, normal.dot(cluster.coneAxis));
+            }
+            cluster.coneCutoff = minDot <= 0.1F ? 1.F : std::sqrt(1.F - minDot * minDot);
+        }
+        clusters.emplace_back(cluster);
+    }
+    return true;
+}
 
 } // namespace
 
+// Vertex data converted into a new buffer, which replaces the mesh data on the main thread once it is done.
+struct Mesh::VertexConversion {
+    IntrusivePtr<ArrayBuffer> source; // the mesh data, kept alive while the jobs read it
+    IntrusivePtr<ArrayBuffer> result;
+    ccstd::vector<VertexBundleConversion> bundles;
+    std::atomic<uint32_t> remaining{0U};
+    std::promise<void> done;
+    std::future<void> finished;
+};
+
+bool Mesh::dataOptimizationEnabled = false;
+
 Mesh::~Mesh() = default;
 
 ccstd::any Mesh::getNativeAsset() const {
@@ -344,6 +611,9 @@ void Mesh::initialize() {
             return;
         }
 
+        waitVertexConversion();
+        tryConvertVertexData(false);
+
         auto &buffer = _data;
         gfx::Device *gfxDevice = gfx::Device::getInstance();
         RefVector<gfx::Buffer *> vertexBuffers{createVertexBuffers(gfxDevice, buffer.buffer())};
@@ -364,15 +634,10 @@ void Mesh::initialize() {
                 uint32_t dstSize = idxView.length;
                 if (dstStride == 4) {
                     uint32_t vertexCount = _struct.vertexBundles[prim.vertexBundelIndices[0]].view.count;
-#if CC_OPTIMIZE_MESH_DATA
-                    if (vertexCount < 65536) {
+                    if (dataOptimizationEnabled && vertexCount < 65536) {
                         dstStride >>= 1; // Reduce to short.
                         dstSize >>= 1;
                     } else if (!gfxDevice->hasFeature(gfx::Feature::ELEMENT_INDEX_UINT)) {
-                        continue; // Ignore this primitive
-                    }
-#else
-                    if (!gfxDevice->hasFeature(gfx::Feature::ELEMENT_INDEX_UINT)) {
                         if (vertexCount >= 65536) {
                             CC_LOG_WARNING("Device does not support UINT element index type and vertexCount (%u) is larger than ushort", vertexCount);
                             continue;
@@ -381,7 +646,6 @@ void Mesh::initialize() {
                         dstStride >>= 1; // Reduce to short.
                         dstSize >>= 1;
                     }
-#endif
                 }
 
                 indexBuffer = gfxDevice->createBuffer(gfx::BufferInfo{
@@ -392,20 +656,7 @@ void Mesh::initialize() {
                 });
                 indexBuffers.pushBack(indexBuffer);
 
-                const uint8_t *ib = buffer.buffer()->getData() + idxView.offset;
-                if (idxView.stride != dstStride) {
-                    uint32_t ib16BitLength = idxView.length >> 1;
-                    auto *ib16Bit = static_cast<uint16_t *>(CC_MALLOC(ib16BitLength));
-                    const auto *ib32Bit = reinterpret_cast<const uint32_t *>(ib);
-                    for (uint32_t j = 0, len = idxView.count; j < len; ++j) {
-                        ib16Bit[j] = ib32Bit[j];
-                    }
-
-                    indexBuffer->update(ib16Bit, ib16BitLength);
-                    CC_FREE(ib16Bit);
-                } else {
-                    indexBuffer->update(ib);
-                }
+                uploadIndices(indexBuffer, buffer.buffer()->getData() + idxView.offset, idxView);
             }
 
             gfx::BufferList vbReference;
@@ -429,6 +680,9 @@ void Mesh::initialize() {
             auto *subMesh = ccnew RenderingSubMesh(vbReference, gfxAttributes, prim.primitiveMode, indexBuffer);
             subMesh->setMesh(this);
             subMesh->setSubMeshIdx(static_cast<uint32_t>(i));
+            if (i < _clusters.size() && !_clusters[i].empty()) {
+                subMesh->setClusters(_clusters[i]);
+            }
 
             subMeshes.emplace_back(subMesh);
         }
@@ -446,7 +700,28 @@ void Mesh::initialize() {
     }
 }
 
+void Mesh::initializeAsync() {
+    if (_initialized || _vertexConversion || _struct.dynamic.has_value() || !_data.buffer()) {
+        initialize();
+        return;
+    }
+
+    tryConvertVertexData(true);
+    if (!_vertexConversion) {
+        initialize(); // nothing to convert
+    }
+}
+
+void Mesh::setDataOptimizationEnabled(bool enabled) {
+    dataOptimizationEnabled = enabled;
+}
+
+bool Mesh::isDataOptimizationEnabled() {
+    return dataOptimizationEnabled;
+}
+
 void Mesh::destroyRenderingMesh() {
+    waitVertexConversion();
     if (!_renderingSubMeshes.empty()) {
         for (auto &submesh : _renderingSubMeshes) {
             submesh->destroy();
@@ -466,6 +741,7 @@ void Mesh::reset(ICreateInfo &&info) {
     _struct = std::move(info.structInfo);
     _data = std::move(info.data);
     _hash = 0;
+    _clusters.clear();
 }
 
 Mesh::BoneSpaceBounds Mesh::getBoneSpaceBounds(Skeleton *skeleton) {
@@ -836,6 +1112,325 @@ bool Mesh::merge(Mesh *mesh, const Mat4 *worldMatrix /* = nullptr */, bool valid
     return true;
 }
 
+bool Mesh::mergeBatch(const ccstd::vector<Mesh *> &meshes, const ccstd::vector<const Mat4 *> &worldMatrices, bool validate /* = false*/) {
+    const auto getWorldMatrix = [&](size_t i) -> const Mat4 * {
+        return i < worldMatrices.size() ? worldMatrices[i] : nullptr;
+    };
+
+    bool allMerged = true;
+    size_t first = 0;
+    // An uninitialized mesh takes over the first merged mesh.
+    for (; first < meshes.size() && !_initialized; ++first) {
+        allMerged = merge(meshes[first], getWorldMatrix(first), validate) && allMerged;
+    }
+
+    struct Source {
+        Mesh *mesh{nullptr};
+        const Mat4 *worldMatrix{nullptr};
+        Quaternion rotation;
+    };
+    ccstd::vector<Source> sources;
+    sources.reserve(meshes.size() - first);
+    bool batchable = _data.buffer() != nullptr;
+    bool transformed = false;
+    for (size_t i = first; i < meshes.size(); ++i) {
+        // Merging never changes what is validated, so validating against the current mesh is the same as one by one.
+        if (validate && !validateMergingMesh(meshes[i])) {
+            allMerged = false;
+            continue;
+        }
+        Source source{meshes[i], getWorldMatrix(i), {}};
+        // merging a mesh into itself reads what the previous steps wrote
+        batchable = batchable && source.mesh != this && source.mesh->_data.buffer() != nullptr;
+        if (source.worldMatrix != nullptr) {
+            source.worldMatrix->getRotation(&source.rotation);
+            // merge() divides by w with a tolerance, which only affine transforms are guaranteed to skip
+            const float *m = source.worldMatrix->m;
+            batchable = batchable && m[3] == 0.F && m[7] == 0.F && m[11] == 0.F && m[15] == 1.F;
+            transformed = true;
+        }
+        sources.emplace_back(source);
+    }
+    if (sources.empty()) {
+        return allMerged;
+    }
+
+    // merge() transforms positions and normals as 3 floats whatever their format
+    for (const auto &bundle : _struct.vertexBundles) {
+        for (const auto &attr : bundle.attributes) {
+            if (transformed && (attr.name == gfx::ATTR_NAME_POSITION || attr.name == gfx::ATTR_NAME_NORMAL) && attr.format != gfx::Format::RGB32F) {
+                batchable = false;
+            }
+        }
+    }
+    if (!batchable) {
+        for (const auto &source : sources) {
+            merge(source.mesh, source.worldMatrix, false);
+        }
+        return allMerged;
+    }
+
+    const auto sourceCount = static_cast<uint32_t>(sources.size());
+    const auto &bundles = _struct.vertexBundles;
+    const auto &prims = _struct.primitives;
+    Mesh::IStruct meshStruct;
+
+    // Prefix sums of the vertex counts, so every source knows where its vertices go.
+    // vertexStarts[b * (sourceCount + 1) + k] is the first vertex of source k in bundle b, the last one is the total.
+    ccstd::vector<uint32_t> vertexStarts(bundles.size() * (sourceCount + 1));
+    meshStruct.vertexBundles.resize(bundles.size());
+    uint32_t length = 0;
+    uint64_t vertexCount = 0;
+    for (size_t b = 0; b < bundles.size(); ++b) {
+        uint32_t *starts = vertexStarts.data() + b * (sourceCount + 1);
+        uint32_t count = bundles[b].view.count;
+        for (uint32_t k = 0; k < sourceCount; ++k) {
+            starts[k] = count;
+            count += sources[k].mesh->_struct.vertexBundles[b].view.count;
+        }
+        starts[sourceCount] = count;
+        vertexCount += count;
+
+        auto &vertexBundle = meshStruct.vertexBundles[b];
+        vertexBundle.attributes = bundles[b].attributes;
+        vertexBundle.view.offset = length;
+        vertexBundle.view.length = count * bundles[b].view.stride;
+        vertexBundle.view.count = count;
+        vertexBundle.view.stride = bundles[b].view.stride;
+        length += vertexBundle.view.length;
+    }
+
+    // Merging one by one narrows the indices added at each step to the index size of that step,
+    // and drops the indices of a primitive as soon as one side has none.
+    struct IndexLayout {
+        ccstd::vector<uint32_t> starts;       // first index of each source
+        ccstd::vector<uint32_t> bases;        // vertex offset added to the indices of each source
+        ccstd::vector<uint32_t> truncStrides; // index size of the step merging each source
+    };
+    ccstd::vector<IndexLayout> indexLayouts(prims.size());
+    meshStruct.primitives.resize(prims.size());
+    for (size_t p = 0; p < prims.size(); ++p) {
+        const auto &prim = prims[p];
+        auto &primitive = meshStruct.primitives[p];
+        primitive.primitiveMode = prim.primitiveMode;
+        primitive.vertexBundelIndices = prim.vertexBundelIndices;
+
+        bool indexed = prim.indexView.has_value();
+        for (uint32_t k = 0; k < sourceCount && indexed; ++k) {
+            indexed = sources[k].mesh->_struct.primitives[p].indexView.has_value();
+        }
+        if (!indexed) {
+            continue;
+        }
+
+        auto &layout = indexLayouts[p];
+        layout.starts.resize(sourceCount);
+        layout.bases.resize(sourceCount);
+        layout.truncStrides.resize(sourceCount);
+        uint32_t count = prim.indexView->count;
+        for (uint32_t k = 0; k < sourceCount; ++k) {
+            uint32_t base = 0;
+            for (const uint32_t bundleIdx : prim.vertexBundelIndices) {
+                base = std::max(base, vertexStarts[bundleIdx * (sourceCount + 1) + k]);
+            }
+            layout.starts[k] = count;
+            layout.bases[k] = base;
+            count += sources[k].mesh->_struct.primitives[p].indexView->count;
+            layout.truncStrides[k] = getMergedIndexStride(count);
+        }
+
+        IBufferView indexView;
+        indexView.count = count;
+        indexView.stride = getMergedIndexStride(count);
+        const uint32_t remainder = length % indexView.stride;
+        if (remainder != 0) {
+            length += indexView.stride - remainder;
+        }
+        indexView.offset = length;
+        indexView.length = count * indexView.stride;
+        length += indexView.length;
+        primitive.indexView = indexView;
+    }
+
+    auto *buffer = ccnew ArrayBuffer(length);
+    uint8_t *out = buffer->getData();
+
+    // Item 0 is the current mesh, item k + 1 the source k.
+    auto mergeItem = [&](uint32_t item) {
+        if (item == 0) {
+            const uint8_t *data = _data.buffer()->getData();
+            for (size_t b = 0; b < bundles.size(); ++b) {
+                memcpy(out + meshStruct.vertexBundles[b].view.offset, data + bundles[b].view.offset, bundles[b].view.length);
+            }
+            for (size_t p = 0; p < prims.size(); ++p) {
+                const auto &indexView = meshStruct.primitives[p].indexView;
+                if (indexView.has_value()) {
+                    const auto &srcView = prims[p].indexView.value();
+                    rebaseIndices(data + srcView.offset, srcView.stride, srcView.count, 0, indexLayouts[p].truncStrides[0], out + indexView->offset, indexView->stride);
+                }
+            }
+            return;
+        }
+
+        const uint32_t k = item - 1;
+        const auto &source = sources[k];
+        const uint8_t *data = source.mesh->_data.buffer()->getData();
+        for (size_t b = 0; b < bundles.size(); ++b) {
+            const auto &bundle = bundles[b];
+            const auto &srcBundle = source.mesh->_struct.vertexBundles[b];
+            const uint32_t count = srcBundle.view.count;
+            const uint32_t stride = bundle.view.stride;
+            uint8_t *dst = out + meshStruct.vertexBundles[b].view.offset + vertexStarts[b * (sourceCount + 1) + k] * stride;
+
+            uint32_t dstAttrOffset = 0;
+            for (const auto &attr : bundle.attributes) {
+                const uint32_t attrSize = gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(attr.format)].size;
+                uint32_t srcAttrOffset = 0;
+                bool hasAttr = false;
+                for (const auto &srcAttr : srcBundle.attributes) {
+                    if (attr.name == srcAttr.name && attr.format == srcAttr.format) {
+                        hasAttr = true;
+                        break;
+                    }
+                    srcAttrOffset += gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(srcAttr.format)].size;
+                }
+
+                if (hasAttr && count > 0) {
+                    const uint8_t *src = data + srcBundle.view.offset + srcAttrOffset;
+                    uint8_t *attrDst = dst + dstAttrOffset;
+                    for (uint32_t v = 0; v < count; ++v) {
+                        memcpy(attrDst + v * stride, src + v * srcBundle.view.stride, attrSize);
+                    }
+                    if (source.worldMatrix != nullptr && attr.name == gfx::ATTR_NAME_POSITION) {
+                        MathUtil::transformPositions(source.worldMatrix->m, attrDst, stride, attrDst, stride, count);
+                    } else if (source.worldMatrix != nullptr && attr.name == gfx::ATTR_NAME_NORMAL) {
+                        Vec3 normal;
+                        for (uint32_t v = 0; v < count; ++v) {
+                            memcpy(&normal.x, attrDst + v * stride, 3 * sizeof(float));
+                            normal.transformQuat(source.rotation);
+                            memcpy(attrDst + v * stride, &normal.x, 3 * sizeof(float));
+                        }
+                    }
+                }
+                dstAttrOffset += attrSize;
+            }
+        }
+
+        for (size_t p = 0; p < prims.size(); ++p) {
+            const auto &indexView = meshStruct.primitives[p].indexView;
+            if (indexView.has_value()) {
+                const auto &layout = indexLayouts[p];
+                const auto &srcView = source.mesh->_struct.primitives[p].indexView.value();
+                rebaseIndices(data + srcView.offset, srcView.stride, srcView.count, layout.bases[k], layout.truncStrides[k],
+                              out + indexView->offset + layout.starts[k] * indexView->stride, indexView->stride);
+            }
+        }
+    };
+
+    const uint32_t itemCount = sourceCount + 1;
+    const auto maxJobCount = static_cast<uint32_t>(std::min<uint64_t>((vertexCount - 1) / MERGE_MIN_VERTICES_PER_JOB + 1, itemCount));
+    const uint32_t jobCount = vertexCount > 0 ? std::min(JobSystem::getInstance()->threadCount(), maxJobCount) : 1;
+    const uint32_t itemsPerJob = (itemCount - 1) / jobCount + 1;
+    auto mergeJob = [&](uint32_t jobIdx) {
+        for (uint32_t item = jobIdx * itemsPerJob; item < std::min((jobIdx + 1) * itemsPerJob, itemCount); ++item) {
+            mergeItem(item);
+        }
+    };
+    if (jobCount > 1) {
+        JobGraph g(JobSystem::getInstance());
+        g.createForEachIndexJob(1U, jobCount, 1U, mergeJob);
+        g.run();
+        mergeJob(0U);
+        g.waitForAll();
+    } else {
+        mergeJob(0U);
+    }
+
+    // Bounds are accumulated in merge order to get the same rounding.
+    meshStruct.minPosition = _struct.minPosition;
+    meshStruct.maxPosition = _struct.maxPosition;
+    Vec3 vec3Temp;
+    for (const auto &source : sources) {
+        const auto &srcStruct = source.mesh->_struct;
+        if (!meshStruct.minPosition || !srcStruct.minPosition || !meshStruct.maxPosition || !srcStruct.maxPosition) {
+            continue;
+        }
+        if (source.worldMatrix != nullptr) {
+            geometry::AABB boundingBox;
+            Vec3::add(srcStruct.maxPosition.value(), srcStruct.minPosition.value(), &boundingBox.center);
+            boundingBox.center.scale(0.5F);
+            Vec3::subtract(srcStruct.maxPosition.value(), srcStruct.minPosition.value(), &boundingBox.halfExtents);
+            boundingBox.halfExtents.scale(0.5F);
+            boundingBox.transform(*source.worldMatrix, &boundingBox);
+
+            Vec3::add(boundingBox.center, boundingBox.halfExtents, &vec3Temp);
+            Vec3::max(meshStruct.maxPosition.value(), vec3Temp, &meshStruct.maxPosition.value());
+            Vec3::subtract(boundingBox.center, boundingBox.halfExtents, &vec3Temp);
+            Vec3::min(meshStruct.minPosition.value(), vec3Temp, &meshStruct.minPosition.value());
+        } else {
+            Vec3::min(meshStruct.minPosition.value(), srcStruct.minPosition.value(), &meshStruct.minPosition.value());
+            Vec3::max(meshStruct.maxPosition.value(), srcStruct.maxPosition.value(), &meshStruct.maxPosition.value());
+        }
+    }
+
+    reset({std::move(meshStruct), Uint8Array(buffer)});
+    initialize();
+    return allMerged;
+}
+
+bool Mesh::buildClusters(uint32_t maxTrianglesPerCluster /* = 64*/) {
+    waitVertexConversion();
+    _clusters.clear();
+    if (_struct.dynamic.has_value() || _struct.morph.has_value() || !_data.buffer() || maxTrianglesPerCluster == 0) {
+        return false;
+    }
+
+    bool built = false;
+    _clusters.resize(_struct.primitives.size());
+    for (index_t p = 0; p < _struct.primitives.size(); ++p) {
+        const auto &prim = _struct.primitives[p];
+        if (prim.primitiveMode != gfx::PrimitiveMode::TRIANGLE_LIST || !prim.indexView.has_value()) {
+            continue;
+        }
+        const auto *format = readAttributeFormat(p, gfx::ATTR_NAME_POSITION);
+        if (format == nullptr || format->count < 3) {
+            continue;
+        }
+        const auto positions = readAttribute(p, gfx::ATTR_NAME_POSITION);
+        if (!ccstd::holds_alternative<Float32Array>(positions)) {
+            continue;
+        }
+
+        const auto &floats = ccstd::get<Float32Array>(positions);
+        const auto *data = reinterpret_cast<const float *>(floats.buffer()->getData() + floats.byteOffset());
+        const uint32_t vertexCount = floats.length() / format->count;
+        const auto &view = prim.indexView.value();
+        uint8_t *ib = _data.buffer()->getData() + view.offset;
+        auto &clusters = _clusters[p];
+        bool valid = false;
+        switch (view.stride) {
+            case 1: valid = clusterTriangles<uint8_t>(ib, view.count, data, format->count, vertexCount, maxTrianglesPerCluster, clusters); break;
+            case 2: valid = clusterTriangles<uint16_t>(ib, view.count, data, format->count, vertexCount, maxTrianglesPerCluster, clusters); break;
+            default: valid = clusterTriangles<uint32_t>(ib, view.count, data, format->count, vertexCount, maxTrianglesPerCluster, clusters); break;
+        }
+        if (!valid) {
+            clusters.clear();
+            continue;
+        }
+        built = true;
+        _hash = 0; // the indices were reordered
+
+        // already uploaded, reorder the GPU indices as well
+        for (const auto &subMesh : _renderingSubMeshes) {
+            if (subMesh->getSubMeshIdx() == static_cast<uint32_t>(p) && subMesh->getIndexBuffer()) {
+                uploadIndices(subMesh->getIndexBuffer(), ib, view);
+                subMesh->setClusters(clusters);
+            }
+        }
+    }
+    return built;
+}
+
 bool Mesh::validateMergingMesh(Mesh *mesh) {
     // dynamic mesh is not allowed to merge.
     if (_struct.dynamic.has_value() || mesh->_struct.dynamic.has_value()) {
@@ -1149,97 +1744,192 @@ void Mesh::accessAttribute(index_t primitiveIndex, const char *attributeName, co
     }
 }
 
-void Mesh::tryConvertVertexData() {
-#if CC_OPTIMIZE_MESH_DATA
+void Mesh::tryConvertVertexData(bool async) {
+    if (!dataOptimizationEnabled) {
+        return;
+    }
     if (!hasFlag(gfx::Device::getInstance()->getFormatFeatures(gfx::Format::RG16F), gfx::FormatFeature::VERTEX_ATTRIBUTE)) {
         CC_LOG_DEBUG("Does not support half float vertex attribute!");
         return;
     }
 
-    uint8_t *data = _data.buffer()->getData();
+    ArrayBuffer *source = _data.buffer();
+    auto conversion = std::make_shared<VertexConversion>();
     ccstd::vector<uint32_t> attributeIndicsNeedConvert;
+    ccstd::vector<std::pair<uint32_t, uint32_t>> convertedRanges; // offset and length of the converted bundles in the source
 
-    for (auto &vertexBundle : _struct.vertexBundles) {
-        // NOTE: Don't use reference here since we need to copy attributes
-        const auto orignalAttributes = vertexBundle.attributes;
-
-        auto &attributes = vertexBundle.attributes;
-        auto &view = vertexBundle.view;
-        uint32_t offset = view.offset;
-        uint32_t length = view.length;
-        uint32_t count = view.count;
+    for (uint32_t bundleIndex = 0; bundleIndex < _struct.vertexBundles.size(); ++bundleIndex) {
+        const auto &vertexBundle = _struct.vertexBundles[bundleIndex];
+        const auto &orignalAttributes = vertexBundle.attributes;
+        const auto &view = vertexBundle.view;
         const uint32_t stride = view.stride;
         uint32_t dstStride = stride;
 
-        CC_ASSERT_EQ(count * stride == length);
+        CC_ASSERT_EQ(view.count * stride, view.length);
 
-        checkAttributesNeedConvert(orignalAttributes, attributes, attributeIndicsNeedConvert, dstStride);
+        // Resolve the layout once, instead of per vertex.
+        VertexBundleConversion bundleConversion;
+        bundleConversion.attributes = orignalAttributes;
+        checkAttributesNeedConvert(orignalAttributes, bundleConversion.attributes, attributeIndicsNeedConvert, dstStride);
         if (attributeIndicsNeedConvert.empty()) {
-            return;
+            continue;
         }
 
-        for (uint32_t i = 0; i < count; ++i) {
-            uint8_t *srcIndex = data + offset + i * stride;
-            uint8_t *dstIndex = data + offset + i * dstStride;
-            uint32_t wroteBytes = 0;
-
-            for (size_t attributeIndex = 0, len = orignalAttributes.size(); attributeIndex < len; ++attributeIndex) {
-                const auto &attribute = orignalAttributes[attributeIndex];
-                const auto &formatInfo = gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(attribute.format)];
-                const auto iter = std::find(attributeIndicsNeedConvert.cbegin(), attributeIndicsNeedConvert.cend(), attributeIndex);
-
-                if (iter == attributeIndicsNeedConvert.end()) {
-                    memmove(dstIndex, srcIndex, formatInfo.size);
-
-                    dstIndex += formatInfo.size;
-                    wroteBytes += formatInfo.size;
-                    srcIndex += formatInfo.size;
-                    continue;
+        bundleConversion.src = source->getData() + view.offset;
+        bundleConversion.bundle = bundleIndex;
+        bundleConversion.count = view.count;
+        bundleConversion.srcStride = stride;
+        bundleConversion.dstStride = dstStride;
+        uint32_t srcOffset = 0;
+        uint32_t dstOffset = 0;
+        for (uint32_t attributeIndex = 0; attributeIndex < orignalAttributes.size(); ++attributeIndex) {
+            const auto &attribute = orignalAttributes[attributeIndex];
+            const auto &formatInfo = gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(attribute.format)];
+            const bool convert = std::find(attributeIndicsNeedConvert.cbegin(), attributeIndicsNeedConvert.cend(), attributeIndex) != attributeIndicsNeedConvert.cend();
+
+            if (!convert) {
+                if (!bundleConversion.segments.empty() && !bundleConversion.segments.back().convert) {
+                    bundleConversion.segments.back().size += formatInfo.size; // merge with the previous copy
+                } else {
+                    bundleConversion.segments.push_back({srcOffset, dstOffset, formatInfo.size, 0, false});
                 }
+                srcOffset += formatInfo.size;
+                dstOffset += formatInfo.size;
+                continue;
+            }
 
-                const float *pValue = reinterpret_cast<const float *>(srcIndex);
-                uint16_t *pDst = reinterpret_cast<uint16_t *>(dstIndex);
-                uint32_t advance = (formatInfo.size >> 1);
+            VertexSegment segment{srcOffset, dstOffset, formatInfo.count, 0, true};
+#if (CC_PLATFORM == CC_PLATFORM_IOS) || (CC_PLATFORM == CC_PLATFORM_MACOS)
+            // NOTE: Metal needs 4 bytes alignment
+            segment.padding = (formatInfo.size >> 1) % 4;
+#endif
+            bundleConversion.segments.push_back(segment);
+            bundleConversion.floatsPerVertex += formatInfo.count;
+            srcOffset += formatInfo.size;
+            dstOffset += (formatInfo.size >> 1) + segment.padding;
+        }
+        CC_ASSERT_EQ(dstOffset, dstStride);
 
-                switch (attribute.format) {
-                    case gfx::Format::RGB32F: {
-                        convertRGB32FToRGB16F(pValue, pDst);
-    #if (CC_PLATFORM == CC_PLATFORM_IOS) || (CC_PLATFORM == CC_PLATFORM_MACOS)
-                        // NOTE: Metal needs 4 bytes alignment
-                        pDst[3] = 0;
-                        advance += (advance % 4);
-    #endif
+        convertedRanges.emplace_back(view.offset, view.length);
+        conversion->bundles.emplace_back(std::move(bundleConversion));
+    }
 
-                    } break;
-                    case gfx::Format::RG32F: {
-                        convertRG32FToRG16F(pValue, pDst);
-                    } break;
-                    case gfx::Format::RGBA32F: {
-                        convertRGBA32FToRGBA16F(pValue, pDst);
-                    } break;
-                    default:
-                        CC_ABORT();
-                        break;
-                }
+    if (conversion->bundles.empty()) {
+        return;
+    }
 
-                dstIndex += advance;
-                wroteBytes += advance;
-                srcIndex += formatInfo.size;
+    // The vertices are converted from the original data into a new buffer of the same size, so that the
+    // offsets of the views stay valid. The original data is kept as is until the new one replaces it.
+    conversion->source = source;
+    conversion->result = ccnew ArrayBuffer(source->byteLength());
+    for (auto &bundleConversion : conversion->bundles) {
+        bundleConversion.dst = conversion->result->getData() + _struct.vertexBundles[bundleConversion.bundle].view.offset;
+    }
+    std::sort(convertedRanges.begin(), convertedRanges.end());
+    auto copyUnconverted = [conversion, convertedRanges]() {
+        const uint8_t *src = conversion->source->getData();
+        uint8_t *dst = conversion->result->getData();
+        uint32_t begin = 0;
+        for (const auto &range : convertedRanges) {
+            if (range.first > begin) {
+                memcpy(dst + begin, src + begin, range.first - begin);
             }
+            begin = std::max(begin, range.first + range.second);
+        }
+        if (conversion->source->byteLength() > begin) {
+            memcpy(dst + begin, src + begin, conversion->source->byteLength() - begin);
+        }
+    };
+
+    if (!async) {
+        copyUnconverted();
+        for (const auto &bundleConversion : conversion->bundles) {
+            const uint32_t jobCount = getConvertJobCount(bundleConversion.count);
+            const uint32_t verticesPerJob = (bundleConversion.count - 1) / jobCount + 1;
+            auto convertJob = [&](uint32_t jobIdx) {
+                const uint32_t begin = jobIdx * verticesPerJob;
+                convertVertices(bundleConversion, begin, std::min(begin + verticesPerJob, bundleConversion.count));
+            };
+            if (jobCount > 1) {
+                JobGraph g(JobSystem::getInstance());
+                g.createForEachIndexJob(1U, jobCount, 1U, convertJob);
+                g.run();
+                convertJob(0U);
+                g.waitForAll();
+            } else {
+                convertJob(0U);
+            }
+        }
+        applyVertexConversion(*conversion);
+        return;
+    }
 
-            CC_ASSERT_EQ(wroteBytes, dstStride);
+    // Convert on the background lane, and create the GPU buffers on the main thread once all jobs are done.
+    ccstd::vector<std::tuple<uint32_t, uint32_t, uint32_t>> ranges; // bundle, first vertex, last vertex
+    for (uint32_t i = 0; i < conversion->bundles.size(); ++i) {
+        const uint32_t count = conversion->bundles[i].count;
+        const uint32_t verticesPerJob = (count - 1) / getConvertJobCount(count) + 1;
+        for (uint32_t begin = 0; begin < count; begin += verticesPerJob) {
+            ranges.emplace_back(i, begin, std::min(begin + verticesPerJob, count));
         }
+    }
+    conversion->remaining = static_cast<uint32_t>(ranges.size()) + 1U;
+    conversion->finished = conversion->done.get_future();
+    _vertexConversion = conversion;
 
-        // update stride & length
-        view.stride = dstStride;
-        view.length = view.stride * view.count;
+    auto onJobDone = [this, conversion]() {
+        if (conversion->remaining.fetch_sub(1U) != 1U) {
+            return;
+        }
+        conversion->done.set_value();
+        CC_CURRENT_ENGINE()->getScheduler()->performFunctionInCocosThread([this, conversion]() {
+            // skipped if the mesh has been initialized, reset or destroyed meanwhile
+            if (_vertexConversion == conversion) {
+                initialize();
+            }
+            // the buffers hold script objects, they must not be released by a worker
+            conversion->source = nullptr;
+            conversion->result = nullptr;
+            release();
+        });
+    };
+    auto copyJob = [copyUnconverted, onJobDone]() {
+        copyUnconverted();
+        onJobDone();
+    };
+
+    addRef(); // released on the main thread after initialize
+    auto *jobSystem = JobSystem::getInstance();
+    jobSystem->dispatchBackground(std::move(copyJob));
+    for (const auto &range : ranges) {
+        auto convertJob = [conversion, onJobDone, range]() {
+            convertVertices(conversion->bundles[std::get<0>(range)], std::get<1>(range), std::get<2>(range));
+            onJobDone();
+        };
+        jobSystem->dispatchBackground(std::move(convertJob));
     }
-#endif
 }
 
-gfx::BufferList Mesh::createVertexBuffers(gfx::Device *gfxDevice, ArrayBuffer *data) {
-    tryConvertVertexData();
+void Mesh::waitVertexConversion() {
+    if (!_vertexConversion) {
+        return;
+    }
+    const auto conversion = std::move(_vertexConversion);
+    conversion->finished.wait();
+    applyVertexConversion(*conversion);
+}
+
+void Mesh::applyVertexConversion(const VertexConversion &conversion) {
+    for (const auto &bundleConversion : conversion.bundles) {
+        auto &vertexBundle = _struct.vertexBundles[bundleConversion.bundle];
+        vertexBundle.attributes = bundleConversion.attributes;
+        vertexBundle.view.stride = bundleConversion.dstStride;
+        vertexBundle.view.length = vertexBundle.view.stride * vertexBundle.view.count;
+    }
+    _data = Uint8Array(conversion.result, _data.byteOffset(), _data.byteLength());
+}
 
+gfx::BufferList Mesh::createVertexBuffers(gfx::Device *gfxDevice, ArrayBuffer *data) {
     gfx::BufferList buffers;
     buffers.reserve(_struct.vertexBundles.size());
     for (const auto &vertexBundle : _struct.vertexBundles) {
@@ -1267,6 +1957,7 @@ void Mesh::setAllowDataAccess(bool allowDataAccess) {
 }
 
 void Mesh::releaseData() {
+    waitVertexConversion();
     _data.clear();
 }
 
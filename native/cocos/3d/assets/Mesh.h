@@ -25,10 +25,12 @@
 
 #pragma once
 
+#include <memory>
 #include "3d/assets/Morph.h"
 #include "3d/assets/MorphRendering.h"
 #include "base/std/optional.h"
 #include "core/assets/Asset.h"
+#include "core/assets/RenderingSubMesh.h"
 #include "core/geometry/AABB.h"
 #include "math/Mat4.h"
 #include "math/Vec3.h"
@@ -297,11 +299,29 @@ public:
     }
 
     void onLoaded() override {
-        initialize();
+        initializeAsync();
     }
 
     void initialize();
 
+    /**
+     * @en Same as initialize, but converts the vertex data on worker threads first and creates the GPU buffers
+     * on the main thread once it is done, so that loading large meshes doesn't stall the frame.
+     * The mesh data keeps its original layout until then; getRenderingSubMeshes() and initialize() wait for the conversion.
+     * @zh 与 initialize 相同，但先在工作线程转换顶点数据，完成后再在主线程创建 GPU 缓冲。
+     */
+    void initializeAsync();
+
+    /**
+     * @en Whether texture coordinates and tangents are converted to half floats and 32 bits indices are reduced to 16 bits
+     * when meshes are uploaded, if the device supports it. Disabled by default since it lowers their precision.
+     * Set from the `rendering.meshDataOptimization` project setting when the engine starts.
+     * @zh 上传网格时是否将纹理坐标和切线转换为半精度浮点数，并将 32 位索引缩减为 16 位。默认关闭，因为会降低精度。
+     * 引擎启动时由项目设置 `rendering.meshDataOptimization` 设置。
+     */
+    static void setDataOptimizationEnabled(bool enabled);
+    static bool isDataOptimizationEnabled();
+
     /**
      * @en Destroy the mesh and release all related GPU resources
      * @zh 销毁此网格，并释放它占有的所有 GPU 资源。
@@ -351,6 +371,27 @@ public:
      */
     bool merge(Mesh *mesh, const Mat4 *worldMatrix = nullptr, bool validate = false);
 
+    /**
+     * @en Merge a batch of meshes into the current mesh, with the same result as merging them one by one,
+     * but building the data once and merging different meshes in parallel.
+     * @zh 批量合并网格到此网格中，结果与逐个合并相同。
+     * @param meshes The meshes to be merged
+     * @param worldMatrices The world matrices of the meshes, missing or null ones mean no transform
+     * @param [validate=false] Whether to validate the meshes, the ones failing validation are skipped
+     * @returns Whether all meshes were merged.
+     */
+    bool mergeBatch(const ccstd::vector<Mesh *> &meshes, const ccstd::vector<const Mat4 *> &worldMatrices, bool validate = false);
+
+    /**
+     * @en Reorders the triangles of the indexed sub meshes to be spatially coherent and splits them into clusters
+     * with bounds and normal cones, so that the parts of a large static mesh out of view or facing away are not drawn.
+     * The clusters are dropped when the mesh is reset, e.g. by merging, so build them afterwards.
+     * @zh 将索引子网格的三角形按空间重新排序并分簇，使大型静态网格在视野外或背向的部分不被绘制。
+     * @param [maxTrianglesPerCluster=64] The maximum triangle count of a cluster
+     * @returns Whether any sub mesh was clustered.
+     */
+    bool buildClusters(uint32_t maxTrianglesPerCluster = 64);
+
     /**
      * @en Validation for whether the given mesh can be merged into the current mesh.
      * To pass the validation, it must satisfy either of these two requirements:
@@ -453,13 +494,18 @@ private:
     void accessAttribute(index_t primitiveIndex, const char *attributeName, const AccessorType &accessor);
 
     gfx::BufferList createVertexBuffers(gfx::Device *gfxDevice, ArrayBuffer *data);
-    void tryConvertVertexData();
+    struct VertexConversion;
+    void tryConvertVertexData(bool async);
+    void waitVertexConversion();
+    void applyVertexConversion(const VertexConversion &conversion);
 
     void initDefault(const ccstd::optional<ccstd::string> &uuid) override;
     void releaseData();
 
     static TypedArray createTypedArrayWithGFXFormat(gfx::Format format, uint32_t count);
 
+    static bool dataOptimizationEnabled;
+
 public:
     IntrusivePtr<MorphRendering> morphRendering;
 
@@ -472,6 +518,11 @@ private:
     bool _allowDataAccess{true};
     bool _isMeshDataUploaded{false};
 
+    std::shared_ptr<VertexConversion> _vertexConversion; // pending conversion started by initializeAsync
+
+    // per primitive, empty if the primitive isn't clustered
+    ccstd::vector<ccstd::vector<IMeshCluster>> _clusters;
+
     RenderingSubMeshList _renderingSubMeshes;
 
     ccstd::unordered_map<uint64_t, BoneSpaceBounds> _boneSpaceBounds;
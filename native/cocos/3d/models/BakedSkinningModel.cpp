@@ -64,9 +64,16 @@ void BakedSkinningModel::destroy() {
         CC_SAFE_DESTROY_NULL(_jointMedium.buffer);
     }
     if (_jointMedium.texture.has_value()) {
-        CC_SAFE_DELETE(_jointMedium.texture.value());
+        if (_jointTexturePool) {
+            _jointTexturePool->releaseHandle(_jointMedium.texture.value());
+        } else {
+            CC_SAFE_DELETE(_jointMedium.texture.value());
+        }
+        _jointMedium.texture = ccstd::nullopt;
     }
     applyJointTexture(ccstd::nullopt);
+    _jointTexturePool = nullptr;
+    CC_SAFE_DESTROY_NULL(_animInfoBuffer);
     Super::destroy();
 }
 
@@ -91,7 +98,7 @@ void BakedSkinningModel::bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Me
 
 void BakedSkinningModel::updateTransform(uint32_t stamp) {
     Super::updateTransform(stamp);
-    if (!_isUploadedAnim) {
+    if (!_isUploadedAnim || _jointMedium.animInfo.curFrame == nullptr) {
         return;
     }
     IAnimInfo &animInfo = _jointMedium.animInfo;
@@ -116,6 +123,9 @@ void BakedSkinningModel::updateUBOs(uint32_t stamp) {
     IAnimInfo &info = _jointMedium.animInfo;
     const int idx = _instAnimInfoIdx;
     const float *curFrame = info.curFrame;
+    if (curFrame == nullptr) {
+        return;
+    }
     bool hasNonInstancingPass = false;
     for (const auto &subModel : _subModels) {
         if (idx >= 0) {
@@ -127,17 +137,86 @@ void BakedSkinningModel::updateUBOs(uint32_t stamp) {
     }
 
     const uint32_t frameDataBytes = info.frameDataBytes;
-    if (hasNonInstancingPass && *info.dirtyForJSB != 0) {
+    if (hasNonInstancingPass && info.dirtyForJSB != nullptr && *info.dirtyForJSB != 0) {
         info.buffer->update(curFrame, frameDataBytes);
         *info.dirtyForJSB = 0;
     }
 }
 
-void BakedSkinningModel::applyJointTexture(const ccstd::optional<IJointTextureHandle *> &texture) {
-    auto oldTex = _jointMedium.texture;
-    if (oldTex.has_value() && texture.has_value() && (&oldTex.value() != &texture.value())) {
-        //        _dataPoolManager->jointTexturePool->releaseHandle(oldTex.value());
+void BakedSkinningModel::uploadAnimation(JointTexturePool *pool, const IBakedClip *clip) {
+    if (_skeleton == nullptr || _mesh == nullptr || pool == nullptr) {
+        return;
+    }
+    const ccstd::hash_t clipHash = clip != nullptr ? clip->hash : 0U;
+    if (_jointTexturePool == pool && _jointMedium.texture.has_value() && _uploadedClipHash == clipHash) {
+        return;
     }
+
+    if (_animInfoBuffer == nullptr) {
+        _animInfoData.reset(pipeline::UBOSkinningAnimation::COUNT);
+        _animInfoBuffer = _device->createBuffer({
+            gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
+            gfx::MemoryUsageBit::HOST | gfx::MemoryUsageBit::DEVICE,
+            pipeline::UBOSkinningAnimation::SIZE,
+            pipeline::UBOSkinningAnimation::SIZE,
+        });
+        auto &animInfo = _jointMedium.animInfo;
+        animInfo.buffer = _animInfoBuffer;
+        animInfo.curFrame = &_animInfoData[0];
+        animInfo.frameDataBytes = _animInfoData.byteLength();
+        animInfo.dirtyForJSB = &_animInfoDirty;
+    }
+
+    // keep the old handle alive until the new one is applied, both may share the same pool entry
+    auto oldTexture = _jointMedium.texture;
+    auto oldPool = _jointTexturePool;
+    _jointMedium.texture = ccstd::nullopt;
+    _jointTexturePool = pool;
+    _uploadedClipHash = clipHash;
+    _isUploadedAnim = clip != nullptr;
+
+    auto *skinningRoot = getTransform();
+    const auto meshHash = static_cast<uint32_t>(_mesh->getHash());
+    ccstd::optional<IJointTextureHandle *> texture;
+    _jointMedium.boundsInfo.clear();
+    if (clip != nullptr) {
+        texture = pool->getSequencePoseTexture(_skeleton, *clip, _mesh, skinningRoot);
+        if (texture.has_value()) {
+            for (const auto &bound : texture.value()->bounds[meshHash]) {
+                _jointMedium.boundsInfo.emplace_back(bound);
+            }
+        }
+    } else {
+        texture = pool->getDefaultPoseTexture(_skeleton, _mesh, skinningRoot);
+        if (texture.has_value() && _modelBounds) {
+            updateModelBounds(&texture.value()->bounds[meshHash][0]);
+        }
+    }
+    setFrame(0.F);
+    applyJointTexture(texture);
+    // sub-models initialized later get the anim info buffer and the joint texture from updateLocalDescriptors too
+    for (index_t i = 0; i < _subModels.size(); ++i) {
+        updateLocalDescriptors(i, _subModels[i]->getDescriptorSet());
+    }
+
+    if (oldTexture.has_value()) {
+        if (oldPool) {
+            oldPool->releaseHandle(oldTexture.value());
+        } else {
+            delete oldTexture.value();
+        }
+    }
+}
+
+void BakedSkinningModel::setFrame(float frame) {
+    if (_animInfoData.empty()) {
+        return;
+    }
+    _animInfoData[0] = frame;
+    _animInfoDirty = 1;
+}
+
+void BakedSkinningModel::applyJointTexture(const ccstd::optional<IJointTextureHandle *> &texture) {
     _jointMedium.texture = texture;
     if (!texture.has_value()) {
         return;
@@ -154,10 +233,12 @@ void BakedSkinningModel::applyJointTexture(const ccstd::optional<IJointTextureHa
         buffer->update(&jointTextureInfo[0], jointTextureInfo.byteLength());
     }
     auto *tex = textureHandle->handle.texture;
+    auto *sampler = _device->getSampler(JOINT_TEXTURE_SAMPLER_INFO);
 
     for (const auto &subModel : _subModels) {
         auto *descriptorSet = subModel->getDescriptorSet();
         descriptorSet->bindTexture(pipeline::JOINTTEXTURE::BINDING, tex);
+        descriptorSet->bindSampler(pipeline::JOINTTEXTURE::BINDING, sampler);
     }
 }
 
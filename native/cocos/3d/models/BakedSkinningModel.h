@@ -62,7 +62,15 @@ public:
     void updateUBOs(uint32_t stamp) override;
     void updateInstancedAttributes(const ccstd::vector<gfx::Attribute> &attributes, scene::SubModel *subModel) override;
     void updateInstancedJointTextureInfo();
-    // void                             uploadAnimation(AnimationClip *anim); // TODO(xwx): AnimationClip not define
+
+    /**
+     * Bakes the clip (or the default pose if it is null) into the joint textures of the pool and plays it natively,
+     * models sharing a pool chunk are drawn together through the instanced path, each with its own frame.
+     * In JSB the animation clips are uploaded by JS instead and synchronized by syncDataForJS & syncAnimInfoForJS,
+     * baked clips are uploaded natively through `uploadBakedClip`, which uses the joint texture pool of Root.
+     */
+    void uploadAnimation(JointTexturePool *pool, const IBakedClip *clip);
+    void setFrame(float frame);
 
     void bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Mesh *mesh);
 
@@ -96,6 +104,11 @@ private:
     IntrusivePtr<Skeleton> _skeleton;
     IntrusivePtr<Mesh> _mesh;
     // AnimationClip* uploadedAnim;
+    IntrusivePtr<JointTexturePool> _jointTexturePool; // owner of _jointMedium.texture if set by uploadAnimation
+    ccstd::hash_t _uploadedClipHash{0U};
+    Float32Array _animInfoData; // native counterpart of the JSB anim info of the data pool manager
+    IntrusivePtr<gfx::Buffer> _animInfoBuffer;
+    uint8_t _animInfoDirty{0};
     bool _isUploadedAnim{false};
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(BakedSkinningModel);
@@ -30,6 +30,7 @@
 #include "3d/assets/Skeleton.h"
 #include "core/platform/Debug.h"
 #include "core/scene-graph/Node.h"
+#include "math/MathUtil.h"
 #include "renderer/gfx-base/GFXBuffer.h"
 #include "scene/Pass.h"
 #include "scene/RenderScene.h"
@@ -79,6 +80,7 @@ void SkinningModel::bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Mesh *m
     }
     _bufferIndices.clear();
     _joints.clear();
+    _bindposes.clear();
 
     if (!skeleton || !skinningRoot || !mesh) return;
     auto jointCount = static_cast<uint32_t>(skeleton->getJoints().size());
@@ -113,54 +115,87 @@ void SkinningModel::bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Mesh *m
         jointInfo.buffers = std::move(buffers);
         jointInfo.indices = std::move(indices);
         _joints.emplace_back(std::move(jointInfo));
+        _bindposes.emplace_back(bindPose);
     }
+    _jointWorlds.resize(_joints.size());
+    _jointPalette.resize(_joints.size() * 12);
 }
 
 void SkinningModel::updateTransform(uint32_t stamp) {
+    updateJointTransforms(stamp);
+    updateJointBounds();
+}
+
+void SkinningModel::updateJointTransforms(uint32_t stamp) {
     auto *root = getTransform();
     if (root->getChangedFlags() || root->getDirtyFlag()) {
         root->updateWorldTransform();
         _localDataUpdated = true;
     }
+    for (size_t i = 0; i < _joints.size(); ++i) {
+        _jointWorlds[i] = cc::getWorldMatrix(_joints[i].transform, static_cast<int32_t>(stamp));
+    }
+}
+
+void SkinningModel::prepareJoints() {
+    updateJointBounds();
+    updateJointPalette();
+}
+
+void SkinningModel::updateJointBounds() {
     Vec3 v3Min{INFINITY, INFINITY, INFINITY};
     Vec3 v3Max{-INFINITY, -INFINITY, -INFINITY};
     geometry::AABB ab1;
     Vec3 v31;
     Vec3 v32;
-    for (JointInfo &jointInfo : _joints) {
-        auto &transform = jointInfo.transform;
-        Mat4 worldMatrix = cc::getWorldMatrix(transform, static_cast<int32_t>(stamp));
-        jointInfo.bound->transform(worldMatrix, &ab1);
+    for (size_t i = 0; i < _joints.size(); ++i) {
+        _joints[i].bound->transform(_jointWorlds[i], &ab1);
         ab1.getBoundary(&v31, &v32);
         Vec3::min(v3Min, v31, &v3Min);
         Vec3::max(v3Max, v32, &v3Max);
     }
     if (_modelBounds && _modelBounds->isValid() && _worldBounds) {
         geometry::AABB::fromPoints(v3Min, v3Max, _modelBounds);
-        _modelBounds->transform(root->getWorldMatrix(), _worldBounds);
+        _modelBounds->transform(getTransform()->getWorldMatrix(), _worldBounds);
         _worldBoundsDirty = true;
     }
 }
 
 void SkinningModel::updateUBOs(uint32_t stamp) {
     Super::updateUBOs(stamp);
-    uint32_t bIdx = 0;
-    Mat4 mat4;
-    for (const JointInfo &jointInfo : _joints) {
-        Mat4::multiply(jointInfo.transform->world, jointInfo.bindpose, &mat4);
-        for (uint32_t buffer : jointInfo.buffers) {
-            uploadJointData(jointInfo.indices[bIdx] * 12, mat4, _dataArray[buffer]);
-            bIdx++;
+    if (!_jointPaletteUpdated) {
+        updateJointPalette();
+    }
+    _jointPaletteUpdated = false;
+    uploadJointPalette();
+}
+
+void SkinningModel::updateJointPalette() {
+    const auto jointCount = static_cast<uint32_t>(_joints.size());
+    if (jointCount > 0) {
+        MathUtil::multiplyAffine3x4(_jointWorlds[0].m, _bindposes[0].m, jointCount, _jointPalette.data());
+    }
+    for (uint32_t i = 0; i < jointCount; ++i) {
+        const JointInfo &jointInfo = _joints[i];
+        const float *palette = _jointPalette.data() + i * 12;
+        for (size_t bIdx = 0; bIdx < jointInfo.buffers.size(); ++bIdx) {
+            memcpy(_dataArray[jointInfo.buffers[bIdx]] + jointInfo.indices[bIdx] * 12, palette, sizeof(float) * 12);
         }
-        bIdx = 0;
     }
+    _jointPaletteUpdated = true;
+}
+
+void SkinningModel::uploadJointPalette() {
     if (_realTimeTextureMode) {
         updateRealTimeJointTextureBuffer();
-    } else {
-        bIdx = 0;
-        for (gfx::Buffer *buffer : _buffers) {
-            buffer->update(_dataArray[bIdx], buffer->getSize());
-            bIdx++;
+        return;
+    }
+    auto *arena = UniformArena::getInstance();
+    for (size_t i = 0; i < _buffers.size(); ++i) {
+        if (_bufferHandles[i].isValid()) {
+            arena->write(_bufferHandles[i], _dataArray[i], 0, _buffers[i]->getSize());
+        } else {
+            _buffers[i]->update(_dataArray[i], _buffers[i]->getSize());
         }
     }
 }
@@ -188,13 +223,6 @@ ccstd::vector<scene::IMacroPatch> SkinningModel::getMacroPatches(index_t subMode
     return myPatches;
 }
 
-void SkinningModel::uploadJointData(uint32_t base, const Mat4 &mat, float *dst) {
-    memcpy(reinterpret_cast<void *>(dst + base), mat.m, sizeof(float) * 12);
-    dst[base + 3] = mat.m[12];
-    dst[base + 7] = mat.m[13];
-    dst[base + 11] = mat.m[14];
-}
-
 void SkinningModel::updateLocalDescriptors(index_t submodelIdx, gfx::DescriptorSet *descriptorset) {
     Super::updateLocalDescriptors(submodelIdx, descriptorset);
     uint32_t idx = _bufferIndices[submodelIdx];
@@ -219,12 +247,7 @@ void SkinningModel::updateInstancedAttributes(const ccstd::vector<gfx::Attribute
 }
 
 void SkinningModel::ensureEnoughBuffers(uint32_t count) {
-    if (!_buffers.empty()) {
-        for (gfx::Buffer *buffer : _buffers) {
-            CC_SAFE_DESTROY(buffer);
-        }
-        _buffers.clear();
-    }
+    releaseBuffers();
     if (!_dataArray.empty()) {
         for (auto *data : _dataArray) {
             CC_SAFE_DELETE_ARRAY(data);
@@ -234,14 +257,22 @@ void SkinningModel::ensureEnoughBuffers(uint32_t count) {
     _dataArray.resize(count);
     if (!_realTimeTextureMode) {
         _buffers.resize(count);
+        _bufferHandles.resize(count);
         uint32_t length = pipeline::UBOSkinning::count;
+        auto *arena = UniformArena::getInstance();
         for (uint32_t i = 0; i < count; i++) {
-            _buffers[i] = _device->createBuffer({
-                gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
-                gfx::MemoryUsageBit::HOST | gfx::MemoryUsageBit::DEVICE,
-                pipeline::UBOSkinning::size,
-                pipeline::UBOSkinning::size,
-            });
+            if (arena != nullptr) {
+                // all joint palettes of the frame are uploaded together with the arena
+                _bufferHandles[i] = arena->alloc(pipeline::UBOSkinning::size);
+                _buffers[i] = arena->createBufferView(_bufferHandles[i], 0, pipeline::UBOSkinning::size);
+            } else {
+                _buffers[i] = _device->createBuffer({
+                    gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
+                    gfx::MemoryUsageBit::HOST | gfx::MemoryUsageBit::DEVICE,
+                    pipeline::UBOSkinning::size,
+                    pipeline::UBOSkinning::size,
+                });
+            }
             _dataArray[i] = new float[length];
             memset(_dataArray[i], 0, sizeof(float) * length);
         }
@@ -349,12 +380,20 @@ void SkinningModel::releaseData() {
         _dataArray.clear();
     }
     CC_SAFE_DELETE(_realTimeJointTexture);
-    if (!_buffers.empty()) {
-        for (gfx::Buffer *buffer : _buffers) {
-            CC_SAFE_DESTROY(buffer);
+    releaseBuffers();
+}
+
+void SkinningModel::releaseBuffers() {
+    for (gfx::Buffer *buffer : _buffers) {
+        CC_SAFE_DESTROY(buffer);
+    }
+    _buffers.clear();
+    if (auto *arena = UniformArena::getInstance()) {
+        for (auto &handle : _bufferHandles) {
+            arena->free(handle);
         }
-        _buffers.clear();
     }
+    _bufferHandles.clear();
 }
 
 } // namespace cc
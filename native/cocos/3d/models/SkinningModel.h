@@ -30,6 +30,7 @@
 #include "base/std/container/array.h"
 #include "core/animation/SkeletalAnimationUtils.h"
 #include "math/Mat4.h"
+#include "renderer/core/UniformArena.h"
 #include "renderer/gfx-base/GFXDef-common.h"
 #include "renderer/pipeline/Define.h"
 
@@ -65,18 +66,32 @@ public:
 
     void bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Mesh *mesh);
 
+    // updateTransform split for RenderScene::updateModelsParallelly:
+    // joint transforms may be shared by several models and must be updated on one thread,
+    // prepareJoints only touches this model and may run on a worker afterwards.
+    void updateJointTransforms(uint32_t stamp);
+    void prepareJoints();
+
 private:
-    static void uploadJointData(uint32_t base, const Mat4 &mat, float *dst);
+    void updateJointBounds();
+    void updateJointPalette();
+    void uploadJointPalette();
     void ensureEnoughBuffers(uint32_t count);
     void updateRealTimeJointTextureBuffer();
     void initRealTimeJointTexture();
     void bindRealTimeJointTexture(uint32_t idx, gfx::DescriptorSet *descriptorset);
     void releaseData();
+    void releaseBuffers();
 
     ccstd::vector<index_t> _bufferIndices;
     ccstd::vector<IntrusivePtr<gfx::Buffer>> _buffers;
     ccstd::vector<JointInfo> _joints;
     ccstd::vector<float *> _dataArray;
+    ccstd::vector<UniformArenaHandle> _bufferHandles; // valid if _buffers are views of the uniform arena
+    ccstd::vector<Mat4> _jointWorlds;                 // contiguous world matrices of _joints
+    ccstd::vector<Mat4> _bindposes;                   // contiguous bind poses of _joints
+    ccstd::vector<float> _jointPalette;               // 12 floats per joint, see MathUtil::multiplyAffine3x4
+    bool _jointPaletteUpdated = false;
     bool _realTimeTextureMode = false;
     RealTimeJointTexture *_realTimeJointTexture = nullptr;
 
@@ -25,6 +25,7 @@
 
 #include "3d/skeletal-animation/SkeletalAnimationUtils.h"
 #include "3d/assets/Mesh.h"
+#include "base/job-system/JobSystem.h"
 #include "core/scene-graph/Node.h"
 #include "renderer/pipeline/Define.h"
 
@@ -39,7 +40,7 @@ cc::gfx::Format selectJointsMediumFormat(cc::gfx::Device *device) {
 }
 
 // Linear Blending Skinning
-void uploadJointDataLBS(cc::Float32Array out, uint32_t base, const cc::Mat4 &mat, bool /*firstBone*/) {
+void uploadJointDataLBS(cc::Float32Array &out, uint32_t base, const cc::Mat4 &mat, bool /*firstBone*/) {
     out[base + 0] = mat.m[0];
     out[base + 1] = mat.m[1];
     out[base + 2] = mat.m[2];
@@ -72,7 +73,7 @@ void multiplyScalar(const cc::Quaternion &a, float b, cc::Quaternion *out) {
 }
 
 // Dual Quaternion Skinning
-void uploadJointDataDQS(cc::Float32Array out, uint32_t base, cc::Mat4 &mat, bool firstBone) {
+void uploadJointDataDQS(cc::Float32Array &out, uint32_t base, cc::Mat4 &mat, bool firstBone) {
     cc::Mat4::toRTS(mat, &qt1, &v31, &v32);
     // // sign consistency
     if (firstBone) {
@@ -107,6 +108,7 @@ const uint32_t MINIMUM_JOINT_TEXTURE_SIZE = 2040;
 #else
 const uint32_t MINIMUM_JOINT_TEXTURE_SIZE = 480; // have to be multiples of 12
 #endif
+constexpr uint32_t BAKE_MIN_FRAMES_PER_JOB = 8;
 
 uint32_t roundUpTextureSize(uint32_t targetLength, uint32_t formatSize) {
     double formatScale = 4 / std::sqrt(formatSize);
@@ -189,6 +191,8 @@ ccstd::optional<IJointTextureHandle *> JointTexturePool::getDefaultPoseTexture(S
             handle = _customPool->alloc(bufSize * Float32Array::BYTES_PER_ELEMENT, _chunkIdxMap[hash]);
         } else {
             handle = _pool->alloc(bufSize * Float32Array::BYTES_PER_ELEMENT);
+        }
+        if (handle.texture == nullptr) {
             return texture;
         }
         IJointTextureHandle *textureHandle = IJointTextureHandle::createJoinTextureHandle();
@@ -209,7 +213,7 @@ ccstd::optional<IJointTextureHandle *> JointTexturePool::getDefaultPoseTexture(S
     Mat4 mat4;
     Vec3 v34;
     Vec3 v33;
-    Vec3 v3Min(-INF, -INF, -INF);
+    Vec3 v3Min(INF, INF, INF);
     Vec3 v3Max(-INF, -INF, -INF);
     auto boneSpaceBounds = mesh->getBoneSpaceBounds(skeleton);
     for (uint32_t j = 0, offset = 0; j < jointCount; ++j, offset += 12) {
@@ -231,114 +235,137 @@ ccstd::optional<IJointTextureHandle *> JointTexturePool::getDefaultPoseTexture(S
         }
     }
 
-    ccstd::vector<geometry::AABB> bounds;
-    texture.value()->bounds[static_cast<uint32_t>(mesh->getHash())] = bounds;
+    ccstd::vector<geometry::AABB> bounds(1);
     geometry::AABB::fromPoints(v3Min, v3Max, &bounds[0]);
+    texture.value()->bounds[static_cast<uint32_t>(mesh->getHash())] = bounds;
     if (buildTexture) {
-        _pool->update(texture.value()->handle, textureBuffer.buffer());
+        auto chunkIter = _chunkIdxMap.find(hash);
+        (chunkIter != _chunkIdxMap.end() ? _customPool : _pool)->update(texture.value()->handle, textureBuffer.buffer());
         _textureBuffers[hash] = texture.value();
     }
 
     return texture;
 }
 
-// TODO(xwx): need to implement this function after define AnimationClip
-// ccstd::optional<IJointTextureHandle> JointTexturePool::getSequencePoseTexture(Skeleton *skeleton,AnimationClip *clip, Mesh *mesh, Node *skinningRoot) {
-//     uint64_t                           hash = skeleton->getHash() ^ clip->getHash();
-//     ccstd::optional<IJointTextureHandle> texture;
-//     if (_textureBuffers.find(hash) != _textureBuffers.end()) {
-//         texture = _textureBuffers[hash];
-//         if (texture->bounds.find(mesh->getHash()) != texture->bounds.end()) {
-//             texture->refCount++;
-//             return texture;
-//         }
-//     }
-//     const ccstd::vector<ccstd::string> &joints    = skeleton->getJoints();
-//     const ccstd::vector<Mat4> &       bindPoses = skeleton->getBindposes();
-//     // const clipData = SkelAnimDataHub.getOrExtract(clip);
-//     // const { frames } = clipData;
-//     Float32Array textureBuffer;
-//     bool         buildTexture = false;
-//     uint32_t     jointCount   = joints.size();
-//     if (!texture.has_value()) {
-//         uint32_t             bufSize = jointCount * 12;
-//         ITextureBufferHandle handle;
-//         if (_chunkIdxMap.find(hash) != _chunkIdxMap.end()) {
-//             handle = _customPool->alloc(bufSize * sizeof(Float32Array), _chunkIdxMap[hash]); // TODO(xwx): Float32Array.BYTES_PER_ELEMENT == sizeof(Float32Array) ?
-//         } else {
-//             handle = _pool->alloc(bufSize * sizeof(Float32Array));
-//             return texture;
-//         }
-//         // auto animInfos = createAnimInfos(skeleton, clip, skinningRoot); // TODO(xwx): createAnimInfos not implement
-
-//         texture = IJointTextureHandle{
-//             .pixelOffset      = handle.start / _formatSize,
-//             .refCount         = 1,
-//             .clipHash         = 0,
-//             .skeletonHash     = skeleton->getHash(),
-//             .readyToBeDeleted = false,
-//             .handle           = handle,
-//             // .animInfos        = animInfos // TODO(xwx)
-//         };
-//         textureBuffer.resize(bufSize);
-//         buildTexture = true;
-//     } else {
-//         texture->refCount++;
-//     }
-//     auto                        boneSpaceBounds = mesh->getBoneSpaceBounds(skeleton);
-//     ccstd::vector<geometry::AABB> bounds;
-//     texture->bounds[mesh->getHash()] = bounds;
-
-//     // for (uint32_t f = 0; f < frames; ++f) { // TODO(xwx): frames not define
-//     //     bounds.emplace_back(geometry::AABB(INF, INF, INF, -INF, -INF, -INF));
-//     // }
-
-//     // TODO(xwx) : need to implement when define animInfos
-//     // for (uint32_t f = 0, offset = 0; f < frames; ++f) {
-//     //     auto bound = bounds[f];
-//     //     for (uint32_t j = 0; j < jointCount; ++j, offset += 12) {
-//     //         const {
-//     //             curveData,
-//     //             downstream,
-//     //             bindposeIdx,
-//     //             bindposeCorrection,
-//     //         } = texture.animInfos ![j];
-//     //         let mat : Mat4;
-//     //         let transformValid = true;
-//     //         if (curveData && downstream) { // curve & static two-way combination
-//     //             mat = Mat4.multiply(m4_1, curveData[f], downstream);
-//     //         } else if (curveData) { // there is a curve directly controlling the joint
-//     //             mat = curveData[f];
-//     //         } else if (downstream) { // fallback to default pose if no animation curve can be found upstream
-//     //             mat = downstream;
-//     //         } else { // bottom line: render the original mesh as-is
-//     //             mat            = skeleton.inverseBindposes[bindposeIdx];
-//     //             transformValid = false;
-//     //         }
-//     //         if (j < boneSpaceBounds.size()) {
-//     //             auto bound     = boneSpaceBounds[j];
-//     //             auto tarnsform = bindposeCorrection ? Mat4::multiply(mat, bindposeCorrection, &m42) : mat; // TODO(xwx): mat not define
-//     //             ab1.getBoundary(&v33, &v34);
-//     //             Vec3::min(bound.center, v33, &bound.center);
-//     //             Vec3::max(bound.halfExtents, v34, &bound.halfExtents);
-//     //         }
-
-//     //         if (buildTexture) {
-//     //             if (transformValid) {
-//     //                 Mat4::multiply(mat, bindPoses[bindposIdx], &m41);
-//     //                 UPLOAD_JOINT_DATA(textureBuffer, offset, transformValid ? m41 : Mat4::IDENTITY, j == 0);
-//     //             }
-//     //         }
-//     //     }
-//     //     AABB::fromPoints(bound.center, bound.halfExtents, &bound);
-//     // }
-//     if (buildTexture) {
-//         // _pool->update(texture->handle, textureBuffer.buffer); // TODO(xwx): ArrayBuffer not implemented
-//         _textureBuffers[hash] = texture.value();
-//     }
-//     return texture;
-// }
-// }
+ccstd::optional<IJointTextureHandle *> JointTexturePool::getSequencePoseTexture(Skeleton *skeleton, const IBakedClip &clip, Mesh *mesh, Node *skinningRoot) {
+    ccstd::hash_t hash = skeleton->getHash() ^ clip.hash;
+    ccstd::optional<IJointTextureHandle *> texture;
+    auto iter = _textureBuffers.find(hash);
+    if (iter != _textureBuffers.end()) {
+        texture = iter->second;
+        if (texture.value()->bounds.count(static_cast<uint32_t>(mesh->getHash())) > 0) {
+            texture.value()->refCount++;
+            return texture;
+        }
+    }
+
+    const ccstd::vector<ccstd::string> &joints = skeleton->getJoints();
+    const ccstd::vector<Mat4> &bindPoses = skeleton->getBindposes();
+    const ccstd::vector<Mat4> &inverseBindPoses = skeleton->getInverseBindposes();
+    const auto jointCount = static_cast<uint32_t>(joints.size());
+    const uint32_t frames = clip.frames;
+    Float32Array textureBuffer;
+    bool buildTexture = false;
+    if (!texture.has_value()) {
+        uint32_t bufSize = jointCount * 12 * frames;
+        ITextureBufferHandle handle;
+        auto chunkIter = _chunkIdxMap.find(hash);
+        if (chunkIter != _chunkIdxMap.end()) {
+            handle = _customPool->alloc(bufSize * Float32Array::BYTES_PER_ELEMENT, chunkIter->second);
+        } else {
+            handle = _pool->alloc(bufSize * Float32Array::BYTES_PER_ELEMENT);
+        }
+        if (handle.texture == nullptr) {
+            return texture;
+        }
+        IJointTextureHandle *textureHandle = IJointTextureHandle::createJoinTextureHandle();
+        textureHandle->pixelOffset = handle.start / _formatSize;
+        textureHandle->refCount = 1;
+        textureHandle->clipHash = clip.hash;
+        textureHandle->skeletonHash = skeleton->getHash();
+        textureHandle->readyToBeDeleted = false;
+        textureHandle->handle = handle;
+        texture = textureHandle;
+        textureBuffer = Float32Array(bufSize);
+        buildTexture = true;
+    } else {
+        texture.value()->refCount++;
+    }
+
+    const auto animInfos = createAnimInfos(skeleton, clip, skinningRoot);
+    auto boneSpaceBounds = mesh->getBoneSpaceBounds(skeleton);
+    ccstd::vector<geometry::AABB> &bounds = texture.value()->bounds[static_cast<uint32_t>(mesh->getHash())];
+    bounds.resize(frames);
+
+    // Frames are independent of each other, each one owns its bound and its part of the texture buffer.
+    auto bakeFrames = [&](uint32_t begin, uint32_t end) {
+        geometry::AABB ab1;
+        Mat4 m41;
+        Mat4 m42;
+        Vec3 v33;
+        Vec3 v34;
+        for (uint32_t f = begin; f < end; ++f) {
+            Vec3 v3Min(INF, INF, INF);
+            Vec3 v3Max(-INF, -INF, -INF);
+            for (uint32_t j = 0, offset = f * jointCount * 12; j < jointCount; ++j, offset += 12) {
+                const auto &animInfo = animInfos[j];
+                Mat4 mat;
+                bool transformValid = true;
+                if (animInfo.curveData && animInfo.downstream.has_value()) { // curve & static two-way combination
+                    Mat4::multiply((*animInfo.curveData)[f], animInfo.downstream.value(), &mat);
+                } else if (animInfo.curveData) { // there is a curve directly controlling the joint
+                    mat = (*animInfo.curveData)[f];
+                } else if (animInfo.downstream.has_value()) { // fallback to default pose if no animation curve can be found upstream
+                    mat = animInfo.downstream.value();
+                } else { // bottom line: render the original mesh as-is
+                    mat = inverseBindPoses[animInfo.bindposeIdx];
+                    transformValid = false;
+                }
+                if (j < boneSpaceBounds.size() && boneSpaceBounds[j]) {
+                    const Mat4 *transform = &mat;
+                    if (animInfo.bindposeCorrection.has_value()) {
+                        Mat4::multiply(mat, animInfo.bindposeCorrection.value(), &m42);
+                        transform = &m42;
+                    }
+                    boneSpaceBounds[j]->transform(*transform, &ab1);
+                    ab1.getBoundary(&v33, &v34);
+                    Vec3::min(v3Min, v33, &v3Min);
+                    Vec3::max(v3Max, v34, &v3Max);
+                }
+                if (buildTexture) {
+                    if (transformValid) {
+                        Mat4::multiply(mat, bindPoses[animInfo.bindposeIdx], &m41);
+                    }
+                    uploadJointDataLBS(textureBuffer, offset, transformValid ? m41 : Mat4::IDENTITY, j == 0);
+                }
+            }
+            geometry::AABB::fromPoints(v3Min, v3Max, &bounds[f]);
+        }
+    };
+
+    const uint32_t maxJobCount = frames > 0 ? (frames - 1) / BAKE_MIN_FRAMES_PER_JOB + 1 : 1;
+    const uint32_t jobCount = std::min(JobSystem::getInstance()->threadCount(), maxJobCount);
+    if (jobCount > 1) {
+        const uint32_t framesPerJob = (frames - 1) / jobCount + 1;
+        auto bakeJob = [&](uint32_t job) {
+            bakeFrames(job * framesPerJob, std::min(frames, (job + 1) * framesPerJob));
+        };
+        JobGraph g(JobSystem::getInstance());
+        g.createForEachIndexJob(1U, jobCount, 1U, bakeJob);
+        g.run();
+        bakeJob(0U);
+        g.waitForAll();
+    } else {
+        bakeFrames(0, frames);
+    }
+
+    if (buildTexture) {
+        auto chunkIter = _chunkIdxMap.find(hash);
+        (chunkIter != _chunkIdxMap.end() ? _customPool : _pool)->update(texture.value()->handle, textureBuffer.buffer());
+        _textureBuffers[hash] = texture.value();
+    }
+    return texture;
+}
 
 void JointTexturePool::releaseHandle(IJointTextureHandle *handle) {
     if (handle->refCount > 0) {
@@ -373,91 +400,79 @@ void JointTexturePool::releaseSkeleton(Skeleton *skeleton) {
     }
 }
 
-// TODO(xwx): AnimationClip not define
-// public releaseAnimationClip(clip: AnimationClip) {
-//     const it = this._textureBuffers.values();
-//     let res  = it.next();
-//     while (!res.done) {
-//         const handle = res.value;
-//         if (handle.clipHash == = clip.hash) {
-//             handle.readyToBeDeleted = true;
-//             if (handle.refCount) {
-//                 // delete handle record immediately so new allocations with the same asset could work
-//                 this._textureBuffers.delete(handle.skeletonHash ^ handle.clipHash);
-//             } else {
-//                 this.releaseHandle(handle);
-//             }
-//         }
-//         res = it.next();
-//     }
-// }
-
-// TODO(xwx): AnimationClip not define
-// private _createAnimInfos (skeleton: Skeleton, clip: AnimationClip, skinningRoot: Node) {
-//     const animInfos: IInternalJointAnimInfo[] = [];
-//     const { joints, bindposes } = skeleton;
-//     const jointCount = joints.length;
-//     const clipData = SkelAnimDataHub.getOrExtract(clip);
-//     for (let j = 0; j < jointCount; j++) {
-//         let animPath = joints[j];
-//         let source = clipData.joints[animPath];
-//         let animNode = skinningRoot.getChildByPath(animPath);
-//         let downstream: Mat4 | undefined;
-//         let correctionPath: string | undefined;
-//         while (!source) {
-//             const idx = animPath.lastIndexOf('/');
-//             animPath = animPath.substring(0, idx);
-//             source = clipData.joints[animPath];
-//             if (animNode) {
-//                 if (!downstream) { downstream = ccnew Mat4(); }
-//                 Mat4.fromRTS(m4_1, animNode.rotation, animNode.position, animNode.scale);
-//                 Mat4.multiply(downstream, m4_1, downstream);
-//                 animNode = animNode.parent;
-//             } else { // record the nearest curve path if no downstream pose is present
-//                 correctionPath = animPath;
-//             }
-//             if (idx < 0) { break; }
-//         }
-//         // the default behavior, just use the bindpose for current joint directly
-//         let bindposeIdx = j;
-//         let bindposeCorrection: Mat4 | undefined;
-//         /**
-//          * It is regularly observed that developers may choose to delete the whole
-//          * skeleton node tree for skinning models that only use baked animations
-//          * as an effective optimization strategy (substantial improvements on both
-//          * package size and runtime efficiency).
-//          *
-//          * This becomes troublesome in some cases during baking though, e.g. when a
-//          * skeleton joint node is not directly controlled by any animation curve,
-//          * but its parent nodes are. Due to lack of proper downstream default pose,
-//          * the joint transform can not be calculated accurately.
-//          *
-//          * We address this issue by employing some pragmatic approximation.
-//          * Specifically, by multiplying the bindpose of the joint corresponding to
-//          * the nearest curve, instead of the actual target joint. This effectively
-//          * merges the skinning influence of the 'incomplete' joint into its nearest
-//          * parent with accurate transform data.
-//          * It gives more visually-plausible results compared to the naive approach
-//          * for most cases we've covered.
-//          */
-//         if (correctionPath !== undefined && source) {
-//             // just use the previous joint if the exact path is not found
-//             bindposeIdx = j - 1;
-//             for (let t = 0; t < jointCount; t++) {
-//                 if (joints[t] === correctionPath) {
-//                     bindposeIdx = t;
-//                     bindposeCorrection = ccnew Mat4();
-//                     Mat4.multiply(bindposeCorrection, bindposes[t], skeleton.inverseBindposes[j]);
-//                     break;
-//                 }
-//             }
-//         }
-//         animInfos.push({
-//             curveData: source && source.transforms, downstream, bindposeIdx, bindposeCorrection,
-//         });
-//     }
-//     return animInfos;
-// }
+void JointTexturePool::releaseAnimationClip(ccstd::hash_t clipHash) {
+    for (auto iter = _textureBuffers.begin(); iter != _textureBuffers.end();) {
+        auto *handle = iter->second;
+        if (handle->clipHash != clipHash) {
+            ++iter;
+            continue;
+        }
+        handle->readyToBeDeleted = true;
+        if (handle->refCount > 0) {
+            // delete handle record immediately so new allocations with the same asset could work
+            iter = _textureBuffers.erase(iter);
+        } else {
+            ++iter;
+            releaseHandle(handle);
+        }
+    }
+}
+
+ccstd::vector<IInternalJointAnimInfo> JointTexturePool::createAnimInfos(Skeleton *skeleton, const IBakedClip &clip, Node *skinningRoot) {
+    ccstd::vector<IInternalJointAnimInfo> animInfos;
+    const ccstd::vector<ccstd::string> &joints = skeleton->getJoints();
+    const ccstd::vector<Mat4> &bindPoses = skeleton->getBindposes();
+    const auto jointCount = static_cast<index_t>(joints.size());
+    animInfos.reserve(jointCount);
+    Mat4 m41;
+    for (index_t j = 0; j < jointCount; j++) {
+        ccstd::string animPath = joints[j];
+        auto sourceIter = clip.joints.find(animPath);
+        auto *animNode = skinningRoot->getChildByPath(animPath);
+        ccstd::optional<Mat4> downstream;
+        ccstd::optional<ccstd::string> correctionPath;
+        while (sourceIter == clip.joints.end()) {
+            const auto idx = animPath.rfind('/');
+            animPath = idx == ccstd::string::npos ? "" : animPath.substr(0, idx);
+            sourceIter = clip.joints.find(animPath);
+            if (animNode != nullptr) {
+                if (!downstream.has_value()) {
+                    downstream = Mat4::IDENTITY;
+                }
+                Mat4::fromRTS(animNode->getRotation(), animNode->getPosition(), animNode->getScale(), &m41);
+                Mat4::multiply(downstream.value(), m41, &downstream.value());
+                animNode = animNode->getParent();
+            } else { // record the nearest curve path if no downstream pose is present
+                correctionPath = animPath;
+            }
+            if (idx == ccstd::string::npos) {
+                break;
+            }
+        }
+        const bool hasSource = sourceIter != clip.joints.end();
+        // the default behavior, just use the bindpose for current joint directly
+        IInternalJointAnimInfo animInfo;
+        animInfo.bindposeIdx = j;
+        // Joints that are not controlled by any curve and have no downstream node (e.g. the skeleton nodes
+        // were stripped for baking) are approximated with the bindpose of the nearest animated parent joint.
+        if (correctionPath.has_value() && hasSource) {
+            // just use the previous joint if the exact path is not found
+            animInfo.bindposeIdx = j - 1;
+            for (index_t t = 0; t < jointCount; t++) {
+                if (joints[t] == correctionPath.value()) {
+                    animInfo.bindposeIdx = t;
+                    animInfo.bindposeCorrection = Mat4();
+                    Mat4::multiply(bindPoses[t], skeleton->getInverseBindposes()[j], &animInfo.bindposeCorrection.value());
+                    break;
+                }
+            }
+        }
+        animInfo.curveData = hasSource && sourceIter->second.size() >= clip.frames ? &sourceIter->second : nullptr;
+        animInfo.downstream = downstream;
+        animInfos.emplace_back(std::move(animInfo));
+    }
+    return animInfos;
+}
 
 JointAnimationInfo::JointAnimationInfo(gfx::Device *device)
 : _device(device) {
@@ -53,11 +53,21 @@ struct ICustomJointTextureLayout {
 
 struct IInternalJointAnimInfo {
     ccstd::optional<Mat4> downstream;               // downstream default pose, if present
-    ccstd::optional<ccstd::vector<Mat4>> curveData; // the nearest animation curve, if present
+    const ccstd::vector<Mat4> *curveData{nullptr};  // the nearest animation curve, if present
     index_t bindposeIdx{0};                         // index of the actual bindpose to use
     ccstd::optional<Mat4> bindposeCorrection;       // correction factor from the original bindpose
 };
 
+/**
+ * The sampled joint transforms of an animation clip, i.e. what SkelAnimDataHub extracts from an AnimationClip in JS:
+ * the transform relative to the skinning root of every animated joint path, at every frame.
+ */
+struct IBakedClip {
+    ccstd::hash_t hash{0U};
+    uint32_t frames{0};
+    ccstd::unordered_map<ccstd::string, ccstd::vector<Mat4>> joints;
+};
+
 class IJointTextureHandle {
 public:
     uint32_t pixelOffset{0};
@@ -103,16 +113,16 @@ public:
      * @zh
      * 获取指定动画片段的骨骼贴图。
      */
-    // ccstd::optional<IJointTextureHandle> getSequencePoseTexture(Skeleton *skeleton, AnimationClip *clip, Mesh *mesh, Node *skinningRoot);
+    ccstd::optional<IJointTextureHandle *> getSequencePoseTexture(Skeleton *skeleton, const IBakedClip &clip, Mesh *mesh, Node *skinningRoot);
 
     void releaseHandle(IJointTextureHandle *handle);
 
     void releaseSkeleton(Skeleton *skeleton);
 
-    // void releaseAnimationClip (AnimationClip* clip); // TODO(xwx): AnimationClip not define
+    void releaseAnimationClip(ccstd::hash_t clipHash);
 
 private:
-    // const IInternalJointAnimInfo &createAnimInfos(Skeleton *skeleton, AnimationClip *clip, Node *skinningRoot); // TODO(xwx): AnimationClip not define
+    static ccstd::vector<IInternalJointAnimInfo> createAnimInfos(Skeleton *skeleton, const IBakedClip &clip, Node *skinningRoot);
 
     gfx::Device *_device{nullptr};
     IntrusivePtr<TextureBufferPool> _pool;
@@ -25,14 +25,11 @@
 ****************************************************************************/
 
 #include "audio/include/AudioEngine.h"
-#include <condition_variable>
 #include <cstdint>
-#include <mutex>
-#include <thread>
 #include "base/Log.h"
+#include "base/ThreadPool.h"
 #include "base/Utils.h"
 #include "base/memory/Memory.h"
-#include "base/std/container/queue.h"
 #include "platform/FileUtils.h"
 
 #if CC_PLATFORM == CC_PLATFORM_ANDROID
@@ -51,6 +48,10 @@
 
 #define TIME_DELAY_PRECISION 0.0001
 
+#ifndef DEFAULT_CACHE_MEMORY_BUDGET
+    #define DEFAULT_CACHE_MEMORY_BUDGET 0
+#endif
+
 #ifdef ERROR
     #undef ERROR
 #endif // ERROR
@@ -65,6 +66,7 @@ ccstd::unordered_map<ccstd::string, ccstd::list<int>> AudioEngine::sAudioPathIDM
 //profileName,ProfileHelper
 ccstd::unordered_map<ccstd::string, AudioEngine::ProfileHelper> AudioEngine::sAudioPathProfileHelperMap;
 unsigned int AudioEngine::sMaxInstances = MAX_AUDIOINSTANCES;
+uint32_t AudioEngine::sCacheMemoryBudget = DEFAULT_CACHE_MEMORY_BUDGET;
 AudioEngine::ProfileHelper *AudioEngine::sDefaultProfileHelper = nullptr;
 ccstd::unordered_map<int, AudioEngine::AudioInfo> AudioEngine::sAudioIDInfoMap;
 AudioEngineImpl *AudioEngine::sAudioEngineImpl = nullptr;
@@ -87,62 +89,25 @@ AudioEngine::AudioInfo::AudioInfo()
   state(AudioState::INITIALIZING) {
 }
 
+// a legacy pool, which shares the IO lane of the job system scheduler when that backend is selected
 class AudioEngine::AudioEngineThreadPool {
 public:
-    explicit AudioEngineThreadPool(int threads = 4) {
-        for (int index = 0; index < threads; ++index) {
-            _workers.emplace_back(std::thread([this]() {
-                threadFunc();
-            }));
-        }
+    explicit AudioEngineThreadPool(int threads = 4)
+    : _pool(LegacyThreadPool::newFixedThreadPool(threads)) {
     }
 
     void addTask(const std::function<void()> &task) {
-        std::unique_lock<std::mutex> lk(_queueMutex);
-        _taskQueue.emplace(task);
-        _taskCondition.notify_one();
+        _pool->pushTask([task](int /*tid*/) { task(); }, LegacyThreadPool::TaskType::AUDIO);
     }
 
     ~AudioEngineThreadPool() {
-        {
-            std::unique_lock<std::mutex> lk(_queueMutex);
-            _stop = true;
-            _taskCondition.notify_all();
-        }
-
-        for (auto &&worker : _workers) {
-            worker.join();
-        }
+        // drop the pending tasks, only wait for the running ones
+        _pool->stopAllTasks();
+        delete _pool;
     }
 
 private:
-    void threadFunc() {
-        while (true) {
-            std::function<void()> task = nullptr;
-            {
-                std::unique_lock<std::mutex> lk(_queueMutex);
-                if (_stop) {
-                    break;
-                }
-                if (!_taskQueue.empty()) {
-                    task = std::move(_taskQueue.front());
-                    _taskQueue.pop();
-                } else {
-                    _taskCondition.wait(lk);
-                    continue;
-                }
-            }
-
-            task();
-        }
-    }
-
-    ccstd::vector<std::thread> _workers;
-    ccstd::queue<std::function<void()>> _taskQueue;
-
-    std::mutex _queueMutex;
-    std::condition_variable _taskCondition;
-    bool _stop{};
+    LegacyThreadPool *_pool{nullptr};
 };
 
 void AudioEngine::end() {
@@ -25,7 +25,9 @@
 ****************************************************************************/
 
 #include "audio/common/decoder/AudioDecoder.h"
+#include <algorithm>
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include "audio/include/AudioMacros.h"
 #include "platform/FileUtils.h"
@@ -42,6 +44,31 @@ AudioDecoder::AudioDecoder()
 
 AudioDecoder::~AudioDecoder() = default;
 
+bool AudioDecoder::openMemory(const char * /*path*/, const uint8_t * /*data*/, uint32_t /*size*/) {
+    return false;
+}
+
+size_t AudioDecoder::MemorySource::read(void *buffer, size_t bytes) {
+    bytes = std::min(bytes, static_cast<size_t>(size - position));
+    memcpy(buffer, data + position, bytes);
+    position += static_cast<uint32_t>(bytes);
+    return bytes;
+}
+
+int64_t AudioDecoder::MemorySource::seek(int64_t offset, int whence) {
+    int64_t base = 0;
+    if (whence == SEEK_CUR) {
+        base = position;
+    } else if (whence == SEEK_END) {
+        base = size;
+    }
+    if (base + offset < 0 || base + offset > size) {
+        return -1;
+    }
+    position = static_cast<uint32_t>(base + offset);
+    return position;
+}
+
 bool AudioDecoder::isOpened() const {
     return _isOpened;
 }
@@ -48,12 +48,30 @@ class AudioDecoder {
 public:
     static const uint32_t INVALID_FRAME_INDEX = UINT32_MAX;
 
+    // Reads the data given to openMemory, handed to the I/O callbacks of the decoding libraries.
+    struct MemorySource {
+        const uint8_t *data{nullptr};
+        uint32_t size{0};
+        uint32_t position{0};
+
+        size_t read(void *buffer, size_t bytes);
+        // Returns the new position, or -1 if it would be out of the data.
+        int64_t seek(int64_t offset, int whence);
+    };
+
     /**
      * @brief Opens an audio file specified by a file path.
      * @return true if succeed, otherwise false.
      */
     virtual bool open(const char *path) = 0;
 
+    /**
+     * @brief Opens the encoded data of an audio file kept in memory, the data has to outlive the decoder.
+     * @param path The path of the file the data was read from.
+     * @return true if succeed, false if failed or if the decoder can only read files.
+     */
+    virtual bool openMemory(const char *path, const uint8_t *data, uint32_t size);
+
     /**
      * @brief Checks whether decoder has opened file successfully.
      * @return true if succeed, otherwise false.
@@ -123,6 +141,7 @@ protected:
 
     bool _isOpened;
     PCMHeader _pcmHeader;
+    MemorySource _memorySource;
     void *_fsHooks = nullptr;
 
     friend class AudioDecoderManager;
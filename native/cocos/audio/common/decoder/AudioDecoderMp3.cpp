@@ -48,6 +48,18 @@
 
 namespace cc {
 
+namespace {
+
+ssize_t readMemory(void *source, void *buffer, size_t bytes) {
+    return static_cast<ssize_t>(static_cast<AudioDecoder::MemorySource *>(source)->read(buffer, bytes));
+}
+
+off_t seekMemory(void *source, off_t offset, int whence) {
+    return static_cast<off_t>(static_cast<AudioDecoder::MemorySource *>(source)->seek(offset, whence));
+}
+
+} // namespace
+
 static bool sMp3Inited = false;
 
 bool AudioDecoderMp3::lazyInit() {
@@ -82,10 +94,7 @@ AudioDecoderMp3::~AudioDecoderMp3() {
 bool AudioDecoderMp3::open(const char *path) {
     ccstd::string fullPath = FileUtils::getInstance()->fullPathForFilename(path);
 
-    long rate = 0; //NOLINT(google-runtime-int)
     int error = MPG123_OK;
-    int mp3Encoding = 0;
-    int channel = 0;
     do {
         _mpg123handle = mpg123_new(nullptr, &error);
         if (nullptr == _mpg123handle) {
@@ -95,35 +104,41 @@ bool AudioDecoderMp3::open(const char *path) {
 #if CC_PLATFORM_OHOS == CC_PLATFORM
         auto *fu = static_cast<FileUtilsOHOS *>(FileUtils::getInstance());
         _fdAndDeleter = fu->getFd(fullPath);
-        if (mpg123_open_fd(_mpg123handle, _fdAndDeleter.first) != MPG123_OK || mpg123_getformat(_mpg123handle, &rate, &channel, &mp3Encoding) != MPG123_OK) {
+        if (mpg123_open_fd(_mpg123handle, _fdAndDeleter.first) != MPG123_OK || !readFormat()) {
 #else
-        if (mpg123_open(_mpg123handle, FileUtils::getInstance()->getSuitableFOpen(fullPath).c_str()) != MPG123_OK || mpg123_getformat(_mpg123handle, &rate, &channel, &mp3Encoding) != MPG123_OK) {
+        if (mpg123_open(_mpg123handle, FileUtils::getInstance()->getSuitableFOpen(fullPath).c_str()) != MPG123_OK || !readFormat()) {
 #endif
             ALOGE("Trouble with mpg123: %s\n", mpg123_strerror(_mpg123handle));
             break;
         }
 
-        _pcmHeader.channelCount = channel;
-        _pcmHeader.sampleRate = rate;
+        _isOpened = true;
+        return true;
+    } while (false);
 
-        if (mp3Encoding == MPG123_ENC_SIGNED_16) {
-            _pcmHeader.bytesPerFrame = 2 * _pcmHeader.channelCount;
-            _pcmHeader.dataFormat = AudioDataFormat::SIGNED_16;
-        } else if (mp3Encoding == MPG123_ENC_FLOAT_32) {
-            _pcmHeader.bytesPerFrame = 4 * _pcmHeader.channelCount;
-            _pcmHeader.dataFormat = AudioDataFormat::FLOAT_32;
-        } else {
-            ALOGE("Bad encoding: 0x%x!\n", mp3Encoding);
+    if (_mpg123handle != nullptr) {
+        mpg123_close(_mpg123handle);
+        mpg123_delete(_mpg123handle);
+        _mpg123handle = nullptr;
+    }
+    return false;
+}
+
+bool AudioDecoderMp3::openMemory(const char * /*path*/, const uint8_t *data, uint32_t size) {
+    int error = MPG123_OK;
+    do {
+        _mpg123handle = mpg123_new(nullptr, &error);
+        if (nullptr == _mpg123handle) {
+            ALOGE("Basic setup goes wrong: %s", mpg123_plain_strerror(error));
             break;
         }
 
-        /* Ensure that this output format will not change (it could, when we allow it). */
-        mpg123_format_none(_mpg123handle);
-        mpg123_format(_mpg123handle, rate, channel, mp3Encoding);
-        /* Ensure that we can get accurate length by call mpg123_length */
-        mpg123_scan(_mpg123handle);
-
-        _pcmHeader.totalFrames = mpg123_length(_mpg123handle);
+        _memorySource = {data, size, 0};
+        if (mpg123_replace_reader_handle(_mpg123handle, &readMemory, &seekMemory, nullptr) != MPG123_OK ||
+            mpg123_open_handle(_mpg123handle, &_memorySource) != MPG123_OK || !readFormat()) {
+            ALOGE("Trouble with mpg123: %s\n", mpg123_strerror(_mpg123handle));
+            break;
+        }
 
         _isOpened = true;
         return true;
@@ -137,6 +152,38 @@ bool AudioDecoderMp3::open(const char *path) {
     return false;
 }
 
+bool AudioDecoderMp3::readFormat() {
+    long rate = 0; //NOLINT(google-runtime-int)
+    int mp3Encoding = 0;
+    int channel = 0;
+    if (mpg123_getformat(_mpg123handle, &rate, &channel, &mp3Encoding) != MPG123_OK) {
+        return false;
+    }
+
+    _pcmHeader.channelCount = channel;
+    _pcmHeader.sampleRate = rate;
+
+    if (mp3Encoding == MPG123_ENC_SIGNED_16) {
+        _pcmHeader.bytesPerFrame = 2 * _pcmHeader.channelCount;
+        _pcmHeader.dataFormat = AudioDataFormat::SIGNED_16;
+    } else if (mp3Encoding == MPG123_ENC_FLOAT_32) {
+        _pcmHeader.bytesPerFrame = 4 * _pcmHeader.channelCount;
+        _pcmHeader.dataFormat = AudioDataFormat::FLOAT_32;
+    } else {
+        ALOGE("Bad encoding: 0x%x!\n", mp3Encoding);
+        return false;
+    }
+
+    /* Ensure that this output format will not change (it could, when we allow it). */
+    mpg123_format_none(_mpg123handle);
+    mpg123_format(_mpg123handle, rate, channel, mp3Encoding);
+    /* Ensure that we can get accurate length by call mpg123_length */
+    mpg123_scan(_mpg123handle);
+
+    _pcmHeader.totalFrames = mpg123_length(_mpg123handle);
+    return true;
+}
+
 void AudioDecoderMp3::close() {
     if (isOpened()) {
         if (_mpg123handle != nullptr) {
@@ -45,6 +45,12 @@ public:
      */
     bool open(const char *path) override;
 
+    /**
+     * @brief Opens the encoded data of an mp3 file kept in memory, the data has to outlive the decoder.
+     * @return true if succeed, otherwise false.
+     */
+    bool openMemory(const char *path, const uint8_t *data, uint32_t size) override;
+
     /**
      * @brief Closes opened audio file.
      * @note The method will also be automatically invoked in the destructor.
@@ -79,6 +85,7 @@ protected:
     static bool lazyInit();
     static void destroy();
 
+    bool readFormat();
     struct mpg123_handle_struct *_mpg123handle = nullptr;
 
 #if CC_PLATFORM_OHOS == CC_PLATFORM
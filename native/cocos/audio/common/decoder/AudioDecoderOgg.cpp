@@ -25,6 +25,7 @@
 ****************************************************************************/
 
 #include "audio/common/decoder/AudioDecoderOgg.h"
+#include <algorithm>
 #include <cstdint>
 
 #include "audio/include/AudioMacros.h"
@@ -52,6 +53,22 @@ ov_callbacks ogg_callbacks = { //NOLINT
 
 namespace cc {
 
+namespace {
+
+size_t readMemory(void *buffer, size_t size, size_t count, void *source) {
+    return static_cast<AudioDecoder::MemorySource *>(source)->read(buffer, size * count) / std::max<size_t>(size, 1);
+}
+
+int seekMemory(void *source, ogg_int64_t offset, int whence) {
+    return static_cast<AudioDecoder::MemorySource *>(source)->seek(offset, whence) < 0 ? -1 : 0;
+}
+
+long tellMemory(void *source) { //NOLINT(google-runtime-int)
+    return static_cast<long>(static_cast<AudioDecoder::MemorySource *>(source)->position); //NOLINT(google-runtime-int)
+}
+
+} // namespace
+
 AudioDecoderOgg::AudioDecoderOgg() = default;
 
 AudioDecoderOgg::~AudioDecoderOgg() {
@@ -68,19 +85,32 @@ bool AudioDecoderOgg::open(const char *path) {
     auto *fp = cc::ohosOpen(FileUtils::getInstance()->getSuitableFOpen(fullPath).c_str(), this);
     if (0 == ov_open_callbacks(fp, &_vf, nullptr, 0, ogg_callbacks)) {
 #endif
-        // header
-        vorbis_info *vi = ov_info(&_vf, -1);
-        _pcmHeader.sampleRate = static_cast<uint32_t>(vi->rate);
-        _pcmHeader.channelCount = vi->channels;
-        _pcmHeader.bytesPerFrame = vi->channels * sizeof(int16_t);
-        _pcmHeader.dataFormat = AudioDataFormat::SIGNED_16;
-        _pcmHeader.totalFrames = static_cast<uint32_t>(ov_pcm_total(&_vf, -1));
-        _isOpened = true;
+        readHeader();
+        return true;
+    }
+    return false;
+}
+
+bool AudioDecoderOgg::openMemory(const char * /*path*/, const uint8_t *data, uint32_t size) {
+    static const ov_callbacks MEMORY_CALLBACKS = {&readMemory, &seekMemory, nullptr, &tellMemory};
+    _memorySource = {data, size, 0};
+    if (0 == ov_open_callbacks(&_memorySource, &_vf, nullptr, 0, MEMORY_CALLBACKS)) {
+        readHeader();
         return true;
     }
     return false;
 }
 
+void AudioDecoderOgg::readHeader() {
+    vorbis_info *vi = ov_info(&_vf, -1);
+    _pcmHeader.sampleRate = static_cast<uint32_t>(vi->rate);
+    _pcmHeader.channelCount = vi->channels;
+    _pcmHeader.bytesPerFrame = vi->channels * sizeof(int16_t);
+    _pcmHeader.dataFormat = AudioDataFormat::SIGNED_16;
+    _pcmHeader.totalFrames = static_cast<uint32_t>(ov_pcm_total(&_vf, -1));
+    _isOpened = true;
+}
+
 void AudioDecoderOgg::close() {
     if (isOpened()) {
         ov_clear(&_vf);
@@ -47,6 +47,12 @@ public:
      */
     bool open(const char *path) override;
 
+    /**
+     * @brief Opens the encoded data of an ogg file kept in memory, the data has to outlive the decoder.
+     * @return true if succeed, otherwise false.
+     */
+    bool openMemory(const char *path, const uint8_t *data, uint32_t size) override;
+
     /**
      * @brief Closes opened audio file.
      * @note The method will also be automatically invoked in the destructor.
@@ -78,6 +84,7 @@ protected:
     AudioDecoderOgg();
     ~AudioDecoderOgg() override;
 
+    void readHeader();
     OggVorbis_File _vf;
 
     friend class AudioDecoderManager;
@@ -256,6 +256,21 @@ public:
      */
     static bool setMaxAudioInstance(int maxInstances);
 
+    /**
+     * Gets the memory budget of the audio data kept in the cache, in bytes, 0 if there is none.
+     */
+    static uint32_t getCacheMemoryBudget() { return sCacheMemoryBudget; }
+
+    /**
+     * Sets the memory budget of the decoded and compressed audio data kept in the cache. Once it's exceeded,
+     * the least recently used audio files that aren't playing are uncached, the next time an audio file
+     * is loaded or stops playing.
+     *
+     * @param bytes The budget in bytes, 0 for no budget. Defaults to 64 MB on OpenHarmony and no budget elsewhere.
+     * @note Only the OpenAL Soft backend has a budget.
+     */
+    static void setCacheMemoryBudget(uint32_t bytes) { sCacheMemoryBudget = bytes; }
+
     /** 
      * Uncache the audio data from internal buffer.
      * AudioEngine cache audio data on ios,mac, and oalsoft platform.
@@ -380,6 +395,8 @@ protected:
 
     static unsigned int sMaxInstances;
 
+    static uint32_t sCacheMemoryBudget;
+
     static ProfileHelper *sDefaultProfileHelper;
 
     static AudioEngineImpl *sAudioEngineImpl;
@@ -399,6 +416,7 @@ private:
     static void onEnterForeground();
 
     friend class AudioEngineImpl;
+    friend class AudioStreamer;
 };
 
 } // namespace cc
@@ -32,6 +32,8 @@
 #include "application/ApplicationManager.h"
 #include "audio/common/decoder/AudioDecoder.h"
 #include "audio/common/decoder/AudioDecoderManager.h"
+#include "platform/FileUtils.h"
+#include "profiler/Profiler.h"
 
 #include <string.h>
 
@@ -48,7 +50,8 @@ namespace {
 unsigned int gIdIndex = 0;
 }
 
-#define PCMDATA_CACHEMAXSIZE 1048576
+#define PCMDATA_CACHEMAXSIZE        1048576
+#define COMPRESSEDDATA_CACHEMAXSIZE 1048576
 
 using namespace cc; //NOLINT
 
@@ -95,6 +98,9 @@ AudioCache::~AudioCache() {
             free(buffer);
         }
     }
+
+    CC_PROFILE_MEMORY_DEC(AudioPCM, _pcmMemorySize);
+    CC_PROFILE_MEMORY_DEC(AudioCompressed, _compressedMemorySize);
     ALOGVV("~AudioCache() %p, id=%u, end", this, _id);
 }
 
@@ -106,8 +112,21 @@ void AudioCache::readDataTask(unsigned int selfId) {
     _state = State::LOADING;
 
     AudioDecoder *decoder = AudioDecoderManager::createDecoder(_fileFullPath.c_str());
+    std::shared_ptr<Data> encodedData;
     do {
-        if (decoder == nullptr || !decoder->open(_fileFullPath.c_str())) {
+        if (decoder == nullptr) {
+            break;
+        }
+
+        // Small enough files are read at once and decoded from memory, the streamed ones keep their encoded data.
+        const auto fileSize = FileUtils::getInstance()->getFileSize(_fileFullPath);
+        if (fileSize > 0 && fileSize <= COMPRESSEDDATA_CACHEMAXSIZE) {
+            encodedData = std::make_shared<Data>(FileUtils::getInstance()->getDataFromFile(_fileFullPath));
+            if (encodedData->isNull() || !decoder->openMemory(_fileFullPath.c_str(), encodedData->getBytes(), encodedData->getSize())) {
+                encodedData.reset();
+            }
+        }
+        if (!encodedData && !decoder->open(_fileFullPath.c_str())) {
             break;
         }
 
@@ -216,6 +235,8 @@ void AudioCache::readDataTask(unsigned int selfId) {
 
             alBufferData(_alBufferId, _format, _pcmData, static_cast<ALsizei>(dataSize), static_cast<ALsizei>(sampleRate));
 
+            // The PCM data is kept next to the copy OpenAL makes of it.
+            _pcmMemorySize = dataSize * 2;
             _state = State::READY;
         } else {
             _isStreaming = true;
@@ -231,6 +252,11 @@ void AudioCache::readDataTask(unsigned int selfId) {
                 decoder->readFixedFrames(_queBufferFrames, _queBuffers[index]);
             }
 
+            _pcmMemorySize = queBufferBytes * QUEUEBUFFER_NUM;
+            if (encodedData) {
+                _encodedData = encodedData;
+                _compressedMemorySize = encodedData->getSize();
+            }
             _state = State::READY;
         }
 
@@ -242,7 +268,10 @@ void AudioCache::readDataTask(unsigned int selfId) {
 
     AudioDecoderManager::destroyDecoder(decoder);
 
-    if (_state != State::READY) {
+    if (_state == State::READY) {
+        CC_PROFILE_MEMORY_INC(AudioPCM, _pcmMemorySize);
+        CC_PROFILE_MEMORY_INC(AudioCompressed, _compressedMemorySize);
+    } else {
         _state = State::FAILED;
         if (_alBufferId != INVALID_AL_BUFFER_ID && alIsBuffer(_alBufferId)) {
             ALOGV("readDataTask failed, delete buffer: %u", _alBufferId);
@@ -41,6 +41,7 @@
     #include <AL/al.h>
 #endif
 #include "audio/include/AudioMacros.h"
+#include "base/Data.h"
 #include "base/Macros.h"
 #include "base/std/container/vector.h"
 #define INVALID_AL_BUFFER_ID 0xFFFFFFFF
@@ -66,6 +67,8 @@ public:
 
     uint32_t getChannelCount() const { return _channelCount; }
     bool isStreaming() const { return _isStreaming; }
+    // The decoded and compressed data owned by the cache, in bytes.
+    uint32_t getMemorySize() const { return _pcmMemorySize + _compressedMemorySize; }
 
 protected:
     void setSkipReadDataTask(bool isSkip) { _isSkipReadDataTask = isSkip; };
@@ -99,6 +102,17 @@ protected:
     ALsizei _queBufferSize[QUEUEBUFFER_NUM];
     uint32_t _queBufferFrames{0};
 
+    /* Compressed residency related stuff;
+     * Streamed clips whose file is at most COMPRESSEDDATA_CACHEMAXSIZE keep their encoded data,
+     * and are decoded from memory instead of the file system.
+     */
+    std::shared_ptr<Data> _encodedData;
+
+    uint32_t _pcmMemorySize{0};
+    uint32_t _compressedMemorySize{0};
+    // Last time the cache was requested, for the least recently used eviction.
+    uint64_t _lastUsed{0};
+
     std::mutex _playCallbackMutex;
     ccstd::vector<std::function<void()>> _playCallbacks;
 
@@ -32,6 +32,7 @@
 #include "audio/common/decoder/AudioDecoder.h"
 #include "base/Log.h"
 #include "base/Utils.h"
+#include "base/std/container/unordered_set.h"
 #include "base/std/container/vector.h"
 #define LOG_TAG "AudioEngine-OALSOFT"
 
@@ -137,6 +138,9 @@ AudioEngineImpl::~AudioEngineImpl() {
     }
 
     if (sALContext) {
+        delete _streamer;
+        _streamer = nullptr;
+
         alDeleteSources(MAX_AUDIOINSTANCES, _alSources);
 
         _audioCaches.clear();
@@ -175,6 +179,8 @@ bool AudioEngineImpl::init() {
                 _alSourceUsed[src] = false;
             }
 
+            _streamer = ccnew AudioStreamer();
+
             _scheduler = CC_CURRENT_ENGINE()->getScheduler();
             ret = AudioDecoderManager::init();
             CC_LOG_DEBUG("OpenAL was initialized successfully!");
@@ -201,9 +207,14 @@ AudioCache *AudioEngineImpl::preload(const ccstd::string &filePath, const std::f
             }
             audioCache->readDataTask(cacheId);
         });
+        // The load callbacks are invoked in the cocos thread, where the caches are uncached.
+        audioCache->addLoadCallback([this, audioCache](bool /*isSuccess*/) {
+            evictCaches(audioCache);
+        });
     } else {
         audioCache = &it->second;
     }
+    audioCache->_lastUsed = ++_cacheUseCount;
 
     if (audioCache && callback) {
         audioCache->addLoadCallback(callback);
@@ -238,6 +249,7 @@ int AudioEngineImpl::play2d(const ccstd::string &filePath, bool loop, float volu
     player->_alSource = alSource;
     player->_loop = loop;
     player->_volume = volume;
+    player->_streamer = _streamer;
 
     auto audioCache = preload(filePath, nullptr);
     if (audioCache == nullptr) {
@@ -486,6 +498,7 @@ void AudioEngineImpl::update(float /*dt*/) {
     int audioID;
     AudioPlayer *player;
     ALuint alSource;
+    const size_t playerCount = _audioPlayers.size();
 
     //    ALOGV("AudioPlayer count: %d", (int)_audioPlayers.size());
 
@@ -525,6 +538,10 @@ void AudioEngineImpl::update(float /*dt*/) {
         }
     }
 
+    if (_audioPlayers.size() < playerCount) {
+        evictCaches(nullptr);
+    }
+
     if (_audioPlayers.empty()) {
         _lazyInitLoop = true;
         if (auto sche = _scheduler.lock()) {
@@ -541,6 +558,44 @@ void AudioEngineImpl::uncacheAll() {
     _audioCaches.clear();
 }
 
+void AudioEngineImpl::evictCaches(const AudioCache *keptCache) {
+    const uint32_t budget = AudioEngine::getCacheMemoryBudget();
+    if (budget == 0) {
+        return;
+    }
+
+    uint64_t memorySize = 0;
+    for (const auto &item : _audioCaches) {
+        memorySize += item.second.getMemorySize();
+    }
+
+    ccstd::unordered_set<const AudioCache *> usedCaches;
+    for (const auto &item : _audioPlayers) {
+        usedCaches.insert(item.second->_audioCache);
+    }
+
+    while (memorySize > budget) {
+        auto evicted = _audioCaches.end();
+        for (auto it = _audioCaches.begin(); it != _audioCaches.end(); ++it) {
+            const auto &cache = it->second;
+            // Loading caches can't be destroyed without waiting for them.
+            if (&cache == keptCache || cache._state != AudioCache::State::READY || cache.getMemorySize() == 0 || usedCaches.count(&cache) != 0) {
+                continue;
+            }
+            if (evicted == _audioCaches.end() || cache._lastUsed < evicted->second._lastUsed) {
+                evicted = it;
+            }
+        }
+        if (evicted == _audioCaches.end()) {
+            break;
+        }
+
+        ALOGV("Uncache %s to fit in the audio cache budget", evicted->first.c_str());
+        memorySize -= evicted->second.getMemorySize();
+        _audioCaches.erase(evicted);
+    }
+}
+
 bool AudioEngineImpl::checkAudioIdValid(int audioID) {
     return _audioPlayers.find(audioID) != _audioPlayers.end();
 }
@@ -30,6 +30,7 @@
 #include "audio/include/AudioDef.h"
 #include "audio/oalsoft/AudioCache.h"
 #include "audio/oalsoft/AudioPlayer.h"
+#include "audio/oalsoft/AudioStreamer.h"
 #include "base/std/container/unordered_map.h"
 #include "cocos/base/RefCounted.h"
 #include "cocos/base/std/any.h"
@@ -40,6 +41,13 @@ class Scheduler;
 
 #define MAX_AUDIOINSTANCES 32
 
+// Default memory budget of the audio cache in bytes, 0 for no budget.
+#if CC_PLATFORM == CC_PLATFORM_OHOS
+    #define DEFAULT_CACHE_MEMORY_BUDGET (64 * 1024 * 1024)
+#else
+    #define DEFAULT_CACHE_MEMORY_BUDGET 0
+#endif
+
 class CC_DLL AudioEngineImpl : public RefCounted {
 public:
     AudioEngineImpl();
@@ -69,6 +77,8 @@ public:
 private:
     bool checkAudioIdValid(int audioID);
     void play2dImpl(AudioCache *cache, int audioID);
+    // Uncaches the least recently used caches not in use until they fit in the memory budget.
+    void evictCaches(const AudioCache *keptCache);
 
     ALuint _alSources[MAX_AUDIOINSTANCES];
 
@@ -77,11 +87,15 @@ private:
 
     //filePath,bufferInfo
     ccstd::unordered_map<ccstd::string, AudioCache> _audioCaches;
+    uint64_t _cacheUseCount{0};
 
     //audioID,AudioInfo
     ccstd::unordered_map<int, AudioPlayer *> _audioPlayers;
     std::mutex _threadMutex;
 
+    // Refills the buffer queues of all the streaming players.
+    AudioStreamer *_streamer{nullptr};
+
     bool _lazyInitLoop;
 
     int _currentAudioID;
@@ -29,11 +29,8 @@
 #include "audio/oalsoft/AudioPlayer.h"
 #include <cstdlib>
 #include <cstring>
-#include "audio/common/decoder/AudioDecoder.h"
-#include "audio/common/decoder/AudioDecoderManager.h"
 #include "audio/oalsoft/AudioCache.h"
 #include "base/Log.h"
-#include "base/memory/Memory.h"
 
 using namespace cc; //NOLINT
 
@@ -49,9 +46,8 @@ AudioPlayer::AudioPlayer()
   _ready(false),
   _currTime(0.0F),
   _streamingSource(false),
-  _rotateBufferThread(nullptr),
   _timeDirty(false),
-  _isRotateThreadExited(false),
+  _streamer(nullptr),
   _id(++gIdIndex) {
     memset(_bufferIds, 0, sizeof(_bufferIds));
 }
@@ -66,6 +62,8 @@ AudioPlayer::~AudioPlayer() {
 }
 
 void AudioPlayer::destroy() {
+    // Only waits for a play2d in progress, the streaming stops without waiting for its decoding.
+    std::lock_guard<std::mutex> lk(_play2dMutex);
     if (_isDestroyed) {
         return;
     }
@@ -74,39 +72,10 @@ void AudioPlayer::destroy() {
 
     _isDestroyed = true;
 
-    do {
-        if (_audioCache != nullptr) {
-            if (_audioCache->_state == AudioCache::State::INITIAL) {
-                CC_LOG_INFO("AudioPlayer::destroy, id=%u, cache isn't ready!", _id);
-                break;
-            }
-
-            while (!_audioCache->_isLoadingFinished) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(5));
-            }
-        }
-
-        // Wait for play2d to be finished.
-        _play2dMutex.lock();
-        _play2dMutex.unlock();
-
-        if (_streamingSource) {
-            if (_rotateBufferThread != nullptr) {
-                while (!_isRotateThreadExited) {
-                    _sleepCondition.notify_one();
-                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
-                }
-
-                if (_rotateBufferThread->joinable()) {
-                    _rotateBufferThread->join();
-                }
-
-                delete _rotateBufferThread;
-                _rotateBufferThread = nullptr;
-                CC_LOG_DEBUG("rotateBufferThread exited!");
-            }
-        }
-    } while (false);
+    if (_stream) {
+        _stream->stop();
+        _stream.reset();
+    }
 
     CC_LOG_DEBUG("Before alSourceStop");
     alSourceStop(_alSource);
@@ -126,7 +95,7 @@ void AudioPlayer::setCache(AudioCache *cache) {
 }
 
 bool AudioPlayer::play2d() {
-    _play2dMutex.lock();
+    std::lock_guard<std::mutex> lk(_play2dMutex);
     CC_LOG_INFO("AudioPlayer::play2d, _alSource: %u, player id=%u", _alSource, _id);
 
     /*********************************************************************/
@@ -134,6 +103,10 @@ bool AudioPlayer::play2d() {
     /*********************************************************************/
     bool ret = false;
     do {
+        if (_isDestroyed) {
+            break;
+        }
+
         if (_audioCache->_state != AudioCache::State::READY) {
             CC_LOG_ERROR("alBuffer isn't ready for play!");
             break;
@@ -173,25 +146,23 @@ bool AudioPlayer::play2d() {
             _streamingSource = true;
         }
 
-        {
-            std::unique_lock<std::mutex> lk(_sleepMutex);
-            if (_isDestroyed) {
-                break;
-            }
-
-            if (_streamingSource) {
-                alSourceQueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
-                CHECK_AL_ERROR_DEBUG();
-                _rotateBufferThread = ccnew std::thread(&AudioPlayer::rotateBufferThread, this,
-                                                        _audioCache->_queBufferFrames * QUEUEBUFFER_NUM + 1);
-            } else {
-                alSourcei(_alSource, AL_BUFFER, _audioCache->_alBufferId);
-                CHECK_AL_ERROR_DEBUG();
+        if (_streamingSource) {
+            alSourceQueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
+            CHECK_AL_ERROR_DEBUG();
+            _stream = std::make_shared<AudioStreamer::Stream>(_alSource, _audioCache->_fileFullPath, _audioCache->_encodedData, _audioCache->_format, _audioCache->_sampleRate,
+                                                              _audioCache->_queBufferFrames, _audioCache->_duration, _loop);
+            if (_timeDirty) {
+                _timeDirty = false;
+                _stream->seek(_currTime);
             }
-
-            alSourcePlay(_alSource);
+            _streamer->add(_stream);
+        } else {
+            alSourcei(_alSource, AL_BUFFER, _audioCache->_alBufferId);
+            CHECK_AL_ERROR_DEBUG();
         }
 
+        alSourcePlay(_alSource);
+
         auto alError = alGetError();
         if (alError != AL_NO_ERROR) {
             ALOGE("%s:alSourcePlay error code:%x", __FUNCTION__, alError);
@@ -214,94 +185,15 @@ bool AudioPlayer::play2d() {
         _removeByAudioEngine = true;
     }
 
-    _play2dMutex.unlock();
     return ret;
 }
 
-void AudioPlayer::rotateBufferThread(int offsetFrame) {
-    char *tmpBuffer = nullptr;
-    AudioDecoder *decoder = AudioDecoderManager::createDecoder(_audioCache->_fileFullPath.c_str());
-    do {
-        BREAK_IF(decoder == nullptr || !decoder->open(_audioCache->_fileFullPath.c_str()));
-
-        uint32_t framesRead = 0;
-        const uint32_t framesToRead = _audioCache->_queBufferFrames;
-        const uint32_t bufferSize = framesToRead * decoder->getBytesPerFrame();
-        tmpBuffer = static_cast<char *>(malloc(bufferSize));
-        memset(tmpBuffer, 0, bufferSize);
-
-        if (offsetFrame != 0) {
-            decoder->seek(offsetFrame);
-        }
-
-        ALint sourceState;
-        ALint bufferProcessed = 0;
-        bool needToExitThread = false;
-
-        while (!_isDestroyed) {
-            alGetSourcei(_alSource, AL_SOURCE_STATE, &sourceState);
-            if (sourceState == AL_PLAYING) {
-                alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
-                while (bufferProcessed > 0) {
-                    bufferProcessed--;
-                    if (_timeDirty) {
-                        _timeDirty = false;
-                        offsetFrame = static_cast<int>(_currTime * decoder->getSampleRate());
-                        decoder->seek(offsetFrame);
-                    } else {
-                        _currTime += QUEUEBUFFER_TIME_STEP;
-                        if (_currTime > _audioCache->_duration) {
-                            if (_loop) {
-                                _currTime = 0.0F;
-                            } else {
-                                _currTime = _audioCache->_duration;
-                            }
-                        }
-                    }
-
-                    framesRead = decoder->readFixedFrames(framesToRead, tmpBuffer);
-
-                    if (framesRead == 0) {
-                        if (_loop) {
-                            decoder->seek(0);
-                            framesRead = decoder->readFixedFrames(framesToRead, tmpBuffer);
-                        } else {
-                            needToExitThread = true;
-                            break;
-                        }
-                    }
-
-                    ALuint bid;
-                    alSourceUnqueueBuffers(_alSource, 1, &bid);
-                    alBufferData(bid, _audioCache->_format, tmpBuffer, framesRead * decoder->getBytesPerFrame(),
-                                 decoder->getSampleRate());
-                    alSourceQueueBuffers(_alSource, 1, &bid);
-                }
-            }
-
-            std::unique_lock<std::mutex> lk(_sleepMutex);
-            if (_isDestroyed || needToExitThread) {
-                break;
-            }
-
-            _sleepCondition.wait_for(lk, std::chrono::milliseconds(75));
-        }
-
-    } while (false);
-
-    CC_LOG_INFO("Exit rotate buffer thread ...");
-    if (decoder != nullptr) {
-        decoder->close();
-    }
-    AudioDecoderManager::destroyDecoder(decoder);
-    free(tmpBuffer);
-    _isRotateThreadExited = true;
-    CC_LOG_INFO("%s exited.\n", __FUNCTION__);
-}
-
 bool AudioPlayer::setLoop(bool loop) {
     if (!_isDestroyed) {
         _loop = loop;
+        if (_stream) {
+            _stream->setLoop(loop);
+        }
         return true;
     }
 
@@ -311,9 +203,17 @@ bool AudioPlayer::setLoop(bool loop) {
 bool AudioPlayer::setTime(float time) {
     if (!_isDestroyed && time >= 0.0F && time < _audioCache->_duration) {
         _currTime = time;
-        _timeDirty = true;
+        if (_stream) {
+            _stream->seek(time);
+        } else {
+            _timeDirty = true;
+        }
 
         return true;
     }
     return false;
 }
+
+float AudioPlayer::getTime() {
+    return _stream ? _stream->getTime() : _currTime;
+}
@@ -26,10 +26,9 @@
 
 #pragma once
 
-#include <condition_variable>
 #include <functional>
+#include <memory>
 #include <mutex>
-#include <thread>
 #include "base/std/container/string.h"
 #ifdef OPENAL_PLAIN_INCLUDES
     #include <al.h>
@@ -40,6 +39,7 @@
 #elif CC_PLATFORM == CC_PLATFORM_LINUX || CC_PLATFORM == CC_PLATFORM_QNX
     #include <AL/al.h>
 #endif
+#include "audio/oalsoft/AudioStreamer.h"
 #include "base/Macros.h"
 
 namespace cc {
@@ -56,12 +56,11 @@ public:
 
     //queue buffer related stuff
     bool setTime(float time);
-    float getTime() { return _currTime; }
+    float getTime();
     bool setLoop(bool loop);
 
 protected:
     void setCache(AudioCache *cache);
-    void rotateBufferThread(int offsetFrame);
     bool play2d();
 
     AudioCache *_audioCache;
@@ -79,11 +78,9 @@ protected:
     float _currTime;
     bool _streamingSource;
     ALuint _bufferIds[3];
-    std::thread *_rotateBufferThread;
-    std::condition_variable _sleepCondition;
-    std::mutex _sleepMutex;
     bool _timeDirty;
-    bool _isRotateThreadExited;
+    AudioStreamer *_streamer;
+    std::shared_ptr<AudioStreamer::Stream> _stream;
 
     std::mutex _play2dMutex;
 
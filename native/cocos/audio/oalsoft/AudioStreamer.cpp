@@ -0,0 +1,393 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#define LOG_TAG "AudioStreamer"
+
+#include "audio/oalsoft/AudioStreamer.h"
+#include <algorithm>
+#include <chrono>
+#ifdef OPENAL_PLAIN_INCLUDES
+    #include "alext.h"
+#elif CC_PLATFORM == CC_PLATFORM_WINDOWS
+    #include "OpenalSoft/alext.h"
+#elif CC_PLATFORM == CC_PLATFORM_OHOS
+    #include "AL/alext.h"
+#elif CC_PLATFORM == CC_PLATFORM_LINUX || CC_PLATFORM == CC_PLATFORM_QNX
+    #include "AL/alext.h"
+#endif
+#include "audio/common/decoder/AudioDecoder.h"
+#include "audio/common/decoder/AudioDecoderManager.h"
+#include "audio/include/AudioEngine.h"
+#include "audio/include/AudioMacros.h"
+#include "profiler/Profiler.h"
+
+namespace cc {
+
+namespace {
+
+// The refill deadline of a stream is never shorter than this, so that a nearly completed buffer doesn't spin the thread.
+constexpr float MIN_WAIT = 0.005F;
+// Enough chunks for the buffer queues of a few dozen streams.
+constexpr size_t MAX_POOLED_BUFFERS = 64;
+
+#ifdef AL_SOFT_events
+void AL_APIENTRY onBufferCompleted(ALenum /*eventType*/, ALuint /*object*/, ALuint /*param*/, ALsizei /*length*/, const ALchar * /*message*/, void *userParam) noexcept {
+    // Called on the OpenAL event thread.
+    auto *notify = static_cast<std::function<void()> *>(userParam);
+    (*notify)();
+}
+
+bool setBufferCompletedEvents(std::function<void()> *notify) {
+    if (!alIsExtensionPresent("AL_SOFT_events")) {
+        return false;
+    }
+    auto eventControl = reinterpret_cast<LPALEVENTCONTROLSOFT>(alGetProcAddress("alEventControlSOFT"));
+    auto eventCallback = reinterpret_cast<LPALEVENTCALLBACKSOFT>(alGetProcAddress("alEventCallbackSOFT"));
+    if (!eventControl || !eventCallback) {
+        return false;
+    }
+    const ALenum types[] = {AL_EVENT_TYPE_BUFFER_COMPLETED_SOFT};
+    if (notify) {
+        eventCallback(&onBufferCompleted, notify);
+        eventControl(1, types, AL_TRUE);
+    } else {
+        eventControl(1, types, AL_FALSE);
+        eventCallback(nullptr, nullptr);
+    }
+    return alGetError() == AL_NO_ERROR;
+}
+#endif
+
+} // namespace
+
+AudioStreamer::Stream::Stream(ALuint source, const ccstd::string &filePath, const std::shared_ptr<Data> &encodedData, ALenum format, ALsizei sampleRate, uint32_t framesPerBuffer, float duration, bool loop)
+: _source(source),
+  _filePath(filePath),
+  _encodedData(encodedData),
+  _format(format),
+  _sampleRate(sampleRate),
+  _framesPerBuffer(framesPerBuffer),
+  _duration(duration),
+  _loop(loop),
+  _nextFrame(framesPerBuffer * QUEUEBUFFER_NUM) {
+    for (uint32_t i = 0; i < QUEUEBUFFER_NUM; ++i) {
+        _queuedTimes.push_back(static_cast<float>(i * framesPerBuffer) / static_cast<float>(sampleRate));
+    }
+    _nextTime = static_cast<float>(_nextFrame) / static_cast<float>(sampleRate);
+}
+
+AudioStreamer::Stream::~Stream() {
+    if (_decoder != nullptr) {
+        _decoder->close();
+        AudioDecoderManager::destroyDecoder(_decoder);
+    }
+}
+
+void AudioStreamer::Stream::stop() {
+    std::lock_guard<std::mutex> lk(_mutex);
+    _stopped = true;
+    _chunks.clear();
+}
+
+void AudioStreamer::Stream::setLoop(bool loop) {
+    std::lock_guard<std::mutex> lk(_mutex);
+    _loop = loop;
+    if (loop) {
+        // The decoder may have reached the end while the last buffers are still playing.
+        _endOfStream = false;
+    }
+}
+
+void AudioStreamer::Stream::seek(float time) {
+    std::lock_guard<std::mutex> lk(_mutex);
+    _currTime = time;
+    _seekTime = time;
+    _seekPending = true;
+    // Chunks being decoded from the previous position are dropped when the decoding completes.
+    ++_generation;
+    _chunks.clear();
+    _endOfStream = false;
+    std::fill(_queuedTimes.begin(), _queuedTimes.end(), time);
+}
+
+float AudioStreamer::Stream::getTime() {
+    std::lock_guard<std::mutex> lk(_mutex);
+    return _currTime;
+}
+
+void AudioStreamer::Signal::notify() {
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        notified = true;
+    }
+    condition.notify_one();
+}
+
+AudioStreamer::BufferPool::~BufferPool() {
+    for (const auto &buffer : buffers) {
+        CC_PROFILE_MEMORY_DEC(AudioStreamPool, static_cast<uint32_t>(buffer.capacity()));
+    }
+}
+
+ccstd::vector<char> AudioStreamer::BufferPool::acquire(uint32_t size) {
+    ccstd::vector<char> buffer;
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        if (!buffers.empty()) {
+            buffer = std::move(buffers.back());
+            buffers.pop_back();
+        }
+    }
+    CC_PROFILE_MEMORY_DEC(AudioStreamPool, static_cast<uint32_t>(buffer.capacity()));
+    buffer.resize(size);
+    return buffer;
+}
+
+void AudioStreamer::BufferPool::release(ccstd::vector<char> &&buffer) {
+    std::lock_guard<std::mutex> lk(mutex);
+    if (buffers.size() < MAX_POOLED_BUFFERS) {
+        CC_PROFILE_MEMORY_INC(AudioStreamPool, static_cast<uint32_t>(buffer.capacity()));
+        buffers.push_back(std::move(buffer));
+    }
+}
+
+AudioStreamer::AudioStreamer()
+: _signal(std::make_shared<Signal>()),
+  _pool(std::make_shared<BufferPool>()),
+  _notify([signal = _signal.get()]() { signal->notify(); }) {
+#ifdef AL_SOFT_events
+    _eventsEnabled = setBufferCompletedEvents(&_notify);
+#endif
+    CC_LOG_DEBUG("AudioStreamer: refill %s", _eventsEnabled ? "on buffer completed events" : "at buffer completion deadlines");
+    _thread = std::thread(&AudioStreamer::run, this);
+}
+
+AudioStreamer::~AudioStreamer() {
+#ifdef AL_SOFT_events
+    if (_eventsEnabled) {
+        setBufferCompletedEvents(nullptr);
+    }
+#endif
+    {
+        std::lock_guard<std::mutex> lk(_signal->mutex);
+        _running = false;
+    }
+    _signal->condition.notify_one();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+void AudioStreamer::add(const std::shared_ptr<Stream> &stream) {
+    {
+        std::lock_guard<std::mutex> lk(_signal->mutex);
+        _streams.push_back(stream);
+    }
+    _signal->notify();
+}
+
+void AudioStreamer::run() {
+    ccstd::vector<std::shared_ptr<Stream>> streams;
+    ccstd::vector<Stream *> stopped;
+
+    std::unique_lock<std::mutex> lk(_signal->mutex);
+    while (_running) {
+        _signal->notified = false;
+        streams = _streams;
+        lk.unlock();
+
+        // Buffer completed events wake the thread up, the timeout only covers missed refills.
+        float wait = _eventsEnabled ? QUEUEBUFFER_TIME_STEP * QUEUEBUFFER_NUM : QUEUEBUFFER_TIME_STEP;
+        for (const auto &stream : streams) {
+            float streamWait = wait;
+            if (!service(stream, &streamWait)) {
+                stopped.push_back(stream.get());
+            } else if (!_eventsEnabled) {
+                wait = std::min(wait, streamWait);
+            }
+        }
+        // The last references of the stopped streams may be released here, closing their decoders.
+        streams.clear();
+
+        lk.lock();
+        if (!stopped.empty()) {
+            _streams.erase(std::remove_if(_streams.begin(), _streams.end(), [&](const std::shared_ptr<Stream> &stream) {
+                               return std::find(stopped.begin(), stopped.end(), stream.get()) != stopped.end();
+                           }),
+                           _streams.end());
+            stopped.clear();
+        }
+
+        auto isNotified = [this]() { return _signal->notified || !_running; };
+        if (_streams.empty()) {
+            _signal->condition.wait(lk, isNotified);
+        } else {
+            _signal->condition.wait_for(lk, std::chrono::duration<float>(wait), isNotified);
+        }
+    }
+}
+
+bool AudioStreamer::service(const std::shared_ptr<Stream> &stream, float *wait) {
+    // AL calls on the source are made under the stream lock, so that none is made after Stream::stop returns.
+    std::lock_guard<std::mutex> lk(stream->_mutex);
+    if (stream->_stopped) {
+        return false;
+    }
+
+    ALint processed = 0;
+    alGetSourcei(stream->_source, AL_BUFFERS_PROCESSED, &processed);
+    bool refilled = false;
+    while (processed > 0 && !stream->_chunks.empty()) {
+        const auto &chunk = stream->_chunks.front();
+        ALuint buffer = 0;
+        alSourceUnqueueBuffers(stream->_source, 1, &buffer);
+        alBufferData(buffer, stream->_format, chunk.pcm.data(), static_cast<ALsizei>(chunk.pcm.size()), stream->_sampleRate);
+        alSourceQueueBuffers(stream->_source, 1, &buffer);
+        CHECK_AL_ERROR_DEBUG();
+
+        stream->_queuedTimes.pop_front();
+        stream->_queuedTimes.push_back(chunk.time);
+        _pool->release(std::move(stream->_chunks.front().pcm));
+        stream->_chunks.pop_front();
+        --processed;
+        refilled = true;
+    }
+
+    const auto queued = static_cast<ALint>(stream->_queuedTimes.size());
+    if (processed < queued) {
+        stream->_currTime = stream->_queuedTimes[processed];
+    } else if (stream->_endOfStream) {
+        stream->_currTime = stream->_duration;
+    }
+
+    ALint state = AL_STOPPED;
+    alGetSourcei(stream->_source, AL_SOURCE_STATE, &state);
+    if (refilled && state == AL_STOPPED) {
+        // The source ran out of buffers before the decoding caught up.
+        alSourcePlay(stream->_source);
+        state = AL_PLAYING;
+    }
+
+    if (!stream->_decoding && !stream->_endOfStream && stream->_chunks.size() < QUEUEBUFFER_NUM) {
+        stream->_decoding = true;
+        AudioEngine::addTask([stream, signal = _signal, pool = _pool]() {
+            decode(stream, signal, pool);
+        });
+    }
+
+    // Processed buffers left over wait for the decoding, which notifies when it completes.
+    if (state == AL_PLAYING && processed == 0) {
+        ALint offset = 0;
+        alGetSourcei(stream->_source, AL_SAMPLE_OFFSET, &offset);
+        const uint32_t remaining = stream->_framesPerBuffer - static_cast<uint32_t>(offset) % stream->_framesPerBuffer;
+        *wait = std::max(static_cast<float>(remaining) / static_cast<float>(stream->_sampleRate), MIN_WAIT);
+    }
+    return true;
+}
+
+void AudioStreamer::decode(const std::shared_ptr<Stream> &stream, const std::shared_ptr<Signal> &signal, const std::shared_ptr<BufferPool> &pool) {
+    //Note: It's in the audio thread pool, and the only task decoding this stream.
+    std::unique_lock<std::mutex> lk(stream->_mutex);
+    if (stream->_stopped) {
+        stream->_decoding = false;
+        return;
+    }
+    const uint32_t generation = stream->_generation;
+    const auto count = static_cast<uint32_t>(QUEUEBUFFER_NUM - stream->_chunks.size());
+    const bool loop = stream->_loop;
+    const bool seekPending = stream->_seekPending;
+    const float seekTime = stream->_seekTime;
+    stream->_seekPending = false;
+    lk.unlock();
+
+    auto *&decoder = stream->_decoder;
+    ccstd::vector<Stream::Chunk> chunks;
+    bool endOfStream = false;
+    do {
+        if (decoder == nullptr) {
+            decoder = AudioDecoderManager::createDecoder(stream->_filePath.c_str());
+            const auto &encoded = stream->_encodedData;
+            const bool opened = decoder != nullptr &&
+                                (encoded ? decoder->openMemory(stream->_filePath.c_str(), encoded->getBytes(), encoded->getSize())
+                                         : decoder->open(stream->_filePath.c_str()));
+            if (!opened) {
+                ALOGE("Failed to open %s for streaming", stream->_filePath.c_str());
+                AudioDecoderManager::destroyDecoder(decoder);
+                decoder = nullptr;
+                endOfStream = true;
+                break;
+            }
+            decoder->seek(stream->_nextFrame);
+        }
+
+        if (seekPending) {
+            decoder->seek(static_cast<uint32_t>(seekTime * static_cast<float>(decoder->getSampleRate())));
+            stream->_nextTime = seekTime;
+        }
+
+        const uint32_t bytesPerFrame = decoder->getBytesPerFrame();
+        const auto sampleRate = static_cast<float>(decoder->getSampleRate());
+        for (uint32_t i = 0; i < count; ++i) {
+            Stream::Chunk chunk;
+            chunk.pcm = pool->acquire(stream->_framesPerBuffer * bytesPerFrame);
+            uint32_t framesRead = decoder->readFixedFrames(stream->_framesPerBuffer, chunk.pcm.data());
+            if (framesRead == 0 && loop) {
+                decoder->seek(0);
+                stream->_nextTime = 0.F;
+                framesRead = decoder->readFixedFrames(stream->_framesPerBuffer, chunk.pcm.data());
+            }
+            if (framesRead == 0) {
+                pool->release(std::move(chunk.pcm));
+                endOfStream = true;
+                break;
+            }
+            chunk.pcm.resize(framesRead * bytesPerFrame);
+            chunk.time = stream->_nextTime;
+            stream->_nextTime += static_cast<float>(framesRead) / sampleRate;
+            chunks.push_back(std::move(chunk));
+        }
+    } while (false);
+
+    lk.lock();
+    stream->_decoding = false;
+    const bool current = !stream->_stopped && generation == stream->_generation;
+    if (current) {
+        for (auto &chunk : chunks) {
+            stream->_chunks.push_back(std::move(chunk));
+        }
+        stream->_endOfStream = endOfStream;
+    }
+    lk.unlock();
+
+    if (!current) {
+        for (auto &chunk : chunks) {
+            pool->release(std::move(chunk.pcm));
+        }
+    }
+
+    signal->notify();
+}
+
+} // namespace cc
@@ -0,0 +1,149 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "base/std/container/deque.h"
+#include "base/std/container/string.h"
+#include "base/std/container/vector.h"
+#ifdef OPENAL_PLAIN_INCLUDES
+    #include <al.h>
+#elif CC_PLATFORM == CC_PLATFORM_WINDOWS
+    #include <OpenalSoft/al.h>
+#elif CC_PLATFORM == CC_PLATFORM_OHOS
+    #include <AL/al.h>
+#elif CC_PLATFORM == CC_PLATFORM_LINUX || CC_PLATFORM == CC_PLATFORM_QNX
+    #include <AL/al.h>
+#endif
+#include "base/Data.h"
+#include "base/Macros.h"
+
+namespace cc {
+
+class AudioDecoder;
+
+/**
+ * Keeps the buffer queues of all the streamed sources filled from a single thread. Processed buffers are refilled as
+ * soon as OpenAL reports them, with the AL_SOFT_events extension when available, otherwise at the time the playing
+ * buffer is expected to complete. Decoding runs ahead on the audio thread pool, one task per stream at a time, into
+ * buffers recycled between the streams.
+ */
+class CC_DLL AudioStreamer final {
+public:
+    class CC_DLL Stream final {
+    public:
+        // The first QUEUEBUFFER_NUM buffers of the file are already queued on the source.
+        // The file is decoded from encodedData instead when it's given.
+        Stream(ALuint source, const ccstd::string &filePath, const std::shared_ptr<Data> &encodedData, ALenum format, ALsizei sampleRate, uint32_t framesPerBuffer, float duration, bool loop);
+        ~Stream();
+
+        // Stops touching the source and drops the decoded data, returns without waiting for a pending decoding.
+        void stop();
+        void setLoop(bool loop);
+        void seek(float time);
+        float getTime();
+
+    private:
+        struct Chunk {
+            ccstd::vector<char> pcm;
+            float time{0.F};
+        };
+
+        ALuint _source{0};
+        ccstd::string _filePath;
+        std::shared_ptr<Data> _encodedData;
+        ALenum _format{0};
+        ALsizei _sampleRate{0};
+        uint32_t _framesPerBuffer{0};
+        float _duration{0.F};
+
+        std::mutex _mutex;
+        // Start times of the buffers queued on the source, and of the decoded chunks waiting for a processed buffer.
+        ccstd::deque<float> _queuedTimes;
+        ccstd::deque<Chunk> _chunks;
+        float _currTime{0.F};
+        float _seekTime{0.F};
+        uint32_t _generation{0};
+        bool _loop{false};
+        bool _seekPending{false};
+        bool _decoding{false};
+        bool _endOfStream{false};
+        bool _stopped{false};
+
+        // Only used by the decoding task.
+        AudioDecoder *_decoder{nullptr};
+        uint32_t _nextFrame{0};
+        float _nextTime{0.F};
+
+        friend class AudioStreamer;
+    };
+
+    AudioStreamer();
+    ~AudioStreamer();
+
+    void add(const std::shared_ptr<Stream> &stream);
+
+private:
+    struct Signal {
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool notified{false};
+
+        void notify();
+    };
+
+    // Recycles the PCM chunks passed from the decoding tasks to the streamer thread.
+    struct BufferPool {
+        std::mutex mutex;
+        ccstd::vector<ccstd::vector<char>> buffers;
+
+        ~BufferPool();
+        ccstd::vector<char> acquire(uint32_t size);
+        void release(ccstd::vector<char> &&buffer);
+    };
+
+    void run();
+    // Returns false once the stream is stopped, otherwise the seconds until its playing buffer completes.
+    bool service(const std::shared_ptr<Stream> &stream, float *wait);
+    static void decode(const std::shared_ptr<Stream> &stream, const std::shared_ptr<Signal> &signal, const std::shared_ptr<BufferPool> &pool);
+
+    std::shared_ptr<Signal> _signal;
+    std::shared_ptr<BufferPool> _pool;
+    // Handed to the OpenAL event callback.
+    std::function<void()> _notify;
+    ccstd::vector<std::shared_ptr<Stream>> _streams;
+    bool _running{true};
+    bool _eventsEnabled{false};
+    std::thread _thread;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(AudioStreamer);
+};
+
+} // namespace cc
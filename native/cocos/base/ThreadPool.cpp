@@ -25,10 +25,14 @@
 ****************************************************************************/
 
 #include "base/ThreadPool.h"
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include "base/memory/Memory.h"
 #include "platform/StdC.h"
+#if CC_USE_JOB_SYSTEM_SCHEDULER
+    #include "base/threading/TaskScheduler.h"
+#endif
 
 #ifdef __ANDROID__
     #include <android/log.h>
@@ -98,7 +102,13 @@ LegacyThreadPool *LegacyThreadPool::newSingleThreadPool() {
 LegacyThreadPool::LegacyThreadPool(int minNum, int maxNum)
 : _minThreadNum(minNum),
   _maxThreadNum(maxNum) {
+#if CC_USE_JOB_SYSTEM_SCHEDULER
+    // no threads of its own, the IO lane of the scheduler grows by the ones this pool may use
+    _maxThreadNum = std::max({1, _minThreadNum, _maxThreadNum});
+    TaskScheduler::getInstance()->reserveIOWorkers(_maxThreadNum);
+#else
     init();
+#endif
 }
 
 // the destructor waits for all the functions in the queue to be finished
@@ -109,8 +119,13 @@ LegacyThreadPool::~LegacyThreadPool() {
 // number of idle threads
 int LegacyThreadPool::getIdleThreadNum() const {
     auto *thiz = const_cast<LegacyThreadPool *>(this);
+#if CC_USE_JOB_SYSTEM_SCHEDULER
+    std::lock_guard<std::mutex> lk(thiz->_mutex);
+    return _maxThreadNum - _initedThreadNum;
+#else
     std::lock_guard<std::mutex> lk(thiz->_idleThreadNumMutex);
     return _idleThreadNum;
+#endif
 }
 
 void LegacyThreadPool::init() {
@@ -138,6 +153,9 @@ void LegacyThreadPool::init() {
 }
 
 bool LegacyThreadPool::tryShrinkPool() {
+#if CC_USE_JOB_SYSTEM_SCHEDULER
+    return true; // the idle IO threads of the scheduler leave by themselves
+#else
     LOGD("shrink pool, _idleThreadNum = %d \n", getIdleThreadNum());
 
     auto before = std::chrono::high_resolution_clock::now();
@@ -179,6 +197,7 @@ bool LegacyThreadPool::tryShrinkPool() {
     LOGD("shrink %d threads, waste: %f seconds\n", (int)threadIDsToJoin.size(), seconds);
 
     return (_initedThreadNum <= _minThreadNum);
+#endif
 }
 
 void LegacyThreadPool::stretchPool(int count) {
@@ -211,6 +230,7 @@ void LegacyThreadPool::stretchPool(int count) {
 
 void LegacyThreadPool::pushTask(const std::function<void(int)> &runnable,
                                 TaskType type /* = DEFAULT*/) {
+#if !CC_USE_JOB_SYSTEM_SCHEDULER
     if (!_isFixedSize) {
         _idleThreadNumMutex.lock();
         int idleNum = _idleThreadNum;
@@ -229,6 +249,7 @@ void LegacyThreadPool::pushTask(const std::function<void(int)> &runnable,
             stretchPool(_stretchStep);
         }
     }
+#endif
 
     auto callback = ccnew std::function<void(int)>([runnable](int tid) {
         runnable(tid);
@@ -239,10 +260,41 @@ void LegacyThreadPool::pushTask(const std::function<void(int)> &runnable,
     task.callback = callback;
     _taskQueue.push(task);
 
+#if CC_USE_JOB_SYSTEM_SCHEDULER
+    int tid = 0;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_initedThreadNum >= _maxThreadNum) {
+            return; // a running drain task will pick it up
+        }
+        tid = _initedThreadNum++;
+    }
+    TaskScheduler::getInstance()->schedule([this, tid]() { drainTasks(tid); }, TaskPriority::IO);
+#else
     {
         std::unique_lock<std::mutex> lock(_mutex);
         _cv.notify_one();
     }
+#endif
+}
+
+void LegacyThreadPool::drainTasks(int tid) {
+    Task task;
+    while (true) {
+        while (_taskQueue.pop(task)) {
+            std::unique_ptr<std::function<void(int)>> func(
+                task.callback); // at return, delete the function even if an exception occurred
+            (*task.callback)(tid);
+        }
+
+        // pushTask enqueues before it checks _initedThreadNum, so look again under the lock before leaving
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_taskQueue.empty()) {
+            --_initedThreadNum;
+            _cv.notify_all();
+            return;
+        }
+    }
 }
 
 void LegacyThreadPool::stopAllTasks() {
@@ -320,6 +372,17 @@ void LegacyThreadPool::stop() {
 
     _isDone = true; // give the waiting threads a command to finish
 
+#if CC_USE_JOB_SYSTEM_SCHEDULER
+    {
+        // wait for the drain tasks to run the queue empty
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cv.wait(lock, [this]() { return _initedThreadNum == 0; });
+    }
+    stopAllTasks();
+    if (TaskScheduler::hasInstance()) {
+        TaskScheduler::getInstance()->reserveIOWorkers(-_maxThreadNum);
+    }
+#else
     {
         std::unique_lock<std::mutex> lock(_mutex);
         _cv.notify_all(); // stop all waiting threads
@@ -333,6 +396,7 @@ void LegacyThreadPool::stop() {
     stopAllTasks();
     _threads.clear();
     _abortFlags.clear();
+#endif
 }
 
 void LegacyThreadPool::setThread(int tid) {
@@ -38,6 +38,10 @@
 
 namespace cc {
 
+/**
+ * With the work stealing job system backend the pools own no threads, their tasks run on the IO lane of the
+ * TaskScheduler, at most getMaxThreadNum() of them at once per pool. Otherwise each pool has its own threads.
+ */
 class CC_DLL LegacyThreadPool {
 public:
     enum class TaskType {
@@ -143,6 +147,9 @@ private:
 
     void stretchPool(int count);
 
+    // runs the queued tasks on the scheduler, _initedThreadNum counts the running drains then
+    void drainTasks(int tid);
+
     ccstd::vector<std::unique_ptr<std::thread>> _threads;
     ccstd::vector<std::shared_ptr<std::atomic<bool>>> _abortFlags;
     ccstd::vector<std::shared_ptr<std::atomic<bool>>> _idleFlags;
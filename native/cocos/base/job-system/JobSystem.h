@@ -41,6 +41,14 @@ using JobToken = TBBJobToken;
 using JobGraph = TBBJobGraph;
 using JobSystem = TBBJobSystem;
 } // namespace cc
+#elif CC_USE_JOB_SYSTEM_SCHEDULER
+    #include "job-system-scheduler/SchedulerJobGraph.h"
+    #include "job-system-scheduler/SchedulerJobSystem.h"
+namespace cc {
+using JobToken = SchedulerJobToken;
+using JobGraph = SchedulerJobGraph;
+using JobSystem = SchedulerJobSystem;
+} // namespace cc
 #else
     #include "job-system-dummy/DummyJobGraph.h"
     #include "job-system-dummy/DummyJobSystem.h"
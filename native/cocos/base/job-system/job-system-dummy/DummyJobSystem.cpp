@@ -25,9 +25,18 @@
 
 #include "DummyJobSystem.h"
 #include "DummyJobGraph.h"
+#include "base/ThreadPool.h"
 
 namespace cc {
 
 DummyJobSystem *DummyJobSystem::instance = nullptr;
 
+void DummyJobSystem::dispatchBackground(std::function<void()> &&task) { //NOLINT
+    LegacyThreadPool::getDefaultThreadPool()->pushTask([task = std::move(task)](int /*tid*/) { task(); });
+}
+
+void DummyJobSystem::dispatchIO(std::function<void()> &&task) { //NOLINT
+    LegacyThreadPool::getDefaultThreadPool()->pushTask([task = std::move(task)](int /*tid*/) { task(); }, LegacyThreadPool::TaskType::IO);
+}
+
 } // namespace cc
@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <functional>
 #include "base/Macros.h"
 #include "base/memory/Memory.h"
 
@@ -55,6 +56,11 @@ public:
     explicit DummyJobSystem(uint32_t /*threadCount*/) noexcept {}
 
     inline uint32_t threadCount() const { return THREAD_COUNT; } //NOLINT
+    inline bool isWorkerThread() const { return false; }        //NOLINT
+
+    // there are no job workers, both run on the default legacy pool
+    void dispatchBackground(std::function<void()> &&task); //NOLINT
+    void dispatchIO(std::function<void()> &&task);         //NOLINT
 
 private:
     static constexpr uint32_t THREAD_COUNT = 1U; //always one
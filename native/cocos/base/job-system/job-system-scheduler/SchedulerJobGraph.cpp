@@ -0,0 +1,107 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "SchedulerJobGraph.h"
+#include <algorithm>
+
+namespace cc {
+
+void SchedulerJobGraph::makeEdge(uint32_t j1, uint32_t j2) noexcept {
+    _jobs[j1].successors.emplace_back(j2);
+    ++_jobs[j2].predecessorCount;
+}
+
+void SchedulerJobGraph::run() noexcept {
+    if (_pending || _jobs.empty()) return;
+    _pending = true;
+
+    // all counters have to be reset before the first job may finish
+    _pendingJobs.store(static_cast<uint32_t>(_jobs.size()), std::memory_order_relaxed);
+    for (auto &job : _jobs) {
+        job.pendingPredecessors.store(job.predecessorCount, std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (uint32_t id = 0U; id < static_cast<uint32_t>(_jobs.size()); ++id) {
+        if (!_jobs[id].predecessorCount) {
+            submit(id);
+        }
+    }
+}
+
+void SchedulerJobGraph::waitForAll() {
+    if (_pending) {
+        _scheduler->helpUntil([this]() {
+            return _pendingJobs.load(std::memory_order_acquire) == 0U;
+        });
+        _pending = false;
+    }
+}
+
+void SchedulerJobGraph::submit(uint32_t id) {
+    auto &job = _jobs[id];
+    if (job.func) {
+        _scheduler->schedule([this, id]() {
+            _jobs[id].func();
+            finish(id);
+        });
+        return;
+    }
+
+    const uint32_t count = job.end > job.begin ? (job.end - job.begin + job.step - 1U) / job.step : 0U;
+    if (!count) {
+        finish(id);
+        return;
+    }
+
+    // one contiguous range per worker plus one for the thread helping in waitForAll
+    const uint32_t chunkCount = std::min(count, _scheduler->getWorkerCount() + 1U);
+    job.pendingChunks.store(chunkCount, std::memory_order_relaxed);
+    for (uint32_t chunk = 0U; chunk < chunkCount; ++chunk) {
+        const uint32_t first = static_cast<uint32_t>(static_cast<uint64_t>(count) * chunk / chunkCount);
+        const uint32_t last = static_cast<uint32_t>(static_cast<uint64_t>(count) * (chunk + 1U) / chunkCount);
+        _scheduler->schedule([this, id, first, last]() {
+            auto &job = _jobs[id];
+            for (uint32_t i = first; i < last; ++i) {
+                job.indexFunc(job.begin + i * job.step);
+            }
+            if (job.pendingChunks.fetch_sub(1U, std::memory_order_acq_rel) == 1U) {
+                finish(id);
+            }
+        });
+    }
+}
+
+void SchedulerJobGraph::finish(uint32_t id) {
+    for (uint32_t successor : _jobs[id].successors) {
+        if (_jobs[successor].pendingPredecessors.fetch_sub(1U, std::memory_order_acq_rel) == 1U) {
+            submit(successor);
+        }
+    }
+    // must be the last access to the graph, the waiting thread may destroy it right after
+    _pendingJobs.fetch_sub(1U, std::memory_order_release);
+}
+
+} // namespace cc
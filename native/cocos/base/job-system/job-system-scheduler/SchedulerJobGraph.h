@@ -0,0 +1,98 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include "SchedulerJobSystem.h"
+#include "base/std/container/deque.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+class SchedulerJobGraph final {
+public:
+    explicit SchedulerJobGraph(SchedulerJobSystem *system) noexcept : _scheduler(system->_scheduler) {}
+    SchedulerJobGraph(const SchedulerJobGraph &) = delete;
+    SchedulerJobGraph(SchedulerJobGraph &&) = delete;
+    SchedulerJobGraph &operator=(const SchedulerJobGraph &) = delete;
+    SchedulerJobGraph &operator=(SchedulerJobGraph &&) = delete;
+    ~SchedulerJobGraph() { waitForAll(); } // in-flight jobs still reference the graph
+
+    template <typename Function>
+    uint32_t createJob(Function &&func) noexcept;
+
+    template <typename Function>
+    uint32_t createForEachIndexJob(uint32_t begin, uint32_t end, uint32_t step, Function &&func) noexcept;
+
+    void makeEdge(uint32_t j1, uint32_t j2) noexcept;
+
+    void run() noexcept;
+
+    // the waiting thread keeps executing frame jobs instead of blocking
+    void waitForAll();
+
+private:
+    struct Job {
+        std::function<void()> func;
+        std::function<void(uint32_t)> indexFunc; // for-each jobs only
+        uint32_t begin{0U};
+        uint32_t end{0U};
+        uint32_t step{1U};
+
+        ccstd::vector<uint32_t> successors;
+        uint32_t predecessorCount{0U};
+        std::atomic<uint32_t> pendingPredecessors{0U};
+        std::atomic<uint32_t> pendingChunks{0U};
+    };
+
+    void submit(uint32_t id);
+    void finish(uint32_t id);
+
+    TaskScheduler *_scheduler{nullptr};
+    ccstd::deque<Job> _jobs; // existing jobs cannot be invalidated
+    std::atomic<uint32_t> _pendingJobs{0U};
+    bool _pending{false};
+};
+
+template <typename Function>
+uint32_t SchedulerJobGraph::createJob(Function &&func) noexcept {
+    auto &job = _jobs.emplace_back();
+    job.func = std::forward<Function>(func);
+    return static_cast<uint32_t>(_jobs.size() - 1U);
+}
+
+template <typename Function>
+uint32_t SchedulerJobGraph::createForEachIndexJob(uint32_t begin, uint32_t end, uint32_t step, Function &&func) noexcept {
+    auto &job = _jobs.emplace_back();
+    job.indexFunc = std::forward<Function>(func);
+    job.begin = begin;
+    job.end = end;
+    job.step = step;
+    return static_cast<uint32_t>(_jobs.size() - 1U);
+}
+
+} // namespace cc
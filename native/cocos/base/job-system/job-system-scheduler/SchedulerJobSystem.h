@@ -0,0 +1,77 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/memory/Memory.h"
+#include "base/threading/TaskScheduler.h"
+
+namespace cc {
+
+using SchedulerJobToken = void;
+
+class SchedulerJobGraph;
+
+class SchedulerJobSystem final {
+public:
+    static SchedulerJobSystem *getInstance() {
+        if (!instance) {
+            instance = ccnew SchedulerJobSystem;
+        }
+        return instance;
+    }
+
+    static void destroyInstance() {
+        CC_SAFE_DELETE(instance);
+    }
+
+    // shares the workers of the engine-wide task scheduler
+    SchedulerJobSystem() noexcept;
+    // owns a private scheduler
+    explicit SchedulerJobSystem(uint32_t threadCount) noexcept;
+    ~SchedulerJobSystem();
+    SchedulerJobSystem(const SchedulerJobSystem &) = delete;
+    SchedulerJobSystem(SchedulerJobSystem &&) = delete;
+    SchedulerJobSystem &operator=(const SchedulerJobSystem &) = delete;
+    SchedulerJobSystem &operator=(SchedulerJobSystem &&) = delete;
+
+    inline uint32_t threadCount() const { return _scheduler->getWorkerCount(); }
+    inline bool isWorkerThread() const { return _scheduler->getCurrentWorkerIndex() >= 0; }
+
+    // on the BACKGROUND and IO lanes of the scheduler
+    inline void dispatchBackground(std::function<void()> &&task) { _scheduler->schedule(std::move(task), TaskPriority::BACKGROUND); }
+    inline void dispatchIO(std::function<void()> &&task) { _scheduler->schedule(std::move(task), TaskPriority::IO); }
+
+private:
+    friend class SchedulerJobGraph;
+
+    static SchedulerJobSystem *instance;
+
+    TaskScheduler *_scheduler{nullptr};
+    bool _ownsScheduler{false};
+};
+
+} // namespace cc
@@ -26,6 +26,7 @@
 #include "TFJobSystem.h"
 #include "TFJobGraph.h"
 #include "base/Log.h"
+#include "base/ThreadPool.h"
 
 namespace cc {
 
@@ -36,4 +37,12 @@ TFJobSystem::TFJobSystem(uint32_t threadCount) noexcept
     CC_LOG_INFO("Taskflow Job system initialized: %d worker threads", threadCount);
 }
 
+void TFJobSystem::dispatchBackground(std::function<void()> &&task) {
+    _executor.silent_async(std::move(task));
+}
+
+void TFJobSystem::dispatchIO(std::function<void()> &&task) {
+    LegacyThreadPool::getDefaultThreadPool()->pushTask([task = std::move(task)](int /*tid*/) { task(); }, LegacyThreadPool::TaskType::IO);
+}
+
 } // namespace cc
@@ -26,6 +26,7 @@
 #pragma once
 
 #include <algorithm>
+#include <functional>
 #include <thread>
 #include "base/memory/Memory.h"
 #include "taskflow/taskflow.hpp"
@@ -49,6 +50,12 @@ public:
     explicit TFJobSystem(uint32_t threadCount) noexcept;
 
     inline uint32_t threadCount() { return static_cast<uint32_t>(_executor.num_workers()); }
+    // jobs must not wait on nested graphs, the waiting worker would not run other tasks
+    inline bool isWorkerThread() const { return _executor.this_worker_id() >= 0; }
+
+    // background work runs on the executor, blocking work on the default legacy pool
+    void dispatchBackground(std::function<void()> &&task);
+    void dispatchIO(std::function<void()> &&task);
 
 private:
     friend class TFJobGraph;
@@ -24,6 +24,7 @@
 ****************************************************************************/
 
 #include "base/Log.h"
+#include "base/ThreadPool.h"
 
 #include "TBBJobGraph.h"
 #include "TBBJobSystem.h"
@@ -38,4 +39,16 @@ TBBJobSystem::TBBJobSystem(uint32_t threadCount) noexcept
     CC_LOG_INFO("TBB Job system initialized: %d worker threads", threadCount);
 }
 
+TBBJobSystem::~TBBJobSystem() {
+    _backgroundTasks.wait();
+}
+
+void TBBJobSystem::dispatchBackground(std::function<void()> &&task) {
+    _backgroundTasks.run(std::move(task));
+}
+
+void TBBJobSystem::dispatchIO(std::function<void()> &&task) {
+    LegacyThreadPool::getDefaultThreadPool()->pushTask([task = std::move(task)](int /*tid*/) { task(); }, LegacyThreadPool::TaskType::IO);
+}
+
 } // namespace cc
@@ -26,9 +26,12 @@
 #pragma once
 
 #include <algorithm>
+#include <functional>
 #include <thread>
 #include "base/memory/Memory.h"
 #include "tbb/global_control.h"
+#include "tbb/task_arena.h"
+#include "tbb/task_group.h"
 
 namespace cc {
 
@@ -49,13 +52,22 @@ public:
 
     TBBJobSystem() noexcept : TBBJobSystem(std::max(2u, std::thread::hardware_concurrency() - 2u)) {}
     explicit TBBJobSystem(uint32_t threadCount) noexcept;
+    // waits for the background tasks
+    ~TBBJobSystem();
 
     inline uint32_t threadCount() { return _threadCount; }
+    // slot 0 of the arena is kept for the thread that created it, the others are workers
+    inline bool isWorkerThread() const { return tbb::this_task_arena::current_thread_index() > 0; }
+
+    // background work runs on the workers, blocking work on the default legacy pool
+    void dispatchBackground(std::function<void()> &&task);
+    void dispatchIO(std::function<void()> &&task);
 
 private:
     static TBBJobSystem *_instance;
 
     tbb::global_control _control;
+    tbb::task_group _backgroundTasks;
     uint32_t _threadCount{0u};
 };
 
@@ -0,0 +1,354 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "TaskScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include "base/memory/Memory.h"
+
+namespace cc {
+
+namespace {
+// how many times an idle worker yields before going to sleep
+constexpr uint32_t IDLE_SPIN_COUNT{64U};
+constexpr uint32_t DEFAULT_MAX_IO_WORKER_COUNT{16U};
+// how long an IO thread waits for a task before leaving
+constexpr std::chrono::seconds IO_IDLE_TIMEOUT{5};
+
+thread_local TaskScheduler *tlsScheduler{nullptr};
+thread_local int32_t tlsWorkerIndex{-1};
+thread_local uint32_t tlsStealSeed{0U};
+
+uint64_t nowNanoseconds() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+} // namespace
+
+TaskScheduler *TaskScheduler::instance = nullptr;
+
+TaskScheduler *TaskScheduler::getInstance() {
+    if (!instance) {
+        instance = ccnew TaskScheduler;
+    }
+    return instance;
+}
+
+void TaskScheduler::destroyInstance() {
+    CC_SAFE_DELETE(instance);
+}
+
+TaskScheduler::TaskScheduler()
+: TaskScheduler(std::max(2U, std::max(4U, std::thread::hardware_concurrency()) - 2U), DEFAULT_MAX_IO_WORKER_COUNT) {}
+
+TaskScheduler::TaskScheduler(uint32_t workerCount, uint32_t maxIOWorkerCount)
+: _backgroundLimit(static_cast<int32_t>(std::max(1U, workerCount / 2U))),
+  _maxIOWorkerCount(std::max(1U, maxIOWorkerCount)),
+  _lastCollectTime(nowNanoseconds()) {
+    _workers.resize(workerCount);
+    for (auto &worker : _workers) {
+        worker = ccnew Worker;
+    }
+    // every deque has to exist before any worker starts stealing
+    for (uint32_t i = 0U; i < workerCount; ++i) {
+        _workers[i]->thread = std::thread([this, i]() { workerLoop(i); });
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _running.store(false, std::memory_order_release);
+    }
+    _sleepCondition.notify_all();
+    for (auto *worker : _workers) {
+        worker->thread.join();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_ioMutex);
+        _ioRunning = false;
+    }
+    _ioCondition.notify_all();
+    for (auto &thread : _ioThreads) {
+        thread.join();
+    }
+
+    // IO tasks may have spawned frame work after the workers have left
+    TaskNode *node = nullptr;
+    while ((node = findTask(-1, true)) != nullptr) {
+        execute(node, nullptr);
+    }
+
+    for (auto *worker : _workers) {
+        delete worker;
+    }
+    _workers.clear();
+}
+
+void TaskScheduler::schedule(Task &&task, TaskPriority priority) {
+    auto *node = ccnew TaskNode{std::move(task), priority};
+
+    switch (priority) {
+        case TaskPriority::IO:
+            scheduleIO(node);
+            return;
+        case TaskPriority::BACKGROUND:
+            _pendingBackgroundCount.fetch_add(1);
+            _backgroundQueue.enqueue(node);
+            break;
+        case TaskPriority::FRAME:
+        default:
+            _pendingFrameCount.fetch_add(1);
+            if (tlsScheduler == this) {
+                _workers[tlsWorkerIndex]->deque.push(node);
+            } else {
+                _frameQueue.enqueue(node);
+            }
+            break;
+    }
+
+    wakeWorker();
+}
+
+bool TaskScheduler::tryRunFrameTask() {
+    const int32_t index = getCurrentWorkerIndex();
+    TaskNode *node = findTask(index, false);
+    if (!node) {
+        return false;
+    }
+    execute(node, index < 0 ? nullptr : &_workers[index]->counters);
+    return true;
+}
+
+int32_t TaskScheduler::getCurrentWorkerIndex() const {
+    return tlsScheduler == this ? tlsWorkerIndex : -1;
+}
+
+void TaskScheduler::collectWorkerStats(ccstd::vector<WorkerStats> &out) {
+    const uint64_t now = nowNanoseconds();
+    const uint64_t elapsed = now - _lastCollectTime;
+    _lastCollectTime = now;
+
+    auto take = [elapsed](Counters &counters, WorkerStats &stats) {
+        stats.busyTime = counters.busyTime.exchange(0U, std::memory_order_relaxed);
+        stats.taskCount = counters.taskCount.exchange(0U, std::memory_order_relaxed);
+        stats.stealCount = counters.stealCount.exchange(0U, std::memory_order_relaxed);
+        stats.elapsedTime = elapsed;
+    };
+
+    out.resize(_workers.size() + 1);
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        take(_workers[i]->counters, out[i]);
+    }
+
+    auto &ioStats = out.back();
+    take(_ioCounters, ioStats);
+    std::lock_guard<std::mutex> lock(_ioMutex);
+    ioStats.elapsedTime *= std::max<size_t>(1U, _ioThreads.size() - _exitedIOThreads.size());
+}
+
+void TaskScheduler::reserveIOWorkers(int32_t count) {
+    std::lock_guard<std::mutex> lock(_ioMutex);
+    _maxIOWorkerCount = static_cast<uint32_t>(std::max(1, static_cast<int32_t>(_maxIOWorkerCount) + count));
+}
+
+void TaskScheduler::workerLoop(uint32_t index) {
+    tlsScheduler = this;
+    tlsWorkerIndex = static_cast<int32_t>(index);
+    tlsStealSeed = index + 1;
+
+    auto *counters = &_workers[index]->counters;
+    uint32_t idleSpins = 0U;
+    while (true) {
+        if (TaskNode *node = findTask(tlsWorkerIndex, true)) {
+            execute(node, counters);
+            idleSpins = 0U;
+            continue;
+        }
+
+        if (!_running.load(std::memory_order_acquire) && !hasPendingWork()) {
+            break;
+        }
+
+        if (++idleSpins < IDLE_SPIN_COUNT) {
+            std::this_thread::yield();
+            continue;
+        }
+        idleSpins = 0U;
+
+        // the pending counters are bumped before the sleeper count is read by schedule(),
+        // so checking them after registering as a sleeper can not miss a wake up.
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _sleepingCount.fetch_add(1U);
+        _sleepCondition.wait(lock, [this]() {
+            return !_running.load(std::memory_order_acquire) || hasRunnableWork();
+        });
+        _sleepingCount.fetch_sub(1U);
+    }
+
+    tlsScheduler = nullptr;
+    tlsWorkerIndex = -1;
+}
+
+void TaskScheduler::ioLoop() {
+    std::unique_lock<std::mutex> lock(_ioMutex);
+    while (true) {
+        if (!_ioTasks.empty()) {
+            TaskNode *node = _ioTasks.front();
+            _ioTasks.pop_front();
+            lock.unlock();
+            execute(node, &_ioCounters);
+            lock.lock();
+            continue;
+        }
+
+        if (!_ioRunning) {
+            break;
+        }
+
+        ++_ioIdleCount;
+        const bool timedOut = _ioCondition.wait_for(lock, IO_IDLE_TIMEOUT) == std::cv_status::timeout;
+        --_ioIdleCount;
+        if (timedOut && _ioTasks.empty() && _ioRunning) {
+            // joined by the next scheduleIO, or the destructor
+            _exitedIOThreads.push_back(std::this_thread::get_id());
+            break;
+        }
+    }
+}
+
+void TaskScheduler::joinExitedIOThreads() {
+    for (const auto id : _exitedIOThreads) {
+        auto iter = std::find_if(_ioThreads.begin(), _ioThreads.end(), [id](const std::thread &thread) { return thread.get_id() == id; });
+        iter->join();
+        _ioThreads.erase(iter);
+    }
+    _exitedIOThreads.clear();
+}
+
+void TaskScheduler::scheduleIO(TaskNode *node) {
+    std::unique_lock<std::mutex> lock(_ioMutex);
+    if (!_ioRunning) {
+        // the IO lane has already been shut down
+        lock.unlock();
+        execute(node, nullptr);
+        return;
+    }
+
+    _ioTasks.push_back(node);
+    joinExitedIOThreads();
+
+    // more queued tasks than sleeping threads: grow the lane, IO tasks block so they can't share a thread
+    if (_ioTasks.size() > _ioIdleCount && _ioThreads.size() < _maxIOWorkerCount) {
+        _ioThreads.emplace_back([this]() { ioLoop(); });
+    } else {
+        _ioCondition.notify_one();
+    }
+}
+
+void TaskScheduler::wakeWorker() {
+    if (_sleepingCount.load() > 0U) {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _sleepCondition.notify_one();
+    }
+}
+
+TaskScheduler::TaskNode *TaskScheduler::findTask(int32_t index, bool allowBackground) {
+    TaskNode *node = nullptr;
+    if (index >= 0) {
+        node = _workers[index]->deque.pop();
+    }
+    if (!node) {
+        _frameQueue.try_dequeue(node);
+    }
+    if (!node) {
+        node = steal(index);
+    }
+    if (node) {
+        _pendingFrameCount.fetch_sub(1);
+        return node;
+    }
+
+    if (allowBackground && _pendingBackgroundCount.load(std::memory_order_relaxed) > 0) {
+        // reserve a slot first so the background lane never occupies more than its share of workers
+        if (_runningBackgroundCount.fetch_add(1) < _backgroundLimit || !_running.load(std::memory_order_relaxed)) {
+            if (_backgroundQueue.try_dequeue(node)) {
+                _pendingBackgroundCount.fetch_sub(1);
+                return node;
+            }
+        }
+        _runningBackgroundCount.fetch_sub(1);
+    }
+    return nullptr;
+}
+
+TaskScheduler::TaskNode *TaskScheduler::steal(int32_t index) {
+    const auto workerCount = static_cast<uint32_t>(_workers.size());
+    if (!workerCount) {
+        return nullptr;
+    }
+
+    // start from a rotating victim so the thieves don't all hammer the same deque
+    const uint32_t start = tlsStealSeed++;
+    for (uint32_t i = 0U; i < workerCount; ++i) {
+        const uint32_t victim = (start + i) % workerCount;
+        if (static_cast<int32_t>(victim) == index) {
+            continue;
+        }
+        if (TaskNode *node = _workers[victim]->deque.steal()) {
+            if (index >= 0) {
+                _workers[index]->counters.stealCount.fetch_add(1U, std::memory_order_relaxed);
+            }
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+void TaskScheduler::execute(TaskNode *node, Counters *counters) {
+    const uint64_t begin = counters ? nowNanoseconds() : 0U;
+    node->func();
+
+    if (node->priority == TaskPriority::BACKGROUND) {
+        _runningBackgroundCount.fetch_sub(1);
+    }
+    delete node;
+
+    if (counters) {
+        counters->busyTime.fetch_add(nowNanoseconds() - begin, std::memory_order_relaxed);
+        counters->taskCount.fetch_add(1U, std::memory_order_relaxed);
+    }
+}
+
+bool TaskScheduler::hasRunnableWork() const {
+    return _pendingFrameCount.load() > 0 ||
+           (_pendingBackgroundCount.load() > 0 && _runningBackgroundCount.load() < _backgroundLimit);
+}
+
+bool TaskScheduler::hasPendingWork() const {
+    return _pendingFrameCount.load() > 0 || _pendingBackgroundCount.load() > 0;
+}
+
+} // namespace cc
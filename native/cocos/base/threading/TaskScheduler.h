@@ -0,0 +1,182 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "WorkStealingDeque.h"
+#include "base/Macros.h"
+#include "base/std/container/deque.h"
+#include "base/std/container/vector.h"
+#include "concurrentqueue/concurrentqueue.h"
+
+namespace cc {
+
+enum class TaskPriority : uint8_t {
+    FRAME,      // short CPU work the current frame waits for, e.g. job graphs
+    BACKGROUND, // CPU work that may span several frames, only a part of the workers may run it at once
+    IO,         // blocking work like file, network or audio decoding, runs on dedicated IO threads
+};
+
+/**
+ * The engine-wide task scheduler.
+ * FRAME and BACKGROUND tasks run on a fixed set of workers, each owning a lock-free work stealing deque:
+ * tasks spawned from a worker go to its own deque, tasks from other threads go to a shared injection queue,
+ * and idle workers steal from each other before going to sleep.
+ * IO tasks may block, so they run on a separate group of threads created on demand up to a limit,
+ * which keeps them from ever occupying the frame workers. IO threads idle for a while leave.
+ */
+class CC_DLL TaskScheduler final {
+public:
+    using Task = std::function<void()>;
+
+    struct WorkerStats {
+        uint64_t busyTime{0U};    // nanoseconds spent executing tasks
+        uint64_t elapsedTime{0U}; // nanoseconds since the last collection, multiplied by the thread count for the IO lane
+        uint32_t taskCount{0U};
+        uint32_t stealCount{0U};
+    };
+
+    static TaskScheduler *getInstance();
+    static void destroyInstance();
+    // Whether getInstance() has created the engine-wide scheduler, to query it without starting its threads.
+    static bool hasInstance() { return instance != nullptr; }
+
+    TaskScheduler();
+    TaskScheduler(uint32_t workerCount, uint32_t maxIOWorkerCount);
+    ~TaskScheduler();
+    TaskScheduler(const TaskScheduler &) = delete;
+    TaskScheduler(TaskScheduler &&) = delete;
+    TaskScheduler &operator=(const TaskScheduler &) = delete;
+    TaskScheduler &operator=(TaskScheduler &&) = delete;
+
+    void schedule(Task &&task, TaskPriority priority = TaskPriority::FRAME);
+
+    template <typename Function, typename... Args>
+    auto dispatchTask(TaskPriority priority, Function &&func, Args &&...args) -> std::future<decltype(func(std::forward<Args>(args)...))>;
+
+    // Runs FRAME tasks on the calling thread until `done` returns true, so waiting never idles a core.
+    template <typename Predicate>
+    void helpUntil(Predicate &&done);
+
+    // Runs at most one FRAME task on the calling thread, returns false if there was nothing to run.
+    bool tryRunFrameTask();
+
+    inline uint32_t getWorkerCount() const { return static_cast<uint32_t>(_workers.size()); }
+    inline uint32_t getMaxIOWorkerCount() const { return _maxIOWorkerCount; }
+
+    // Raises the IO thread limit by count for a client whose tasks may wait on each other, e.g. a legacy pool,
+    // so that its tasks never queue behind the ones of other clients. A negative count gives them back.
+    void reserveIOWorkers(int32_t count);
+
+    // Index of the calling thread if it is a worker of this scheduler, -1 otherwise.
+    int32_t getCurrentWorkerIndex() const;
+
+    // Gathers and resets the utilization counters: one entry per worker followed by one entry for the IO lane.
+    // Should be called from one thread only, e.g. the profiler on the main thread.
+    void collectWorkerStats(ccstd::vector<WorkerStats> &out);
+
+private:
+    struct TaskNode {
+        Task func;
+        TaskPriority priority{TaskPriority::FRAME};
+    };
+
+    struct Counters {
+        std::atomic<uint64_t> busyTime{0U};
+        std::atomic<uint32_t> taskCount{0U};
+        std::atomic<uint32_t> stealCount{0U};
+    };
+
+    struct ALIGNAS(64) Worker {
+        WorkStealingDeque<TaskNode *> deque;
+        Counters counters;
+        std::thread thread;
+    };
+
+    void workerLoop(uint32_t index);
+    void ioLoop();
+    void scheduleIO(TaskNode *node);
+    void joinExitedIOThreads();
+    void wakeWorker();
+    TaskNode *findTask(int32_t index, bool allowBackground);
+    TaskNode *steal(int32_t index);
+    void execute(TaskNode *node, Counters *counters);
+    bool hasRunnableWork() const;
+    bool hasPendingWork() const;
+
+    static TaskScheduler *instance;
+
+    ccstd::vector<Worker *> _workers;
+    moodycamel::ConcurrentQueue<TaskNode *> _frameQueue;
+    moodycamel::ConcurrentQueue<TaskNode *> _backgroundQueue;
+    std::atomic<int32_t> _pendingFrameCount{0};
+    std::atomic<int32_t> _pendingBackgroundCount{0};
+    std::atomic<int32_t> _runningBackgroundCount{0};
+    int32_t _backgroundLimit{1};
+
+    std::atomic<bool> _running{true};
+    std::atomic<uint32_t> _sleepingCount{0U};
+    std::mutex _sleepMutex;
+    std::condition_variable _sleepCondition;
+
+    ccstd::deque<TaskNode *> _ioTasks;
+    ccstd::vector<std::thread> _ioThreads;
+    ccstd::vector<std::thread::id> _exitedIOThreads;
+    std::mutex _ioMutex;
+    std::condition_variable _ioCondition;
+    Counters _ioCounters;
+    uint32_t _ioIdleCount{0U};
+    uint32_t _maxIOWorkerCount{0U};
+    bool _ioRunning{true};
+
+    uint64_t _lastCollectTime{0U};
+};
+
+template <typename Function, typename... Args>
+auto TaskScheduler::dispatchTask(TaskPriority priority, Function &&func, Args &&...args) -> std::future<decltype(func(std::forward<Args>(args)...))> {
+    using ReturnType = decltype(func(std::forward<Args>(args)...));
+    auto task = std::make_shared<std::packaged_task<ReturnType()>>(std::bind(std::forward<Function>(func), std::forward<Args>(args)...));
+    schedule([task]() { (*task)(); }, priority);
+    return task->get_future();
+}
+
+template <typename Predicate>
+void TaskScheduler::helpUntil(Predicate &&done) {
+    while (!done()) {
+        if (!tryRunFrameTask()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+} // namespace cc
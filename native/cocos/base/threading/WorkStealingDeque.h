@@ -0,0 +1,151 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "base/Macros.h"
+#include "base/memory/Memory.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+/**
+ * Chase-Lev work stealing deque (Le et al., "Correct and Efficient Work-Stealing for Weak Memory Models").
+ * The owner thread pushes and pops at the bottom, any other thread may steal from the top.
+ * T must be a pointer type, the buffer grows on demand and retired buffers are kept until destruction
+ * since a concurrent thief may still be reading from them.
+ */
+template <typename T>
+class WorkStealingDeque final {
+    static_assert(std::is_pointer<T>::value, "WorkStealingDeque only stores pointers");
+
+public:
+    explicit WorkStealingDeque(uint32_t capacity = 256) noexcept {
+        CC_ASSERT(capacity && (capacity & (capacity - 1)) == 0); // capacity must be power of 2
+        _buffer.store(ccnew Buffer(capacity), std::memory_order_relaxed);
+    }
+    ~WorkStealingDeque() {
+        delete _buffer.load(std::memory_order_relaxed);
+        for (auto *buffer : _retiredBuffers) {
+            delete buffer;
+        }
+    }
+    WorkStealingDeque(const WorkStealingDeque &) = delete;
+    WorkStealingDeque(WorkStealingDeque &&) = delete;
+    WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+    WorkStealingDeque &operator=(WorkStealingDeque &&) = delete;
+
+    // owner thread only
+    void push(T item) noexcept {
+        int64_t const b = _bottom.load(std::memory_order_relaxed);
+        int64_t const t = _top.load(std::memory_order_acquire);
+        Buffer *buffer = _buffer.load(std::memory_order_relaxed);
+        if (b - t > static_cast<int64_t>(buffer->capacity) - 1) {
+            buffer = grow(buffer, b, t);
+        }
+        buffer->store(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        _bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // owner thread only, LIFO
+    T pop() noexcept {
+        int64_t const b = _bottom.load(std::memory_order_relaxed) - 1;
+        Buffer *buffer = _buffer.load(std::memory_order_relaxed);
+        _bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = _top.load(std::memory_order_relaxed);
+
+        T item = nullptr;
+        if (t <= b) {
+            item = buffer->load(b);
+            if (t == b) {
+                // last item, race against thieves
+                if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    item = nullptr;
+                }
+                _bottom.store(b + 1, std::memory_order_relaxed);
+            }
+        } else {
+            _bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    // any thread, FIFO, returns nullptr if empty or the race is lost
+    T steal() noexcept {
+        int64_t t = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t const b = _bottom.load(std::memory_order_acquire);
+
+        T item = nullptr;
+        if (t < b) {
+            Buffer *buffer = _buffer.load(std::memory_order_acquire);
+            item = buffer->load(t);
+            if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return nullptr;
+            }
+        }
+        return item;
+    }
+
+    bool empty() const noexcept {
+        int64_t const b = _bottom.load(std::memory_order_relaxed);
+        int64_t const t = _top.load(std::memory_order_relaxed);
+        return b <= t;
+    }
+
+private:
+    struct Buffer {
+        explicit Buffer(uint32_t c) noexcept : capacity(c), mask(c - 1), items(ccnew std::atomic<T>[c]) {}
+        ~Buffer() { delete[] items; }
+
+        inline void store(int64_t i, T item) noexcept { items[i & mask].store(item, std::memory_order_relaxed); }
+        inline T load(int64_t i) const noexcept { return items[i & mask].load(std::memory_order_relaxed); }
+
+        uint32_t capacity{0};
+        int64_t mask{0};
+        std::atomic<T> *items{nullptr};
+    };
+
+    Buffer *grow(Buffer *buffer, int64_t bottom, int64_t top) {
+        auto *newBuffer = ccnew Buffer(buffer->capacity * 2);
+        for (int64_t i = top; i != bottom; ++i) {
+            newBuffer->store(i, buffer->load(i));
+        }
+        _retiredBuffers.push_back(buffer);
+        _buffer.store(newBuffer, std::memory_order_release);
+        return newBuffer;
+    }
+
+    alignas(64) std::atomic<int64_t> _top{0};
+    alignas(64) std::atomic<int64_t> _bottom{0};
+    std::atomic<Buffer *> _buffer{nullptr};
+    ccstd::vector<Buffer *> _retiredBuffers; // owner thread only
+};
+
+} // namespace cc
@@ -23,6 +23,7 @@
  THE SOFTWARE.
  ****************************************************************************/
 
+#include "3d/assets/Mesh.h"
 #include "bindings/auto/jsb_assets_auto.h"
 #include "core/assets/Material.h"
 #include "core/assets/SimpleTexture.h"
@@ -121,6 +122,96 @@ static bool js_assets_Material_registerPassesUpdatedListener(se::State &s) // NO
 }
 SE_BIND_FUNC(js_assets_Material_registerPassesUpdatedListener) // NOLINT(readability-identifier-naming)
 
+static bool js_assets_Mesh_mergeBatch(se::State &s) // NOLINT(readability-identifier-naming)
+{
+    auto *cobj = SE_THIS_OBJECT<cc::Mesh>(s);
+    SE_PRECONDITION2(cobj, false, "Invalid Native Object");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc < 2 || argc > 3) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 2);
+        return false;
+    }
+
+    bool ok = true;
+    ccstd::vector<cc::Mesh *> meshes;
+    ok &= sevalue_to_native(args[0], &meshes, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments");
+
+    // The world matrices are converted from script objects, null or undefined ones stand for no transform.
+    ccstd::vector<cc::Mat4> matrices;
+    ccstd::vector<const cc::Mat4 *> worldMatrices;
+    if (args[1].isObject() && args[1].toObject()->isArray()) {
+        uint32_t length = 0;
+        args[1].toObject()->getArrayLength(&length);
+        matrices.resize(length);
+        worldMatrices.resize(length, nullptr);
+        se::Value element;
+        for (uint32_t i = 0; i < length; ++i) {
+            if (args[1].toObject()->getArrayElement(i, &element) && element.isObject()) {
+                ok &= sevalue_to_native(element, &matrices[i], nullptr);
+                worldMatrices[i] = &matrices[i];
+            }
+        }
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+    }
+
+    bool validate = false;
+    if (argc == 3) {
+        ok &= sevalue_to_native(args[2], &validate, nullptr);
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+    }
+
+    s.rval().setBoolean(cobj->mergeBatch(meshes, worldMatrices, validate));
+    return true;
+}
+SE_BIND_FUNC(js_assets_Mesh_mergeBatch) // NOLINT(readability-identifier-naming)
+
+static bool js_assets_Mesh_buildClusters(se::State &s) // NOLINT(readability-identifier-naming)
+{
+    auto *cobj = SE_THIS_OBJECT<cc::Mesh>(s);
+    SE_PRECONDITION2(cobj, false, "Invalid Native Object");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc > 1) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+        return false;
+    }
+
+    uint32_t maxTrianglesPerCluster = 64;
+    if (argc == 1) {
+        bool ok = sevalue_to_native(args[0], &maxTrianglesPerCluster, nullptr);
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+    }
+    s.rval().setBoolean(cobj->buildClusters(maxTrianglesPerCluster));
+    return true;
+}
+SE_BIND_FUNC(js_assets_Mesh_buildClusters) // NOLINT(readability-identifier-naming)
+
+static bool js_assets_Mesh_setDataOptimizationEnabled(se::State &s) // NOLINT(readability-identifier-naming)
+{
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc != 1) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+        return false;
+    }
+
+    bool enabled = false;
+    bool ok = sevalue_to_native(args[0], &enabled, nullptr);
+    SE_PRECONDITION2(ok, false, "Error processing arguments");
+    cc::Mesh::setDataOptimizationEnabled(enabled);
+    return true;
+}
+SE_BIND_FUNC(js_assets_Mesh_setDataOptimizationEnabled) // NOLINT(readability-identifier-naming)
+
+static bool js_assets_Mesh_isDataOptimizationEnabled(se::State &s) // NOLINT(readability-identifier-naming)
+{
+    s.rval().setBoolean(cc::Mesh::isDataOptimizationEnabled());
+    return true;
+}
+SE_BIND_FUNC(js_assets_Mesh_isDataOptimizationEnabled) // NOLINT(readability-identifier-naming)
+
 bool register_all_assets_manual(se::Object *obj) // NOLINT(readability-identifier-naming)
 {
     // Get the ns
@@ -135,6 +226,13 @@ bool register_all_assets_manual(se::Object *obj) // NOLINT(readability-identifie
     __jsb_cc_SimpleTexture_proto->defineFunction("_registerListeners", _SE(js_assets_SimpleTexture_registerListeners));
     __jsb_cc_TextureBase_proto->defineFunction("_registerGFXSamplerUpdatedListener", _SE(js_assets_TextureBase_registerGFXSamplerUpdatedListener));
     __jsb_cc_Material_proto->defineFunction("_registerPassesUpdatedListener", _SE(js_assets_Material_registerPassesUpdatedListener));
+    __jsb_cc_Mesh_proto->defineFunction("mergeBatch", _SE(js_assets_Mesh_mergeBatch));
+    __jsb_cc_Mesh_proto->defineFunction("buildClusters", _SE(js_assets_Mesh_buildClusters));
+
+    se::Value meshVal;
+    nsVal.toObject()->getProperty("Mesh", &meshVal);
+    meshVal.toObject()->defineFunction("setDataOptimizationEnabled", _SE(js_assets_Mesh_setDataOptimizationEnabled));
+    meshVal.toObject()->defineFunction("isDataOptimizationEnabled", _SE(js_assets_Mesh_isDataOptimizationEnabled));
 
     return true;
 }
@@ -67,6 +67,36 @@ static bool js_audio_AudioEngine_getOriginalPCMBuffer(se::State& s) // NOLINT
 }
 SE_BIND_FUNC(js_audio_AudioEngine_getOriginalPCMBuffer)
 
+static bool js_audio_AudioEngine_getCacheMemoryBudget(se::State& s) // NOLINT
+{
+    const auto& args = s.args();
+    size_t argc = args.size();
+    if (argc == 0) {
+        s.rval().setUint32(cc::AudioEngine::getCacheMemoryBudget());
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_audio_AudioEngine_getCacheMemoryBudget)
+
+static bool js_audio_AudioEngine_setCacheMemoryBudget(se::State& s) // NOLINT
+{
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        uint32_t arg0{0}; // budget in bytes
+        ok &= sevalue_to_native(args[0], &arg0, nullptr);
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        cc::AudioEngine::setCacheMemoryBudget(arg0);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_audio_AudioEngine_setCacheMemoryBudget)
+
 bool register_all_audio_manual(se::Object* obj) // NOLINT
 {
     se::Value jsbVal;
@@ -76,5 +106,7 @@ bool register_all_audio_manual(se::Object* obj) // NOLINT
 
     audioEngineVal.toObject()->defineFunction("getPCMHeader", _SE(js_audio_AudioEngine_getPCMHeader));
     audioEngineVal.toObject()->defineFunction("getOriginalPCMBuffer", _SE(js_audio_AudioEngine_getOriginalPCMBuffer));
+    audioEngineVal.toObject()->defineFunction("getCacheMemoryBudget", _SE(js_audio_AudioEngine_getCacheMemoryBudget));
+    audioEngineVal.toObject()->defineFunction("setCacheMemoryBudget", _SE(js_audio_AudioEngine_setCacheMemoryBudget));
     return true;
 }
@@ -38,6 +38,7 @@
 #include "network/Downloader.h"
 #include "network/HttpClient.h"
 #include "platform/Image.h"
+#include "platform/ImageDecodeQueue.h"
 #include "platform/interfaces/modules/ISystem.h"
 #include "platform/interfaces/modules/ISystemWindow.h"
 #include "ui/edit-box/EditBox.h"
@@ -53,6 +54,7 @@
 using namespace cc; // NOLINT
 
 static LegacyThreadPool *gThreadPool = nullptr;
+static ImageDecodeQueue *gImageDecodeQueue = nullptr;
 
 static std::shared_ptr<cc::network::Downloader> gLocalDownloader = nullptr;
 static ccstd::unordered_map<ccstd::string, std::function<void(const ccstd::string &, unsigned char *, uint)>> gLocalDownloaderHandlers;
@@ -548,9 +550,33 @@ struct ImageInfo *createImageInfo(Image *img) {
 
     return imgInfo;
 }
+
+// {filter: 'box' | 'kaiser' | 'lanczos', srgb: boolean, premultipliedAlpha: boolean}, all optional
+MipmapGenerator::Options getMipmapOptions(se::Object *obj) {
+    MipmapGenerator::Options options;
+    se::Value tmp;
+    if (obj->getProperty("filter", &tmp) && tmp.isString()) {
+        const auto &filter = tmp.toString();
+        if (filter == "kaiser") {
+            options.filter = MipmapGenerator::Filter::KAISER;
+        } else if (filter == "lanczos") {
+            options.filter = MipmapGenerator::Filter::LANCZOS;
+        }
+    }
+    if (obj->getProperty("srgb", &tmp) && tmp.isBoolean()) {
+        options.srgb = tmp.toBoolean();
+    }
+    if (obj->getProperty("premultipliedAlpha", &tmp) && tmp.isBoolean()) {
+        options.premultipliedAlpha = tmp.toBoolean();
+    }
+    return options;
+}
 } // namespace
 
-bool jsb_global_load_image(const ccstd::string &path, const se::Value &callbackVal) { // NOLINT(readability-identifier-naming)
+bool jsb_global_load_image(const ccstd::string &path, const se::Value &callbackVal, int32_t priority, uint32_t *requestId, const ccstd::optional<MipmapGenerator::Options> &mipmaps) { // NOLINT(readability-identifier-naming)
+    if (requestId) {
+        *requestId = 0;
+    }
     if (path.empty()) {
         se::ValueArray seArgs;
         callbackVal.toObject()->call(seArgs, nullptr);
@@ -559,66 +585,54 @@ bool jsb_global_load_image(const ccstd::string &path, const se::Value &callbackV
 
     std::shared_ptr<se::Value> callbackPtr = std::make_shared<se::Value>(callbackVal);
 
-    auto initImageFunc = [path, callbackPtr](const ccstd::string &fullPath, unsigned char *imageData, int imageBytes) {
-        auto *img = ccnew Image();
+    auto initImageFunc = [path, callbackPtr, priority, mipmaps](const ccstd::string &fullPath, unsigned char *imageData, int imageBytes) -> ImageDecodeQueue::RequestId {
+        // NOTE: FileUtils::getInstance()->fullPathForFilename isn't a threadsafe method,
+        // Image::initWithImageFile will call fullPathForFilename internally which may
+        // cause thread race issues. Therefore, we get the full path of file before
+        // going into the decode queue.
+        // The callback is invoked in the cocos thread, the image is decoded to RGBA8 already.
+        auto onLoaded = [path, callbackPtr](Image *img) {
+            se::AutoHandleScope hs;
+            se::ValueArray seArgs;
+
+            if (img) {
+                ImageInfo *imgInfo = createImageInfo(img);
+                se::HandleObject retObj(se::Object::createPlainObject());
+                auto *obj = se::Object::createObjectWithClass(__jsb_cc_JSBNativeDataHolder_class);
+                auto *nativeObj = JSB_MAKE_PRIVATE_OBJECT(cc::JSBNativeDataHolder, imgInfo->data);
+                obj->setPrivateObject(nativeObj);
+                retObj->setProperty("data", se::Value(obj));
+                retObj->setProperty("width", se::Value(imgInfo->width));
+                retObj->setProperty("height", se::Value(imgInfo->height));
+
+                se::Value mipmapLevelDataSizeArr;
+                nativevalue_to_se(imgInfo->mipmapLevelDataSize, mipmapLevelDataSizeArr, nullptr);
+                retObj->setProperty("mipmapLevelDataSize", mipmapLevelDataSizeArr);
+
+                seArgs.push_back(se::Value(retObj));
 
-        gThreadPool->pushTask([=](int /*tid*/) {
-            // NOTE: FileUtils::getInstance()->fullPathForFilename isn't a threadsafe method,
-            // Image::initWithImageFile will call fullPathForFilename internally which may
-            // cause thread race issues. Therefore, we get the full path of file before
-            // going into task callback.
-            // Be careful of invoking any Cocos2d-x interface in a sub-thread.
-            bool loadSucceed = false;
-            if (fullPath.empty()) {
-                loadSucceed = img->initWithImageData(imageData, imageBytes);
-                free(imageData);
-            } else {
-                loadSucceed = img->initWithImageFile(fullPath);
-            }
-
-            ImageInfo *imgInfo = nullptr;
-            if (loadSucceed) {
-                imgInfo = createImageInfo(img);
-            }
-            auto app = CC_CURRENT_APPLICATION();
-            if (!app) {
                 delete imgInfo;
-                delete img;
-                return;
+            } else {
+                SE_REPORT_ERROR("initWithImageFile: %s failed!", path.c_str());
             }
-            auto engine = app->getEngine();
-            CC_ASSERT_NOT_NULL(engine);
-            engine->getScheduler()->performFunctionInCocosThread([=]() {
-                se::AutoHandleScope hs;
-                se::ValueArray seArgs;
+            callbackPtr->toObject()->call(seArgs, nullptr);
+        };
 
-                if (loadSucceed) {
-                    se::HandleObject retObj(se::Object::createPlainObject());
-                    auto *obj = se::Object::createObjectWithClass(__jsb_cc_JSBNativeDataHolder_class);
-                    auto *nativeObj = JSB_MAKE_PRIVATE_OBJECT(cc::JSBNativeDataHolder, imgInfo->data);
-                    obj->setPrivateObject(nativeObj);
-                    retObj->setProperty("data", se::Value(obj));
-                    retObj->setProperty("width", se::Value(imgInfo->width));
-                    retObj->setProperty("height", se::Value(imgInfo->height));
-                    
-                    se::Value mipmapLevelDataSizeArr;
-                    nativevalue_to_se(imgInfo->mipmapLevelDataSize, mipmapLevelDataSizeArr, nullptr);
-                    retObj->setProperty("mipmapLevelDataSize", mipmapLevelDataSizeArr);
-
-                    seArgs.push_back(se::Value(retObj));
-
-                    delete imgInfo;
-                } else {
-                    SE_REPORT_ERROR("initWithImageFile: %s failed!", path.c_str());
-                }
-                callbackPtr->toObject()->call(seArgs, nullptr);
-                delete img;
-            });
-        });
+        if (!gImageDecodeQueue) {
+            free(imageData);
+            return 0;
+        }
+        if (fullPath.empty()) {
+            return gImageDecodeQueue->loadData(imageData, static_cast<uint32_t>(imageBytes), priority, std::move(onLoaded), mipmaps);
+        }
+        return gImageDecodeQueue->loadFile(fullPath, priority, std::move(onLoaded), mipmaps);
     };
     size_t pos = ccstd::string::npos;
     if (path.find("http://") == 0 || path.find("https://") == 0) {
-        localDownloaderCreateTask(path, initImageFunc);
+        // the request is queued once downloaded, so it can't be cancelled before
+        localDownloaderCreateTask(path, [initImageFunc](const ccstd::string &fullPath, unsigned char *imageData, int imageBytes) {
+            initImageFunc(fullPath, imageData, imageBytes);
+        });
 
     } else if (path.find("data:") == 0 && (pos = path.find("base64,")) != ccstd::string::npos) {
         int imageBytes = 0;
@@ -631,7 +645,10 @@ bool jsb_global_load_image(const ccstd::string &path, const se::Value &callbackV
             SE_REPORT_ERROR("Decode base64 image data failed!");
             return false;
         }
-        initImageFunc("", imageData, imageBytes);
+        auto id = initImageFunc("", imageData, imageBytes);
+        if (requestId) {
+            *requestId = id;
+        }
     } else {
         ccstd::string fullPath(FileUtils::getInstance()->fullPathForFilename(path));
         if (0 == path.find("file://")) {
@@ -642,30 +659,88 @@ bool jsb_global_load_image(const ccstd::string &path, const se::Value &callbackV
             SE_REPORT_ERROR("File (%s) doesn't exist!", path.c_str());
             return false;
         }
-        initImageFunc(fullPath, nullptr, 0);
+        auto id = initImageFunc(fullPath, nullptr, 0);
+        if (requestId) {
+            *requestId = id;
+        }
     }
     return true;
 }
 
+// path, callback, priority(optional), mipmaps(optional), returns the request id to cancel it
 static bool js_loadImage(se::State &s) { // NOLINT
     const auto &args = s.args();
     size_t argc = args.size();
     CC_UNUSED bool ok = true;
-    if (argc == 2) {
+    if (argc >= 2 && argc <= 4) {
         ccstd::string path;
         ok &= sevalue_to_native(args[0], &path);
+        int32_t priority = 0;
+        if (argc >= 3 && args[2].isNumber()) {
+            ok &= sevalue_to_native(args[2], &priority);
+        }
+        ccstd::optional<MipmapGenerator::Options> mipmaps;
+        if (argc == 4 && args[3].isObject()) {
+            mipmaps = getMipmapOptions(args[3].toObject());
+        }
         SE_PRECONDITION2(ok, false, "Error processing arguments");
 
         se::Value callbackVal = args[1];
         CC_ASSERT(callbackVal.isObject());
         CC_ASSERT(callbackVal.toObject()->isFunction());
 
-        return jsb_global_load_image(path, callbackVal);
+        uint32_t requestId = 0;
+        ok = jsb_global_load_image(path, callbackVal, priority, &requestId, mipmaps);
+        s.rval().setUint32(requestId);
+        return ok;
     }
     SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 2);
     return false;
 }
 SE_BIND_FUNC(js_loadImage)
+
+// request id returned by loadImage, the callback won't be invoked
+static bool js_cancelLoadImage(se::State &s) { // NOLINT
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc == 1) {
+        uint32_t requestId = 0;
+        bool ok = sevalue_to_native(args[0], &requestId);
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        bool cancelled = requestId != 0 && gImageDecodeQueue && gImageDecodeQueue->cancel(requestId);
+        s.rval().setBoolean(cancelled);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_cancelLoadImage)
+
+// bytes of encoded and decoded data that images being loaded may hold
+static bool js_setImageMemoryBudget(se::State &s) { // NOLINT
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc == 1) {
+        uint64_t budget = 0;
+        bool ok = sevalue_to_native(args[0], &budget);
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        if (gImageDecodeQueue) {
+            gImageDecodeQueue->setMemoryBudget(budget);
+        }
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_setImageMemoryBudget)
+
+static bool js_getImageMemoryBudget(se::State &s) { // NOLINT
+    const uint64_t budget = gImageDecodeQueue ? gImageDecodeQueue->getMemoryBudget() : 0;
+    // a number rather than a BigInt
+    s.rval().setDouble(static_cast<double>(budget));
+    return true;
+}
+SE_BIND_FUNC(js_getImageMemoryBudget)
 // pixels(RGBA), width, height, fullFilePath(*.png/*.jpg)
 static bool js_saveImageData(se::State &s) { // NOLINT
     const auto &args = s.args();
@@ -1378,6 +1453,7 @@ SE_BIND_PROP_GET(JSB_process_get_argv)
 
 bool jsb_register_global_variables(se::Object *global) { // NOLINT
     gThreadPool = LegacyThreadPool::newFixedThreadPool(3);
+    gImageDecodeQueue = ccnew ImageDecodeQueue();
 
     global->defineFunction("require", _SE(require));
     global->defineFunction("requireModule", _SE(moduleRequire));
@@ -1388,6 +1464,9 @@ bool jsb_register_global_variables(se::Object *global) { // NOLINT
     __jsbObj->defineFunction("dumpNativePtrToSeObjectMap", _SE(jsc_dumpNativePtrToSeObjectMap));
 
     __jsbObj->defineFunction("loadImage", _SE(js_loadImage));
+    __jsbObj->defineFunction("cancelLoadImage", _SE(js_cancelLoadImage));
+    __jsbObj->defineFunction("setImageMemoryBudget", _SE(js_setImageMemoryBudget));
+    __jsbObj->defineFunction("getImageMemoryBudget", _SE(js_getImageMemoryBudget));
     __jsbObj->defineFunction("saveImageData", _SE(js_saveImageData));
     __jsbObj->defineFunction("openURL", _SE(JSB_openURL));
     __jsbObj->defineFunction("copyTextToClipboard", _SE(JSB_copyTextToClipboard));
@@ -1441,6 +1520,8 @@ bool jsb_register_global_variables(se::Object *global) { // NOLINT
     se::ScriptEngine::getInstance()->addBeforeCleanupHook([]() {
         delete gThreadPool;
         gThreadPool = nullptr;
+        delete gImageDecodeQueue;
+        gImageDecodeQueue = nullptr;
 
         DeferredReleasePool::clear();
     });
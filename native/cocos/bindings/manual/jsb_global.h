@@ -25,8 +25,10 @@
 
 #pragma once
 
+#include "base/std/optional.h"
 #include "bindings/jswrapper/PrivateObject.h"
 #include "jsb_global_init.h"
+#include "platform/MipmapGenerator.h"
 
 template <typename T, class... Args>
 T *jsb_override_new(Args &&...args) { // NOLINT(readability-identifier-naming)
@@ -76,4 +78,4 @@ bool jsb_set_extend_property(const char *ns, const char *clsName);
 bool jsb_run_script(const ccstd::string &filePath, se::Value *rval = nullptr);        // NOLINT(readability-identifier-naming)
 bool jsb_run_script_module(const ccstd::string &filePath, se::Value *rval = nullptr); // NOLINT(readability-identifier-naming)
 
-bool jsb_global_load_image(const ccstd::string &path, const se::Value &callbackVal); // NOLINT(readability-identifier-naming)
+bool jsb_global_load_image(const ccstd::string &path, const se::Value &callbackVal, int32_t priority = 0, uint32_t *requestId = nullptr, const ccstd::optional<cc::MipmapGenerator::Options> &mipmaps = ccstd::nullopt); // NOLINT(readability-identifier-naming)
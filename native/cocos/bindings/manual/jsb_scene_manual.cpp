@@ -26,6 +26,7 @@
 #include "jsb_scene_manual.h"
 #include "bindings/auto/jsb_scene_auto.h"
 #include "bindings/auto/jsb_gfx_auto.h"
+#include "3d/models/BakedSkinningModel.h"
 #include "core/Root.h"
 #include "core/scene-graph/Node.h"
 #include "scene/Model.h"
@@ -648,6 +649,26 @@ static bool js_scene_RenderScene_root_getter(se::State &s) { // NOLINT(readabili
 }
 SE_BIND_PROP_GET(js_scene_RenderScene_root_getter)
 
+static bool js_scene_RenderScene_parallelUpdateEnabled_getter(se::State &s) { // NOLINT(readability-identifier-naming)
+    auto *cobj = SE_THIS_OBJECT<cc::scene::RenderScene>(s);
+    SE_PRECONDITION2(cobj, false, "Invalid Native Object");
+    s.rval().setBoolean(cobj->isParallelUpdateEnabled());
+    return true;
+}
+SE_BIND_PROP_GET(js_scene_RenderScene_parallelUpdateEnabled_getter)
+
+static bool js_scene_RenderScene_parallelUpdateEnabled_setter(se::State &s) { // NOLINT(readability-identifier-naming)
+    auto *cobj = SE_THIS_OBJECT<cc::scene::RenderScene>(s);
+    SE_PRECONDITION2(cobj, false, "Invalid Native Object");
+    const auto &args = s.args();
+    bool enabled = false;
+    bool ok = sevalue_to_native(args[0], &enabled, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing new value");
+    cobj->setParallelUpdateEnabled(enabled);
+    return true;
+}
+SE_BIND_PROP_SET(js_scene_RenderScene_parallelUpdateEnabled_setter)
+
 static bool js_Model_setInstancedAttribute(se::State &s) // NOLINT(readability-identifier-naming)
 {
     auto *cobj = SE_THIS_OBJECT<cc::scene::Model>(s);
@@ -799,6 +820,64 @@ static bool js_Model_registerListeners(se::State &s) // NOLINT(readability-ident
 }
 SE_BIND_FUNC(js_Model_registerListeners) // NOLINT(readability-identifier-naming)
 
+// A baked clip is { hash: number, frames: number, joints: Record<string, Mat4[]> }, one matrix per frame and joint path.
+static bool sevalue_to_baked_clip(const se::Value &from, cc::IBakedClip *to, se::Object *ctx) // NOLINT(readability-identifier-naming)
+{
+    if (!from.isObject()) {
+        return false;
+    }
+    auto *obj = from.toObject();
+    se::Value field;
+    bool ok = obj->getProperty("hash", &field) && field.isNumber();
+    if (ok) {
+        to->hash = static_cast<ccstd::hash_t>(field.toDouble());
+    }
+    ok = ok && obj->getProperty("frames", &field) && sevalue_to_native(field, &to->frames, ctx);
+    ok = ok && obj->getProperty("joints", &field) && sevalue_to_native(field, &to->joints, ctx);
+    return ok;
+}
+
+static bool js_BakedSkinningModel_uploadBakedClip(se::State &s) // NOLINT(readability-identifier-naming)
+{
+    auto *cobj = SE_THIS_OBJECT<cc::BakedSkinningModel>(s);
+    SE_PRECONDITION2(cobj, false, "Invalid Native Object");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc == 1) {
+        auto *pool = cc::Root::getInstance()->getJointTexturePool();
+        if (args[0].isNullOrUndefined()) {
+            cobj->uploadAnimation(pool, nullptr);
+            return true;
+        }
+        cc::IBakedClip clip;
+        bool ok = sevalue_to_baked_clip(args[0], &clip, s.thisObject());
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        cobj->uploadAnimation(pool, &clip);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_BakedSkinningModel_uploadBakedClip) // NOLINT(readability-identifier-naming)
+
+static bool js_BakedSkinningModel_setFrame(se::State &s) // NOLINT(readability-identifier-naming)
+{
+    auto *cobj = SE_THIS_OBJECT<cc::BakedSkinningModel>(s);
+    SE_PRECONDITION2(cobj, false, "Invalid Native Object");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc == 1) {
+        float frame = 0.F;
+        bool ok = sevalue_to_native(args[0], &frame, s.thisObject());
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        cobj->setFrame(frame);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_BakedSkinningModel_setFrame) // NOLINT(readability-identifier-naming)
+
 static bool js_assets_MaterialInstance_registerListeners(se::State &s) // NOLINT(readability-identifier-naming)
 {
     auto *cobj = SE_THIS_OBJECT<cc::MaterialInstance>(s);
@@ -884,10 +963,15 @@ bool register_all_scene_manual(se::Object *obj) // NOLINT(readability-identifier
     __jsb_cc_scene_Pass_proto->defineProperty("blocks", _SE(js_scene_Pass_blocks_getter), nullptr);
 
     __jsb_cc_scene_RenderScene_proto->defineProperty("root", _SE(js_scene_RenderScene_root_getter), nullptr);
+    __jsb_cc_scene_RenderScene_proto->defineProperty("parallelUpdateEnabled", _SE(js_scene_RenderScene_parallelUpdateEnabled_getter),
+                                                     _SE(js_scene_RenderScene_parallelUpdateEnabled_setter));
 
     __jsb_cc_scene_Model_proto->defineFunction("_setInstancedAttribute", _SE(js_Model_setInstancedAttribute));
 
     __jsb_cc_scene_Model_proto->defineFunction("_registerListeners", _SE(js_Model_registerListeners));
+
+    __jsb_cc_BakedSkinningModel_proto->defineFunction("uploadBakedClip", _SE(js_BakedSkinningModel_uploadBakedClip));
+    __jsb_cc_BakedSkinningModel_proto->defineFunction("setFrame", _SE(js_BakedSkinningModel_setFrame));
     __jsb_cc_MaterialInstance_proto->defineFunction("_registerListeners", _SE(js_assets_MaterialInstance_registerListeners));
 
     return true;
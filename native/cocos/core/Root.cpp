@@ -25,8 +25,10 @@
 
 #include "core/Root.h"
 #include "2d/renderer/Batcher2d.h"
+#include "3d/skeletal-animation/SkeletalAnimationUtils.h"
 #include "application/ApplicationManager.h"
 #include "bindings/event/EventDispatcher.h"
+#include "core/scene-graph/Node.h"
 #include "platform/interfaces/modules/IScreen.h"
 #include "platform/interfaces/modules/ISystemWindow.h"
 #include "platform/interfaces/modules/ISystemWindowManager.h"
@@ -35,11 +37,13 @@
     #include "profiler/DebugRenderer.h"
 #endif
 #include "profiler/Profiler.h"
+#include "renderer/core/UniformArena.h"
 #include "renderer/gfx-base/GFXDevice.h"
 #include "renderer/gfx-base/GFXSwapchain.h"
 #include "renderer/pipeline/Define.h"
 #include "renderer/pipeline/GeometryRenderer.h"
 #include "renderer/pipeline/PipelineSceneData.h"
+#include "renderer/pipeline/PipelineStateManager.h"
 #include "renderer/pipeline/custom/NativePipelineTypes.h"
 #include "renderer/pipeline/custom/RenderInterfaceTypes.h"
 #include "renderer/pipeline/deferred/DeferredPipeline.h"
@@ -93,6 +97,10 @@ void Root::initialize(gfx::Swapchain * /*swapchain*/) {
     uint32_t maxJoints = (_device->getCapabilities().maxVertexUniformVectors - usedUBOVectorCount) / 3;
     maxJoints = maxJoints < 256 ? maxJoints : 256;
     pipeline::localDescriptorSetLayoutResizeMaxJoints(maxJoints);
+
+    if (UniformArena::isEnabled() && !_uniformArena) {
+        _uniformArena = ccnew UniformArena(_device);
+    }
 }
 
 render::Pipeline *Root::getCustomPipeline() const {
@@ -146,6 +154,7 @@ cc::scene::RenderWindow *Root::createRenderWindowFromSystemWindow(uint32_t windo
 }
 
 void Root::destroy() {
+    _dirtyNodeList.clear();
     destroyScenes();
     removeWindowEventListener();
     if (_pipelineRuntime) {
@@ -156,6 +165,12 @@ void Root::destroy() {
     CC_SAFE_DESTROY_NULL(_pipeline);
 
     CC_SAFE_DELETE(_batcher);
+    CC_SAFE_DELETE(_uniformArena);
+
+    if (_jointTexturePool) {
+        _jointTexturePool->clear();
+        _jointTexturePool = nullptr;
+    }
 
     for (auto *swapchain : _swapchains) {
         CC_SAFE_DELETE(swapchain);
@@ -166,6 +181,13 @@ void Root::destroy() {
     //    this.dataPoolManager.clear();
 }
 
+JointTexturePool *Root::getJointTexturePool() {
+    if (!_jointTexturePool) {
+        _jointTexturePool = ccnew JointTexturePool(_device);
+    }
+    return _jointTexturePool;
+}
+
 void Root::resize(uint32_t width, uint32_t height, uint32_t windowId) {
     for (const auto &window : _renderWindows) {
         auto *swapchain = window->getSwapchain();
@@ -390,6 +412,7 @@ void Root::frameMoveProcess(bool isNeedUpdateScene, int32_t totalFrames) {
         }
 
         if (isNeedUpdateScene) {
+            _dirtyNodeList.flush();
             for (const auto &scene : _scenes) {
                 scene->update(stamp);
             }
@@ -397,6 +420,8 @@ void Root::frameMoveProcess(bool isNeedUpdateScene, int32_t totalFrames) {
 
         CC_PROFILER_UPDATE;
     }
+    // without a flush this frame, the dirty nodes are left to the lazy path
+    _dirtyNodeList.clear();
 }
 
 void Root::frameMoveEnd() {
@@ -419,10 +444,14 @@ void Root::frameMoveEnd() {
     #endif
 
         emit<BeforeRender>();
+        if (_uniformArena != nullptr) {
+            _uniformArena->flush();
+        }
         _pipelineRuntime->render(_cameraList);
         emit<AfterRender>();
 #endif
         _device->present();
+        pipeline::PipelineStateManager::onFrameEnd();
     }
 
     if (_batcher != nullptr) {
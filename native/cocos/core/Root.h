@@ -29,6 +29,7 @@
 #include "bindings/event/EventDispatcher.h"
 #include "core/event/Event.h"
 #include "core/memop/Pool.h"
+#include "core/scene-graph/DirtyNodeList.h"
 #include "renderer/pipeline/RenderPipeline.h"
 #include "scene/DrawBatch2D.h"
 #include "scene/Light.h"
@@ -52,6 +53,8 @@ class PipelineRuntime;
 class Pipeline;
 } // namespace render
 class Batcher2d;
+class UniformArena;
+class JointTexturePool;
 
 struct CC_DLL DebugViewConfig {
     uint8_t singleMode;
@@ -245,6 +248,18 @@ public:
      */
     inline Batcher2d *getBatcher2D() const { return _batcher; }
 
+    /**
+     * @en The joint texture pool of the baked skinning models animated natively, created on first use.
+     * @zh 原生烘焙蒙皮模型使用的骨骼贴图池，首次使用时创建。
+     */
+    JointTexturePool *getJointTexturePool();
+
+    /**
+     * @en The nodes whose world transform changed this frame, flushed before the scenes are updated.
+     * @zh 本帧世界变换失效的节点，在更新场景前批量刷新。
+     */
+    inline DirtyNodeList &getDirtyNodeList() { return _dirtyNodeList; }
+
     /**
      * @zh
      * 场景列表
@@ -312,6 +327,7 @@ private:
     gfx::Device *_device{nullptr};
     gfx::Swapchain *_swapchain{nullptr};
     Batcher2d *_batcher{nullptr};
+    UniformArena *_uniformArena{nullptr};
     IntrusivePtr<scene::RenderWindow> _mainRenderWindow;
     IntrusivePtr<scene::RenderWindow> _curRenderWindow;
     IntrusivePtr<scene::RenderWindow> _tempWindow;
@@ -319,7 +335,9 @@ private:
     IntrusivePtr<pipeline::RenderPipeline> _pipeline{nullptr};
     std::unique_ptr<render::PipelineRuntime> _pipelineRuntime;
     //    IntrusivePtr<DataPoolManager>                  _dataPoolMgr;
+    IntrusivePtr<JointTexturePool> _jointTexturePool;
     ccstd::vector<IntrusivePtr<scene::RenderScene>> _scenes;
+    DirtyNodeList _dirtyNodeList;
     DebugViewConfig _debugViewConfig;
     float _cumulativeTime{0.F};
     float _frameTime{0.F};
@@ -54,7 +54,7 @@ void ImageAsset::setNativeAsset(const ccstd::any &obj) {
             const auto *imageSource = ccstd::any_cast<IMemoryImageSource>(&obj);
             if (imageSource != nullptr) {
                 _arrayBuffer = imageSource->data;
-                _data = const_cast<uint8_t *>(_arrayBuffer->getData());
+                _data = const_cast<uint8_t *>(_arrayBuffer->getData()) + imageSource->byteOffset;
                 _width = imageSource->width;
                 _height = imageSource->height;
                 _format = imageSource->format;
@@ -40,6 +40,7 @@ class Image;
  */
 struct IMemoryImageSource {
     ArrayBuffer::Ptr data;
+    uint32_t byteOffset{0}; // where the image starts in data
     bool compressed{false};
     uint32_t width{0};
     uint32_t height{0};
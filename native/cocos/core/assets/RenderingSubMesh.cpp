@@ -207,6 +207,26 @@ void RenderingSubMesh::enableVertexIdChannel(gfx::Device *device) {
     };
 }
 
+void RenderingSubMesh::setClusters(const ccstd::vector<IMeshCluster> &clusters) {
+    _clusters = clusters;
+
+    // padded with empty boxes so that the SIMD culling kernel can run over whole lanes
+    const auto count = static_cast<uint32_t>(clusters.size());
+    const uint32_t capacity = (count + 3) & ~3U;
+    for (auto &data : _clusterBounds) {
+        data.assign(capacity, 0.F);
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        const auto &cluster = clusters[i];
+        _clusterBounds[0][i] = cluster.center.x;
+        _clusterBounds[1][i] = cluster.center.y;
+        _clusterBounds[2][i] = cluster.center.z;
+        _clusterBounds[3][i] = cluster.halfExtents.x;
+        _clusterBounds[4][i] = cluster.halfExtents.y;
+        _clusterBounds[5][i] = cluster.halfExtents.z;
+    }
+}
+
 bool RenderingSubMesh::destroy() {
     for (auto *vertexBuffer : _vertexBuffers) {
         vertexBuffer->destroy();
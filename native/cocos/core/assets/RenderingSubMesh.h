@@ -28,6 +28,7 @@
 #include "3d/assets/Types.h"
 #include "base/RefCounted.h"
 #include "base/RefVector.h"
+#include "base/std/container/array.h"
 #include "base/std/variant.h"
 #include "core/TypedArray.h"
 #include "core/Types.h"
@@ -77,6 +78,35 @@ struct IFlatBuffer {
     Uint8Array buffer;
 };
 
+/**
+ * @en A range of triangles of a sub mesh with its bounds in model space, used to cull parts of large meshes
+ * @zh 子网格中的一段三角形及其模型空间包围体，用于剔除大网格的局部。
+ */
+struct IMeshCluster {
+    uint32_t firstIndex{0};
+    uint32_t indexCount{0};
+
+    /**
+     * @en The bounding box
+     * @zh 包围盒。
+     */
+    Vec3 center;
+    Vec3 halfExtents;
+
+    /**
+     * @en The radius of the bounding sphere around the box center
+     * @zh 以包围盒中心为球心的包围球半径。
+     */
+    float radius{0.F};
+
+    /**
+     * @en The normal cone, all triangles face away from the points behind it if the cutoff is less than 1
+     * @zh 法线锥，截断值小于 1 时有效。
+     */
+    Vec3 coneAxis;
+    float coneCutoff{1.F};
+};
+
 namespace gfx {
 class Buffer;
 }
@@ -184,6 +214,19 @@ public:
      */
     void enableVertexIdChannel(gfx::Device *device);
 
+    /**
+     * @en The clusters of the sub mesh in index order, empty if it isn't clustered
+     * @zh 子网格的簇，按索引顺序排列，未分簇时为空。
+     */
+    inline const ccstd::vector<IMeshCluster> &getClusters() const { return _clusters; }
+    void setClusters(const ccstd::vector<IMeshCluster> &clusters);
+
+    /**
+     * @en The cluster bounding boxes as center x, y, z and half extents x, y, z arrays, padded to a multiple of 4
+     * @zh 簇包围盒的结构数组形式，长度补齐到 4 的倍数。
+     */
+    inline const ccstd::array<ccstd::vector<float>, 6> &getClusterBounds() const { return _clusterBounds; }
+
     inline void setMesh(Mesh *mesh) { _mesh = mesh; }
     inline Mesh *getMesh() const { return _mesh; }
 
@@ -210,6 +253,9 @@ private:
 
     ccstd::optional<IGeometricInfo> _geometricInfo;
 
+    ccstd::vector<IMeshCluster> _clusters;
+    ccstd::array<ccstd::vector<float>, 6> _clusterBounds;
+
     // As gfx::InputAssemblerInfo needs the data structure, so not use IntrusivePtr.
     RefVector<gfx::Buffer *> _vertexBuffers;
 
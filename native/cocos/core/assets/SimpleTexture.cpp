@@ -27,6 +27,7 @@
 #include "core/assets/ImageAsset.h"
 #include "core/platform/Debug.h"
 #include "core/platform/Macro.h"
+#include "platform/CompressedTextureDecoder.h"
 #include "renderer/gfx-base/GFXDevice.h"
 
 namespace cc {
@@ -49,6 +50,14 @@ bool canGenerateMipmap(uint32_t w, uint32_t h) {
     return isPOT(w) && isPOT(h);
 }
 
+// Compressed formats the device can't sample are decoded to RGBA8 on upload, so that the same assets work everywhere.
+gfx::Format getSampledFormat(gfx::Device *device, gfx::Format format) {
+    if (!hasFlag(device->getFormatFeatures(format), gfx::FormatFeature::SAMPLED_TEXTURE) && CompressedTextureDecoder::isSupported(format)) {
+        return CompressedTextureDecoder::getDecodedFormat(format);
+    }
+    return format;
+}
+
 } // namespace
 
 SimpleTexture::SimpleTexture() = default;
@@ -69,7 +78,11 @@ void SimpleTexture::uploadDataWithArrayBuffer(const ArrayBuffer &source, uint32_
 }
 
 void SimpleTexture::uploadData(const uint8_t *source, uint32_t level /* = 0 */, uint32_t arrayIndex /* = 0 */) {
-    if (!_gfxTexture || _mipmapLevel <= level) {
+    uploadMipmaps(&source, level, 1, arrayIndex);
+}
+
+void SimpleTexture::uploadMipmaps(const uint8_t *const *sources, uint32_t firstLevel, uint32_t levelCount, uint32_t arrayIndex /* = 0 */) {
+    if (!_gfxTexture || _mipmapLevel <= firstLevel) {
         return;
     }
 
@@ -78,14 +91,38 @@ void SimpleTexture::uploadData(const uint8_t *source, uint32_t level /* = 0 */,
         return;
     }
 
-    gfx::BufferTextureCopy region;
-    region.texExtent.width = _textureWidth >> level;
-    region.texExtent.height = _textureHeight >> level;
-    region.texSubres.mipLevel = level;
-    region.texSubres.baseArrayLayer = arrayIndex;
+    levelCount = std::min(levelCount, _mipmapLevel - firstLevel);
+    gfx::BufferDataList buffers;
+    gfx::BufferTextureCopyList regions;
+    ccstd::vector<ccstd::vector<uint8_t>> decoded;
+    buffers.reserve(levelCount);
+    regions.reserve(levelCount);
+    for (uint32_t i = 0; i < levelCount; ++i) {
+        const uint8_t *source = sources[i];
+        if (!source) {
+            continue;
+        }
+        const uint32_t level = firstLevel + i;
+        gfx::BufferTextureCopy region;
+        region.texExtent.width = _textureWidth >> level;
+        region.texExtent.height = _textureHeight >> level;
+        region.texSubres.mipLevel = level;
+        region.texSubres.baseArrayLayer = arrayIndex;
+
+        if (_gfxTextureFormat != getGFXFormat()) {
+            const uint32_t width = std::max(region.texExtent.width, 1U);
+            const uint32_t height = std::max(region.texExtent.height, 1U);
+            auto &texels = decoded.emplace_back(width * height * 4);
+            CompressedTextureDecoder::decode(getGFXFormat(), source, width, height, texels.data());
+            source = texels.data();
+        }
+        buffers.emplace_back(source);
+        regions.emplace_back(region);
+    }
 
-    const uint8_t *buffers[1]{source};
-    gfxDevice->copyBuffersToTexture(buffers, _gfxTexture, &region, 1);
+    if (!regions.empty()) {
+        gfxDevice->copyBuffersToTexture(buffers, _gfxTexture, regions);
+    }
 }
 
 void SimpleTexture::assignImage(ImageAsset *image, uint32_t level, uint32_t arrayIndex /* = 0 */) {
@@ -135,14 +172,15 @@ void SimpleTexture::createTexture(gfx::Device *device) {
     auto flags = gfx::TextureFlagBit::NONE;
     if (_mipFilter != Filter::NONE && canGenerateMipmap(_width, _height)) {
         _mipmapLevel = getMipLevel(_width, _height);
-        if (!isUsingOfflineMipmaps() && !isCompressed()) {
+        if (!isUsingOfflineMipmaps() && !isCompressed() && !hasAllMipmapLevels()) {
             flags = gfx::TextureFlagBit::GEN_MIPMAP;
         }
     }
 
+    _gfxTextureFormat = getSampledFormat(device, getGFXFormat());
     auto textureCreateInfo = getGfxTextureCreateInfo(
         gfx::TextureUsageBit::SAMPLED | gfx::TextureUsageBit::TRANSFER_DST,
-        getGFXFormat(),
+        _gfxTextureFormat,
         _mipmapLevel,
         flags);
 
@@ -166,7 +204,7 @@ gfx::Texture *SimpleTexture::createTextureView(gfx::Device *device) {
     const uint32_t maxLevel = _maxLevel < _mipmapLevel ? _maxLevel : _mipmapLevel - 1;
     auto textureViewCreateInfo = getGfxTextureViewCreateInfo(
         _gfxTexture,
-        getGFXFormat(),
+        _gfxTextureFormat,
         _baseLevel,
         maxLevel - _baseLevel + 1);
 
@@ -102,6 +102,9 @@ public:
     void uploadDataWithArrayBuffer(const ArrayBuffer &source, uint32_t level = 0, uint32_t arrayIndex = 0);
     void uploadData(const uint8_t *source, uint32_t level = 0, uint32_t arrayIndex = 0);
 
+    // Uploads consecutive mipmap levels in one copy, the levels whose source is null are skipped.
+    void uploadMipmaps(const uint8_t *const *sources, uint32_t firstLevel, uint32_t levelCount, uint32_t arrayIndex = 0);
+
     void assignImage(ImageAsset *image, uint32_t level, uint32_t arrayIndex = 0);
 
     void checkTextureLoaded();
@@ -145,6 +148,9 @@ protected:
      */
     virtual gfx::TextureViewInfo getGfxTextureViewCreateInfo(gfx::Texture *texture, gfx::Format format, uint32_t baseLevel, uint32_t levelCount) = 0;
 
+    // Whether the data of every mipmap level is uploaded, so that the device doesn't generate them.
+    virtual bool hasAllMipmapLevels() const { return false; }
+
     void tryReset();
 
     void createTexture(gfx::Device *device);
@@ -166,6 +172,9 @@ protected:
     uint32_t _baseLevel{0};
     uint32_t _maxLevel{1000};
 
+    // The format of the GFX texture, which differs from the asset format when it is decoded on upload.
+    gfx::Format _gfxTextureFormat{gfx::Format::UNKNOWN};
+
     CC_DISALLOW_COPY_MOVE_ASSIGN(SimpleTexture);
 };
 
@@ -44,25 +44,32 @@ void Texture2D::setMipmaps(const ccstd::vector<IntrusivePtr<ImageAsset>> &value)
         _compressedImageAsset.clear();
         const auto mipmapLevelData = value[0]->getMipmapLevelDataSize();
         _compressedImageAsset.resize(mipmapLevelData.size());
-        auto *data = const_cast<unsigned char *>(value[0]->getData());
 
+        // the data of value[0] may be replaced from the scripts, so the chain is copied once
+        // into a buffer shared by the levels, each of them keeping it alive
+        uint32_t chainSize = 0;
+        for (auto size : mipmapLevelData) {
+            chainSize += size;
+        }
+        ArrayBuffer::Ptr chain = ccnew ArrayBuffer(value[0]->getData(), chainSize);
         uint32_t byteOffset = 0;
         for (uint32_t i = 0; i < mipmapLevelData.size(); ++i) {
-            auto *dstData = static_cast<unsigned char *>(malloc(mipmapLevelData[i] * sizeof(unsigned char)));
-            memcpy(dstData, data + byteOffset, mipmapLevelData[i]);
-
+            IMemoryImageSource source;
+            source.data = chain;
+            source.byteOffset = byteOffset;
+            source.width = value[0]->getWidth();
+            source.height = value[0]->getHeight();
+            source.format = value[0]->getFormat();
+            source.compressed = value[0]->isCompressed();
             _compressedImageAsset[i] = new ImageAsset();
-            _compressedImageAsset[i]->setData(dstData);
-            _compressedImageAsset[i]->setNeedFreeData(true);
-            _compressedImageAsset[i]->setWidth(value[0]->getWidth());
-            _compressedImageAsset[i]->setHeight(value[0]->getHeight());
-            _compressedImageAsset[i]->setFormat(value[0]->getFormat());
+            _compressedImageAsset[i]->setNativeAsset(source);
             _compressedImageAsset[i]->setUuid(value[0]->getUuid());
             setMipFilter(Filter::LINEAR);
             byteOffset += mipmapLevelData[i];
         }
         setMipmapParams(_compressedImageAsset);
     } else {
+        _compressedImageAsset.clear();
         setMipmapParams(value);
     }
 }
@@ -81,9 +88,7 @@ void Texture2D::setMipmapParams(const ccstd::vector<IntrusivePtr<ImageAsset>>& v
         info.maxLevel = _maxLevel;
         reset(info);
 
-        for (size_t i = 0, len = _mipmaps.size(); i < len; ++i) {
-            assignImage(_mipmaps[i], static_cast<uint32_t>(i));
-        }
+        updateMipmaps(0, 0);
 
     } else {
         ITexture2DCreateInfo info;
@@ -145,14 +150,28 @@ void Texture2D::updateMipmaps(uint32_t firstLevel, uint32_t count) {
         (count == 0 ? _mipmaps.size() : count),
         (_mipmaps.size() - firstLevel)));
 
+    // all the levels in one copy
+    ccstd::vector<const uint8_t *> sources(nUpdate);
+    for (uint32_t i = 0; i < nUpdate; ++i) {
+        sources[i] = _mipmaps[firstLevel + i]->getData();
+    }
+    uploadMipmaps(sources.data(), firstLevel, nUpdate);
+
     for (uint32_t i = 0; i < nUpdate; ++i) {
-        const uint32_t level = firstLevel + i;
-        assignImage(_mipmaps[level], level);
+        if (sources[i]) {
+            checkTextureLoaded();
+            emit<AfterAssignImage>(_mipmaps[firstLevel + i].get());
+        }
     }
 }
 
+bool Texture2D::hasAllMipmapLevels() const {
+    return _mipmaps.size() >= _mipmapLevel;
+}
+
 bool Texture2D::destroy() {
     _mipmaps.clear();
+    _compressedImageAsset.clear();
     return Super::destroy();
 }
 
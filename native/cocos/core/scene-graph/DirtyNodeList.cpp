@@ -0,0 +1,121 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "core/scene-graph/DirtyNodeList.h"
+#include "core/scene-graph/Node.h"
+
+namespace cc {
+
+DirtyNodeList::DirtyNodeList() = default;
+
+DirtyNodeList::~DirtyNodeList() {
+    clear();
+}
+
+void DirtyNodeList::add(Node *node) {
+    if (node->_inDirtyList) {
+        return;
+    }
+    node->_inDirtyList = true;
+    if (node->_depth >= _nodesByDepth.size()) {
+        _nodesByDepth.resize(node->_depth + 1);
+    }
+    _nodesByDepth[node->_depth].emplace_back(node);
+}
+
+void DirtyNodeList::pushDirtyChildren(const Node *node, uint32_t dirtyBits) {
+    for (const auto &child : node->_children) {
+        if (child->_dirtyFlag) {
+            _nextLevel.push_back({child.get(), dirtyBits});
+        }
+    }
+}
+
+void DirtyNodeList::flush() {
+    // Breadth first: every node at a level only reads the world matrix of a parent
+    // that was updated at the level above, so no node walks up its ancestors.
+    for (uint32_t depth = 0; depth < _nodesByDepth.size() || !_nextLevel.empty(); ++depth) {
+        _level.swap(_nextLevel);
+        _nextLevel.clear();
+
+        for (const Entry &entry : _level) {
+            Node *node = entry.node;
+            // A recorded node reached from a dirty ancestor is updated here, not from the list.
+            node->_inDirtyList = false;
+            const uint32_t dirtyBits = entry.parentDirtyBits | node->_dirtyFlag;
+            if (node->_dirtyFlag) {
+                node->calculateWorldTransform(dirtyBits);
+            }
+            pushDirtyChildren(node, dirtyBits);
+        }
+
+        if (depth >= _nodesByDepth.size()) {
+            continue;
+        }
+        // Indexed, add() below may grow _nodesByDepth.
+        for (size_t i = 0; i < _nodesByDepth[depth].size(); ++i) {
+            Node *node = _nodesByDepth[depth][i].get();
+            if (!node->_inDirtyList || !node->isValid()) {
+                continue;
+            }
+            if (node->_depth > depth) {
+                // Moved deeper since it was recorded, update it after its new ancestors.
+                node->_inDirtyList = false;
+                add(node);
+                continue;
+            }
+            node->_inDirtyList = false;
+            Node *parent = node->_parent;
+            if (parent && parent->_dirtyFlag) {
+                // Its dirty ancestors were not recorded, e.g. left behind by a lazy update.
+                node->updateWorldTransform();
+            } else if (node->_dirtyFlag) {
+                node->calculateWorldTransform(node->_dirtyFlag);
+            }
+            // Recorded nodes cleaned by a lazy update may still have dirty children.
+            pushDirtyChildren(node, 0);
+        }
+    }
+    _level.clear();
+    clear();
+}
+
+void DirtyNodeList::clear() {
+    for (auto &nodes : _nodesByDepth) {
+        for (const auto &node : nodes) {
+            node->_inDirtyList = false;
+        }
+        // Give back the memory of a burst of changes, e.g. a scene being loaded.
+        if (nodes.capacity() > 256 && nodes.capacity() > nodes.size() * 4) {
+            ccstd::vector<IntrusivePtr<Node>> compacted;
+            compacted.reserve(nodes.size());
+            nodes.swap(compacted);
+        } else {
+            nodes.clear();
+        }
+    }
+}
+
+} // namespace cc
@@ -0,0 +1,77 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/Ptr.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+class Node;
+
+/**
+ * @en The nodes whose world transform was invalidated since the last flush, bucketed by their depth.
+ * Only the node an invalidation starts from is recorded, its dirty descendants are reached from it.
+ * @zh 自上次刷新以来世界变换失效的节点，按层级深度分组。只记录失效的起始节点，其失效的子孙节点由它向下遍历得到。
+ */
+class DirtyNodeList final {
+public:
+    DirtyNodeList();
+    ~DirtyNodeList();
+
+    void add(Node *node);
+
+    /**
+     * @en Update the world transform of the recorded nodes and their dirty descendants level by level, then clear the list.
+     * @zh 逐层更新记录节点及其失效子孙节点的世界变换，然后清空列表。
+     */
+    void flush();
+
+    /**
+     * @en Forget the recorded nodes, they stay dirty and are updated when read.
+     * @zh 清空记录的节点，它们保持失效状态，在读取时再更新。
+     */
+    void clear();
+
+private:
+    struct Entry {
+        Node *node{nullptr};
+        // Dirty bits already applied to the parent in this flush.
+        uint32_t parentDirtyBits{0};
+    };
+
+    void pushDirtyChildren(const Node *node, uint32_t dirtyBits);
+
+    ccstd::vector<ccstd::vector<IntrusivePtr<Node>>> _nodesByDepth;
+    // Scratch for the level being updated and the one below it.
+    ccstd::vector<Entry> _level;
+    ccstd::vector<Entry> _nextLevel;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(DirtyNodeList);
+};
+
+} // namespace cc
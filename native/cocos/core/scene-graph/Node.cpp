@@ -25,6 +25,7 @@
 
 #include "core/scene-graph/Node.h"
 #include "base/StringUtil.h"
+#include "core/Root.h"
 #include "core/data/Object.h"
 #include "core/memop/CachedArray.h"
 #include "core/platform/Debug.h"
@@ -45,6 +46,8 @@ uint32_t Node::globalFlagChangeVersion{0};
 namespace {
 const ccstd::string EMPTY_NODE_NAME;
 IDGenerator idGenerator("Node");
+// Scratch of the iterative hierarchy walks. Walks nested through event listeners only pop what they pushed.
+ccstd::vector<Node *> nodeStack;
 } // namespace
 
 Node::Node() : Node(EMPTY_NODE_NAME) {
@@ -103,6 +106,7 @@ Node *Node::instantiate(Node *cloned, bool isSyncedNode) {
     //    }
     //}
     cloned->_parent = nullptr;
+    cloned->updateDepth();
     cloned->onBatchCreated(isSyncedNode);
     return cloned;
 }
@@ -465,6 +469,15 @@ void Node::updateWorldTransformRecursive(uint32_t &dirtyBits) { // NOLINT(misc-n
         parent->updateWorldTransformRecursive(dirtyBits);
     }
     dirtyBits |= currDirtyBits;
+    calculateWorldTransform(dirtyBits);
+    if (!_children.empty()) {
+        // The children are left dirty, let the next flush reach them from here.
+        addToDirtyNodeList();
+    }
+}
+
+void Node::calculateWorldTransform(uint32_t dirtyBits) {
+    const Node *parent = getParent();
     if (parent) {
         if (dirtyBits & static_cast<uint32_t>(TransformBit::POSITION)) {
             _worldPosition.transformMat4(_localPosition, parent->_worldMatrix);
@@ -518,17 +531,58 @@ Mat4 Node::getWorldRT() {
     return target;
 }
 
-void Node::invalidateChildren(TransformBit dirtyBit) { // NOLINT(misc-no-recursion)
-    auto curDirtyBit{static_cast<uint32_t>(dirtyBit)};
-    const uint32_t hasChangedFlags = getChangedFlags();
-    const uint32_t dirtyFlags = getDirtyFlag();
-    if (isValid() && (dirtyFlags & hasChangedFlags & curDirtyBit) != curDirtyBit) {
-        setDirtyFlag(dirtyFlags | curDirtyBit);
-        setChangedFlags(hasChangedFlags | curDirtyBit);
-        emit<AncestorTransformChanged>(dirtyBit);
+void Node::invalidateChildren(TransformBit dirtyBit) {
+    const auto base = nodeStack.size();
+    nodeStack.emplace_back(this);
+    while (nodeStack.size() > base) {
+        Node *node = nodeStack.back();
+        nodeStack.pop_back();
+        const TransformBit nodeDirtyBit = node == this ? dirtyBit : dirtyBit | TransformBit::POSITION;
+        auto curDirtyBit{static_cast<uint32_t>(nodeDirtyBit)};
+        const uint32_t hasChangedFlags = node->getChangedFlags();
+        const uint32_t dirtyFlags = node->getDirtyFlag();
+        if (node->isValid() && (dirtyFlags & hasChangedFlags & curDirtyBit) != curDirtyBit) {
+            node->setDirtyFlag(dirtyFlags | curDirtyBit);
+            node->setChangedFlags(hasChangedFlags | curDirtyBit);
+            node->emit<AncestorTransformChanged>(nodeDirtyBit);
+            // Reversed, so the children are visited in order as the recursion did.
+            const auto &children = node->getChildren();
+            for (auto it = children.rbegin(); it != children.rend(); ++it) {
+                nodeStack.emplace_back(it->get());
+            }
+        }
+    }
 
-        for (Node *child : getChildren()) {
-            child->invalidateChildren(dirtyBit | TransformBit::POSITION);
+    // Only the node the invalidation starts from is recorded, the flush reaches its dirty children.
+    if (_dirtyFlag && isValid()) {
+        addToDirtyNodeList();
+    }
+}
+
+void Node::addToDirtyNodeList() {
+    if (_inDirtyList) {
+        return;
+    }
+    auto *root = Root::getInstance();
+    if (root != nullptr) {
+        root->getDirtyNodeList().add(this);
+    }
+}
+
+void Node::updateDepth() {
+    const uint32_t depth = _parent ? _parent->_depth + 1 : 0;
+    if (_depth == depth) {
+        return;
+    }
+    _depth = depth;
+    const auto base = nodeStack.size();
+    nodeStack.emplace_back(this);
+    while (nodeStack.size() > base) {
+        const Node *node = nodeStack.back();
+        nodeStack.pop_back();
+        for (const auto &child : node->_children) {
+            child->_depth = node->_depth + 1;
+            nodeStack.emplace_back(child.get());
         }
     }
 }
@@ -645,6 +699,7 @@ void Node::setAngle(float val) {
 }
 
 void Node::onSetParent(Node *oldParent, bool keepWorldTransform) {
+    updateDepth();
     if (_parent) {
         if ((oldParent == nullptr || oldParent->_scene != _parent->_scene) && _parent->_scene != nullptr) {
             walk(setScene);
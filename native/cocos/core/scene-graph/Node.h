@@ -598,6 +598,10 @@ private:
 
     void inverseTransformPointRecursive(Vec3 &out) const;
     void updateWorldTransformRecursive(uint32_t &superDirtyBits);
+    // Recompute the world transform from a parent whose own one is up to date.
+    void calculateWorldTransform(uint32_t dirtyBits);
+    void updateDepth();
+    void addToDirtyNodeList();
 
     inline void notifyLocalPositionUpdated() {
         emit<LocalPositionUpdated>(_localPosition.x, _localPosition.y, _localPosition.z);
@@ -665,6 +669,12 @@ private:
 
     bool _eulerDirty{false};
 
+    // Number of ancestors, recomputed when the parent is set.
+    uint32_t _depth{0};
+    // Whether the node is recorded in the DirtyNodeList of Root.
+    bool _inDirtyList{false};
+
+    friend class DirtyNodeList;
     friend class NodeActivator;
     friend class Scene;
 
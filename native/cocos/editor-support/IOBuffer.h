@@ -207,6 +207,10 @@ public:
         _maxSize = maxSize;
     }
 
+    std::size_t getMaxSize() const {
+        return _maxSize;
+    }
+
     using fullCallback = std::function<void()>;
     void setFullCallback(fullCallback callback) {
         _fullCallback = std::move(callback);
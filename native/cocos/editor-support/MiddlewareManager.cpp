@@ -27,10 +27,45 @@
 #include <algorithm>
 #include "SeApi.h"
 #include "2d/renderer/Batcher2d.h"
+#include "base/job-system/JobSystem.h"
 #include "core/Root.h"
 
 MIDDLEWARE_BEGIN
 
+namespace {
+// skeletons are heavy, a few of them already pay for a job
+constexpr uint32_t PARALLEL_MIN_EDITORS_PER_JOB{4};
+
+template <typename Fn>
+void forEachParallel(uint32_t count, const Fn &fn) {
+    if (count == 0) {
+        return;
+    }
+    auto run = [&fn](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            fn(i);
+        }
+    };
+
+    const uint32_t maxJobCount = (count - 1) / PARALLEL_MIN_EDITORS_PER_JOB + 1;
+    const uint32_t jobCount = std::min(JobSystem::getInstance()->threadCount(), maxJobCount);
+    if (jobCount > 1) {
+        const uint32_t editorsPerJob = (count - 1) / jobCount + 1; // ceil(count / jobCount)
+        auto job = [&run, count, editorsPerJob](uint32_t index) {
+            run(index * editorsPerJob, std::min(count, (index + 1) * editorsPerJob));
+        };
+
+        JobGraph g(JobSystem::getInstance());
+        g.createForEachIndexJob(1U, jobCount, 1U, job);
+        g.run();
+        job(0U);
+        g.waitForAll();
+    } else {
+        run(0U, count);
+    }
+}
+} // namespace
+
 MiddlewareManager *MiddlewareManager::instance = nullptr;
 
 MiddlewareManager::MiddlewareManager() : _renderInfo(se::Object::TypedArrayType::UINT32),
@@ -66,6 +101,24 @@ void MiddlewareManager::clearRemoveList() {
     _removeList.clear();
 }
 
+bool MiddlewareManager::isRemoved(IMiddleware *editor) const {
+    return !_removeList.empty() && std::find(_removeList.begin(), _removeList.end(), editor) != _removeList.end();
+}
+
+void MiddlewareManager::flushPendingRenders() {
+    // resolve the pointers only now, reserving later slices may have resized the buffers
+    for (auto &pending : _pendingRenders) {
+        pending.slice.vb = pending.meshBuffer->getVB().getBuffer() + pending.slice.vbOffset;
+        pending.slice.ib = reinterpret_cast<uint16_t *>(pending.meshBuffer->getIB().getBuffer() + pending.slice.ibOffset);
+    }
+
+    const auto *pendings = _pendingRenders.data();
+    forEachParallel(static_cast<uint32_t>(_pendingRenders.size()), [pendings](uint32_t i) {
+        pendings[i].editor->fillRender(pendings[i].slice);
+    });
+    _pendingRenders.clear();
+}
+
 void MiddlewareManager::update(float dt) {
     isUpdating = true;
 
@@ -75,17 +128,28 @@ void MiddlewareManager::update(float dt) {
         attachBuffer->writeUint32(0);
     }
 
+    _parallelUpdates.clear();
     for (auto *editor : _updateList) {
-        if (!_removeList.empty()) {
-            auto removeIt = std::find(_removeList.begin(), _removeList.end(), editor);
-            if (removeIt == _removeList.end()) {
-                editor->update(dt);
-            }
+        if (isRemoved(editor)) {
+            continue;
+        }
+        if (editor->beginParallelUpdate(dt)) {
+            _parallelUpdates.push_back(editor);
         } else {
             editor->update(dt);
         }
     }
 
+    auto *const *editors = _parallelUpdates.data();
+    forEachParallel(static_cast<uint32_t>(_parallelUpdates.size()), [editors, dt](uint32_t i) {
+        editors[i]->parallelUpdate(dt);
+    });
+    // always end the updates that ran, even if an earlier one removed the editor meanwhile
+    for (auto *editor : _parallelUpdates) {
+        editor->endParallelUpdate(dt);
+    }
+    _parallelUpdates.clear();
+
     isUpdating = false;
 
     clearRemoveList();
@@ -101,17 +165,51 @@ void MiddlewareManager::render(float dt) {
 
     isRendering = true;
 
+    // Middlewares which can't tell their size up front render first, they may switch buffer pages at any time.
+    _parallelRenders.clear();
     for (auto *editor : _updateList) {
-        if (!_removeList.empty()) {
-            auto removeIt = std::find(_removeList.begin(), _removeList.end(), editor);
-            if (removeIt == _removeList.end()) {
-                editor->render(dt);
-            }
+        if (isRemoved(editor)) {
+            continue;
+        }
+        PendingRender pending;
+        int vertexFormat = 0;
+        if (editor->prepareRender(dt, vertexFormat, pending.vbSize, pending.ibSize)) {
+            pending.editor = editor;
+            pending.meshBuffer = getMeshBuffer(vertexFormat);
+            _parallelRenders.push_back(pending);
         } else {
             editor->render(dt);
         }
     }
 
+    // Then the others get their slices by a prefix sum over their sizes and fill them in parallel.
+    for (auto &pending : _parallelRenders) {
+        auto &vb = pending.meshBuffer->getVB();
+        auto &ib = pending.meshBuffer->getIB();
+        const bool overflow = vb.getMaxSize() > 0 && vb.getCurPos() + pending.vbSize > vb.getMaxSize();
+        if (overflow) {
+            // the page is uploaded when it's full, so fill it before
+            flushPendingRenders();
+        }
+        if (overflow && pending.vbSize > vb.getMaxSize()) {
+            // bigger than a page, let the middleware split it itself
+            pending.editor->render(dt);
+            continue;
+        }
+        vb.checkSpace(pending.vbSize, true);
+        ib.checkSpace(pending.ibSize, true);
+        pending.slice.uiMeshBuffer = pending.meshBuffer->getUIMeshBuffer();
+        pending.slice.vbOffset = vb.getCurPos();
+        pending.slice.ibOffset = ib.getCurPos();
+        vb.move(static_cast<int>(pending.vbSize));
+        ib.move(static_cast<int>(pending.ibSize));
+
+        pending.editor->commitRender(pending.slice);
+        _pendingRenders.push_back(pending);
+    }
+    flushPendingRenders();
+    _parallelRenders.clear();
+
     isRendering = false;
 
     for (auto it : _mbMap) {
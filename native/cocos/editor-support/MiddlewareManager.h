@@ -34,6 +34,19 @@
 
 MIDDLEWARE_BEGIN
 
+/**
+ * A range of the current MeshBuffer page reserved for one middleware.
+ */
+struct MeshBufferSlice {
+    cc::UIMeshBuffer *uiMeshBuffer{nullptr};
+    // offsets in bytes from the start of the page
+    std::size_t vbOffset{0};
+    std::size_t ibOffset{0};
+    // only valid in IMiddleware::fillRender
+    uint8_t *vb{nullptr};
+    uint16_t *ib{nullptr};
+};
+
 /**
  * All middleware must implement IMiddleware interface.
  */
@@ -43,6 +56,24 @@ public:
     virtual ~IMiddleware() = default;
     virtual void update(float dt) = 0;
     virtual void render(float dt) = 0;
+
+    /**
+     * Optional parallel update. If beginParallelUpdate returns true, parallelUpdate is called on a job system
+     * worker concurrently with other middlewares and endParallelUpdate on the main thread afterwards,
+     * otherwise update is called on the main thread.
+     */
+    virtual bool beginParallelUpdate(float /*dt*/) { return false; }
+    virtual void parallelUpdate(float /*dt*/) {}
+    virtual void endParallelUpdate(float /*dt*/) {}
+
+    /**
+     * Optional two-phase render. prepareRender returns the vertex format and the sizes in bytes it will write,
+     * or false to be rendered by render instead. commitRender sets up the draw infos for the reserved slice on
+     * the main thread, and fillRender writes the vertices and indices of the slice, possibly on a job system worker.
+     */
+    virtual bool prepareRender(float /*dt*/, int & /*vertexFormat*/, std::size_t & /*vbSize*/, std::size_t & /*ibSize*/) { return false; }
+    virtual void commitRender(const MeshBufferSlice & /*slice*/) {}
+    virtual void fillRender(const MeshBufferSlice & /*slice*/) {}
 };
 
 /**
@@ -114,12 +145,26 @@ public:
     bool isUpdating = false;
 
 private:
+    struct PendingRender {
+        IMiddleware *editor{nullptr};
+        MeshBuffer *meshBuffer{nullptr};
+        std::size_t vbSize{0};
+        std::size_t ibSize{0};
+        MeshBufferSlice slice;
+    };
+
     void clearRemoveList();
+    bool isRemoved(IMiddleware *editor) const;
+    void flushPendingRenders();
 
     ccstd::vector<IMiddleware *> _updateList;
     ccstd::vector<IMiddleware *> _removeList;
     std::map<int, MeshBuffer *> _mbMap;
 
+    ccstd::vector<IMiddleware *> _parallelUpdates;
+    ccstd::vector<PendingRender> _parallelRenders;
+    ccstd::vector<PendingRender> _pendingRenders;
+
     SharedBufferManager _renderInfo;
     SharedBufferManager _attachInfo;
 
@@ -25,6 +25,7 @@
 #include "CCFactory.h"
 #include "base/TypeDef.h"
 #include "base/memory/Memory.h"
+#include "math/MathUtil.h"
 
 USING_NS_MW; // NOLINT(google-build-using-namespace)
 
@@ -369,13 +370,11 @@ void ArmatureCache::traverseArmature(Armature *armature, float parentOpacity /*=
         middleware::Triangles &triangles = slot->triangles;
         middleware::V3F_T2F_C4B *worldTriangles = slot->worldVerts;
 
-        for (int v = 0, w = 0, vn = triangles.vertCount; v < vn; ++v, w += 2) {
-            middleware::V3F_T2F_C4B *vertex = triangles.verts + v;
+        // z of the slot vertices is treated as 0
+        cc::MathUtil::transformPositions(worldMatrix->m, triangles.verts, sizeof(middleware::V3F_T2F_C4B),
+                                         worldTriangles, sizeof(middleware::V3F_T2F_C4B), triangles.vertCount, true);
+        for (int v = 0, vn = triangles.vertCount; v < vn; ++v) {
             middleware::V3F_T2F_C4B *worldVertex = worldTriangles + v;
-
-            vertex->vertex.z = 0; //reset for z value
-            worldVertex->vertex.transformMat4(vertex->vertex, *worldMatrix);
-
             worldVertex->color.r = color.r;
             worldVertex->color.g = color.g;
             worldVertex->color.b = color.b;
@@ -32,6 +32,7 @@
 #include "dragonbones-creator-support/CCSlot.h"
 #include "gfx-base/GFXDef.h"
 #include "math/Math.h"
+#include "math/MathUtil.h"
 #include "math/Vec3.h"
 #include "renderer/core/MaterialInstance.h"
 
@@ -324,14 +325,11 @@ void CCArmatureDisplay::traverseArmature(Armature *armature, float parentOpacity
 
         middleware::V3F_T2F_C4B *worldTriangles = slot->worldVerts;
 
-        for (int v = 0, w = 0, vn = triangles.vertCount; v < vn; ++v, w += 2) {
-            middleware::V3F_T2F_C4B *vertex = triangles.verts + v;
-            middleware::V3F_T2F_C4B *worldVertex = worldTriangles + v;
-
-            vertex->vertex.z = 0; //reset for z value
-            worldVertex->vertex.transformMat4(vertex->vertex, *worldMatrix);
-
-            worldVertex->color = color;
+        // z of the slot vertices is treated as 0
+        cc::MathUtil::transformPositions(worldMatrix->m, triangles.verts, sizeof(middleware::V3F_T2F_C4B),
+                                         worldTriangles, sizeof(middleware::V3F_T2F_C4B), triangles.vertCount, true);
+        for (int v = 0, vn = triangles.vertCount; v < vn; ++v) {
+            worldTriangles[v].color = color;
         }
 
         // Fill MiddlewareManager vertex buffer
@@ -131,6 +131,35 @@ void SkeletonAnimation::update(float deltaTime) {
     }
 }
 
+bool SkeletonAnimation::beginParallelUpdate(float /*deltaTime*/) {
+    if (!_skeleton || _paused) return false;
+    // a skeleton passed in by initWithSkeleton may be shared with other instances, which update it serially
+    if (!_ownsSkeleton) return false;
+    // Listeners may call into script, so the events are queued and raised on the main thread in endParallelUpdate.
+    _queueDisabledByUser = _state->isQueueDisabled();
+    _state->disableQueue();
+    return true;
+}
+
+void SkeletonAnimation::parallelUpdate(float deltaTime) {
+    deltaTime *= _timeScale * GlobalTimeScale;
+    if (_ownsSkeleton) _skeleton->update(deltaTime);
+    _state->update(deltaTime);
+    _state->apply(*_skeleton);
+    _skeleton->updateWorldTransform();
+}
+
+void SkeletonAnimation::endParallelUpdate(float /*deltaTime*/) {
+    if (_queueDisabledByUser) return;
+    _state->enableQueue();
+    // The listeners run after the pose was applied. Bones they set directly show up in this frame,
+    // but tracks they set or change are only applied by the next update, one frame later than in update().
+    // The state is not applied again here, that would raise the events of the event timelines twice.
+    if (_state->drainQueue()) {
+        _skeleton->updateWorldTransform();
+    }
+}
+
 void SkeletonAnimation::setAnimationStateData(AnimationStateData *stateData) {
     CC_ASSERT(stateData);
 
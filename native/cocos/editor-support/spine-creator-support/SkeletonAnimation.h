@@ -51,6 +51,9 @@ public:
     static void setGlobalTimeScale(float timeScale);
 
     virtual void update(float deltaTime) override;
+    bool beginParallelUpdate(float deltaTime) override;
+    void parallelUpdate(float deltaTime) override;
+    void endParallelUpdate(float deltaTime) override;
 
     void setAnimationStateData(AnimationStateData *stateData);
     void setMix(const std::string &fromAnimation, const std::string &toAnimation, float duration);
@@ -100,6 +103,7 @@ protected:
     DisposeListener _disposeListener = nullptr;
     CompleteListener _completeListener = nullptr;
     EventListener _eventListener = nullptr;
+    bool _queueDisabledByUser = false;
 
 private:
     typedef SkeletonRenderer super;
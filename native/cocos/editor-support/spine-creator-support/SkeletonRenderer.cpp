@@ -39,6 +39,7 @@
 #include "base/memory/Memory.h"
 #include "gfx-base/GFXDef.h"
 #include "math/Math.h"
+#include "math/MathUtil.h"
 #include "math/Vec3.h"
 #include "renderer/core/MaterialInstance.h"
 #include "spine-creator-support/AttachmentVertices.h"
@@ -256,15 +257,42 @@ void SkeletonRenderer::initWithBinaryFile(const std::string &skeletonDataFile, c
     initialize();
 }
 
-void SkeletonRenderer::render(float /*deltaTime*/) {
+void SkeletonRenderer::render(float deltaTime) {
     if (!_skeleton) return;
+    auto *mgr = MiddlewareManager::getInstance();
+
+    // The common case is written by the two-phase render, when it fits in the current page.
+    int format = 0;
+    std::size_t sliceVBSize = 0;
+    std::size_t sliceIBSize = 0;
+    if (prepareRender(deltaTime, format, sliceVBSize, sliceIBSize)) {
+        cc::middleware::MeshBuffer *mb = mgr->getMeshBuffer(format);
+        cc::middleware::IOBuffer &vb = mb->getVB();
+        cc::middleware::IOBuffer &ib = mb->getIB();
+        if (vb.getMaxSize() == 0 || vb.getCurPos() + sliceVBSize <= vb.getMaxSize()) {
+            vb.checkSpace(sliceVBSize, true);
+            ib.checkSpace(sliceIBSize, true);
+            cc::middleware::MeshBufferSlice slice;
+            slice.uiMeshBuffer = mb->getUIMeshBuffer();
+            slice.vbOffset = vb.getCurPos();
+            slice.ibOffset = ib.getCurPos();
+            vb.move(static_cast<int>(sliceVBSize));
+            ib.move(static_cast<int>(sliceIBSize));
+
+            commitRender(slice);
+            slice.vb = vb.getBuffer() + slice.vbOffset;
+            slice.ib = reinterpret_cast<uint16_t *>(ib.getBuffer() + slice.ibOffset);
+            fillRender(slice);
+            return;
+        }
+    }
+
     auto *entity = _entity;
     entity->clearDynamicRenderDrawInfos();
     _sharedBufferOffset->reset();
     _sharedBufferOffset->clear();
 
     // avoid other place call update.
-    auto *mgr = MiddlewareManager::getInstance();
     if (!mgr->isRendering) return;
 
     auto *attachMgr = mgr->getAttachInfoMgr();
@@ -305,8 +333,6 @@ void SkeletonRenderer::render(float /*deltaTime*/) {
     unsigned int vbSize = 0;
     unsigned int ibSize = 0;
 
-    int curBlendSrc = -1;
-    int curBlendDst = -1;
     int curBlendMode = -1;
     int preBlendMode = -1;
     uint32_t curISegLen = 0;
@@ -335,24 +361,7 @@ void SkeletonRenderer::render(float /*deltaTime*/) {
         entity->addDynamicRenderDrawInfo(curDrawInfo);
         // prepare to fill new segment field
         curBlendMode = slot->getData().getBlendMode();
-        switch (curBlendMode) {
-            case BlendMode_Additive:
-                curBlendSrc = static_cast<int>(_premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA);
-                curBlendDst = static_cast<int>(BlendFactor::ONE);
-                break;
-            case BlendMode_Multiply:
-                curBlendSrc = static_cast<int>(BlendFactor::DST_COLOR);
-                curBlendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_ALPHA);
-                break;
-            case BlendMode_Screen:
-                curBlendSrc = static_cast<int>(BlendFactor::ONE);
-                curBlendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_COLOR);
-                break;
-            default:
-                curBlendSrc = static_cast<int>(_premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA);
-                curBlendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_ALPHA);
-        }
-        auto *material = requestMaterial(curBlendSrc, curBlendDst);
+        auto *material = requestBlendModeMaterial(curBlendMode);
         curDrawInfo->setMaterial(material);
         gfx::Texture *texture = curTexture->getGFXTexture();
         gfx::Sampler *sampler = curTexture->getGFXSampler();
@@ -721,12 +730,8 @@ void SkeletonRenderer::render(float /*deltaTime*/) {
         }
         if (_enableBatch) {
             uint8_t *vbBuffer = vb.getCurBuffer();
-            cc::Vec3 *point = nullptr;
-            for (unsigned int ii = 0, nn = vbSize; ii < nn; ii += vbs) {
-                point = reinterpret_cast<cc::Vec3 *>(vbBuffer + ii);
-                point->z = 0;
-                point->transformMat4(*point, nodeWorldMat);
-            }
+            // transform in place, z of the slot vertices is treated as 0
+            cc::MathUtil::transformPositions(nodeWorldMat.m, vbBuffer, vbs, vbBuffer, vbs, vbSize / vbs, true);
         }
         auto vertexOffset = vb.getCurPos() / vbs;
         if (vbSize > 0 && ibSize > 0) {
@@ -798,6 +803,223 @@ void SkeletonRenderer::render(float /*deltaTime*/) {
     }
 }
 
+bool SkeletonRenderer::prepareRender(float /*deltaTime*/, int &vertexFormat, std::size_t &vbSize, std::size_t &ibSize) {
+    // Only the common case is rendered in two phases, vertex effects, clipping and debug data go through render().
+    if (!_skeleton || _debugSlots || _debugBones || _debugMesh) return false;
+    if (_effectDelegate && _effectDelegate->getVertexEffect()) return false;
+    auto *mgr = MiddlewareManager::getInstance();
+    if (!mgr->isRendering || !mgr->getAttachInfoMgr()->getBuffer()) return false;
+    if (_skeleton->getColor().a == 0) return false;
+
+    _renderSlots.clear();
+    unsigned int vbs = _useTint ? sizeof(V3F_T2F_C4B_C4B) : sizeof(V3F_T2F_C4B);
+    cc::middleware::Color4F color;
+    bool inRange = !(_startSlotIndex != -1 || _endSlotIndex != -1);
+    vbSize = 0;
+    ibSize = 0;
+
+    // same visibility and color rules as render()
+    auto &drawOrder = _skeleton->getDrawOrder();
+    for (size_t i = 0, n = drawOrder.size(); i < n; ++i) {
+        Slot *slot = drawOrder[i];
+        if (slot->getBone().isActive() == false) continue;
+
+        if (_startSlotIndex >= 0 && _startSlotIndex == slot->getData().getIndex()) {
+            inRange = true;
+        }
+        if (!inRange) continue;
+        if (_endSlotIndex >= 0 && _endSlotIndex == slot->getData().getIndex()) {
+            inRange = false;
+        }
+
+        Attachment *attachment = slot->getAttachment();
+        if (!attachment || slot->getColor().a == 0) continue;
+
+        RenderSlot renderSlot;
+        renderSlot.slot = slot;
+        renderSlot.attachment = attachment;
+        if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+            auto *region = static_cast<RegionAttachment *>(attachment);
+            const auto &attachmentColor = region->getColor();
+            color.r = attachmentColor.r;
+            color.g = attachmentColor.g;
+            color.b = attachmentColor.b;
+            color.a = attachmentColor.a;
+            renderSlot.attachmentVertices = static_cast<AttachmentVertices *>(region->getRendererObject());
+        } else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+            auto *mesh = static_cast<MeshAttachment *>(attachment);
+            const auto &attachmentColor = mesh->getColor();
+            color.r = attachmentColor.r;
+            color.g = attachmentColor.g;
+            color.b = attachmentColor.b;
+            color.a = attachmentColor.a;
+            renderSlot.attachmentVertices = static_cast<AttachmentVertices *>(mesh->getRendererObject());
+            renderSlot.isMesh = true;
+        } else if (attachment->getRTTI().isExactly(ClippingAttachment::rtti)) {
+            return false;
+        } else {
+            continue;
+        }
+        if (color.a == 0) continue;
+
+        color.a = _skeleton->getColor().a * slot->getColor().a * color.a * _nodeColor.a * 255;
+        if (color.a == 0) continue;
+
+        float multiplier = _premultipliedAlpha ? color.a : 255;
+        float red = _nodeColor.r * _skeleton->getColor().r * color.r * multiplier;
+        float green = _nodeColor.g * _skeleton->getColor().g * color.g * multiplier;
+        float blue = _nodeColor.b * _skeleton->getColor().b * color.b * multiplier;
+
+        renderSlot.light.r = (uint8_t)(red * slot->getColor().r);
+        renderSlot.light.g = (uint8_t)(green * slot->getColor().g);
+        renderSlot.light.b = (uint8_t)(blue * slot->getColor().b);
+        renderSlot.light.a = (uint8_t)color.a;
+        if (slot->hasDarkColor()) {
+            renderSlot.dark.r = (uint8_t)(red * slot->getDarkColor().r);
+            renderSlot.dark.g = (uint8_t)(green * slot->getDarkColor().g);
+            renderSlot.dark.b = (uint8_t)(blue * slot->getDarkColor().b);
+        } else {
+            renderSlot.dark.r = 0;
+            renderSlot.dark.g = 0;
+            renderSlot.dark.b = 0;
+        }
+        renderSlot.dark.a = _premultipliedAlpha ? 255 : 0;
+
+        renderSlot.vbOffset = static_cast<uint32_t>(vbSize);
+        renderSlot.ibOffset = static_cast<uint32_t>(ibSize);
+        vbSize += renderSlot.attachmentVertices->_triangles->vertCount * vbs;
+        ibSize += renderSlot.attachmentVertices->_triangles->indexCount * sizeof(uint16_t);
+        _renderSlots.push_back(renderSlot);
+    }
+
+    vertexFormat = _useTint ? VF_XYZUVCC : VF_XYZUVC;
+    return true;
+}
+
+void SkeletonRenderer::commitRender(const cc::middleware::MeshBufferSlice &slice) {
+    auto *entity = _entity;
+    entity->clearDynamicRenderDrawInfos();
+    _sharedBufferOffset->reset();
+    _sharedBufferOffset->clear();
+
+    auto *attachInfo = MiddlewareManager::getInstance()->getAttachInfoMgr()->getBuffer();
+    // store attach info offset
+    _sharedBufferOffset->writeUint32(static_cast<uint32_t>(attachInfo->getCurPos()) / sizeof(uint32_t));
+    // the node may not be touched by fillRender on a worker
+    _renderWorldMatrix = entity->getNode()->getWorldMatrix();
+
+    // split into draw infos whenever the texture or the blend mode changes, like render()
+    RenderDrawInfo *curDrawInfo = nullptr;
+    cc::Texture2D *preTexture = nullptr;
+    int preBlendMode = -1;
+    int materialLen = 0;
+    uint32_t segmentBegin = 0;
+    for (const auto &renderSlot : _renderSlots) {
+        auto *texture = static_cast<cc::Texture2D *>(renderSlot.attachmentVertices->_texture->getRealTexture());
+        int blendMode = renderSlot.slot->getData().getBlendMode();
+        if (texture == preTexture && blendMode == preBlendMode) continue;
+
+        if (curDrawInfo) {
+            curDrawInfo->setIbCount((renderSlot.ibOffset - segmentBegin) / sizeof(uint16_t));
+        }
+        curDrawInfo = requestDrawInfo(materialLen++);
+        entity->addDynamicRenderDrawInfo(curDrawInfo);
+        curDrawInfo->setMaterial(requestBlendModeMaterial(blendMode));
+        curDrawInfo->setTexture(texture->getGFXTexture());
+        curDrawInfo->setSampler(texture->getGFXSampler());
+        curDrawInfo->setMeshBuffer(slice.uiMeshBuffer);
+        curDrawInfo->setIndexOffset(static_cast<uint32_t>(slice.ibOffset + renderSlot.ibOffset) / sizeof(uint16_t));
+        segmentBegin = renderSlot.ibOffset;
+        preTexture = texture;
+        preBlendMode = blendMode;
+    }
+    if (curDrawInfo) {
+        const auto &last = _renderSlots.back();
+        curDrawInfo->setIbCount((last.ibOffset - segmentBegin) / sizeof(uint16_t) + last.attachmentVertices->_triangles->indexCount);
+    }
+
+    if (_useAttach) {
+        auto &bones = _skeleton->getBones();
+        cc::Mat4 boneMat = cc::Mat4::IDENTITY;
+        for (size_t i = 0, n = bones.size(); i < n; i++) {
+            Bone *bone = bones[i];
+            boneMat.m[0] = bone->getA();
+            boneMat.m[1] = bone->getC();
+            boneMat.m[4] = bone->getB();
+            boneMat.m[5] = bone->getD();
+            boneMat.m[12] = bone->getWorldX();
+            boneMat.m[13] = bone->getWorldY();
+            attachInfo->checkSpace(sizeof(boneMat), true);
+            attachInfo->writeBytes(reinterpret_cast<const char *>(&boneMat), sizeof(boneMat));
+        }
+    }
+}
+
+void SkeletonRenderer::fillRender(const cc::middleware::MeshBufferSlice &slice) {
+    unsigned int vbs = _useTint ? sizeof(V3F_T2F_C4B_C4B) : sizeof(V3F_T2F_C4B);
+    unsigned int vs = vbs / sizeof(float);
+
+    for (const auto &renderSlot : _renderSlots) {
+        const auto *triangles = renderSlot.attachmentVertices->_triangles;
+        uint8_t *vertices = slice.vb + renderSlot.vbOffset;
+        auto *positions = reinterpret_cast<float *>(vertices);
+
+        if (!_useTint) {
+            auto *verts = reinterpret_cast<V3F_T2F_C4B *>(vertices);
+            for (int v = 0; v < triangles->vertCount; ++v) {
+                verts[v] = triangles->verts[v];
+                verts[v].color = renderSlot.light;
+            }
+        } else {
+            auto *verts = reinterpret_cast<V3F_T2F_C4B_C4B *>(vertices);
+            for (int v = 0; v < triangles->vertCount; ++v) {
+                verts[v].vertex.z = 0;
+                verts[v].texCoord = triangles->verts[v].texCoord;
+                verts[v].color = renderSlot.light;
+                verts[v].color2 = renderSlot.dark;
+            }
+        }
+        if (renderSlot.isMesh) {
+            auto *mesh = static_cast<MeshAttachment *>(renderSlot.attachment);
+            mesh->computeWorldVertices(*renderSlot.slot, 0, mesh->getWorldVerticesLength(), positions, 0, vs);
+        } else {
+            static_cast<RegionAttachment *>(renderSlot.attachment)->computeWorldVertices(renderSlot.slot->getBone(), positions, 0, vs);
+        }
+        if (_enableBatch) {
+            cc::MathUtil::transformPositions(_renderWorldMatrix.m, vertices, vbs, vertices, vbs, triangles->vertCount, true);
+        }
+
+        auto vertexOffset = static_cast<uint16_t>((slice.vbOffset + renderSlot.vbOffset) / vbs);
+        uint16_t *indices = slice.ib + renderSlot.ibOffset / sizeof(uint16_t);
+        for (int ii = 0; ii < triangles->indexCount; ++ii) {
+            indices[ii] = triangles->indices[ii] + vertexOffset;
+        }
+    }
+}
+
+cc::Material *SkeletonRenderer::requestBlendModeMaterial(int blendMode) {
+    int blendSrc = 0;
+    int blendDst = 0;
+    switch (blendMode) {
+        case BlendMode_Additive:
+            blendSrc = static_cast<int>(_premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA);
+            blendDst = static_cast<int>(BlendFactor::ONE);
+            break;
+        case BlendMode_Multiply:
+            blendSrc = static_cast<int>(BlendFactor::DST_COLOR);
+            blendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_ALPHA);
+            break;
+        case BlendMode_Screen:
+            blendSrc = static_cast<int>(BlendFactor::ONE);
+            blendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_COLOR);
+            break;
+        default:
+            blendSrc = static_cast<int>(_premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA);
+            blendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_ALPHA);
+    }
+    return requestMaterial(blendSrc, blendDst);
+}
+
 cc::Rect SkeletonRenderer::getBoundingBox() const {
     static cc::middleware::IOBuffer buffer(1024);
     float *worldVertices = nullptr;
@@ -61,6 +61,9 @@ public:
 
     void update(float deltaTime) override {}
     void render(float deltaTime) override;
+    bool prepareRender(float deltaTime, int &vertexFormat, std::size_t &vbSize, std::size_t &ibSize) override;
+    void commitRender(const cc::middleware::MeshBufferSlice &slice) override;
+    void fillRender(const cc::middleware::MeshBufferSlice &slice) override;
     virtual cc::Rect getBoundingBox() const;
 
     Skeleton *getSkeleton() const;
@@ -153,6 +156,19 @@ public:
 
 protected:
     void setSkeletonData(SkeletonData *skeletonData, bool ownsSkeletonData);
+    cc::Material *requestBlendModeMaterial(int blendMode);
+
+    // A visible slot recorded by prepareRender, offsets are in bytes from the start of the slice.
+    struct RenderSlot {
+        Slot *slot{nullptr};
+        Attachment *attachment{nullptr};
+        AttachmentVertices *attachmentVertices{nullptr};
+        bool isMesh{false};
+        uint32_t vbOffset{0};
+        uint32_t ibOffset{0};
+        cc::middleware::Color4B light;
+        cc::middleware::Color4B dark;
+    };
 
     bool _ownsSkeletonData = false;
     bool _ownsSkeleton = false;
@@ -185,6 +201,9 @@ protected:
     cc::Material *_material = nullptr;
     ccstd::vector<cc::RenderDrawInfo *> _drawInfoArray;
     ccstd::unordered_map<uint32_t, cc::Material*> _materialCaches;
+
+    ccstd::vector<RenderSlot> _renderSlots;
+    cc::Mat4 _renderWorldMatrix;
 };
 
 } // namespace spine
@@ -28,6 +28,7 @@
  *****************************************************************************/
 
 #include "spine-creator-support/spine-cocos2dx.h"
+#include <mutex>
 #include "base/Data.h"
 #include "middleware-adapter.h"
 #include "platform/FileUtils.h"
@@ -40,6 +41,8 @@ void spAtlasPage_setCustomTextureLoader(CustomTextureLoader texLoader) {
 }
 
 static SpineObjectDisposeCallback spineObjectDisposeCallback = nullptr;
+// skeletons may be updated on job system workers, the callback touches a global map
+static std::mutex spineObjectDisposeMutex;
 void setSpineObjectDisposeCallback(SpineObjectDisposeCallback callback) {
     spineObjectDisposeCallback = callback;
 }
@@ -147,6 +150,9 @@ SpineExtension *spine::getDefaultExtension() {
 }
 
 void Cocos2dExtension::_free(void *mem, const char *file, int line) {
-    spineObjectDisposeCallback(mem);
+    {
+        std::lock_guard<std::mutex> lock(spineObjectDisposeMutex);
+        spineObjectDisposeCallback(mem);
+    }
     DefaultSpineExtension::_free(mem, file, line);
 }
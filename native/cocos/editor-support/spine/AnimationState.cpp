@@ -638,6 +638,14 @@ void AnimationState::disableQueue() {
 void AnimationState::enableQueue() {
     _queue->_drainDisabled = false;
 }
+bool AnimationState::isQueueDisabled() const {
+    return _queue->_drainDisabled;
+}
+bool AnimationState::drainQueue() {
+    if (_queue->_eventQueueEntries.size() == 0) return false;
+    _queue->drain();
+    return true;
+}
 
 Animation *AnimationState::getEmptyAnimation() {
     static Vector<Timeline *> timelines;
@@ -384,6 +384,10 @@ public:
 
     void disableQueue();
     void enableQueue();
+    bool isQueueDisabled() const;
+
+    /// Raises the events queued while the queue was disabled. Returns false if there were none.
+    bool drainQueue();
 
 private:
     AnimationStateData* _data;
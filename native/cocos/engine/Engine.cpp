@@ -30,6 +30,9 @@
 #include <sstream>
 #include "base/DeferredReleasePool.h"
 #include "base/Macros.h"
+#include "base/ThreadPool.h"
+#include "base/job-system/JobSystem.h"
+#include "base/threading/TaskScheduler.h"
 #include "bindings/jswrapper/SeApi.h"
 #include "core/builtin/BuiltinResMgr.h"
 #include "engine/EngineEvents.h"
@@ -141,6 +144,13 @@ int32_t Engine::init() {
 }
 
 void Engine::destroy() {
+    // Background jobs may still create pipeline states or read script buffers,
+    // finish them while the device and the script engine are alive.
+    // The results they post to the cocos thread are dropped with the other pending functions below.
+    JobSystem::destroyInstance();
+    LegacyThreadPool::destroyDefaultThreadPool();
+    TaskScheduler::destroyInstance();
+
     cc::DeferredReleasePool::clear();
     cc::network::HttpClient::destroyInstance();
     _scheduler->removeAllFunctionsToBePerformedInCocosThread();
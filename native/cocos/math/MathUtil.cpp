@@ -22,6 +22,7 @@ This file was modified to fit the cocos2d-x project
 
 #include "math/MathUtil.h"
 #include "base/Macros.h"
+#include "base/Utils.h"
 
 #if (CC_PLATFORM == CC_PLATFORM_ANDROID)
     #include <cpu-features.h>
@@ -64,6 +65,7 @@ This file was modified to fit the cocos2d-x project
 #ifdef INCLUDE_SSE
     #include "math/MathUtilSSE.inl"
 #endif
+#include <cmath>
 #include <cstring>
 #include "math/MathUtil.inl"
 
@@ -279,6 +281,137 @@ void MathUtil::crossVec3(const float *v1, const float *v2, float *dst) {
 #endif
 }
 
+void MathUtil::aabbPlanesSoA(const float *const boxes[6], uint32_t count, const float *planes, uint32_t planeCount, uint32_t *visibility) {
+    CC_ASSERT(count % 4 == 0 && planeCount <= MAX_SOA_PLANES);
+    memset(visibility, 0, sizeof(uint32_t) * ((count + 31) / 32));
+#if defined(USE_NEON64)
+    MathUtilNeon64::aabbPlanesSoA(boxes, count, planes, planeCount, visibility);
+#elif defined(USE_SSE)
+    __m128 ssePlanes[MAX_SOA_PLANES * 7];
+    for (uint32_t p = 0; p < planeCount; ++p) {
+        const float *plane = planes + p * 4;
+        __m128 *dst = ssePlanes + p * 7;
+        dst[0] = _mm_set1_ps(std::abs(plane[0]));
+        dst[1] = _mm_set1_ps(std::abs(plane[1]));
+        dst[2] = _mm_set1_ps(std::abs(plane[2]));
+        dst[3] = _mm_set1_ps(plane[0]);
+        dst[4] = _mm_set1_ps(plane[1]);
+        dst[5] = _mm_set1_ps(plane[2]);
+        dst[6] = _mm_set1_ps(plane[3]);
+    }
+    aabbPlanesSoA(boxes, count, ssePlanes, planeCount, visibility);
+#else
+    MathUtilC::aabbPlanesSoA(boxes, count, planes, planeCount, visibility);
+#endif
+}
+
+void MathUtil::transformPositions(const float *m, const void *src, uint32_t srcStride, void *dst, uint32_t dstStride, uint32_t count, bool ignoreZ) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::transformPositions(m, src, srcStride, dst, dstStride, count, ignoreZ);
+#elif defined(USE_SSE)
+    // w is exactly 1 for affine matrices, the perspective divide can be skipped then
+    const bool affine = m[3] == 0.0F && m[7] == 0.0F && m[11] == 0.0F && m[15] == 1.0F;
+    const __m128 columns[4] = {_mm_loadu_ps(m), _mm_loadu_ps(m + 4), _mm_loadu_ps(m + 8), _mm_loadu_ps(m + 12)};
+    transformPositions(columns, affine, src, srcStride, dst, dstStride, count, ignoreZ);
+#else
+    MathUtilC::transformPositions(m, src, srcStride, dst, dstStride, count, ignoreZ);
+#endif
+}
+
+void MathUtil::fillStrided(const float *value, void *dst, uint32_t stride, uint32_t count) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::fillStrided(value, dst, stride, count);
+#elif defined(USE_SSE)
+    fillStrided(_mm_loadu_ps(value), dst, stride, count);
+#else
+    MathUtilC::fillStrided(value, dst, stride, count);
+#endif
+}
+
+void MathUtil::distancesSoA(const float *const points[3], uint32_t count, const float *point, float *distances) {
+    CC_ASSERT(count % 4 == 0);
+#if defined(USE_NEON64)
+    MathUtilNeon64::distancesSoA(points, count, point, distances);
+#elif defined(USE_SSE)
+    const __m128 ssePoint[3] = {_mm_set1_ps(point[0]), _mm_set1_ps(point[1]), _mm_set1_ps(point[2])};
+    distancesSoA(points, count, ssePoint, distances);
+#else
+    MathUtilC::distancesSoA(points, count, point, distances);
+#endif
+}
+
+void MathUtil::multiplyAffine3x4(const float *m1, const float *m2, uint32_t count, float *dst) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::multiplyAffine3x4(m1, m2, count, dst);
+#elif defined(USE_SSE)
+    for (uint32_t i = 0; i < count; ++i, m1 += 16, m2 += 16, dst += 12) {
+        const __m128 columns[4] = {_mm_loadu_ps(m1), _mm_loadu_ps(m1 + 4), _mm_loadu_ps(m1 + 8), _mm_loadu_ps(m1 + 12)};
+        multiplyAffine3x4(columns, m2, dst);
+    }
+#else
+    MathUtilC::multiplyAffine3x4(m1, m2, count, dst);
+#endif
+}
+
+void MathUtil::floatToHalf(const float *src, uint32_t count, uint16_t *dst) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::floatToHalf(src, count, dst);
+#elif defined(USE_SSE) && defined(__SSE2__)
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        floatToHalf(_mm_loadu_ps(src + i), dst + i);
+    }
+    MathUtilC::floatToHalf(src + i, count - i, dst + i);
+#else
+    MathUtilC::floatToHalf(src, count, dst);
+#endif
+}
+
+void MathUtil::weightedSum(const float *const *src, const float *weights, uint32_t srcCount, uint32_t count, float *dst) {
+    CC_ASSERT(count % 4 == 0);
+#if defined(USE_NEON64)
+    MathUtilNeon64::weightedSum(src, weights, srcCount, count, dst);
+#elif defined(USE_SSE)
+    for (uint32_t i = 0; i < count; i += 4) {
+        __m128 sum;
+        weightedSum(src, weights, srcCount, i, sum);
+        _mm_storeu_ps(dst + i, sum);
+    }
+#else
+    MathUtilC::weightedSum(src, weights, srcCount, count, dst);
+#endif
+}
+
+void MathUtil::unormToFloat(const uint8_t *src, uint32_t count, float *dst) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::unormToFloat(src, count, dst);
+#elif defined(USE_SSE) && defined(__SSE2__)
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 value;
+        unormToFloat(src + i, value);
+        _mm_storeu_ps(dst + i, value);
+    }
+    MathUtilC::unormToFloat(src + i, count - i, dst + i);
+#else
+    MathUtilC::unormToFloat(src, count, dst);
+#endif
+}
+
+void MathUtil::floatToUnorm(const float *src, uint32_t count, uint8_t *dst) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::floatToUnorm(src, count, dst);
+#elif defined(USE_SSE) && defined(__SSE2__)
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        floatToUnorm(_mm_loadu_ps(src + i), dst + i);
+    }
+    MathUtilC::floatToUnorm(src + i, count - i, dst + i);
+#else
+    MathUtilC::floatToUnorm(src, count, dst);
+#endif
+}
+
 void MathUtil::combineHash(size_t &seed, const size_t &v) {
     seed ^= v + 0x9e3779b9 + (seed << 6) + (seed >> 2);
 }
@@ -95,6 +95,104 @@ public:
      */
     static void combineHash(size_t &seed, const size_t &v);
 
+    /**
+     * Tests a batch of axis aligned boxes stored as structure of arrays against a set of planes,
+     * a box is visible unless it is completely behind one of the planes (plane normals point to the inside).
+     *
+     * @param boxes arrays of center x, y, z and half extents x, y, z, each holding count floats.
+     * @param count box count, must be a multiple of 4.
+     * @param planes planeCount * 4 floats: normal x, y, z and distance, at most MAX_SOA_PLANES planes.
+     * @param planeCount plane count.
+     * @param visibility (count + 31) / 32 words, bit i is set if box i is visible.
+     */
+    static void aabbPlanesSoA(const float *const boxes[6], uint32_t count, const float *planes, uint32_t planeCount, uint32_t *visibility);
+
+    static constexpr uint32_t MAX_SOA_PLANES{8};
+
+    /**
+     * Transforms a batch of strided vertex positions by a matrix, with the same result as Vec3::transformMat4 per vertex.
+     * Only the first 3 floats of each destination vertex are written, src and dst may be the same buffer.
+     *
+     * @param m the matrix.
+     * @param src the first source position.
+     * @param srcStride the distance between two source positions in bytes.
+     * @param dst the first destination position.
+     * @param dstStride the distance between two destination positions in bytes.
+     * @param count vertex count.
+     * @param ignoreZ treats the z of the source positions as 0, for 2D vertices.
+     */
+    static void transformPositions(const float *m, const void *src, uint32_t srcStride, void *dst, uint32_t dstStride, uint32_t count, bool ignoreZ = false);
+
+    /**
+     * Stores the same 4 floats to a batch of strided vertices, e.g. a color.
+     *
+     * @param value the 4 floats to store.
+     * @param dst where the value of the first vertex goes.
+     * @param stride the distance between two vertices in bytes.
+     * @param count vertex count.
+     */
+    static void fillStrided(const float *value, void *dst, uint32_t stride, uint32_t count);
+
+    /**
+     * Computes the distances from a batch of points stored as structure of arrays to a point.
+     *
+     * @param points arrays of x, y, z, each holding count floats.
+     * @param count point count, must be a multiple of 4.
+     * @param point the x, y, z of the point to measure to.
+     * @param distances count floats receiving the distances.
+     */
+    static void distancesSoA(const float *const points[3], uint32_t count, const float *point, float *distances);
+
+    /**
+     * Multiplies a batch of matrix pairs, e.g. joint world matrices with their bind poses, and stores each product
+     * as 12 floats: the first 3 columns, each followed by the x, y or z of the translation, as skinning uniforms expect.
+     * The products have the same value as Mat4::multiply.
+     *
+     * @param m1 count contiguous matrices.
+     * @param m2 count contiguous matrices.
+     * @param count matrix count.
+     * @param dst count * 12 floats.
+     */
+    static void multiplyAffine3x4(const float *m1, const float *m2, uint32_t count, float *dst);
+
+    /**
+     * Converts a batch of floats to half floats, rounding to nearest even like utils::floatToHalf.
+     *
+     * @param src count floats.
+     * @param count float count.
+     * @param dst count half floats as raw bits.
+     */
+    static void floatToHalf(const float *src, uint32_t count, uint16_t *dst);
+
+    /**
+     * Sums arrays of floats weighted per array: dst[i] = weights[0] * src[0][i] + ... + weights[srcCount - 1] * src[srcCount - 1][i].
+     *
+     * @param src srcCount arrays of count floats.
+     * @param weights srcCount floats.
+     * @param srcCount array count.
+     * @param count float count of each array, multiple of 4.
+     * @param dst count floats.
+     */
+    static void weightedSum(const float *const *src, const float *weights, uint32_t srcCount, uint32_t count, float *dst);
+
+    /**
+     * Converts a batch of unsigned normalized bytes to floats in [0, 1].
+     *
+     * @param src count bytes.
+     * @param count byte count.
+     * @param dst count floats.
+     */
+    static void unormToFloat(const uint8_t *src, uint32_t count, float *dst);
+
+    /**
+     * Converts a batch of floats to unsigned normalized bytes, clamping to [0, 1] and rounding to nearest.
+     *
+     * @param src count floats.
+     * @param count float count.
+     * @param dst count bytes.
+     */
+    static void floatToUnorm(const float *src, uint32_t count, uint8_t *dst);
+
 private:
     //Indicates that if neon is enabled
     static bool isNeon32Enabled();
@@ -117,6 +215,24 @@ private:
     static void transposeMatrix(const __m128 m[4], __m128 dst[4]);
 
     static void transformVec4(const __m128 m[4], const __m128 &v, __m128 &dst);
+
+    static void aabbPlanesSoA(const float *const boxes[6], uint32_t count, const __m128 *planes, uint32_t planeCount, uint32_t *visibility);
+
+    static void transformPositions(const __m128 m[4], bool affine, const void *src, uint32_t srcStride, void *dst, uint32_t dstStride, uint32_t count, bool ignoreZ);
+
+    static void fillStrided(const __m128 &value, void *dst, uint32_t stride, uint32_t count);
+
+    static void distancesSoA(const float *const points[3], uint32_t count, const __m128 point[3], float *distances);
+
+    static void multiplyAffine3x4(const __m128 m1[4], const float *m2, float *dst);
+
+    static void floatToHalf(const __m128 &value, uint16_t *dst);
+
+    static void weightedSum(const float *const *src, const float *weights, uint32_t srcCount, uint32_t offset, __m128 &dst);
+
+    static void unormToFloat(const uint8_t *src, __m128 &dst);
+
+    static void floatToUnorm(const __m128 &value, uint8_t *dst);
 #endif
     static void addMatrix(const float *m, float scalar, float *dst);
 
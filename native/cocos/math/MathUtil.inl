@@ -42,6 +42,24 @@ public:
     inline static void transformVec4(const float* m, const float* v, float* dst);
     
     inline static void crossVec3(const float* v1, const float* v2, float* dst);
+
+    inline static void aabbPlanesSoA(const float* const boxes[6], uint32_t count, const float* planes, uint32_t planeCount, uint32_t* visibility);
+
+    inline static void transformPositions(const float* m, const void* src, uint32_t srcStride, void* dst, uint32_t dstStride, uint32_t count, bool ignoreZ);
+
+    inline static void fillStrided(const float* value, void* dst, uint32_t stride, uint32_t count);
+
+    inline static void distancesSoA(const float* const points[3], uint32_t count, const float* point, float* distances);
+
+    inline static void multiplyAffine3x4(const float* m1, const float* m2, uint32_t count, float* dst);
+
+    inline static void floatToHalf(const float* src, uint32_t count, uint16_t* dst);
+
+    inline static void weightedSum(const float* const* src, const float* weights, uint32_t srcCount, uint32_t count, float* dst);
+
+    inline static void unormToFloat(const uint8_t* src, uint32_t count, float* dst);
+
+    inline static void floatToUnorm(const float* src, uint32_t count, uint8_t* dst);
 };
 
 inline void MathUtilC::addMatrix(const float* m, float scalar, float* dst)
@@ -215,4 +233,111 @@ inline void MathUtilC::crossVec3(const float* v1, const float* v2, float* dst)
     dst[2] = z;
 }
 
+inline void MathUtilC::aabbPlanesSoA(const float* const boxes[6], uint32_t count, const float* planes, uint32_t planeCount, uint32_t* visibility)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        bool outside = false;
+        for (uint32_t p = 0; p < planeCount && !outside; ++p)
+        {
+            const float* plane = planes + p * 4;
+            float r = boxes[3][i] * std::abs(plane[0]) + boxes[4][i] * std::abs(plane[1]) + boxes[5][i] * std::abs(plane[2]);
+            float dot = plane[0] * boxes[0][i] + plane[1] * boxes[1][i] + plane[2] * boxes[2][i];
+            outside = dot + r < plane[3];
+        }
+        if (!outside)
+        {
+            visibility[i >> 5] |= 1U << (i & 31);
+        }
+    }
+}
+
+inline void MathUtilC::transformPositions(const float* m, const void* src, uint32_t srcStride, void* dst, uint32_t dstStride, uint32_t count, bool ignoreZ)
+{
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    for (uint32_t i = 0; i < count; ++i, in += srcStride, out += dstStride)
+    {
+        const auto* p = reinterpret_cast<const float*>(in);
+        float tmp[4] = {p[0], p[1], ignoreZ ? 0.0F : p[2], 1.0F};
+        transformVec4(m, tmp, tmp);
+        float rhw = tmp[3] != 0.0F ? 1.0F / tmp[3] : 1.0F;
+        auto* q = reinterpret_cast<float*>(out);
+        q[0] = tmp[0] * rhw;
+        q[1] = tmp[1] * rhw;
+        q[2] = tmp[2] * rhw;
+    }
+}
+
+inline void MathUtilC::fillStrided(const float* value, void* dst, uint32_t stride, uint32_t count)
+{
+    auto* out = static_cast<uint8_t*>(dst);
+    for (uint32_t i = 0; i < count; ++i, out += stride)
+    {
+        memcpy(out, value, 4 * sizeof(float));
+    }
+}
+
+inline void MathUtilC::distancesSoA(const float* const points[3], uint32_t count, const float* point, float* distances)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const float dx = points[0][i] - point[0];
+        const float dy = points[1][i] - point[1];
+        const float dz = points[2][i] - point[2];
+        distances[i] = std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+}
+
+inline void MathUtilC::multiplyAffine3x4(const float* m1, const float* m2, uint32_t count, float* dst)
+{
+    float product[16];
+    for (uint32_t i = 0; i < count; ++i, m1 += 16, m2 += 16, dst += 12)
+    {
+        multiplyMatrix(m1, m2, product);
+        memcpy(dst, product, 12 * sizeof(float));
+        dst[3] = product[12];
+        dst[7] = product[13];
+        dst[11] = product[14];
+    }
+}
+
+inline void MathUtilC::floatToHalf(const float* src, uint32_t count, uint16_t* dst)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        dst[i] = utils::rawHalfAsUint16(utils::floatToHalf(src[i]));
+    }
+}
+
+inline void MathUtilC::weightedSum(const float* const* src, const float* weights, uint32_t srcCount, uint32_t count, float* dst)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        float sum = 0.0F;
+        for (uint32_t s = 0; s < srcCount; ++s)
+        {
+            sum += src[s][i] * weights[s];
+        }
+        dst[i] = sum;
+    }
+}
+
+inline void MathUtilC::unormToFloat(const uint8_t* src, uint32_t count, float* dst)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        dst[i] = static_cast<float>(src[i]) * (1.0F / 255.0F);
+    }
+}
+
+inline void MathUtilC::floatToUnorm(const float* src, uint32_t count, uint8_t* dst)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const float value = src[i] > 0.0F ? (src[i] < 1.0F ? src[i] : 1.0F) : 0.0F;
+        dst[i] = static_cast<uint8_t>(value * 255.0F + 0.5F);
+    }
+}
+
 NS_CC_MATH_END
@@ -18,6 +18,8 @@
  This file was modified to fit the cocos2d-x project
  */
 
+#include <arm_neon.h>
+
 NS_CC_MATH_BEGIN
 
 class MathUtilNeon64
@@ -42,6 +44,24 @@ public:
     inline static void transformVec4(const float* m, const float* v, float* dst);
     
     inline static void crossVec3(const float* v1, const float* v2, float* dst);
+
+    inline static void aabbPlanesSoA(const float* const boxes[6], uint32_t count, const float* planes, uint32_t planeCount, uint32_t* visibility);
+
+    inline static void transformPositions(const float* m, const void* src, uint32_t srcStride, void* dst, uint32_t dstStride, uint32_t count, bool ignoreZ);
+
+    inline static void fillStrided(const float* value, void* dst, uint32_t stride, uint32_t count);
+
+    inline static void distancesSoA(const float* const points[3], uint32_t count, const float* point, float* distances);
+
+    inline static void multiplyAffine3x4(const float* m1, const float* m2, uint32_t count, float* dst);
+
+    inline static void floatToHalf(const float* src, uint32_t count, uint16_t* dst);
+
+    inline static void weightedSum(const float* const* src, const float* weights, uint32_t srcCount, uint32_t count, float* dst);
+
+    inline static void unormToFloat(const uint8_t* src, uint32_t count, float* dst);
+
+    inline static void floatToUnorm(const float* src, uint32_t count, uint8_t* dst);
 };
 
 inline void MathUtilNeon64::addMatrix(const float* m, float scalar, float* dst)
@@ -260,4 +280,181 @@ inline void MathUtilNeon64::crossVec3(const float* v1, const float* v2, float* d
     );
 }
 
+inline void MathUtilNeon64::aabbPlanesSoA(const float* const boxes[6], uint32_t count, const float* planes, uint32_t planeCount, uint32_t* visibility)
+{
+    static const uint32_t laneBits[4] = {1, 2, 4, 8};
+    const uint32x4_t bits = vld1q_u32(laneBits);
+    for (uint32_t i = 0; i < count; i += 4)
+    {
+        const float32x4_t cx = vld1q_f32(boxes[0] + i);
+        const float32x4_t cy = vld1q_f32(boxes[1] + i);
+        const float32x4_t cz = vld1q_f32(boxes[2] + i);
+        const float32x4_t hx = vld1q_f32(boxes[3] + i);
+        const float32x4_t hy = vld1q_f32(boxes[4] + i);
+        const float32x4_t hz = vld1q_f32(boxes[5] + i);
+
+        uint32x4_t outside = vdupq_n_u32(0);
+        for (uint32_t p = 0; p < planeCount; ++p)
+        {
+            const float* plane = planes + p * 4;
+            const float32x4_t nx = vdupq_n_f32(plane[0]);
+            const float32x4_t ny = vdupq_n_f32(plane[1]);
+            const float32x4_t nz = vdupq_n_f32(plane[2]);
+            const float32x4_t r = vaddq_f32(vaddq_f32(vmulq_f32(hx, vabsq_f32(nx)), vmulq_f32(hy, vabsq_f32(ny))), vmulq_f32(hz, vabsq_f32(nz)));
+            const float32x4_t dot = vaddq_f32(vaddq_f32(vmulq_f32(nx, cx), vmulq_f32(ny, cy)), vmulq_f32(nz, cz));
+            outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(dot, r), vdupq_n_f32(plane[3])));
+        }
+        const uint32_t mask = ~vaddvq_u32(vandq_u32(outside, bits)) & 0xFU;
+        visibility[i >> 5] |= mask << (i & 31);
+    }
+}
+
+inline void MathUtilNeon64::transformPositions(const float* m, const void* src, uint32_t srcStride, void* dst, uint32_t dstStride, uint32_t count, bool ignoreZ)
+{
+    const bool affine = m[3] == 0.0F && m[7] == 0.0F && m[11] == 0.0F && m[15] == 1.0F;
+    const float32x4_t c0 = vld1q_f32(m);
+    const float32x4_t c1 = vld1q_f32(m + 4);
+    const float32x4_t c2 = vld1q_f32(m + 8);
+    const float32x4_t c3 = vld1q_f32(m + 12);
+
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    for (uint32_t i = 0; i < count; ++i, in += srcStride, out += dstStride)
+    {
+        const auto* p = reinterpret_cast<const float*>(in);
+        float32x4_t r = vaddq_f32(vmulq_n_f32(c0, p[0]), vmulq_n_f32(c1, p[1]));
+        if (!ignoreZ)
+        {
+            r = vaddq_f32(r, vmulq_n_f32(c2, p[2]));
+        }
+        r = vaddq_f32(r, c3);
+        if (!affine)
+        {
+            const float w = vgetq_lane_f32(r, 3);
+            r = vmulq_n_f32(r, w != 0.0F ? 1.0F / w : 1.0F);
+        }
+        // don't touch the 4th float, it belongs to the next attribute
+        auto* q = reinterpret_cast<float*>(out);
+        vst1_f32(q, vget_low_f32(r));
+        q[2] = vgetq_lane_f32(r, 2);
+    }
+}
+
+inline void MathUtilNeon64::fillStrided(const float* value, void* dst, uint32_t stride, uint32_t count)
+{
+    const float32x4_t v = vld1q_f32(value);
+    auto* out = static_cast<uint8_t*>(dst);
+    for (uint32_t i = 0; i < count; ++i, out += stride)
+    {
+        vst1q_f32(reinterpret_cast<float*>(out), v);
+    }
+}
+
+inline void MathUtilNeon64::distancesSoA(const float* const points[3], uint32_t count, const float* point, float* distances)
+{
+    const float32x4_t px = vdupq_n_f32(point[0]);
+    const float32x4_t py = vdupq_n_f32(point[1]);
+    const float32x4_t pz = vdupq_n_f32(point[2]);
+    for (uint32_t i = 0; i < count; i += 4)
+    {
+        const float32x4_t dx = vsubq_f32(vld1q_f32(points[0] + i), px);
+        const float32x4_t dy = vsubq_f32(vld1q_f32(points[1] + i), py);
+        const float32x4_t dz = vsubq_f32(vld1q_f32(points[2] + i), pz);
+        const float32x4_t lengthSquared = vaddq_f32(vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy)), vmulq_f32(dz, dz));
+        vst1q_f32(distances + i, vsqrtq_f32(lengthSquared));
+    }
+}
+
+inline void MathUtilNeon64::multiplyAffine3x4(const float* m1, const float* m2, uint32_t count, float* dst)
+{
+    for (uint32_t i = 0; i < count; ++i, m1 += 16, m2 += 16, dst += 12)
+    {
+        const float32x4_t a0 = vld1q_f32(m1);
+        const float32x4_t a1 = vld1q_f32(m1 + 4);
+        const float32x4_t a2 = vld1q_f32(m1 + 8);
+        const float32x4_t a3 = vld1q_f32(m1 + 12);
+        float32x4_t c[4];
+        for (uint32_t j = 0; j < 4; ++j)
+        {
+            const float32x4_t e = vld1q_f32(m2 + 4 * j);
+            c[j] = vmulq_laneq_f32(a0, e, 0);
+            c[j] = vfmaq_laneq_f32(c[j], a1, e, 1);
+            c[j] = vfmaq_laneq_f32(c[j], a2, e, 2);
+            c[j] = vfmaq_laneq_f32(c[j], a3, e, 3);
+        }
+        vst1q_f32(dst, vcopyq_laneq_f32(c[0], 3, c[3], 0));
+        vst1q_f32(dst + 4, vcopyq_laneq_f32(c[1], 3, c[3], 1));
+        vst1q_f32(dst + 8, vcopyq_laneq_f32(c[2], 3, c[3], 2));
+    }
+}
+
+inline void MathUtilNeon64::floatToHalf(const float* src, uint32_t count, uint16_t* dst)
+{
+    uint32_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const float16x8_t h = vcvt_high_f16_f32(vcvt_f16_f32(vld1q_f32(src + i)), vld1q_f32(src + i + 4));
+        vst1q_u16(dst + i, vreinterpretq_u16_f16(h));
+    }
+    for (; i + 4 <= count; i += 4)
+    {
+        vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+    }
+    for (; i < count; ++i)
+    {
+        dst[i] = utils::rawHalfAsUint16(utils::floatToHalf(src[i]));
+    }
+}
+
+inline void MathUtilNeon64::weightedSum(const float* const* src, const float* weights, uint32_t srcCount, uint32_t count, float* dst)
+{
+    for (uint32_t i = 0; i < count; i += 4)
+    {
+        float32x4_t sum = vdupq_n_f32(0.0F);
+        for (uint32_t s = 0; s < srcCount; ++s)
+        {
+            sum = vfmaq_n_f32(sum, vld1q_f32(src[s] + i), weights[s]);
+        }
+        vst1q_f32(dst + i, sum);
+    }
+}
+
+inline void MathUtilNeon64::unormToFloat(const uint8_t* src, uint32_t count, float* dst)
+{
+    const float32x4_t scale = vdupq_n_f32(1.0F / 255.0F);
+    uint32_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const uint16x8_t words = vmovl_u8(vld1_u8(src + i));
+        vst1q_f32(dst + i, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(words))), scale));
+        vst1q_f32(dst + i + 4, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(words))), scale));
+    }
+    for (; i < count; ++i)
+    {
+        dst[i] = static_cast<float>(src[i]) * (1.0F / 255.0F);
+    }
+}
+
+inline void MathUtilNeon64::floatToUnorm(const float* src, uint32_t count, uint8_t* dst)
+{
+    const float32x4_t zero = vdupq_n_f32(0.0F);
+    const float32x4_t one = vdupq_n_f32(1.0F);
+    const float32x4_t scale = vdupq_n_f32(255.0F);
+    const float32x4_t half = vdupq_n_f32(0.5F);
+    uint32_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const float32x4_t low = vminq_f32(vmaxq_f32(vld1q_f32(src + i), zero), one);
+        const float32x4_t high = vminq_f32(vmaxq_f32(vld1q_f32(src + i + 4), zero), one);
+        const uint16x8_t words = vcombine_u16(vmovn_u32(vcvtq_u32_f32(vmlaq_f32(half, low, scale))),
+                                              vmovn_u32(vcvtq_u32_f32(vmlaq_f32(half, high, scale))));
+        vst1_u8(dst + i, vmovn_u16(words));
+    }
+    for (; i < count; ++i)
+    {
+        const float value = src[i] > 0.0F ? (src[i] < 1.0F ? src[i] : 1.0F) : 0.0F;
+        dst[i] = static_cast<uint8_t>(value * 255.0F + 0.5F);
+    }
+}
+
 NS_CC_MATH_END
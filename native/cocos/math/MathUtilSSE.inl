@@ -1,3 +1,7 @@
+#ifdef __SSE2__
+    #include <emmintrin.h>
+#endif
+
 NS_CC_MATH_BEGIN
 
 #ifdef __SSE__
@@ -151,6 +155,171 @@ void MathUtil::transformVec4(const __m128 m[4], const __m128& v, __m128& dst)
                      );
 }
 
+void MathUtil::aabbPlanesSoA(const float* const boxes[6], uint32_t count, const __m128* planes, uint32_t planeCount, uint32_t* visibility)
+{
+    for (uint32_t i = 0; i < count; i += 4)
+    {
+        const __m128 cx = _mm_loadu_ps(boxes[0] + i);
+        const __m128 cy = _mm_loadu_ps(boxes[1] + i);
+        const __m128 cz = _mm_loadu_ps(boxes[2] + i);
+        const __m128 hx = _mm_loadu_ps(boxes[3] + i);
+        const __m128 hy = _mm_loadu_ps(boxes[4] + i);
+        const __m128 hz = _mm_loadu_ps(boxes[5] + i);
+
+        __m128 outside = _mm_setzero_ps();
+        for (uint32_t p = 0; p < planeCount; ++p)
+        {
+            // |nx|, |ny|, |nz|, nx, ny, nz, d
+            const __m128* plane = planes + p * 7;
+            __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(hx, plane[0]), _mm_mul_ps(hy, plane[1])), _mm_mul_ps(hz, plane[2]));
+            __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(plane[3], cx), _mm_mul_ps(plane[4], cy)), _mm_mul_ps(plane[5], cz));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(dot, r), plane[6]));
+        }
+        const uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_ps(outside)) & 0xFU;
+        visibility[i >> 5] |= mask << (i & 31);
+    }
+}
+
+void MathUtil::transformPositions(const __m128 m[4], bool affine, const void* src, uint32_t srcStride, void* dst, uint32_t dstStride, uint32_t count, bool ignoreZ)
+{
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    const __m128 one = _mm_set1_ps(1.0F);
+    for (uint32_t i = 0; i < count; ++i, in += srcStride, out += dstStride)
+    {
+        const auto* p = reinterpret_cast<const float*>(in);
+        // same operation order as transformVec4: x * m0 + y * m4 + z * m8 + m12
+        __m128 r = _mm_add_ps(_mm_mul_ps(m[0], _mm_set1_ps(p[0])), _mm_mul_ps(m[1], _mm_set1_ps(p[1])));
+        if (!ignoreZ)
+        {
+            r = _mm_add_ps(r, _mm_mul_ps(m[2], _mm_set1_ps(p[2])));
+        }
+        r = _mm_add_ps(r, m[3]);
+        if (!affine)
+        {
+            __m128 w = _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3));
+            __m128 valid = _mm_cmpneq_ps(w, _mm_setzero_ps());
+            __m128 rhw = _mm_or_ps(_mm_and_ps(valid, _mm_div_ps(one, w)), _mm_andnot_ps(valid, one));
+            r = _mm_mul_ps(r, rhw);
+        }
+        // don't touch the 4th float, it belongs to the next attribute
+        auto* q = reinterpret_cast<float*>(out);
+        _mm_storel_pi(reinterpret_cast<__m64*>(q), r);
+        _mm_store_ss(q + 2, _mm_movehl_ps(r, r));
+    }
+}
+
+void MathUtil::fillStrided(const __m128& value, void* dst, uint32_t stride, uint32_t count)
+{
+    auto* out = static_cast<uint8_t*>(dst);
+    for (uint32_t i = 0; i < count; ++i, out += stride)
+    {
+        _mm_storeu_ps(reinterpret_cast<float*>(out), value);
+    }
+}
+
+void MathUtil::distancesSoA(const float* const points[3], uint32_t count, const __m128 point[3], float* distances)
+{
+    for (uint32_t i = 0; i < count; i += 4)
+    {
+        const __m128 dx = _mm_sub_ps(_mm_loadu_ps(points[0] + i), point[0]);
+        const __m128 dy = _mm_sub_ps(_mm_loadu_ps(points[1] + i), point[1]);
+        const __m128 dz = _mm_sub_ps(_mm_loadu_ps(points[2] + i), point[2]);
+        const __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+        _mm_storeu_ps(distances + i, _mm_sqrt_ps(lengthSquared));
+    }
+}
+
+void MathUtil::multiplyAffine3x4(const __m128 m1[4], const float* m2, float* dst)
+{
+    __m128 c[4];
+    for (uint32_t j = 0; j < 4; ++j)
+    {
+        // same operation order as multiplyMatrix
+        const float* e = m2 + 4 * j;
+        const __m128 a0 = _mm_add_ps(_mm_mul_ps(m1[0], _mm_set1_ps(e[0])), _mm_mul_ps(m1[1], _mm_set1_ps(e[1])));
+        const __m128 a1 = _mm_add_ps(_mm_mul_ps(m1[2], _mm_set1_ps(e[2])), _mm_mul_ps(m1[3], _mm_set1_ps(e[3])));
+        c[j] = _mm_add_ps(a0, a1);
+    }
+    // [cj.x, cj.y, cj.z, c3.j]
+    const __m128 t0 = _mm_shuffle_ps(c[0], c[3], _MM_SHUFFLE(0, 0, 2, 2));
+    const __m128 t1 = _mm_shuffle_ps(c[1], c[3], _MM_SHUFFLE(1, 1, 2, 2));
+    const __m128 t2 = _mm_shuffle_ps(c[2], c[3], _MM_SHUFFLE(2, 2, 2, 2));
+    _mm_storeu_ps(dst, _mm_shuffle_ps(c[0], t0, _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(dst + 4, _mm_shuffle_ps(c[1], t1, _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(dst + 8, _mm_shuffle_ps(c[2], t2, _MM_SHUFFLE(2, 0, 1, 0)));
+}
+
+void MathUtil::floatToHalf(const __m128& value, uint16_t* dst)
+{
+    #ifdef __SSE2__
+    // branchless version of the bit tricks in utils::floatToHalf, so the results are identical
+    const __m128i bits = _mm_castps_si128(value);
+    const __m128i sign = _mm_and_si128(bits, _mm_set1_epi32(static_cast<int>(0x80000000U)));
+    const __m128i u = _mm_xor_si128(bits, sign);
+
+    // normalized: rebias the exponent and round the mantissa to nearest even
+    const __m128i mantOdd = _mm_and_si128(_mm_srli_epi32(u, 13), _mm_set1_epi32(1));
+    __m128i normal = _mm_add_epi32(u, _mm_set1_epi32(static_cast<int>(0xc8000fffU)));
+    normal = _mm_srli_epi32(_mm_add_epi32(normal, mantOdd), 13);
+
+    // denormalized: let the float addition align and round the mantissa
+    const __m128i denormMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+    const __m128i denormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(u), _mm_castsi128_ps(denormMagic))), denormMagic);
+
+    // overflow: infinity, or quiet NaN
+    const __m128i isNaN = _mm_cmpgt_epi32(u, _mm_set1_epi32(255 << 23));
+    const __m128i overflow = _mm_or_si128(_mm_set1_epi32(0x7c00), _mm_and_si128(isNaN, _mm_set1_epi32(0x0200)));
+
+    const __m128i isOverflow = _mm_cmpgt_epi32(u, _mm_set1_epi32(((127 + 16) << 23) - 1));
+    const __m128i isDenormal = _mm_cmplt_epi32(u, _mm_set1_epi32(113 << 23));
+    __m128i result = _mm_or_si128(_mm_and_si128(isDenormal, denormal), _mm_andnot_si128(isDenormal, normal));
+    result = _mm_or_si128(_mm_and_si128(isOverflow, overflow), _mm_andnot_si128(isOverflow, result));
+    result = _mm_or_si128(result, _mm_srli_epi32(sign, 16));
+
+    // sign extend the low 16 bits so the saturating pack keeps them as is
+    result = _mm_srai_epi32(_mm_slli_epi32(result, 16), 16);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_packs_epi32(result, result));
+    #else
+    float values[4];
+    _mm_storeu_ps(values, value);
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        dst[i] = utils::rawHalfAsUint16(utils::floatToHalf(values[i]));
+    }
+    #endif
+}
+
+void MathUtil::weightedSum(const float* const* src, const float* weights, uint32_t srcCount, uint32_t offset, __m128& dst)
+{
+    __m128 sum = _mm_setzero_ps();
+    for (uint32_t s = 0; s < srcCount; ++s)
+    {
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(src[s] + offset), _mm_set1_ps(weights[s])));
+    }
+    dst = sum;
+}
+
+    #ifdef __SSE2__
+void MathUtil::unormToFloat(const uint8_t* src, __m128& dst)
+{
+    int32_t bits = 0;
+    memcpy(&bits, src, 4);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ints = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bits), zero), zero);
+    dst = _mm_mul_ps(_mm_cvtepi32_ps(ints), _mm_set1_ps(1.0F / 255.0F));
+}
+
+void MathUtil::floatToUnorm(const __m128& value, uint8_t* dst)
+{
+    const __m128 clamped = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0F));
+    const __m128i ints = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, _mm_set1_ps(255.0F)), _mm_set1_ps(0.5F)));
+    const __m128i words = _mm_packs_epi32(ints, ints);
+    const int32_t bits = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+    memcpy(dst, &bits, 4);
+}
+    #endif
+
 #endif
 
 
@@ -0,0 +1,1148 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "platform/CompressedTextureDecoder.h"
+#include <algorithm>
+#include <cstring>
+#include "base/job-system/JobSystem.h"
+
+//#define USE_SSE2  : SSE2 code used
+//#define USE_NEON  : NEON code used
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define USE_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define USE_NEON
+#endif
+
+namespace cc {
+
+namespace {
+
+// The kernels process multiples of 16 values, the scratch buffers are padded accordingly.
+constexpr uint32_t KERNEL_WIDTH = 16;
+constexpr uint32_t MIN_BLOCKS_PER_JOB = 1024;
+
+// Clamps signed texel values to [0, 255].
+void packClamped(const int16_t *values, uint32_t count, uint8_t *out) {
+#if defined(USE_SSE2)
+    for (uint32_t i = 0; i < count; i += 16) {
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(values + i));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(values + i + 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_packus_epi16(lo, hi));
+    }
+#elif defined(USE_NEON)
+    for (uint32_t i = 0; i < count; i += 8) {
+        vst1_u8(out + i, vqmovun_s16(vld1q_s16(values + i)));
+    }
+#else
+    for (uint32_t i = 0; i < count; ++i) {
+        out[i] = static_cast<uint8_t>(std::min(std::max(values[i], static_cast<int16_t>(0)), static_cast<int16_t>(255)));
+    }
+#endif
+}
+
+// Interpolates 8-bit endpoints by weights in [0, 64], as the ASTC spec does on endpoints expanded to 16 bits,
+// keeping the top 8 bits as the unorm8 decode mode does. With v = e0 * (64 - w) + e1 * w, that is
+// ((v << 8 | v) + 32) >> 14 for UNORM and (v + 32) >> 6 for sRGB, split so that it fits in 16-bit lanes.
+void interpolate(const uint16_t *e0, const uint16_t *e1, const uint16_t *weights, uint32_t count, bool srgb, uint8_t *out) {
+#if defined(USE_SSE2)
+    const __m128i full = _mm_set1_epi16(64);
+    const __m128i half = _mm_set1_epi16(32);
+    const __m128i low = _mm_set1_epi16(63);
+    for (uint32_t i = 0; i < count; i += 16) {
+        __m128i packed[2];
+        for (uint32_t j = 0; j < 2; ++j) {
+            const __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i *>(weights + i + j * 8));
+            const __m128i a = _mm_mullo_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(e0 + i + j * 8)), _mm_sub_epi16(full, w));
+            const __m128i b = _mm_mullo_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(e1 + i + j * 8)), w);
+            const __m128i v = _mm_add_epi16(a, b);
+            if (srgb) {
+                packed[j] = _mm_srli_epi16(_mm_add_epi16(v, half), 6);
+            } else {
+                const __m128i carry = _mm_add_epi16(_mm_add_epi16(_mm_slli_epi16(_mm_and_si128(v, low), 8), v), half);
+                packed[j] = _mm_add_epi16(_mm_srli_epi16(v, 6), _mm_srli_epi16(carry, 14));
+            }
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_packus_epi16(packed[0], packed[1]));
+    }
+#elif defined(USE_NEON)
+    const uint16x8_t full = vdupq_n_u16(64);
+    const uint16x8_t half = vdupq_n_u16(32);
+    const uint16x8_t low = vdupq_n_u16(63);
+    for (uint32_t i = 0; i < count; i += 8) {
+        const uint16x8_t w = vld1q_u16(weights + i);
+        const uint16x8_t v = vmlaq_u16(vmulq_u16(vld1q_u16(e0 + i), vsubq_u16(full, w)), vld1q_u16(e1 + i), w);
+        if (srgb) {
+            vst1_u8(out + i, vmovn_u16(vrshrq_n_u16(v, 6)));
+        } else {
+            const uint16x8_t carry = vaddq_u16(vaddq_u16(vshlq_n_u16(vandq_u16(v, low), 8), v), half);
+            vst1_u8(out + i, vmovn_u16(vaddq_u16(vshrq_n_u16(v, 6), vshrq_n_u16(carry, 14))));
+        }
+    }
+#else
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t v = e0[i] * (64 - weights[i]) + e1[i] * weights[i];
+        out[i] = static_cast<uint8_t>(srgb ? (v + 32) >> 6 : (v * 257 + 32) >> 14);
+    }
+#endif
+}
+
+// Copies the texels of a block, clipped by the image edges.
+void storeBlock(const uint8_t *texels, uint32_t blockWidth, uint32_t blockHeight, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint8_t *rgba) {
+    const uint32_t columns = std::min(blockWidth, width - x);
+    const uint32_t rows = std::min(blockHeight, height - y);
+    for (uint32_t row = 0; row < rows; ++row) {
+        memcpy(rgba + ((y + row) * width + x) * 4, texels + row * blockWidth * 4, columns * 4);
+    }
+}
+
+// Splits the rows of blocks into jobs, the calling thread takes the first one.
+template <typename Fn>
+void forEachBlockRows(uint32_t rowCount, uint32_t blocksPerRow, const Fn &decodeRows) {
+    const uint32_t maxJobCount = std::max(1U, std::min(rowCount, rowCount * blocksPerRow / MIN_BLOCKS_PER_JOB));
+    const uint32_t jobCount = std::min(JobSystem::getInstance()->threadCount(), maxJobCount);
+    const uint32_t rowsPerJob = (rowCount - 1) / std::max(jobCount, 1U) + 1;
+    auto decodeJob = [&](uint32_t jobIdx) {
+        const uint32_t begin = jobIdx * rowsPerJob;
+        decodeRows(begin, std::min(begin + rowsPerJob, rowCount));
+    };
+    if (jobCount > 1) {
+        JobGraph g(JobSystem::getInstance());
+        g.createForEachIndexJob(1U, jobCount, 1U, decodeJob);
+        g.run();
+        decodeJob(0U);
+        g.waitForAll();
+    } else {
+        decodeJob(0U);
+    }
+}
+
+// ETC
+
+constexpr int16_t ETC_MODIFIERS[8][2]{{2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+constexpr int16_t ETC_DISTANCES[8]{3, 6, 11, 16, 23, 32, 41, 64};
+constexpr int16_t EAC_MODIFIERS[16][8]{
+    {-3, -6, -9, -15, 2, 5, 8, 14},
+    {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12},
+    {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11},
+    {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10},
+    {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},
+    {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},
+    {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},
+    {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},
+    {-3, -5, -7, -9, 2, 4, 6, 8},
+};
+
+enum class EtcAlpha {
+    OPAQUE,
+    PUNCH_THROUGH,
+    EAC,
+};
+
+inline uint64_t readBigEndian64(const uint8_t *data) {
+    uint64_t value = 0;
+    for (uint32_t i = 0; i < 8; ++i) {
+        value = (value << 8) | data[i];
+    }
+    return value;
+}
+
+// `count` bits whose most significant one is `msb`.
+inline int32_t etcBits(uint64_t block, uint32_t msb, uint32_t count) {
+    return static_cast<int32_t>((block >> (msb + 1 - count)) & ((1U << count) - 1));
+}
+
+inline int16_t extend4(int32_t v) { return static_cast<int16_t>((v << 4) | v); }
+inline int16_t extend5(int32_t v) { return static_cast<int16_t>((v << 3) | (v >> 2)); }
+inline int16_t extend6(int32_t v) { return static_cast<int16_t>((v << 2) | (v >> 4)); }
+inline int16_t extend7(int32_t v) { return static_cast<int16_t>((v << 1) | (v >> 6)); }
+
+// Pixel indices are stored column by column, most significant bits in the upper half.
+inline uint32_t etcIndex(uint64_t block, uint32_t x, uint32_t y) {
+    const uint32_t i = x * 4 + y;
+    return static_cast<uint32_t>(((block >> (i + 16)) & 1) << 1 | ((block >> i) & 1));
+}
+
+// Writes the unclamped RGBA of the 16 texels of a color block row by row, alpha is 255 or 0 for punch-through.
+void decodeEtcColor(uint64_t block, bool punchThrough, int16_t *texels) {
+    const bool diffBit = ((block >> 33) & 1) != 0;
+    // with punch-through alpha the differential bit tells whether the block is opaque, there is no individual mode
+    const bool opaque = !punchThrough || diffBit;
+
+    int16_t base[2][3];
+    if (!punchThrough && !diffBit) {
+        for (uint32_t c = 0; c < 3; ++c) {
+            base[0][c] = extend4(etcBits(block, 63 - c * 8, 4));
+            base[1][c] = extend4(etcBits(block, 59 - c * 8, 4));
+        }
+    } else {
+        int32_t sums[3];
+        for (uint32_t c = 0; c < 3; ++c) {
+            const int32_t value = etcBits(block, 63 - c * 8, 5);
+            const int32_t delta = (etcBits(block, 58 - c * 8, 3) ^ 4) - 4;
+            sums[c] = value + delta;
+            base[0][c] = extend5(value);
+            base[1][c] = extend5(sums[c] & 31);
+        }
+
+        const bool tMode = sums[0] < 0 || sums[0] > 31;
+        const bool hMode = !tMode && (sums[1] < 0 || sums[1] > 31);
+        if (tMode || hMode) {
+            int16_t c0[3];
+            int16_t c1[3];
+            int32_t distanceIdx = 0;
+            if (tMode) {
+                c0[0] = extend4((etcBits(block, 60, 2) << 2) | etcBits(block, 57, 2));
+                c0[1] = extend4(etcBits(block, 55, 4));
+                c0[2] = extend4(etcBits(block, 51, 4));
+                c1[0] = extend4(etcBits(block, 47, 4));
+                c1[1] = extend4(etcBits(block, 43, 4));
+                c1[2] = extend4(etcBits(block, 39, 4));
+                distanceIdx = (etcBits(block, 35, 2) << 1) | etcBits(block, 32, 1);
+            } else {
+                c0[0] = extend4(etcBits(block, 62, 4));
+                c0[1] = extend4((etcBits(block, 58, 3) << 1) | etcBits(block, 52, 1));
+                c0[2] = extend4((etcBits(block, 51, 1) << 3) | etcBits(block, 49, 3));
+                c1[0] = extend4(etcBits(block, 46, 4));
+                c1[1] = extend4(etcBits(block, 42, 4));
+                c1[2] = extend4(etcBits(block, 38, 4));
+                const uint32_t v0 = (c0[0] << 16) | (c0[1] << 8) | c0[2];
+                const uint32_t v1 = (c1[0] << 16) | (c1[1] << 8) | c1[2];
+                distanceIdx = (etcBits(block, 34, 1) << 2) | (etcBits(block, 32, 1) << 1) | (v0 >= v1 ? 1 : 0);
+            }
+            const int16_t distance = ETC_DISTANCES[distanceIdx];
+            int16_t paints[4][3];
+            for (uint32_t c = 0; c < 3; ++c) {
+                if (tMode) {
+                    paints[0][c] = c0[c];
+                    paints[1][c] = static_cast<int16_t>(c1[c] + distance);
+                    paints[2][c] = c1[c];
+                    paints[3][c] = static_cast<int16_t>(c1[c] - distance);
+                } else {
+                    paints[0][c] = static_cast<int16_t>(c0[c] + distance);
+                    paints[1][c] = static_cast<int16_t>(c0[c] - distance);
+                    paints[2][c] = static_cast<int16_t>(c1[c] + distance);
+                    paints[3][c] = static_cast<int16_t>(c1[c] - distance);
+                }
+            }
+            for (uint32_t y = 0; y < 4; ++y) {
+                for (uint32_t x = 0; x < 4; ++x) {
+                    const uint32_t idx = etcIndex(block, x, y);
+                    int16_t *texel = texels + (y * 4 + x) * 4;
+                    if (!opaque && idx == 2) {
+                        texel[0] = texel[1] = texel[2] = texel[3] = 0;
+                        continue;
+                    }
+                    texel[0] = paints[idx][0];
+                    texel[1] = paints[idx][1];
+                    texel[2] = paints[idx][2];
+                    texel[3] = 255;
+                }
+            }
+            return;
+        }
+
+        if (sums[2] < 0 || sums[2] > 31) {
+            // planar mode, always opaque
+            int32_t o[3];
+            int32_t h[3];
+            int32_t v[3];
+            o[0] = extend6(etcBits(block, 62, 6));
+            o[1] = extend7((etcBits(block, 56, 1) << 6) | etcBits(block, 54, 6));
+            o[2] = extend6((etcBits(block, 48, 1) << 5) | (etcBits(block, 44, 2) << 3) | etcBits(block, 41, 3));
+            h[0] = extend6((etcBits(block, 38, 5) << 1) | etcBits(block, 32, 1));
+            h[1] = extend7(etcBits(block, 31, 7));
+            h[2] = extend6(etcBits(block, 24, 6));
+            v[0] = extend6(etcBits(block, 18, 6));
+            v[1] = extend7(etcBits(block, 12, 7));
+            v[2] = extend6(etcBits(block, 5, 6));
+            for (uint32_t y = 0; y < 4; ++y) {
+                for (uint32_t x = 0; x < 4; ++x) {
+                    int16_t *texel = texels + (y * 4 + x) * 4;
+                    for (uint32_t c = 0; c < 3; ++c) {
+                        texel[c] = static_cast<int16_t>((static_cast<int32_t>(x) * (h[c] - o[c]) + static_cast<int32_t>(y) * (v[c] - o[c]) + 4 * o[c] + 2) >> 2);
+                    }
+                    texel[3] = 255;
+                }
+            }
+            return;
+        }
+    }
+
+    const bool flip = ((block >> 32) & 1) != 0;
+    const int32_t tables[2]{etcBits(block, 39, 3), etcBits(block, 36, 3)};
+    for (uint32_t y = 0; y < 4; ++y) {
+        for (uint32_t x = 0; x < 4; ++x) {
+            const uint32_t sub = flip ? (y >> 1) : (x >> 1);
+            const uint32_t idx = etcIndex(block, x, y);
+            int16_t *texel = texels + (y * 4 + x) * 4;
+            if (!opaque && idx == 2) {
+                texel[0] = texel[1] = texel[2] = texel[3] = 0;
+                continue;
+            }
+            int16_t modifier = (!opaque && idx == 0) ? 0 : ETC_MODIFIERS[tables[sub]][idx & 1];
+            if (idx & 2) {
+                modifier = static_cast<int16_t>(-modifier);
+            }
+            texel[0] = static_cast<int16_t>(base[sub][0] + modifier);
+            texel[1] = static_cast<int16_t>(base[sub][1] + modifier);
+            texel[2] = static_cast<int16_t>(base[sub][2] + modifier);
+            texel[3] = 255;
+        }
+    }
+}
+
+void decodeEacAlpha(uint64_t block, int16_t *texels) {
+    const int32_t base = etcBits(block, 63, 8);
+    const int32_t multiplier = etcBits(block, 55, 4);
+    const int16_t *modifiers = EAC_MODIFIERS[etcBits(block, 51, 4)];
+    for (uint32_t y = 0; y < 4; ++y) {
+        for (uint32_t x = 0; x < 4; ++x) {
+            const uint32_t idx = etcBits(block, 47 - (x * 4 + y) * 3, 3);
+            texels[(y * 4 + x) * 4 + 3] = static_cast<int16_t>(base + modifiers[idx] * multiplier);
+        }
+    }
+}
+
+void decodeEtc(EtcAlpha alpha, const uint8_t *blocks, uint32_t width, uint32_t height, uint8_t *rgba) {
+    const uint32_t blockSize = alpha == EtcAlpha::EAC ? 16 : 8;
+    const uint32_t blocksPerRow = (width + 3) / 4;
+    const uint32_t rowCount = (height + 3) / 4;
+    forEachBlockRows(rowCount, blocksPerRow, [&](uint32_t beginRow, uint32_t endRow) {
+        int16_t values[64];
+        uint8_t texels[64];
+        for (uint32_t row = beginRow; row < endRow; ++row) {
+            const uint8_t *block = blocks + row * blocksPerRow * blockSize;
+            for (uint32_t column = 0; column < blocksPerRow; ++column, block += blockSize) {
+                if (alpha == EtcAlpha::EAC) {
+                    decodeEtcColor(readBigEndian64(block + 8), false, values);
+                    decodeEacAlpha(readBigEndian64(block), values);
+                } else {
+                    decodeEtcColor(readBigEndian64(block), alpha == EtcAlpha::PUNCH_THROUGH, values);
+                }
+                packClamped(values, 64, texels);
+                storeBlock(texels, 4, 4, column * 4, row * 4, width, height, rgba);
+            }
+        }
+    });
+}
+
+// ASTC
+
+constexpr uint32_t ASTC_MAX_TEXELS = 144;
+constexpr uint32_t ASTC_MAX_WEIGHTS = 64;
+constexpr uint32_t ASTC_MIN_WEIGHT_BITS = 24;
+constexpr uint32_t ASTC_MAX_WEIGHT_BITS = 96;
+constexpr uint32_t ASTC_MAX_COLOR_VALUES = 18;
+// index of the 6 levels quantization, the lowest allowed for endpoints
+constexpr uint32_t ASTC_MIN_COLOR_QUANT = 4;
+constexpr uint32_t ASTC_QUANT_COUNT = 21;
+
+// Bounded integer sequence encoding of each quantization level, from 2 to 256 levels.
+struct IseEncoding {
+    uint8_t bits;
+    uint8_t trits;
+    uint8_t quints;
+};
+constexpr IseEncoding ISE_ENCODINGS[ASTC_QUANT_COUNT]{
+    {1, 0, 0}, {0, 1, 0}, {2, 0, 0}, {0, 0, 1}, {1, 1, 0}, {3, 0, 0}, {1, 0, 1},
+    {2, 1, 0}, {4, 0, 0}, {2, 0, 1}, {3, 1, 0}, {5, 0, 0}, {3, 0, 1}, {4, 1, 0},
+    {6, 0, 0}, {4, 0, 1}, {5, 1, 0}, {7, 0, 0}, {5, 0, 1}, {6, 1, 0}, {8, 0, 0}};
+
+uint32_t iseBitCount(uint32_t count, uint32_t quant) {
+    const auto &encoding = ISE_ENCODINGS[quant];
+    return count * encoding.bits + (encoding.trits ? (count * 8 + 4) / 5 : 0) + (encoding.quints ? (count * 7 + 2) / 3 : 0);
+}
+
+uint32_t replicateBits(uint32_t value, uint32_t bits, uint32_t targetBits) {
+    uint32_t result = 0;
+    int32_t shift = static_cast<int32_t>(targetBits);
+    while (shift > 0) {
+        shift -= static_cast<int32_t>(bits);
+        result |= shift >= 0 ? value << shift : value >> -shift;
+    }
+    return result & ((1U << targetBits) - 1);
+}
+
+// Unquantization of the ISE values, indexed by quantization level then value (trit or quint << bits | bits).
+struct AstcTables {
+    uint8_t trits[256][5];
+    uint8_t quints[128][3];
+    uint8_t colors[ASTC_QUANT_COUNT][256];
+    uint8_t weights[12][32];
+
+    AstcTables() {
+        for (uint32_t t = 0; t < 256; ++t) {
+            auto bit = [t](uint32_t i) { return (t >> i) & 1; };
+            uint32_t c = 0;
+            if (((t >> 2) & 7) == 7) {
+                c = (((t >> 5) & 7) << 2) | (t & 3);
+                trits[t][4] = 2;
+                trits[t][3] = 2;
+            } else {
+                c = t & 0x1F;
+                if (((t >> 5) & 3) == 3) {
+                    trits[t][4] = 2;
+                    trits[t][3] = static_cast<uint8_t>(bit(7));
+                } else {
+                    trits[t][4] = static_cast<uint8_t>(bit(7));
+                    trits[t][3] = static_cast<uint8_t>((t >> 5) & 3);
+                }
+            }
+            if ((c & 3) == 3) {
+                trits[t][2] = 2;
+                trits[t][1] = static_cast<uint8_t>((c >> 4) & 1);
+                trits[t][0] = static_cast<uint8_t>((((c >> 3) & 1) << 1) | (((c >> 2) & 1) & ~((c >> 3) & 1)));
+            } else if (((c >> 2) & 3) == 3) {
+                trits[t][2] = 2;
+                trits[t][1] = 2;
+                trits[t][0] = static_cast<uint8_t>(c & 3);
+            } else {
+                trits[t][2] = static_cast<uint8_t>((c >> 4) & 1);
+                trits[t][1] = static_cast<uint8_t>((c >> 2) & 3);
+                trits[t][0] = static_cast<uint8_t>((((c >> 1) & 1) << 1) | ((c & 1) & ~((c >> 1) & 1)));
+            }
+        }
+
+        for (uint32_t q = 0; q < 128; ++q) {
+            auto bit = [q](uint32_t i) { return (q >> i) & 1; };
+            if (((q >> 1) & 3) == 3 && ((q >> 5) & 3) == 0) {
+                quints[q][2] = static_cast<uint8_t>((bit(0) << 2) | ((bit(4) & ~bit(0) & 1) << 1) | (bit(3) & ~bit(0) & 1));
+                quints[q][1] = 4;
+                quints[q][0] = 4;
+                continue;
+            }
+            uint32_t c = 0;
+            if (((q >> 1) & 3) == 3) {
+                quints[q][2] = 4;
+                c = (((q >> 3) & 3) << 3) | ((~(q >> 5) & 3) << 1) | bit(0);
+            } else {
+                quints[q][2] = static_cast<uint8_t>((q >> 5) & 3);
+                c = q & 0x1F;
+            }
+            if ((c & 7) == 5) {
+                quints[q][1] = 4;
+                quints[q][0] = static_cast<uint8_t>((c >> 3) & 3);
+            } else {
+                quints[q][1] = static_cast<uint8_t>((c >> 3) & 3);
+                quints[q][0] = static_cast<uint8_t>(c & 7);
+            }
+        }
+
+        for (uint32_t quant = 0; quant < ASTC_QUANT_COUNT; ++quant) {
+            const auto &encoding = ISE_ENCODINGS[quant];
+            const uint32_t levels = (encoding.trits ? 3 : (encoding.quints ? 5 : 1)) << encoding.bits;
+            for (uint32_t value = 0; value < levels; ++value) {
+                colors[quant][value] = quant < ASTC_MIN_COLOR_QUANT ? 0 : unquantizeColor(encoding, value);
+                if (quant < 12) {
+                    weights[quant][value] = unquantizeWeight(encoding, value);
+                }
+            }
+        }
+    }
+
+    static uint8_t unquantizeColor(const IseEncoding &encoding, uint32_t value) {
+        const uint32_t n = encoding.bits;
+        if (!encoding.trits && !encoding.quints) {
+            return static_cast<uint8_t>(replicateBits(value, n, 8));
+        }
+        const uint32_t d = value >> n;
+        const uint32_t m = value & ((1U << n) - 1);
+        const uint32_t a = (m & 1) ? 0x1FF : 0;
+        const uint32_t b1 = (m >> 1) & 1;
+        const uint32_t c1 = (m >> 2) & 1;
+        const uint32_t d1 = (m >> 3) & 1;
+        const uint32_t e1 = (m >> 4) & 1;
+        const uint32_t f1 = (m >> 5) & 1;
+        uint32_t b = 0;
+        uint32_t c = 0;
+        if (encoding.trits) {
+            switch (n) {
+                case 1: c = 204; break;
+                case 2: c = 93; b = (b1 << 8) | (b1 << 4) | (b1 << 2) | (b1 << 1); break;
+                case 3: c = 44; b = (c1 << 8) | (b1 << 7) | (c1 << 3) | (b1 << 2) | (c1 << 1) | b1; break;
+                case 4: c = 22; b = (d1 << 8) | (c1 << 7) | (b1 << 6) | (d1 << 2) | (c1 << 1) | b1; break;
+                case 5: c = 11; b = (e1 << 8) | (d1 << 7) | (c1 << 6) | (b1 << 5) | (e1 << 1) | d1; break;
+                default: c = 5; b = (f1 << 8) | (e1 << 7) | (d1 << 6) | (c1 << 5) | (b1 << 4) | f1; break;
+            }
+        } else {
+            switch (n) {
+                case 1: c = 113; break;
+                case 2: c = 54; b = (b1 << 8) | (b1 << 3) | (b1 << 2); break;
+                case 3: c = 26; b = (c1 << 8) | (b1 << 7) | (c1 << 2) | (b1 << 1) | c1; break;
+                case 4: c = 13; b = (d1 << 8) | (c1 << 7) | (b1 << 6) | (d1 << 1) | c1; break;
+                default: c = 6; b = (e1 << 8) | (d1 << 7) | (c1 << 6) | (b1 << 5) | e1; break;
+            }
+        }
+        const uint32_t t = (d * c + b) ^ a;
+        return static_cast<uint8_t>((a & 0x80) | (t >> 2));
+    }
+
+    static uint8_t unquantizeWeight(const IseEncoding &encoding, uint32_t value) {
+        const uint32_t n = encoding.bits;
+        uint32_t weight = 0;
+        if (!encoding.trits && !encoding.quints) {
+            weight = replicateBits(value, n, 6);
+        } else if (n == 0) {
+            static constexpr uint8_t TRIT_WEIGHTS[3]{0, 32, 63};
+            static constexpr uint8_t QUINT_WEIGHTS[5]{0, 16, 32, 47, 63};
+            weight = encoding.trits ? TRIT_WEIGHTS[value] : QUINT_WEIGHTS[value];
+        } else {
+            const uint32_t d = value >> n;
+            const uint32_t m = value & ((1U << n) - 1);
+            const uint32_t a = (m & 1) ? 0x7F : 0;
+            const uint32_t b1 = (m >> 1) & 1;
+            const uint32_t c1 = (m >> 2) & 1;
+            uint32_t b = 0;
+            uint32_t c = 0;
+            if (encoding.trits) {
+                switch (n) {
+                    case 1: c = 50; break;
+                    case 2: c = 23; b = (b1 << 6) | (b1 << 2) | b1; break;
+                    default: c = 11; b = (c1 << 6) | (b1 << 5) | (c1 << 1) | b1; break;
+                }
+            } else {
+                switch (n) {
+                    case 1: c = 28; break;
+                    default: c = 13; b = (b1 << 6) | (b1 << 1); break;
+                }
+            }
+            const uint32_t t = (d * c + b) ^ a;
+            weight = (a & 0x20) | (t >> 2);
+        }
+        return static_cast<uint8_t>(weight > 32 ? weight + 1 : weight);
+    }
+};
+
+const AstcTables &astcTables() {
+    static const AstcTables tables;
+    return tables;
+}
+
+struct AstcBits {
+    uint64_t lo;
+    uint64_t hi;
+
+    uint32_t get(uint32_t offset, uint32_t count) const {
+        if (count == 0) {
+            return 0;
+        }
+        const uint64_t word = offset < 64 ? lo : hi;
+        const uint32_t shift = offset & 63;
+        uint64_t value = word >> shift;
+        if (offset < 64 && shift + count > 64) {
+            value |= hi << (64 - shift);
+        }
+        return static_cast<uint32_t>(value & ((1ULL << count) - 1));
+    }
+};
+
+inline uint64_t reverseBits(uint64_t v) {
+    v = ((v >> 1) & 0x5555555555555555ULL) | ((v & 0x5555555555555555ULL) << 1);
+    v = ((v >> 2) & 0x3333333333333333ULL) | ((v & 0x3333333333333333ULL) << 2);
+    v = ((v >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((v & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    v = ((v >> 8) & 0x00FF00FF00FF00FFULL) | ((v & 0x00FF00FF00FF00FFULL) << 8);
+    v = ((v >> 16) & 0x0000FFFF0000FFFFULL) | ((v & 0x0000FFFF0000FFFFULL) << 16);
+    return (v >> 32) | (v << 32);
+}
+
+// Reads `count` values of the sequence starting at `offset`, bits past its end read as zeros.
+void decodeIse(const AstcBits &bits, uint32_t offset, uint32_t count, uint32_t quant, uint8_t *values) {
+    const auto &encoding = ISE_ENCODINGS[quant];
+    const uint32_t end = offset + iseBitCount(count, quant);
+    auto read = [&](uint32_t n) {
+        const uint32_t available = offset < end ? std::min(n, end - offset) : 0;
+        const uint32_t value = bits.get(offset, available);
+        offset += n;
+        return value;
+    };
+
+    const uint32_t n = encoding.bits;
+    const auto &tables = astcTables();
+    if (encoding.trits) {
+        for (uint32_t i = 0; i < count; i += 5) {
+            uint32_t m[5];
+            uint32_t t = 0;
+            m[0] = read(n);
+            t |= read(2);
+            m[1] = read(n);
+            t |= read(2) << 2;
+            m[2] = read(n);
+            t |= read(1) << 4;
+            m[3] = read(n);
+            t |= read(2) << 5;
+            m[4] = read(n);
+            t |= read(1) << 7;
+            for (uint32_t j = 0; j < 5 && i + j < count; ++j) {
+                values[i + j] = static_cast<uint8_t>((tables.trits[t][j] << n) | m[j]);
+            }
+        }
+    } else if (encoding.quints) {
+        for (uint32_t i = 0; i < count; i += 3) {
+            uint32_t m[3];
+            uint32_t q = 0;
+            m[0] = read(n);
+            q |= read(3);
+            m[1] = read(n);
+            q |= read(2) << 3;
+            m[2] = read(n);
+            q |= read(2) << 5;
+            for (uint32_t j = 0; j < 3 && i + j < count; ++j) {
+                values[i + j] = static_cast<uint8_t>((tables.quints[q][j] << n) | m[j]);
+            }
+        }
+    } else {
+        for (uint32_t i = 0; i < count; ++i) {
+            values[i] = static_cast<uint8_t>(read(n));
+        }
+    }
+}
+
+struct AstcBlockMode {
+    uint32_t gridWidth{0};
+    uint32_t gridHeight{0};
+    uint32_t weightQuant{0};
+    bool dualPlane{false};
+};
+
+bool decodeBlockMode(uint32_t mode, AstcBlockMode *out) {
+    uint32_t quant = (mode >> 4) & 1;
+    uint32_t high = (mode >> 9) & 1;
+    uint32_t dual = (mode >> 10) & 1;
+    const uint32_t a = (mode >> 5) & 3;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    if ((mode & 3) != 0) {
+        quant |= (mode & 3) << 1;
+        uint32_t b = (mode >> 7) & 3;
+        switch ((mode >> 2) & 3) {
+            case 0: width = b + 4; height = a + 2; break;
+            case 1: width = b + 8; height = a + 2; break;
+            case 2: width = a + 2; height = b + 8; break;
+            default:
+                b &= 1;
+                if (mode & 0x100) {
+                    width = b + 2;
+                    height = a + 2;
+                } else {
+                    width = a + 2;
+                    height = b + 6;
+                }
+                break;
+        }
+    } else {
+        quant |= ((mode >> 2) & 3) << 1;
+        if (((mode >> 2) & 3) == 0) {
+            return false;
+        }
+        const uint32_t b = (mode >> 9) & 3;
+        switch ((mode >> 7) & 3) {
+            case 0: width = 12; height = a + 2; break;
+            case 1: width = a + 2; height = 12; break;
+            case 2:
+                width = a + 6;
+                height = b + 6;
+                dual = 0;
+                high = 0;
+                break;
+            default:
+                if (a == 0) {
+                    width = 6;
+                    height = 10;
+                } else if (a == 1) {
+                    width = 10;
+                    height = 6;
+                } else {
+                    return false;
+                }
+                break;
+        }
+    }
+
+    out->gridWidth = width;
+    out->gridHeight = height;
+    out->weightQuant = quant - 2 + 6 * high;
+    out->dualPlane = dual != 0;
+    const uint32_t weightCount = width * height * (dual + 1);
+    const uint32_t weightBits = iseBitCount(weightCount, out->weightQuant);
+    return weightCount <= ASTC_MAX_WEIGHTS && weightBits >= ASTC_MIN_WEIGHT_BITS && weightBits <= ASTC_MAX_WEIGHT_BITS;
+}
+
+uint32_t hashPartitionSeed(uint32_t seed) {
+    seed ^= seed >> 15;
+    seed -= seed << 17;
+    seed += seed << 7;
+    seed += seed << 4;
+    seed ^= seed >> 5;
+    seed += seed << 16;
+    seed ^= seed >> 7;
+    seed ^= seed >> 3;
+    seed ^= seed << 6;
+    seed ^= seed >> 17;
+    return seed;
+}
+
+// The partition selection function of the spec, for 2D blocks, with the seed hashed once per block.
+struct AstcPartitioning {
+    uint32_t count{1};
+    uint32_t rnum{0};
+    uint8_t seeds[8]{};
+
+    AstcPartitioning(uint32_t partitionIndex, uint32_t partitionCount) : count(partitionCount) {
+        rnum = hashPartitionSeed(partitionIndex + (partitionCount - 1) * 1024);
+        uint32_t squares[8];
+        for (uint32_t i = 0; i < 8; ++i) {
+            const uint32_t s = (rnum >> (i * 4)) & 0xF;
+            squares[i] = s * s;
+        }
+        uint32_t sh1 = 0;
+        uint32_t sh2 = 0;
+        if (partitionIndex & 1) {
+            sh1 = (partitionIndex & 2) ? 4 : 5;
+            sh2 = partitionCount == 3 ? 6 : 5;
+        } else {
+            sh1 = partitionCount == 3 ? 6 : 5;
+            sh2 = (partitionIndex & 2) ? 4 : 5;
+        }
+        for (uint32_t i = 0; i < 8; ++i) {
+            seeds[i] = static_cast<uint8_t>(squares[i] >> ((i & 1) ? sh2 : sh1));
+        }
+    }
+
+    uint32_t select(uint32_t x, uint32_t y) const {
+        const uint32_t a = (seeds[0] * x + seeds[1] * y + (rnum >> 14)) & 0x3F;
+        const uint32_t b = (seeds[2] * x + seeds[3] * y + (rnum >> 10)) & 0x3F;
+        const uint32_t c = count < 3 ? 0 : (seeds[4] * x + seeds[5] * y + (rnum >> 6)) & 0x3F;
+        const uint32_t d = count < 4 ? 0 : (seeds[6] * x + seeds[7] * y + (rnum >> 2)) & 0x3F;
+        if (a >= b && a >= c && a >= d) {
+            return 0;
+        }
+        if (b >= c && b >= d) {
+            return 1;
+        }
+        return c >= d ? 2 : 3;
+    }
+};
+
+inline void bitTransferSigned(int32_t &a, int32_t &b) {
+    b >>= 1;
+    b |= a & 0x80;
+    a >>= 1;
+    a &= 0x3F;
+    if (a & 0x20) {
+        a -= 0x40;
+    }
+}
+
+inline int32_t clampUnorm8(int32_t v) {
+    return std::min(std::max(v, 0), 255);
+}
+
+inline void setColor(uint16_t *out, int32_t r, int32_t g, int32_t b, int32_t a) {
+    out[0] = static_cast<uint16_t>(clampUnorm8(r));
+    out[1] = static_cast<uint16_t>(clampUnorm8(g));
+    out[2] = static_cast<uint16_t>(clampUnorm8(b));
+    out[3] = static_cast<uint16_t>(clampUnorm8(a));
+}
+
+inline void setBlueContracted(uint16_t *out, int32_t r, int32_t g, int32_t b, int32_t a) {
+    setColor(out, (r + b) >> 1, (g + b) >> 1, b, a);
+}
+
+// Returns false for the HDR endpoint modes, which decode to the error color in the LDR profile.
+bool decodeEndpoints(uint32_t mode, const uint8_t *values, uint16_t *e0, uint16_t *e1) {
+    int32_t v[8];
+    for (uint32_t i = 0; i < 8; ++i) {
+        v[i] = i < ((mode >> 2) + 1) * 2 ? values[i] : 0;
+    }
+    switch (mode) {
+        case 0:
+            setColor(e0, v[0], v[0], v[0], 0xFF);
+            setColor(e1, v[1], v[1], v[1], 0xFF);
+            return true;
+        case 1: {
+            const int32_t l0 = (v[0] >> 2) | (v[1] & 0xC0);
+            const int32_t l1 = std::min(l0 + (v[1] & 0x3F), 0xFF);
+            setColor(e0, l0, l0, l0, 0xFF);
+            setColor(e1, l1, l1, l1, 0xFF);
+            return true;
+        }
+        case 4:
+            setColor(e0, v[0], v[0], v[0], v[2]);
+            setColor(e1, v[1], v[1], v[1], v[3]);
+            return true;
+        case 5:
+            bitTransferSigned(v[1], v[0]);
+            bitTransferSigned(v[3], v[2]);
+            setColor(e0, v[0], v[0], v[0], v[2]);
+            setColor(e1, v[0] + v[1], v[0] + v[1], v[0] + v[1], v[2] + v[3]);
+            return true;
+        case 6:
+            setColor(e0, (v[0] * v[3]) >> 8, (v[1] * v[3]) >> 8, (v[2] * v[3]) >> 8, 0xFF);
+            setColor(e1, v[0], v[1], v[2], 0xFF);
+            return true;
+        case 8:
+        case 12: {
+            const int32_t a0 = mode == 12 ? v[6] : 0xFF;
+            const int32_t a1 = mode == 12 ? v[7] : 0xFF;
+            if (v[1] + v[3] + v[5] >= v[0] + v[2] + v[4]) {
+                setColor(e0, v[0], v[2], v[4], a0);
+                setColor(e1, v[1], v[3], v[5], a1);
+            } else {
+                setBlueContracted(e0, v[1], v[3], v[5], a1);
+                setBlueContracted(e1, v[0], v[2], v[4], a0);
+            }
+            return true;
+        }
+        case 9:
+        case 13: {
+            bitTransferSigned(v[1], v[0]);
+            bitTransferSigned(v[3], v[2]);
+            bitTransferSigned(v[5], v[4]);
+            int32_t a0 = 0xFF;
+            int32_t a1 = 0xFF;
+            if (mode == 13) {
+                bitTransferSigned(v[7], v[6]);
+                a0 = v[6];
+                a1 = v[6] + v[7];
+            }
+            if (v[1] + v[3] + v[5] >= 0) {
+                setColor(e0, v[0], v[2], v[4], a0);
+                setColor(e1, v[0] + v[1], v[2] + v[3], v[4] + v[5], a1);
+            } else {
+                setBlueContracted(e0, v[0] + v[1], v[2] + v[3], v[4] + v[5], a1);
+                setBlueContracted(e1, v[0], v[2], v[4], a0);
+            }
+            return true;
+        }
+        case 10:
+            setColor(e0, (v[0] * v[3]) >> 8, (v[1] * v[3]) >> 8, (v[2] * v[3]) >> 8, v[4]);
+            setColor(e1, v[0], v[1], v[2], v[5]);
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Per texel bilinear infill of the weight grid, cached since consecutive blocks usually share their grid.
+struct AstcInfill {
+    uint32_t gridWidth{0};
+    uint32_t gridHeight{0};
+    uint8_t indices[ASTC_MAX_TEXELS];
+    uint8_t factors[ASTC_MAX_TEXELS][4];
+
+    void update(uint32_t blockWidth, uint32_t blockHeight, uint32_t width, uint32_t height) {
+        if (gridWidth == width && gridHeight == height) {
+            return;
+        }
+        gridWidth = width;
+        gridHeight = height;
+        const uint32_t ds = (1024 + blockWidth / 2) / (blockWidth - 1);
+        const uint32_t dt = (1024 + blockHeight / 2) / (blockHeight - 1);
+        for (uint32_t t = 0; t < blockHeight; ++t) {
+            for (uint32_t s = 0; s < blockWidth; ++s) {
+                const uint32_t gs = (ds * s * (width - 1) + 32) >> 6;
+                const uint32_t gt = (dt * t * (height - 1) + 32) >> 6;
+                const uint32_t fs = gs & 0xF;
+                const uint32_t ft = gt & 0xF;
+                const uint32_t w11 = (fs * ft + 8) >> 4;
+                const uint32_t i = t * blockWidth + s;
+                indices[i] = static_cast<uint8_t>((gs >> 4) + (gt >> 4) * width);
+                factors[i][0] = static_cast<uint8_t>(16 - fs - ft + w11);
+                factors[i][1] = static_cast<uint8_t>(fs - w11);
+                factors[i][2] = static_cast<uint8_t>(ft - w11);
+                factors[i][3] = static_cast<uint8_t>(w11);
+            }
+        }
+    }
+
+    // `grid` is padded so that the neighbours of the last row and column, with zero factors, can be read
+    uint16_t sample(const uint8_t *grid, uint32_t texel) const {
+        const uint8_t *p = grid + indices[texel];
+        const uint8_t *f = factors[texel];
+        return static_cast<uint16_t>((p[0] * f[0] + p[1] * f[1] + p[gridWidth] * f[2] + p[gridWidth + 1] * f[3] + 8) >> 4);
+    }
+};
+
+struct AstcScratch {
+    AstcInfill infill;
+    uint8_t values[ASTC_MAX_WEIGHTS]{};
+    uint8_t grids[2][ASTC_MAX_WEIGHTS + 16]{};
+    alignas(16) uint16_t e0[ASTC_MAX_TEXELS * 4]{};
+    alignas(16) uint16_t e1[ASTC_MAX_TEXELS * 4]{};
+    alignas(16) uint16_t weights[ASTC_MAX_TEXELS * 4]{};
+    alignas(16) uint8_t texels[ASTC_MAX_TEXELS * 4]{};
+};
+
+void fillTexels(uint8_t *texels, uint32_t count, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    for (uint32_t i = 0; i < count; ++i) {
+        texels[i * 4] = r;
+        texels[i * 4 + 1] = g;
+        texels[i * 4 + 2] = b;
+        texels[i * 4 + 3] = a;
+    }
+}
+
+// Decodes a block into scratch.texels, returns false for blocks that are not valid in the LDR profile.
+bool decodeAstcBlock(const uint8_t *data, uint32_t blockWidth, uint32_t blockHeight, bool srgb, AstcScratch &scratch) {
+    const uint32_t texelCount = blockWidth * blockHeight;
+    AstcBits bits{0, 0};
+    for (uint32_t i = 0; i < 8; ++i) {
+        bits.lo |= static_cast<uint64_t>(data[i]) << (i * 8);
+        bits.hi |= static_cast<uint64_t>(data[i + 8]) << (i * 8);
+    }
+
+    const uint32_t mode = bits.get(0, 11);
+    if ((mode & 0x1FF) == 0x1FC) {
+        // void extent, the HDR flag is an error in the LDR profile
+        if ((mode & 0x200) || bits.get(10, 2) != 3) {
+            return false;
+        }
+        const uint32_t minS = bits.get(12, 13);
+        const uint32_t maxS = bits.get(25, 13);
+        const uint32_t minT = bits.get(38, 13);
+        const uint32_t maxT = bits.get(51, 13);
+        const bool allOnes = minS == 0x1FFF && maxS == 0x1FFF && minT == 0x1FFF && maxT == 0x1FFF;
+        if (!allOnes && (minS >= maxS || minT >= maxT)) {
+            return false;
+        }
+        uint8_t color[4];
+        for (uint32_t c = 0; c < 4; ++c) {
+            const uint32_t value = bits.get(64 + c * 16, 16);
+            color[c] = static_cast<uint8_t>(value >> 8);
+        }
+        fillTexels(scratch.texels, texelCount, color[0], color[1], color[2], color[3]);
+        return true;
+    }
+
+    AstcBlockMode blockMode;
+    if (!decodeBlockMode(mode, &blockMode) || blockMode.gridWidth > blockWidth || blockMode.gridHeight > blockHeight) {
+        return false;
+    }
+    const uint32_t partitionCount = bits.get(11, 2) + 1;
+    if (blockMode.dualPlane && partitionCount == 4) {
+        return false;
+    }
+
+    const uint32_t gridSize = blockMode.gridWidth * blockMode.gridHeight;
+    const uint32_t weightCount = gridSize * (blockMode.dualPlane ? 2 : 1);
+    uint32_t belowWeights = 128 - iseBitCount(weightCount, blockMode.weightQuant);
+
+    uint32_t endpointModes[4]{};
+    uint32_t colorStart = 17;
+    uint32_t partitionIndex = 0;
+    if (partitionCount == 1) {
+        endpointModes[0] = bits.get(13, 4);
+    } else {
+        colorStart = 29;
+        partitionIndex = bits.get(13, 10);
+        uint32_t encoded = bits.get(23, 6);
+        const uint32_t selector = encoded & 3;
+        if (selector == 0) {
+            for (uint32_t p = 0; p < partitionCount; ++p) {
+                endpointModes[p] = encoded >> 2;
+            }
+        } else {
+            // the high bits of the modes are stored below the weights
+            const uint32_t extraBits = 3 * partitionCount - 4;
+            belowWeights -= extraBits;
+            encoded |= bits.get(belowWeights, extraBits) << 6;
+            for (uint32_t p = 0; p < partitionCount; ++p) {
+                const uint32_t modeClass = selector - 1 + ((encoded >> (2 + p)) & 1);
+                endpointModes[p] = (modeClass << 2) | ((encoded >> (2 + partitionCount + p * 2)) & 3);
+            }
+        }
+    }
+    uint32_t plane2Component = 4;
+    if (blockMode.dualPlane) {
+        belowWeights -= 2;
+        plane2Component = bits.get(belowWeights, 2);
+    }
+
+    uint32_t colorValueCount = 0;
+    for (uint32_t p = 0; p < partitionCount; ++p) {
+        colorValueCount += ((endpointModes[p] >> 2) + 1) * 2;
+    }
+    if (colorValueCount > ASTC_MAX_COLOR_VALUES || belowWeights <= colorStart) {
+        return false;
+    }
+    const uint32_t colorBits = belowWeights - colorStart;
+    uint32_t colorQuant = ASTC_QUANT_COUNT - 1;
+    while (colorQuant >= ASTC_MIN_COLOR_QUANT && iseBitCount(colorValueCount, colorQuant) > colorBits) {
+        --colorQuant;
+    }
+    if (colorQuant < ASTC_MIN_COLOR_QUANT) {
+        return false;
+    }
+
+    const auto &tables = astcTables();
+    uint8_t colorValues[ASTC_MAX_COLOR_VALUES];
+    decodeIse(bits, colorStart, colorValueCount, colorQuant, colorValues);
+    uint16_t endpoints[4][2][4];
+    const uint8_t *colorValue = colorValues;
+    for (uint32_t p = 0; p < partitionCount; ++p) {
+        uint8_t unquantized[8];
+        const uint32_t count = ((endpointModes[p] >> 2) + 1) * 2;
+        for (uint32_t i = 0; i < count; ++i) {
+            unquantized[i] = tables.colors[colorQuant][colorValue[i]];
+        }
+        colorValue += count;
+        if (!decodeEndpoints(endpointModes[p], unquantized, endpoints[p][0], endpoints[p][1])) {
+            return false;
+        }
+    }
+
+    // the weights are stored bit reversed from the end of the block
+    const AstcBits reversed{reverseBits(bits.hi), reverseBits(bits.lo)};
+    decodeIse(reversed, 0, weightCount, blockMode.weightQuant, scratch.values);
+    const uint32_t planeCount = blockMode.dualPlane ? 2 : 1;
+    for (uint32_t i = 0; i < gridSize; ++i) {
+        for (uint32_t plane = 0; plane < planeCount; ++plane) {
+            scratch.grids[plane][i] = tables.weights[blockMode.weightQuant][scratch.values[i * planeCount + plane]];
+        }
+    }
+    scratch.infill.update(blockWidth, blockHeight, blockMode.gridWidth, blockMode.gridHeight);
+
+    const AstcPartitioning partitioning(partitionIndex, partitionCount);
+    const bool smallBlock = texelCount < 31;
+    for (uint32_t y = 0; y < blockHeight; ++y) {
+        for (uint32_t x = 0; x < blockWidth; ++x) {
+            const uint32_t texel = y * blockWidth + x;
+            const uint32_t p = partitionCount == 1 ? 0 : (smallBlock ? partitioning.select(x << 1, y << 1) : partitioning.select(x, y));
+            const uint16_t weight = scratch.infill.sample(scratch.grids[0], texel);
+            const uint16_t weight2 = blockMode.dualPlane ? scratch.infill.sample(scratch.grids[1], texel) : weight;
+            for (uint32_t c = 0; c < 4; ++c) {
+                scratch.e0[texel * 4 + c] = endpoints[p][0][c];
+                scratch.e1[texel * 4 + c] = endpoints[p][1][c];
+                scratch.weights[texel * 4 + c] = c == plane2Component ? weight2 : weight;
+            }
+        }
+    }
+    interpolate(scratch.e0, scratch.e1, scratch.weights, (texelCount * 4 + KERNEL_WIDTH - 1) / KERNEL_WIDTH * KERNEL_WIDTH, srgb, scratch.texels);
+    return true;
+}
+
+void decodeAstc(uint32_t blockWidth, uint32_t blockHeight, bool srgb, const uint8_t *blocks, uint32_t width, uint32_t height, uint8_t *rgba) {
+    const uint32_t blocksPerRow = (width + blockWidth - 1) / blockWidth;
+    const uint32_t rowCount = (height + blockHeight - 1) / blockHeight;
+    forEachBlockRows(rowCount, blocksPerRow, [&](uint32_t beginRow, uint32_t endRow) {
+        AstcScratch scratch;
+        for (uint32_t row = beginRow; row < endRow; ++row) {
+            const uint8_t *block = blocks + row * blocksPerRow * 16;
+            for (uint32_t column = 0; column < blocksPerRow; ++column, block += 16) {
+                if (!decodeAstcBlock(block, blockWidth, blockHeight, srgb, scratch)) {
+                    fillTexels(scratch.texels, blockWidth * blockHeight, 0xFF, 0, 0xFF, 0xFF);
+                }
+                storeBlock(scratch.texels, blockWidth, blockHeight, column * blockWidth, row * blockHeight, width, height, rgba);
+            }
+        }
+    });
+}
+
+bool getAstcBlockSize(gfx::Format format, uint32_t *blockWidth, uint32_t *blockHeight) {
+    static constexpr uint8_t BLOCK_SIZES[14][2]{{4, 4}, {5, 4}, {5, 5}, {6, 5}, {6, 6}, {8, 5}, {8, 6}, {8, 8}, {10, 5}, {10, 6}, {10, 8}, {10, 10}, {12, 10}, {12, 12}};
+    uint32_t index = 0;
+    if (format >= gfx::Format::ASTC_RGBA_4X4 && format <= gfx::Format::ASTC_RGBA_12X12) {
+        index = static_cast<uint32_t>(format) - static_cast<uint32_t>(gfx::Format::ASTC_RGBA_4X4);
+    } else if (format >= gfx::Format::ASTC_SRGBA_4X4 && format <= gfx::Format::ASTC_SRGBA_12X12) {
+        index = static_cast<uint32_t>(format) - static_cast<uint32_t>(gfx::Format::ASTC_SRGBA_4X4);
+    } else {
+        return false;
+    }
+    *blockWidth = BLOCK_SIZES[index][0];
+    *blockHeight = BLOCK_SIZES[index][1];
+    return true;
+}
+
+} // namespace
+
+bool CompressedTextureDecoder::isSupported(gfx::Format format) {
+    return getDecodedFormat(format) != gfx::Format::UNKNOWN;
+}
+
+gfx::Format CompressedTextureDecoder::getDecodedFormat(gfx::Format format) {
+    switch (format) {
+        case gfx::Format::ETC_RGB8:
+        case gfx::Format::ETC2_RGB8:
+        case gfx::Format::ETC2_RGB8_A1:
+        case gfx::Format::ETC2_RGBA8:
+            return gfx::Format::RGBA8;
+        case gfx::Format::ETC2_SRGB8:
+        case gfx::Format::ETC2_SRGB8_A1:
+        case gfx::Format::ETC2_SRGB8_A8:
+            return gfx::Format::SRGB8_A8;
+        default:
+            break;
+    }
+    if (format >= gfx::Format::ASTC_RGBA_4X4 && format <= gfx::Format::ASTC_RGBA_12X12) {
+        return gfx::Format::RGBA8;
+    }
+    if (format >= gfx::Format::ASTC_SRGBA_4X4 && format <= gfx::Format::ASTC_SRGBA_12X12) {
+        return gfx::Format::SRGB8_A8;
+    }
+    return gfx::Format::UNKNOWN;
+}
+
+bool CompressedTextureDecoder::decode(gfx::Format format, const uint8_t *blocks, uint32_t width, uint32_t height, uint8_t *rgba) {
+    if (width == 0 || height == 0) {
+        return isSupported(format);
+    }
+    switch (format) {
+        case gfx::Format::ETC_RGB8:
+        case gfx::Format::ETC2_RGB8:
+        case gfx::Format::ETC2_SRGB8:
+            decodeEtc(EtcAlpha::OPAQUE, blocks, width, height, rgba);
+            return true;
+        case gfx::Format::ETC2_RGB8_A1:
+        case gfx::Format::ETC2_SRGB8_A1:
+            decodeEtc(EtcAlpha::PUNCH_THROUGH, blocks, width, height, rgba);
+            return true;
+        case gfx::Format::ETC2_RGBA8:
+        case gfx::Format::ETC2_SRGB8_A8:
+            decodeEtc(EtcAlpha::EAC, blocks, width, height, rgba);
+            return true;
+        default:
+            break;
+    }
+    uint32_t blockWidth = 0;
+    uint32_t blockHeight = 0;
+    if (getAstcBlockSize(format, &blockWidth, &blockHeight)) {
+        decodeAstc(blockWidth, blockHeight, format >= gfx::Format::ASTC_SRGBA_4X4, blocks, width, height, rgba);
+        return true;
+    }
+    return false;
+}
+
+} // namespace cc
@@ -0,0 +1,52 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include "base/Macros.h"
+#include "renderer/gfx-base/GFXDef-common.h"
+
+namespace cc {
+
+/**
+ * Decodes ETC1, ETC2 (RGB, punch-through alpha and RGBA with EAC alpha) and LDR ASTC blocks to RGBA8 on the CPU,
+ * for devices that can't sample these formats. Rows of blocks are decoded in parallel on the job system.
+ */
+class CC_DLL CompressedTextureDecoder final {
+public:
+    static bool isSupported(gfx::Format format);
+
+    // SRGB8_A8 for the sRGB formats, RGBA8 otherwise, UNKNOWN if the format is not supported.
+    static gfx::Format getDecodedFormat(gfx::Format format);
+
+    // Decodes the blocks of a width x height image into tightly packed RGBA8 texels,
+    // returns false if the format is not supported. Invalid ASTC blocks decode to magenta, as on GPUs.
+    static bool decode(gfx::Format format, const uint8_t *blocks, uint32_t width, uint32_t height, uint8_t *rgba);
+
+    CompressedTextureDecoder() = delete;
+};
+
+} // namespace cc
@@ -260,6 +260,58 @@ void pngReadCallback(png_structp pngPtr, png_bytep data, png_size_t length) {
     }
 }
 #endif //CC_USE_PNG
+
+// Expands a row of 1 (L), 2 (LA) or 3 (RGB) component pixels to RGBA8.
+void expandToRGBA8(const unsigned char *src, uint32_t components, uint32_t count, unsigned char *dst) {
+    for (uint32_t i = 0; i < count; ++i, src += components, dst += 4) {
+        if (components >= 3) {
+            dst[0] = src[0];
+            dst[1] = src[1];
+            dst[2] = src[2];
+        } else {
+            dst[0] = dst[1] = dst[2] = src[0];
+        }
+        dst[3] = components == 2 ? src[1] : 255;
+    }
+}
+
+uint32_t readBigEndian16(const unsigned char *data) {
+    return (static_cast<uint32_t>(data[0]) << 8) | data[1];
+}
+
+uint32_t readBigEndian32(const unsigned char *data) {
+    return (readBigEndian16(data) << 16) | readBigEndian16(data + 2);
+}
+
+uint32_t getRGBA8Size(uint32_t width, uint32_t height) {
+    const uint64_t size = static_cast<uint64_t>(width) * height * 4;
+    return size > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(size);
+}
+
+// Finds the frame header of a JPEG stream, which comes before the scan data.
+uint32_t getJpgDecodedSize(const unsigned char *data, uint32_t dataLen) {
+    uint32_t offset = 2;
+    while (offset + 9 <= dataLen) {
+        if (data[offset] != 0xFF) {
+            return 0;
+        }
+        const unsigned char marker = data[offset + 1];
+        if (marker == 0xFF) {
+            ++offset; // fill byte
+            continue;
+        }
+        // SOF0 to SOF15, except DHT, JPG and DAC
+        if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC) {
+            return getRGBA8Size(readBigEndian16(data + offset + 7), readBigEndian16(data + offset + 5));
+        }
+        if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8)) {
+            offset += 2; // markers without payload
+            continue;
+        }
+        offset += 2 + readBigEndian16(data + offset + 2);
+    }
+    return 0;
+}
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -405,6 +457,33 @@ bool Image::isPvr(const unsigned char *data, uint32_t dataLen) {
     return memcmp(&headerv2->pvrTag, G_PVR_TEX_IDENTIFIER, strlen(G_PVR_TEX_IDENTIFIER)) == 0 || CC_SWAP_INT32_BIG_TO_HOST(headerv3->version) == 0x50565203;
 }
 
+uint32_t Image::getDecodedSize(const unsigned char *data, uint32_t dataLen) {
+    switch (detectFormat(data, dataLen)) {
+        case Format::PNG:
+            // the IHDR chunk always comes first
+            return dataLen < 24 ? 0 : getRGBA8Size(readBigEndian32(data + 16), readBigEndian32(data + 20));
+        case Format::JPG:
+            return getJpgDecodedSize(data, dataLen);
+#if CC_USE_WEBP
+        case Format::WEBP: {
+            int width = 0;
+            int height = 0;
+            if (WebPGetInfo(data, dataLen, &width, &height) == 0) {
+                return 0;
+            }
+            return getRGBA8Size(width, height);
+        }
+#else
+        case Format::WEBP:
+#endif
+        case Format::UNKNOWN:
+            return 0;
+        default:
+            // compressed textures are copied as they are
+            return dataLen;
+    }
+}
+
 Image::Format Image::detectFormat(const unsigned char *data, uint32_t dataLen) {
     if (isPng(data, dataLen)) {
         return Format::PNG;
@@ -528,6 +607,7 @@ bool Image::initWithJpgData(const unsigned char *data, uint32_t dataLen) {
     /* libjpeg data structure for storing one row, that is, scanline of an image */
     JSAMPROW rowPointer[1] = {nullptr};
     uint32_t location = 0;
+    ccstd::vector<unsigned char> row;
 
     bool ret = false;
     do {
@@ -563,6 +643,12 @@ bool Image::initWithJpgData(const unsigned char *data, uint32_t dataLen) {
             cinfo.out_color_space = JCS_RGB;
             _renderFormat = gfx::Format::RGB8;
         }
+    #ifdef JCS_EXTENSIONS
+        // libjpeg-turbo writes RGBA itself, for grayscale images too
+        if (_decodeToRGBA8) {
+            cinfo.out_color_space = JCS_EXT_RGBA;
+        }
+    #endif
 
         /* Start decompression jpeg here */
         jpeg_start_decompress(&cinfo);
@@ -571,16 +657,30 @@ bool Image::initWithJpgData(const unsigned char *data, uint32_t dataLen) {
         _isCompressed = false;
         _width = cinfo.output_width;
         _height = cinfo.output_height;
-        _dataLen = cinfo.output_width * cinfo.output_height * cinfo.output_components;
+        const uint32_t components = _decodeToRGBA8 ? 4 : cinfo.output_components;
+        if (_decodeToRGBA8) {
+            _renderFormat = gfx::Format::RGBA8;
+        }
+        _dataLen = cinfo.output_width * cinfo.output_height * components;
         _data = static_cast<unsigned char *>(malloc(_dataLen * sizeof(unsigned char)));
         CC_BREAK_IF(!_data);
+        if (components != static_cast<uint32_t>(cinfo.output_components)) {
+            row.resize(cinfo.output_width * cinfo.output_components);
+        }
 
         /* now actually read the jpeg into the raw buffer */
         /* read one scan line at a time */
-        while (cinfo.output_scanline < cinfo.output_height) {
-            rowPointer[0] = _data + location;
-            location += cinfo.output_width * cinfo.output_components;
+        while (cinfo.output_scanline < cinfo.output_height && !isCancelled()) {
+            rowPointer[0] = row.empty() ? _data + location : row.data();
             jpeg_read_scanlines(&cinfo, rowPointer, 1);
+            if (!row.empty()) {
+                expandToRGBA8(row.data(), cinfo.output_components, cinfo.output_width, _data + location);
+            }
+            location += cinfo.output_width * components;
+        }
+        if (cinfo.output_scanline < cinfo.output_height) {
+            jpeg_destroy_decompress(&cinfo);
+            break;
         }
 
         /* When read image file with broken data, jpeg_finish_decompress() may cause error.
@@ -668,6 +768,14 @@ bool Image::initWithPngData(const unsigned char *data, uint32_t dataLen) {
         if (bitDepth < 8) {
             png_set_packing(pngPtr);
         }
+        // let libpng expand the rows so that they land in the final layout, the alpha is only added if missing
+        if (_decodeToRGBA8) {
+            if (colorType == PNG_COLOR_TYPE_GRAY || colorType == PNG_COLOR_TYPE_GRAY_ALPHA) {
+                png_set_gray_to_rgb(pngPtr);
+            }
+            png_set_add_alpha(pngPtr, 0xFF, PNG_FILLER_AFTER);
+        }
+        const int passCount = png_set_interlace_handling(pngPtr);
         // update info
         png_read_update_info(pngPtr, infoPtr);
         colorType = png_get_color_type(pngPtr, infoPtr);
@@ -689,29 +797,23 @@ bool Image::initWithPngData(const unsigned char *data, uint32_t dataLen) {
                 break;
         }
 
-        auto *rowPointers = static_cast<png_bytep *>(malloc(sizeof(png_bytep) * _height));
-
         const png_size_t rowBytes = png_get_rowbytes(pngPtr, infoPtr);
 
         _dataLen = static_cast<uint32_t>(rowBytes * _height);
         _data = static_cast<unsigned char *>(malloc(_dataLen * sizeof(unsigned char)));
-        if (!_data) {
-            if (rowPointers != nullptr) {
-                free(rowPointers);
-            }
-            break;
-        }
+        CC_BREAK_IF(!_data);
 
-        for (int i = 0; i < _height; ++i) {
-            rowPointers[i] = _data + i * rowBytes;
+        // same as png_read_image, interlaced images are read once per pass
+        bool cancelled = false;
+        for (int pass = 0; pass < passCount && !cancelled; ++pass) {
+            for (int i = 0; i < _height && !cancelled; ++i) {
+                png_read_row(pngPtr, _data + i * rowBytes, nullptr);
+                cancelled = isCancelled();
+            }
         }
-        png_read_image(pngPtr, rowPointers);
+        CC_BREAK_IF(cancelled);
         png_read_end(pngPtr, nullptr);
 
-        if (rowPointers != nullptr) {
-            free(rowPointers);
-        }
-
         ret = true;
     } while (false);
 
@@ -948,17 +1050,18 @@ bool Image::initWithWebpData(const unsigned char *data, uint32_t dataLen) {
         if (WebPGetFeatures(static_cast<const uint8_t *>(data), dataLen, &config.input) != VP8_STATUS_OK) break;
         if (config.input.width == 0 || config.input.height == 0) break;
 
-        config.output.colorspace = config.input.has_alpha ? MODE_rgbA : MODE_RGB;
-        _renderFormat = config.input.has_alpha ? gfx::Format::RGBA8 : gfx::Format::RGB8;
+        const bool rgba = config.input.has_alpha || _decodeToRGBA8;
+        config.output.colorspace = config.input.has_alpha ? MODE_rgbA : (rgba ? MODE_RGBA : MODE_RGB);
+        _renderFormat = rgba ? gfx::Format::RGBA8 : gfx::Format::RGB8;
         _width = config.input.width;
         _height = config.input.height;
         _isCompressed = false;
 
-        _dataLen = _width * _height * (config.input.has_alpha ? 4 : 3);
+        _dataLen = _width * _height * (rgba ? 4 : 3);
         _data = static_cast<unsigned char *>(malloc(_dataLen * sizeof(unsigned char)));
 
         config.output.u.RGBA.rgba = static_cast<uint8_t *>(_data);
-        config.output.u.RGBA.stride = _width * (config.input.has_alpha ? 4 : 3);
+        config.output.u.RGBA.stride = _width * (rgba ? 4 : 3);
         config.output.u.RGBA.size = _dataLen;
         config.output.is_external_memory = 1;
 
@@ -997,6 +1100,34 @@ bool Image::initWithRawData(const unsigned char *data, uint32_t /*dataLen*/, int
     return ret;
 }
 
+bool Image::generateMipmaps(const MipmapGenerator::Options &options) {
+    const auto width = static_cast<uint32_t>(_width);
+    const auto height = static_cast<uint32_t>(_height);
+    // textures only have mipmaps with power of two sizes
+    if (!_data || _isCompressed || _renderFormat != gfx::Format::RGBA8 || !_mipmapLevelDataSize.empty() ||
+        utils::nextPOT(width) != width || utils::nextPOT(height) != height || _dataLen != width * height * 4) {
+        return false;
+    }
+
+    auto levelDataSize = MipmapGenerator::getMipmapLevelDataSize(width, height);
+    if (levelDataSize.size() < 2 || isCancelled()) {
+        return false;
+    }
+    uint32_t chainSize = 0;
+    for (auto size : levelDataSize) {
+        chainSize += size;
+    }
+    auto *chain = static_cast<unsigned char *>(realloc(_data, chainSize));
+    if (!chain) {
+        return false;
+    }
+    MipmapGenerator::generate(chain, width, height, options);
+    _data = chain;
+    _dataLen = chainSize;
+    _mipmapLevelDataSize = std::move(levelDataSize);
+    return true;
+}
+
 bool Image::saveToFile(const std::string &filename, bool isToRGB) {
     //only support for Image::PixelFormat::RGB888 or Image::PixelFormat::RGBA8888 uncompressed data
     if (isCompressed() || (_renderFormat != gfx::Format::RGB8 && _renderFormat != gfx::Format::RGBA8)) {
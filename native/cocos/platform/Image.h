@@ -27,9 +27,11 @@
 
 #pragma once
 
+#include <atomic>
 #include "base/RefCounted.h"
 #include "base/std/container/string.h"
 #include "gfx-base/GFXDef.h"
+#include "platform/MipmapGenerator.h"
 
 namespace cc {
 
@@ -68,6 +70,31 @@ public:
     // @warning kFmtRawData only support RGBA8888
     bool initWithRawData(const unsigned char *data, uint32_t dataLen, int width, int height, int bitsPerComponent, bool preMulti = false);
 
+    /**
+     @brief    Makes PNG, JPEG and WebP images decode row by row straight into RGBA8, instead of their closest format
+               that has to be converted afterwards.
+     */
+    inline void setDecodeToRGBA8(bool value) { _decodeToRGBA8 = value; }
+
+    /**
+     @brief    Sets a flag polled while decoding, the decoding stops and fails once it is set.
+     */
+    inline void setCancelFlag(const std::atomic<bool> *flag) { _cancelFlag = flag; }
+
+    /**
+     @brief    Appends the mip chain to a decoded RGBA8 image whose sizes are powers of two, the levels are described by
+               getMipmapLevelDataSize afterwards.
+     @return   false if the image can't have mipmaps, it is left as is then.
+     */
+    bool generateMipmaps(const MipmapGenerator::Options &options);
+
+    /**
+     @brief    Tells the size of the decoded data from the header without decoding, PNG, JPEG and WebP images are
+               assumed to be decoded to RGBA8.
+     @return   0 if the size is unknown.
+     */
+    static uint32_t getDecodedSize(const unsigned char *data, uint32_t dataLen);
+
     // data will be free outside.
     inline void takeData(unsigned char **outData) {
         *outData = _data;
@@ -106,6 +133,8 @@ protected:
     bool initWithASTCData(const unsigned char *data, uint32_t dataLen);
     bool initWithCompressedMipsData(const unsigned char *data, uint32_t dataLen);
 
+    inline bool isCancelled() const { return _cancelFlag && _cancelFlag->load(std::memory_order_relaxed); }
+
     bool saveImageToPNG(const std::string &filePath, bool isToRGB = true);
     bool saveImageToJPG(const std::string &filePath);
 
@@ -118,6 +147,8 @@ protected:
     ccstd::string _filePath;
     bool _isCompressed = false;
     ccstd::vector<uint32_t> _mipmapLevelDataSize;
+    bool _decodeToRGBA8 = false;
+    const std::atomic<bool> *_cancelFlag = nullptr;
 
     static Format detectFormat(const unsigned char *data, uint32_t dataLen);
     static bool isPng(const unsigned char *data, uint32_t dataLen);
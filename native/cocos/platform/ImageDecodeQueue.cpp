@@ -0,0 +1,416 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "platform/ImageDecodeQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include "application/ApplicationManager.h"
+#include "base/Scheduler.h"
+#include "base/ZipUtils.h"
+#include "base/job-system/JobSystem.h"
+#include "base/std/container/vector.h"
+#include "platform/FileUtils.h"
+#include "platform/Image.h"
+
+namespace cc {
+
+struct ImageDecodeQueue::Request {
+    RequestId id{0};
+    int32_t priority{0};
+    ccstd::string path;
+    ccstd::optional<MipmapGenerator::Options> mipmaps;
+
+    // encoded data, inflated once read: either allocated with malloc or read into a pooled staging buffer
+    unsigned char *data{nullptr};
+    ccstd::vector<unsigned char> staging;
+    uint32_t size{0};
+    uint32_t decodedSize{0};
+
+    // bytes counted against the budget
+    uint64_t reserved{0};
+
+    std::atomic<bool> cancelled{false};
+
+    ~Request() {
+        free(data);
+    }
+
+    const unsigned char *getEncodedData() const {
+        return data ? data : staging.data();
+    }
+};
+
+struct ImageDecodeQueue::State {
+    mutable std::mutex mutex;
+    // both in arrival order, so that equal priorities are first come first served
+    ccstd::vector<RequestPtr> pending; // not started
+    ccstd::vector<RequestPtr> ready;   // read, waiting for memory to decode
+    ccstd::unordered_map<RequestId, RequestPtr> active;
+    uint32_t runningCount{0};
+    uint32_t deliveringCount{0};
+    uint32_t maxConcurrency{0};
+    uint64_t memoryBudget{0};
+    uint64_t memoryInUse{0};
+    ccstd::vector<ccstd::vector<unsigned char>> stagingBuffers;
+    std::shared_ptr<Scheduler> scheduler;
+
+    // main thread only, null once the queue is destroyed
+    ImageDecodeQueue *owner{nullptr};
+
+    // Nothing else is going to release memory, so the next request has to go beyond the budget or never run.
+    bool isIdle() const {
+        return runningCount == 0 && deliveringCount == 0;
+    }
+
+    void reserve(Request *request, uint64_t bytes) {
+        memoryInUse += bytes;
+        request->reserved += bytes;
+    }
+
+    void release(Request *request, uint64_t bytes) {
+        bytes = std::min(bytes, request->reserved);
+        memoryInUse -= bytes;
+        request->reserved -= bytes;
+    }
+
+    ccstd::vector<unsigned char> acquireStagingBuffer();
+    void recycleStagingBuffer(ccstd::vector<unsigned char> &&buffer);
+};
+
+namespace {
+
+// a staging buffer grown by a larger file is freed instead of being kept
+constexpr size_t MAX_STAGING_BUFFER_SIZE{4 * 1024 * 1024};
+
+template <typename List>
+typename List::iterator findBest(List &list) {
+    // a later request only wins with a strictly higher priority
+    return std::max_element(list.begin(), list.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs->priority < rhs->priority;
+    });
+}
+
+template <typename List>
+bool eraseRequest(List &list, ImageDecodeQueue::RequestId id) {
+    auto iter = std::find_if(list.begin(), list.end(), [id](const auto &request) {
+        return request->id == id;
+    });
+    if (iter == list.end()) {
+        return false;
+    }
+    list.erase(iter);
+    return true;
+}
+
+} // namespace
+
+ccstd::vector<unsigned char> ImageDecodeQueue::State::acquireStagingBuffer() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stagingBuffers.empty()) {
+        return {};
+    }
+    auto buffer = std::move(stagingBuffers.back());
+    stagingBuffers.pop_back();
+    return buffer;
+}
+
+void ImageDecodeQueue::State::recycleStagingBuffer(ccstd::vector<unsigned char> &&buffer) {
+    if (buffer.capacity() == 0 || buffer.capacity() > MAX_STAGING_BUFFER_SIZE) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stagingBuffers.size() < maxConcurrency) {
+        buffer.clear();
+        stagingBuffers.emplace_back(std::move(buffer));
+    }
+}
+
+ImageDecodeQueue::ImageDecodeQueue(uint32_t maxConcurrency, uint64_t memoryBudget, std::shared_ptr<Scheduler> scheduler)
+: _state(std::make_shared<State>()) {
+    _state->maxConcurrency = std::max(maxConcurrency, 1U);
+    _state->memoryBudget = memoryBudget;
+    _state->scheduler = std::move(scheduler);
+    _state->owner = this;
+}
+
+ImageDecodeQueue::~ImageDecodeQueue() {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    _state->owner = nullptr;
+    for (auto &item : _state->active) {
+        item.second->cancelled = true;
+    }
+    _state->pending.clear();
+    _state->ready.clear();
+}
+
+ImageDecodeQueue::RequestId ImageDecodeQueue::loadFile(const ccstd::string &fullPath, int32_t priority, Callback &&callback, const ccstd::optional<MipmapGenerator::Options> &mipmaps) {
+    auto request = std::make_shared<Request>();
+    request->priority = priority;
+    request->path = fullPath;
+    request->mipmaps = mipmaps;
+    // only an estimate until the file is read
+    const auto fileSize = FileUtils::getInstance()->getFileSize(fullPath);
+    request->size = fileSize > 0 ? static_cast<uint32_t>(fileSize) : 0;
+    return enqueue(std::move(request), std::move(callback));
+}
+
+ImageDecodeQueue::RequestId ImageDecodeQueue::loadData(unsigned char *data, uint32_t size, int32_t priority, Callback &&callback, const ccstd::optional<MipmapGenerator::Options> &mipmaps) {
+    auto request = std::make_shared<Request>();
+    request->priority = priority;
+    request->mipmaps = mipmaps;
+    request->data = data;
+    request->size = size;
+    return enqueue(std::move(request), std::move(callback));
+}
+
+ImageDecodeQueue::RequestId ImageDecodeQueue::enqueue(RequestPtr &&request, Callback &&callback) {
+    const RequestId id = _nextId++;
+    request->id = id;
+    _callbacks.emplace(id, std::move(callback));
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        _state->active.emplace(id, request);
+        _state->pending.emplace_back(std::move(request));
+    }
+    pump(_state);
+    return id;
+}
+
+bool ImageDecodeQueue::cancel(RequestId id) {
+    if (_callbacks.erase(id) == 0) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        auto iter = _state->active.find(id);
+        if (iter != _state->active.end()) {
+            auto *request = iter->second.get();
+            request->cancelled = true;
+            // the running ones stop at the next row or stage and release their memory then
+            if (eraseRequest(_state->pending, id) || eraseRequest(_state->ready, id)) {
+                _state->release(request, request->reserved);
+                _state->active.erase(iter);
+            }
+        }
+    }
+    pump(_state);
+    return true;
+}
+
+void ImageDecodeQueue::setMemoryBudget(uint64_t bytes) {
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        _state->memoryBudget = bytes;
+    }
+    pump(_state);
+}
+
+uint64_t ImageDecodeQueue::getMemoryBudget() const {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    return _state->memoryBudget;
+}
+
+uint64_t ImageDecodeQueue::getMemoryInUse() const {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    return _state->memoryInUse;
+}
+
+void ImageDecodeQueue::invoke(RequestId id, Image *image) {
+    auto iter = _callbacks.find(id);
+    if (iter == _callbacks.end()) {
+        return;
+    }
+    auto callback = std::move(iter->second);
+    _callbacks.erase(iter);
+    callback(image);
+}
+
+void ImageDecodeQueue::pump(const StatePtr &state) {
+    ccstd::vector<RequestPtr> reads;
+    ccstd::vector<RequestPtr> decodes;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        while (state->runningCount < state->maxConcurrency) {
+            auto bestPending = findBest(state->pending);
+            auto bestReady = findBest(state->ready);
+            const bool hasPending = bestPending != state->pending.end();
+            const bool hasReady = bestReady != state->ready.end();
+            if (!hasPending && !hasReady) {
+                break;
+            }
+
+            // read images already hold their encoded data, so they go first among equal priorities
+            if (hasReady && (!hasPending || (*bestReady)->priority >= (*bestPending)->priority)) {
+                auto request = *bestReady;
+                if (state->memoryInUse + request->decodedSize > state->memoryBudget && !state->isIdle()) {
+                    break;
+                }
+                state->reserve(request.get(), request->decodedSize);
+                state->ready.erase(bestReady);
+                decodes.emplace_back(std::move(request));
+            } else {
+                auto request = *bestPending;
+                if (state->memoryInUse + request->size > state->memoryBudget && !(state->isIdle() && state->ready.empty())) {
+                    break;
+                }
+                state->reserve(request.get(), request->size);
+                state->pending.erase(bestPending);
+                reads.emplace_back(std::move(request));
+            }
+            ++state->runningCount;
+        }
+    }
+
+    auto *jobSystem = JobSystem::getInstance();
+    for (auto &request : reads) {
+        jobSystem->dispatchIO([state, request]() { read(state, request); });
+    }
+    for (auto &request : decodes) {
+        jobSystem->dispatchIO([state, request]() { decode(state, request); });
+    }
+}
+
+void ImageDecodeQueue::read(const StatePtr &state, const RequestPtr &request) {
+    if (!request->path.empty() && !request->cancelled) {
+        request->staging = state->acquireStagingBuffer();
+        ResizableBufferAdapter<ccstd::vector<unsigned char>> buffer(&request->staging);
+        const bool read = FileUtils::getInstance()->getContents(request->path, &buffer) == FileUtils::Status::OK;
+        request->size = read ? static_cast<uint32_t>(request->staging.size()) : 0;
+    }
+    if (request->getEncodedData() == nullptr || request->size == 0 || request->cancelled) {
+        finish(state, request, nullptr);
+        return;
+    }
+
+    unsigned char *unpacked = nullptr;
+    uint32_t unpackedSize = 0;
+    if (ZipUtils::isCCZBuffer(request->getEncodedData(), request->size)) {
+        const int length = ZipUtils::inflateCCZBuffer(request->getEncodedData(), request->size, &unpacked);
+        unpackedSize = length > 0 ? static_cast<uint32_t>(length) : 0;
+    } else if (ZipUtils::isGZipBuffer(request->getEncodedData(), request->size)) {
+        unpackedSize = ZipUtils::inflateMemory(const_cast<unsigned char *>(request->getEncodedData()), request->size, &unpacked);
+    }
+    if (unpacked != nullptr) {
+        releaseEncodedData(state, request);
+        request->data = unpacked;
+        request->size = unpackedSize;
+    }
+    request->decodedSize = Image::getDecodedSize(request->getEncodedData(), request->size);
+    if (request->mipmaps) {
+        // the chain of a square image is a third of its base level
+        request->decodedSize += request->decodedSize / 3;
+    }
+
+    bool parked = false;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        // the reservation was an estimate, now it is the data actually held
+        state->release(request.get(), request->reserved);
+        state->reserve(request.get(), request->size);
+        if (request->cancelled) {
+            // finished below
+        } else if (state->memoryInUse + request->decodedSize <= state->memoryBudget || (state->runningCount == 1 && state->deliveringCount == 0)) {
+            state->reserve(request.get(), request->decodedSize);
+        } else {
+            // let the memory be released by others first, without holding the thread
+            --state->runningCount;
+            state->ready.emplace_back(request);
+            parked = true;
+        }
+    }
+
+    if (parked) {
+        pump(state);
+    } else if (request->cancelled) {
+        finish(state, request, nullptr);
+    } else {
+        decode(state, request);
+    }
+}
+
+void ImageDecodeQueue::decode(const StatePtr &state, const RequestPtr &request) {
+    auto *image = ccnew Image();
+    image->setDecodeToRGBA8(true);
+    image->setCancelFlag(&request->cancelled);
+    if (request->cancelled || !image->initWithImageData(request->getEncodedData(), request->size)) {
+        delete image;
+        image = nullptr;
+    } else if (request->mipmaps) {
+        // the encoded data isn't needed anymore
+        releaseEncodedData(state, request);
+        image->generateMipmaps(*request->mipmaps);
+    }
+    finish(state, request, image);
+}
+
+void ImageDecodeQueue::releaseEncodedData(const StatePtr &state, const RequestPtr &request) {
+    free(request->data);
+    request->data = nullptr;
+    state->recycleStagingBuffer(std::move(request->staging));
+    request->staging = {};
+}
+
+void ImageDecodeQueue::finish(const StatePtr &state, const RequestPtr &request, Image *image) {
+    releaseEncodedData(state, request);
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        // until the callback takes it, only the decoded data is held
+        state->release(request.get(), request->reserved);
+        if (image) {
+            state->reserve(request.get(), image->getDataLen());
+        }
+        --state->runningCount;
+        ++state->deliveringCount;
+    }
+    pump(state);
+
+    auto scheduler = state->scheduler;
+    if (!scheduler) {
+        auto app = CC_CURRENT_APPLICATION();
+        if (!app) {
+            delete image;
+            return;
+        }
+        scheduler = app->getEngine()->getScheduler();
+    }
+    scheduler->performFunctionInCocosThread([state, request, image]() {
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->release(request.get(), request->reserved);
+            --state->deliveringCount;
+            state->active.erase(request->id);
+        }
+        if (state->owner && !request->cancelled) {
+            state->owner->invoke(request->id, image);
+        }
+        delete image;
+        if (state->owner) {
+            pump(state);
+        }
+    });
+}
+
+} // namespace cc
@@ -0,0 +1,103 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include "base/Macros.h"
+#include "base/std/container/string.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/optional.h"
+#include "platform/MipmapGenerator.h"
+
+namespace cc {
+
+class Image;
+class Scheduler;
+
+/**
+ * Loads images on the IO threads in stages: read the file, inflate CCZ/GZip, then decode row by row straight
+ * into RGBA8 and generate the mip chain if requested, freeing the input of each stage as soon as the next one is done.
+ * Requests start by priority, and the bytes held by loading images are kept under a budget:
+ * an image whose decoded size doesn't fit waits after reading until enough memory is released.
+ * Files are read into staging buffers that are kept for the next requests, up to one per concurrent request.
+ * Must be used from the main thread, callbacks are invoked there too, through the scheduler of the engine by default.
+ */
+class CC_DLL ImageDecodeQueue final {
+public:
+    using RequestId = uint32_t;
+    // The image is null if loading failed, it is deleted after the callback returns.
+    using Callback = std::function<void(Image *image)>;
+
+    static constexpr uint32_t DEFAULT_CONCURRENCY{3};
+    static constexpr uint64_t DEFAULT_MEMORY_BUDGET{64ULL * 1024 * 1024};
+
+    explicit ImageDecodeQueue(uint32_t maxConcurrency = DEFAULT_CONCURRENCY, uint64_t memoryBudget = DEFAULT_MEMORY_BUDGET,
+                              std::shared_ptr<Scheduler> scheduler = nullptr);
+    ~ImageDecodeQueue();
+    ImageDecodeQueue(const ImageDecodeQueue &) = delete;
+    ImageDecodeQueue(ImageDecodeQueue &&) = delete;
+    ImageDecodeQueue &operator=(const ImageDecodeQueue &) = delete;
+    ImageDecodeQueue &operator=(ImageDecodeQueue &&) = delete;
+
+    // Loads a file by its full path, requests with higher priorities start first.
+    // With mipmap options the mip chain is generated once decoded, see Image::generateMipmaps.
+    RequestId loadFile(const ccstd::string &fullPath, int32_t priority, Callback &&callback, const ccstd::optional<MipmapGenerator::Options> &mipmaps = ccstd::nullopt);
+
+    // Loads encoded data allocated with malloc, e.g. downloaded or base64 decoded, the queue takes and frees it.
+    RequestId loadData(unsigned char *data, uint32_t size, int32_t priority, Callback &&callback, const ccstd::optional<MipmapGenerator::Options> &mipmaps = ccstd::nullopt);
+
+    // The callback of a cancelled request is never invoked, returns false if the request already finished.
+    bool cancel(RequestId id);
+
+    void setMemoryBudget(uint64_t bytes);
+    uint64_t getMemoryBudget() const;
+
+    // Bytes of encoded and decoded data held by the requests in flight.
+    uint64_t getMemoryInUse() const;
+
+private:
+    struct Request;
+    struct State;
+    using RequestPtr = std::shared_ptr<Request>;
+    using StatePtr = std::shared_ptr<State>;
+
+    RequestId enqueue(RequestPtr &&request, Callback &&callback);
+    void invoke(RequestId id, Image *image);
+
+    static void pump(const StatePtr &state);
+    static void read(const StatePtr &state, const RequestPtr &request);
+    static void decode(const StatePtr &state, const RequestPtr &request);
+    static void finish(const StatePtr &state, const RequestPtr &request, Image *image);
+    static void releaseEncodedData(const StatePtr &state, const RequestPtr &request);
+
+    StatePtr _state;
+    ccstd::unordered_map<RequestId, Callback> _callbacks;
+    RequestId _nextId{1};
+};
+
+} // namespace cc
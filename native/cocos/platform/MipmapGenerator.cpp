@@ -0,0 +1,277 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "platform/MipmapGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include "math/Math.h"
+#include "math/MathUtil.h"
+
+namespace cc {
+
+namespace {
+
+constexpr uint32_t MAX_TAPS = 12;
+constexpr float FILTER_RADIUS = 3.0F;
+constexpr float KAISER_ALPHA = 4.0F;
+constexpr uint32_t LINEAR_TO_SRGB_STEPS = 16384;
+
+// Weights of the source texels around a destination texel, for a 2:1 reduction.
+struct Kernel {
+    uint32_t taps{1};
+    float weights[MAX_TAPS]{1.0F};
+};
+
+// A dimension of 1 texel is kept as is.
+const Kernel IDENTITY_KERNEL{};
+
+float sinc(float x) {
+    if (std::abs(x) < 1e-6F) {
+        return 1.0F;
+    }
+    x *= math::PI;
+    return std::sin(x) / x;
+}
+
+// Zeroth order modified Bessel function of the first kind.
+float bessel0(float x) {
+    const float quarterSquare = x * x * 0.25F;
+    float sum = 1.0F;
+    float term = 1.0F;
+    for (uint32_t k = 1; k < 32 && term > sum * 1e-7F; ++k) {
+        term *= quarterSquare / static_cast<float>(k * k);
+        sum += term;
+    }
+    return sum;
+}
+
+Kernel makeKernel(MipmapGenerator::Filter filter) {
+    Kernel kernel;
+    if (filter == MipmapGenerator::Filter::BOX) {
+        kernel.taps = 2;
+        kernel.weights[0] = kernel.weights[1] = 0.5F;
+        return kernel;
+    }
+
+    kernel.taps = MAX_TAPS;
+    float sum = 0.0F;
+    for (uint32_t t = 0; t < MAX_TAPS; ++t) {
+        // distance to the center of the destination texel, in destination texels
+        const float x = (static_cast<float>(t) - static_cast<float>(MAX_TAPS - 1) * 0.5F) * 0.5F;
+        float window = 0.0F;
+        if (filter == MipmapGenerator::Filter::KAISER) {
+            const float ratio = x / FILTER_RADIUS;
+            window = bessel0(KAISER_ALPHA * std::sqrt(std::max(1.0F - ratio * ratio, 0.0F))) / bessel0(KAISER_ALPHA);
+        } else {
+            window = sinc(x / FILTER_RADIUS);
+        }
+        kernel.weights[t] = sinc(x) * window;
+        sum += kernel.weights[t];
+    }
+    for (uint32_t t = 0; t < MAX_TAPS; ++t) {
+        kernel.weights[t] /= sum;
+    }
+    return kernel;
+}
+
+const Kernel &getKernel(MipmapGenerator::Filter filter) {
+    static const Kernel KERNELS[]{
+        makeKernel(MipmapGenerator::Filter::BOX),
+        makeKernel(MipmapGenerator::Filter::KAISER),
+        makeKernel(MipmapGenerator::Filter::LANCZOS),
+    };
+    return KERNELS[static_cast<uint32_t>(filter)];
+}
+
+struct ColorTables {
+    float srgbToLinear[256];
+    uint8_t linearToSrgb[LINEAR_TO_SRGB_STEPS + 1];
+
+    ColorTables() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            const float c = static_cast<float>(i) / 255.0F;
+            srgbToLinear[i] = c <= 0.04045F ? c / 12.92F : std::pow((c + 0.055F) / 1.055F, 2.4F);
+        }
+        for (uint32_t i = 0; i <= LINEAR_TO_SRGB_STEPS; ++i) {
+            const float c = static_cast<float>(i) / static_cast<float>(LINEAR_TO_SRGB_STEPS);
+            const float encoded = c <= 0.0031308F ? c * 12.92F : 1.055F * std::pow(c, 1.0F / 2.4F) - 0.055F;
+            linearToSrgb[i] = static_cast<uint8_t>(encoded * 255.0F + 0.5F);
+        }
+    }
+};
+
+const ColorTables &colorTables() {
+    static const ColorTables TABLES;
+    return TABLES;
+}
+
+// RGBA8 texels to linear colors multiplied by alpha, which the filters work on.
+void decodeRow(const uint8_t *src, uint32_t width, const MipmapGenerator::Options &options, const ColorTables &tables, float *out) {
+    if (!options.srgb) {
+        MathUtil::unormToFloat(src, width * 4, out);
+        if (!options.premultipliedAlpha) {
+            for (uint32_t i = 0; i < width; ++i, out += 4) {
+                out[0] *= out[3];
+                out[1] *= out[3];
+                out[2] *= out[3];
+            }
+        }
+        return;
+    }
+    constexpr float SCALE = 1.0F / 255.0F;
+    for (uint32_t i = 0; i < width; ++i, src += 4, out += 4) {
+        const float alpha = static_cast<float>(src[3]) * SCALE;
+        for (uint32_t c = 0; c < 3; ++c) {
+            // premultiplied sRGB colors are multiplied after encoding
+            uint32_t value = src[c];
+            if (options.premultipliedAlpha && src[3] != 0) {
+                value = std::min((value * 255 + src[3] / 2) / src[3], 255U);
+            }
+            out[c] = tables.srgbToLinear[value] * alpha;
+        }
+        out[3] = alpha;
+    }
+}
+
+// Overwrites src, the filtered colors are only needed once.
+void encodeRow(float *src, uint32_t width, const MipmapGenerator::Options &options, const ColorTables &tables, uint8_t *out) {
+    float *texel = src;
+    for (uint32_t i = 0; i < width; ++i, texel += 4) {
+        // the negative lobes of the filters may overshoot
+        const float alpha = std::min(std::max(texel[3], 0.0F), 1.0F);
+        const float scale = alpha > 0.0F ? 1.0F / alpha : 0.0F;
+        for (uint32_t c = 0; c < 3; ++c) {
+            texel[c] = std::min(std::max(texel[c] * scale, 0.0F), 1.0F);
+        }
+        texel[3] = alpha;
+        if (!options.srgb) {
+            if (options.premultipliedAlpha) {
+                texel[0] *= alpha;
+                texel[1] *= alpha;
+                texel[2] *= alpha;
+            }
+            continue;
+        }
+        const auto alphaByte = static_cast<uint8_t>(alpha * 255.0F + 0.5F);
+        uint8_t *encoded = out + i * 4;
+        for (uint32_t c = 0; c < 3; ++c) {
+            uint32_t value = tables.linearToSrgb[static_cast<uint32_t>(texel[c] * static_cast<float>(LINEAR_TO_SRGB_STEPS) + 0.5F)];
+            if (options.premultipliedAlpha) {
+                value = (value * alphaByte + 127) / 255;
+            }
+            encoded[c] = static_cast<uint8_t>(value);
+        }
+        encoded[3] = alphaByte;
+    }
+    if (!options.srgb) {
+        MathUtil::floatToUnorm(src, width * 4, out);
+    }
+}
+
+// Reduces a row of RGBA values horizontally, clamping at the edges.
+void filterRow(const float *row, uint32_t srcWidth, uint32_t dstWidth, const Kernel &kernel, float *out) {
+    const float *texels[MAX_TAPS];
+    const auto offset = static_cast<int32_t>(kernel.taps - 1) / 2;
+    const auto last = static_cast<int32_t>(srcWidth) - 1;
+    for (uint32_t i = 0; i < dstWidth; ++i) {
+        const int32_t begin = static_cast<int32_t>(i * 2) - offset;
+        for (uint32_t t = 0; t < kernel.taps; ++t) {
+            const int32_t x = std::min(std::max(begin + static_cast<int32_t>(t), 0), last);
+            texels[t] = row + x * 4;
+        }
+        MathUtil::weightedSum(texels, kernel.weights, kernel.taps, 4, out + i * 4);
+    }
+}
+
+void generateLevel(const uint8_t *src, uint32_t srcWidth, uint32_t srcHeight, uint8_t *dst, const MipmapGenerator::Options &options) {
+    const auto &tables = colorTables();
+    const uint32_t dstWidth = std::max(srcWidth >> 1, 1U);
+    const uint32_t dstHeight = std::max(srcHeight >> 1, 1U);
+    const Kernel &kernelX = srcWidth > 1 ? getKernel(options.filter) : IDENTITY_KERNEL;
+    const Kernel &kernelY = srcHeight > 1 ? getKernel(options.filter) : IDENTITY_KERNEL;
+    const uint32_t rowSize = dstWidth * 4;
+
+    // Source rows are filtered horizontally once, and kept while the window of rows slides down.
+    // The rows of a window are consecutive, so they don't collide by index modulo the taps.
+    ccstd::vector<float> decoded(srcWidth * 4);
+    ccstd::vector<float> cache(kernelY.taps * rowSize);
+    ccstd::vector<int32_t> cachedRows(kernelY.taps, -1);
+    ccstd::vector<float> filtered(rowSize);
+    const float *rows[MAX_TAPS];
+
+    const auto offset = static_cast<int32_t>(kernelY.taps - 1) / 2;
+    const auto last = static_cast<int32_t>(srcHeight) - 1;
+    for (uint32_t y = 0; y < dstHeight; ++y) {
+        const int32_t begin = static_cast<int32_t>(y * 2) - offset;
+        for (uint32_t t = 0; t < kernelY.taps; ++t) {
+            const int32_t sy = std::min(std::max(begin + static_cast<int32_t>(t), 0), last);
+            const uint32_t slot = static_cast<uint32_t>(sy) % kernelY.taps;
+            float *row = cache.data() + slot * rowSize;
+            if (cachedRows[slot] != sy) {
+                decodeRow(src + static_cast<size_t>(sy) * srcWidth * 4, srcWidth, options, tables, decoded.data());
+                filterRow(decoded.data(), srcWidth, dstWidth, kernelX, row);
+                cachedRows[slot] = sy;
+            }
+            rows[t] = row;
+        }
+        MathUtil::weightedSum(rows, kernelY.weights, kernelY.taps, rowSize, filtered.data());
+        encodeRow(filtered.data(), dstWidth, options, tables, dst + static_cast<size_t>(y) * rowSize);
+    }
+}
+
+} // namespace
+
+uint32_t MipmapGenerator::getLevelCount(uint32_t width, uint32_t height) {
+    uint32_t size = std::max(width, height);
+    uint32_t count = 0;
+    while (size) {
+        size >>= 1;
+        ++count;
+    }
+    return count;
+}
+
+ccstd::vector<uint32_t> MipmapGenerator::getMipmapLevelDataSize(uint32_t width, uint32_t height) {
+    ccstd::vector<uint32_t> sizes(getLevelCount(width, height));
+    for (auto &size : sizes) {
+        size = width * height * 4;
+        width = std::max(width >> 1, 1U);
+        height = std::max(height >> 1, 1U);
+    }
+    return sizes;
+}
+
+void MipmapGenerator::generate(uint8_t *chain, uint32_t width, uint32_t height, const Options &options) {
+    uint8_t *src = chain;
+    for (uint32_t level = 1, count = getLevelCount(width, height); level < count; ++level) {
+        uint8_t *dst = src + static_cast<size_t>(width) * height * 4;
+        generateLevel(src, width, height, dst, options);
+        width = std::max(width >> 1, 1U);
+        height = std::max(height >> 1, 1U);
+        src = dst;
+    }
+}
+
+} // namespace cc
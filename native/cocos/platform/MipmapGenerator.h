@@ -0,0 +1,69 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include "base/Macros.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+/**
+ * Generates the mip chain of RGBA8 images on the CPU, each level filtered from the previous one.
+ * The levels are laid out one after another, as Image::getMipmapLevelDataSize describes them.
+ */
+class CC_DLL MipmapGenerator final {
+public:
+    enum class Filter : uint8_t {
+        BOX,
+        // Kaiser windowed sinc of radius 3, sharper than the box filter without much ringing
+        KAISER,
+        // Lanczos of radius 3, the sharpest
+        LANCZOS,
+    };
+
+    struct Options {
+        Filter filter{Filter::BOX};
+        // Colors are sRGB encoded, they are filtered in linear space.
+        bool srgb{false};
+        // Colors are multiplied by alpha already. Otherwise they are weighted by alpha while filtering,
+        // so that the colors of transparent texels don't bleed into the visible ones.
+        bool premultipliedAlpha{false};
+    };
+
+    // The levels of the full chain, down to 1x1.
+    static uint32_t getLevelCount(uint32_t width, uint32_t height);
+
+    static ccstd::vector<uint32_t> getMipmapLevelDataSize(uint32_t width, uint32_t height);
+
+    // The chain starts with the width x height RGBA8 base level and must have room for all the levels,
+    // the other levels are written after it.
+    static void generate(uint8_t *chain, uint32_t width, uint32_t height, const Options &options);
+
+    MipmapGenerator() = delete;
+};
+
+} // namespace cc
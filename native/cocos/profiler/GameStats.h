@@ -33,6 +33,7 @@
 #include "base/StringUtil.h"
 #include "base/std/container/string.h"
 #include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
 
 namespace cc {
 
@@ -218,6 +219,18 @@ struct ObjectStats {
     }
 };
 
+// assume update in main thread only.
+struct ThreadStats {
+    struct Worker {
+        float utilization{0.0F}; // busy time / elapsed time of the last interval
+        uint32_t taskCount{0U};  // tasks executed during the last interval
+        uint32_t stealCount{0U}; // tasks stolen from other workers during the last interval
+    };
+
+    // one entry per job worker, the last one is the IO lane
+    ccstd::vector<Worker> workers;
+};
+
 class StatsUtil {
 public:
     static inline ccstd::string formatBytes(uint64_t bytes) {
@@ -31,6 +31,7 @@
 #include "base/Log.h"
 #include "base/Macros.h"
 #include "base/memory/MemoryHook.h"
+#include "base/threading/TaskScheduler.h"
 #include "core/Root.h"
 #include "core/assets/Font.h"
 #include "gfx-base/GFXDevice.h"
@@ -206,6 +207,20 @@ void Profiler::doIntervalUpdate() {
     _coreStats.shadowMap = shadows != nullptr && shadows->isEnabled() && shadows->getType() == scene::ShadowType::SHADOW_MAP;
     _coreStats.screenWidth = static_cast<uint32_t>(viewSize.width);
     _coreStats.screenHeight = static_cast<uint32_t>(viewSize.height);
+
+    // the scheduler is only queried if some backend or pool already runs on it
+    ccstd::vector<TaskScheduler::WorkerStats> workerStats;
+    if (TaskScheduler::hasInstance()) {
+        TaskScheduler::getInstance()->collectWorkerStats(workerStats);
+    }
+    _threadStats.workers.resize(workerStats.size());
+    for (size_t i = 0; i < workerStats.size(); ++i) {
+        const auto &stats = workerStats[i];
+        auto &worker = _threadStats.workers[i];
+        worker.utilization = stats.elapsedTime ? std::min(1.0F, static_cast<float>(stats.busyTime) / static_cast<float>(stats.elapsedTime)) : 0.0F;
+        worker.taskCount = stats.taskCount;
+        worker.stealCount = stats.stealCount;
+    }
 }
 
 void Profiler::doFrameUpdate() {
@@ -334,6 +349,36 @@ void Profiler::printStats() {
         rightLines += 0.5F;
     }
 
+    if (isEnabled(ShowOption::THREAD_STATS)) {
+        rightLines = std::max(rightLines, lines);
+        float yOffset = lineHeight * rightLines;
+        float threadOffset = width * 0.5F;
+        float usageOffset = threadOffset + columnWidth * 2;
+        float taskOffset = threadOffset + columnWidth * 3;
+        float stealOffset = threadOffset + columnWidth * 4;
+
+        renderer->addText("ThreadStats", {threadOffset, yOffset}, titleInfo);
+        renderer->addText("Usage", {usageOffset, yOffset}, titleInfo);
+        renderer->addText("Tasks", {taskOffset, yOffset}, titleInfo);
+        renderer->addText("Steals", {stealOffset, yOffset}, titleInfo);
+        rightLines++;
+
+        const auto &workers = _threadStats.workers;
+        for (size_t i = 0; i < workers.size(); ++i) {
+            const auto &item = workers[i];
+            yOffset = lineHeight * rightLines;
+
+            const bool isIO = i + 1 == workers.size();
+            renderer->addText(isIO ? ccstd::string("IO") : StringUtil::format("Worker%u", static_cast<uint32_t>(i)), {threadOffset, yOffset}, textInfos[0]);
+            renderer->addText(StringUtil::format("%.1f%%", item.utilization * 100.0F), {usageOffset, yOffset}, textInfos[0]);
+            renderer->addText(StringUtil::format("%u", item.taskCount), {taskOffset, yOffset}, textInfos[0]);
+            renderer->addText(isIO ? ccstd::string("-") : StringUtil::format("%u", item.stealCount), {stealOffset, yOffset}, textInfos[0]);
+            rightLines++;
+        }
+
+        rightLines += 0.5F;
+    }
+
     if (isEnabled(ShowOption::PERFORMANCE_STATS)) {
         lines = std::max(leftLines, rightLines);
         float yOffset = lineHeight * lines;
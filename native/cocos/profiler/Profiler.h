@@ -41,7 +41,8 @@ enum class ShowOption : uint32_t {
     MEMORY_STATS = 0x02,
     OBJECT_STATS = 0x04,
     PERFORMANCE_STATS = 0x08,
-    ALL = CORE_STATS | MEMORY_STATS | OBJECT_STATS | PERFORMANCE_STATS,
+    THREAD_STATS = 0x10,
+    ALL = CORE_STATS | MEMORY_STATS | OBJECT_STATS | PERFORMANCE_STATS | THREAD_STATS,
 };
 
 /**
@@ -68,6 +69,7 @@ public:
     inline bool isMainThread() const { return _mainThreadId == std::this_thread::get_id(); }
     inline MemoryStats &getMemoryStats() { return _memoryStats; }
     inline ObjectStats &getObjectStats() { return _objectStats; }
+    inline const ThreadStats &getThreadStats() const { return _threadStats; }
 
 private:
     static void doFrameUpdate();
@@ -85,6 +87,7 @@ private:
     CoreStats _coreStats;
     MemoryStats _memoryStats;
     ObjectStats _objectStats;
+    ThreadStats _threadStats;
     ProfilerBlock *_root{nullptr};
     ProfilerBlock *_current{nullptr};
     std::thread::id _mainThreadId;
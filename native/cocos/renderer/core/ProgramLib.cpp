@@ -684,4 +684,13 @@ gfx::Shader *ProgramLib::getGFXShader(gfx::Device *device, const ccstd::string &
     return shader;
 }
 
+gfx::Shader *ProgramLib::findGFXShader(const ccstd::string &instanceName) const {
+    for (const auto &cache : _cache) {
+        if (cache.second->getName() == instanceName) {
+            return cache.second;
+        }
+    }
+    return nullptr;
+}
+
 } // namespace cc
@@ -157,6 +157,13 @@ public:
     gfx::Shader *getGFXShader(gfx::Device *device, const ccstd::string &name, MacroRecord &defines,
                               render::PipelineRuntime *pipeline, ccstd::string *key = nullptr);
 
+    /**
+     * @en Finds an already created shader resource instance by its instance name, e.g. to warm up pipeline states
+     * @zh 根据实例名称查找已创建的 shader 渲染资源实例
+     * @param instanceName The name of the gfx shader
+     */
+    gfx::Shader *findGFXShader(const ccstd::string &instanceName) const;
+
 private:
     CC_DISALLOW_COPY_MOVE_ASSIGN(ProgramLib);
 
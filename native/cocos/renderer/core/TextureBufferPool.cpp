@@ -61,6 +61,7 @@ void TextureBufferPool::destroy() {
         CC_SAFE_DESTROY_AND_DELETE(chunk.texture);
     }
     _chunks.clear();
+    _chunkCount = 0;
     _handles.clear();
 }
 
@@ -81,7 +82,7 @@ ITextureBufferHandle TextureBufferPool::alloc(uint32_t size) {
     }
 
     if (start >= 0) {
-        auto chunk = _chunks[index];
+        auto &chunk = _chunks[index];
         chunk.start += static_cast<index_t>(size);
         ITextureBufferHandle handle;
         handle.chunkIdx = index;
@@ -95,7 +96,7 @@ ITextureBufferHandle TextureBufferPool::alloc(uint32_t size) {
     // create a new one
     auto targetSize = static_cast<int32_t>(std::sqrt(size / _formatSize));
     uint32_t texLength = _roundUpFn ? _roundUpFn(targetSize, _formatSize) : std::max(1024, static_cast<int>(utils::nextPOT(targetSize)));
-    auto newChunk = _chunks[createChunk(texLength)];
+    auto &newChunk = _chunks[createChunk(texLength)];
 
     newChunk.start += static_cast<index_t>(size);
     ITextureBufferHandle texHandle;
@@ -121,7 +122,7 @@ ITextureBufferHandle TextureBufferPool::alloc(uint32_t size, index_t chunkIdx) {
     }
 
     if (start >= 0) {
-        auto chunk = _chunks[index];
+        auto &chunk = _chunks[index];
         chunk.start += static_cast<index_t>(size);
         ITextureBufferHandle handle;
         handle.chunkIdx = index;
@@ -135,7 +136,7 @@ ITextureBufferHandle TextureBufferPool::alloc(uint32_t size, index_t chunkIdx) {
     // create a new one
     auto targetSize = static_cast<int32_t>(std::sqrt(size / _formatSize));
     uint32_t texLength = _roundUpFn ? _roundUpFn(targetSize, _formatSize) : std::max(1024, static_cast<int>(utils::nextPOT(targetSize)));
-    auto newChunk = _chunks[createChunk(texLength)];
+    auto &newChunk = _chunks[createChunk(texLength)];
 
     newChunk.start += static_cast<index_t>(size);
     ITextureBufferHandle texHandle;
@@ -169,7 +170,7 @@ uint32_t TextureBufferPool::createChunk(uint32_t length) {
     chunk.size = texSize;
     chunk.start = 0;
     chunk.end = static_cast<index_t>(texSize);
-    _chunks[_chunkCount] = chunk;
+    _chunks.emplace_back(chunk);
     return _chunkCount++;
 }
 
@@ -247,7 +248,7 @@ index_t TextureBufferPool::findAvailableSpace(uint32_t size, index_t chunkIdx) c
                 handles.emplace_back(h);
             }
         }
-        std::sort(handles.begin(), handles.end(), [](const ITextureBufferHandle &a, const ITextureBufferHandle &b) { return a.start - b.start; });
+        std::sort(handles.begin(), handles.end(), [](const ITextureBufferHandle &a, const ITextureBufferHandle &b) { return a.start < b.start; });
         for (auto handle : handles) {
             if ((start + size) <= handle.start) {
                 isFound = true;
@@ -302,7 +303,7 @@ ITextureBufferHandle TextureBufferPool::mcDonaldAlloc(uint32_t size) {
     // create a new one
     auto targetSize = static_cast<int32_t>(std::sqrt(size / _formatSize));
     uint32_t texLength = _roundUpFn ? _roundUpFn(targetSize, _formatSize) : std::max(1024, static_cast<int>(utils::nextPOT(targetSize)));
-    auto newChunk = _chunks[createChunk(texLength)];
+    auto &newChunk = _chunks[createChunk(texLength)];
 
     newChunk.start += static_cast<index_t>(size);
     ITextureBufferHandle texHandle;
@@ -0,0 +1,174 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "renderer/core/UniformArena.h"
+#include <algorithm>
+#include <cstring>
+#include "renderer/gfx-base/GFXDevice.h"
+
+namespace cc {
+
+namespace {
+constexpr uint32_t CHUNK_SIZE = 256 * 1024;
+
+inline uint32_t alignUp(uint32_t size, uint32_t alignment) {
+    return (size + alignment - 1) / alignment * alignment;
+}
+} // namespace
+
+UniformArena *UniformArena::instance = nullptr;
+bool UniformArena::enabled = false;
+
+UniformArena *UniformArena::getInstance() {
+    return instance;
+}
+
+void UniformArena::setEnabled(bool value) {
+    enabled = value;
+}
+
+bool UniformArena::isEnabled() {
+    return enabled;
+}
+
+UniformArena::UniformArena(gfx::Device *device)
+: _device(device),
+  _alignment(std::max(device->getCapabilities().uboOffsetAlignment, 16U)) {
+    UniformArena::instance = this;
+}
+
+UniformArena::~UniformArena() {
+    for (auto &chunk : _chunks) {
+        chunk->buffer->destroy();
+    }
+    _chunks.clear();
+    UniformArena::instance = nullptr;
+}
+
+index_t UniformArena::createChunk(uint32_t size) {
+    auto chunk = std::make_unique<Chunk>();
+    chunk->size = size;
+    chunk->buffer = _device->createBuffer({
+        gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
+        gfx::MemoryUsageBit::DEVICE,
+        size,
+        size,
+    });
+    chunk->data = std::make_unique<uint8_t[]>(size);
+    memset(chunk->data.get(), 0, size);
+    chunk->freeRanges.push_back({0, size});
+    _chunks.emplace_back(std::move(chunk));
+    return static_cast<index_t>(_chunks.size() - 1);
+}
+
+bool UniformArena::allocFromChunk(Chunk &chunk, uint32_t size, uint32_t *offset) {
+    auto &ranges = chunk.freeRanges;
+    for (auto it = ranges.begin(); it != ranges.end(); ++it) {
+        if (it->size < size) {
+            continue;
+        }
+        *offset = it->offset;
+        it->offset += size;
+        it->size -= size;
+        if (it->size == 0) {
+            ranges.erase(it);
+        }
+        chunk.usedEnd = std::max(chunk.usedEnd, *offset + size);
+        return true;
+    }
+    return false;
+}
+
+UniformArenaHandle UniformArena::alloc(uint32_t size) {
+    UniformArenaHandle handle;
+    handle.size = alignUp(size, _alignment);
+
+    for (index_t i = 0; i < static_cast<index_t>(_chunks.size()); ++i) {
+        if (allocFromChunk(*_chunks[i], handle.size, &handle.offset)) {
+            handle.chunkIdx = i;
+            break;
+        }
+    }
+    if (!handle.isValid()) {
+        handle.chunkIdx = createChunk(std::max(CHUNK_SIZE, handle.size));
+        allocFromChunk(*_chunks[handle.chunkIdx], handle.size, &handle.offset);
+    }
+
+    _allocatedSize += handle.size;
+    return handle;
+}
+
+void UniformArena::free(UniformArenaHandle &handle) {
+    if (!handle.isValid() || handle.chunkIdx >= static_cast<index_t>(_chunks.size())) {
+        return;
+    }
+    auto &chunk = *_chunks[handle.chunkIdx];
+    auto &ranges = chunk.freeRanges;
+    auto next = std::lower_bound(ranges.begin(), ranges.end(), handle.offset,
+                                 [](const FreeRange &range, uint32_t offset) { return range.offset < offset; });
+    auto it = ranges.insert(next, {handle.offset, handle.size});
+
+    // merge with the following and the preceding free ranges
+    auto following = it + 1;
+    if (following != ranges.end() && it->offset + it->size == following->offset) {
+        it->size += following->size;
+        ranges.erase(following);
+    }
+    if (it != ranges.begin()) {
+        auto preceding = it - 1;
+        if (preceding->offset + preceding->size == it->offset) {
+            preceding->size += it->size;
+            it = ranges.erase(it) - 1;
+        }
+    }
+    if (it->offset + it->size == chunk.size) {
+        chunk.usedEnd = it->offset;
+    }
+
+    _allocatedSize -= handle.size;
+    handle = {};
+}
+
+gfx::Buffer *UniformArena::createBufferView(const UniformArenaHandle &handle, uint32_t offset, uint32_t range) const {
+    CC_ASSERT(handle.isValid() && offset + range <= handle.size);
+    return _device->createBuffer({_chunks[handle.chunkIdx]->buffer.get(), handle.offset + offset, range});
+}
+
+void UniformArena::write(const UniformArenaHandle &handle, const void *data, uint32_t offset, uint32_t size) {
+    CC_ASSERT(handle.isValid() && offset + size <= handle.size);
+    auto &chunk = *_chunks[handle.chunkIdx];
+    memcpy(chunk.data.get() + handle.offset + offset, data, size);
+    chunk.dirty.store(true, std::memory_order_relaxed);
+}
+
+void UniformArena::flush() {
+    for (auto &chunk : _chunks) {
+        if (chunk->dirty.exchange(false, std::memory_order_relaxed) && chunk->usedEnd > 0) {
+            chunk->buffer->update(chunk->data.get(), chunk->usedEnd);
+        }
+    }
+}
+
+} // namespace cc
@@ -0,0 +1,114 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include "base/Macros.h"
+#include "base/Ptr.h"
+#include "base/TypeDef.h"
+#include "base/std/container/vector.h"
+#include "renderer/gfx-base/GFXBuffer.h"
+
+namespace cc {
+
+namespace gfx {
+class Device;
+}
+
+struct UniformArenaHandle {
+    index_t chunkIdx{-1};
+    uint32_t offset{0};
+    uint32_t size{0};
+
+    inline bool isValid() const { return chunkIdx >= 0; }
+};
+
+/**
+ * Sub-allocates uniform blocks of models and passes from a few large uniform buffers.
+ * Every allocation is bound through a buffer view of its chunk, writes only go to the CPU shadow of the chunk,
+ * and `flush` uploads each dirty chunk with a single buffer update once per frame,
+ * instead of one gfx buffer object and one update for every model and pass.
+ * The arena is opt-in: `getInstance` returns nullptr unless it was enabled before `Root` is initialized.
+ */
+class CC_DLL UniformArena final {
+public:
+    static UniformArena *getInstance();
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    explicit UniformArena(gfx::Device *device);
+    ~UniformArena();
+
+    UniformArenaHandle alloc(uint32_t size);
+    void free(UniformArenaHandle &handle);
+
+    // The returned view is owned by the caller and covers [handle.offset + offset, handle.offset + offset + range).
+    gfx::Buffer *createBufferView(const UniformArenaHandle &handle, uint32_t offset, uint32_t range) const;
+
+    // Safe to call from job system workers as long as the handles are distinct.
+    void write(const UniformArenaHandle &handle, const void *data, uint32_t offset, uint32_t size);
+    template <typename T>
+    void write(const UniformArenaHandle &handle, const T &value, uint32_t offset) {
+        write(handle, &value, offset, sizeof(T));
+    }
+
+    void flush();
+
+    inline uint32_t getChunkCount() const { return static_cast<uint32_t>(_chunks.size()); }
+    inline uint32_t getAllocatedSize() const { return _allocatedSize; }
+
+private:
+    struct FreeRange {
+        uint32_t offset{0};
+        uint32_t size{0};
+    };
+
+    struct Chunk {
+        IntrusivePtr<gfx::Buffer> buffer;
+        std::unique_ptr<uint8_t[]> data;
+        ccstd::vector<FreeRange> freeRanges; // sorted by offset, never adjacent
+        uint32_t size{0};
+        uint32_t usedEnd{0};
+        std::atomic<bool> dirty{false};
+    };
+
+    index_t createChunk(uint32_t size);
+    static bool allocFromChunk(Chunk &chunk, uint32_t size, uint32_t *offset);
+
+    static UniformArena *instance;
+    static bool enabled;
+
+    gfx::Device *_device{nullptr};
+    uint32_t _alignment{1};
+    uint32_t _allocatedSize{0};
+    ccstd::vector<std::unique_ptr<Chunk>> _chunks;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(UniformArena);
+};
+
+} // namespace cc
@@ -24,6 +24,7 @@
 ****************************************************************************/
 
 #pragma once
+#include <atomic>
 #include "GFXDef.h"
 
 namespace cc {
@@ -45,7 +46,7 @@ public:
 protected:
     template <typename T>
     static uint32_t generateObjectID() noexcept {
-        static uint32_t generator = 1 << 16;
+        static std::atomic<uint32_t> generator{1 << 16};
         return ++generator;
     }
 
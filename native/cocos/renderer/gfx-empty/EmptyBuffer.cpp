@@ -24,20 +24,28 @@
 ****************************************************************************/
 
 #include "EmptyBuffer.h"
+#include "EmptyDevice.h"
 
 namespace cc {
 namespace gfx {
 
 void EmptyBuffer::doInit(const BufferInfo &info) {
+    EmptyDevice::getInstance()->getMemoryStatus().bufferSize += _size;
 }
 
 void EmptyBuffer::doInit(const BufferViewInfo &info) {
 }
 
 void EmptyBuffer::doResize(uint32_t size, uint32_t count) {
+    auto &status = EmptyDevice::getInstance()->getMemoryStatus();
+    status.bufferSize -= _size;
+    status.bufferSize += size;
 }
 
 void EmptyBuffer::doDestroy() {
+    if (!_isBufferView) {
+        EmptyDevice::getInstance()->getMemoryStatus().bufferSize -= _size;
+    }
 }
 
 void EmptyBuffer::update(const void *buffer, uint32_t size) {
@@ -24,12 +24,14 @@
 ****************************************************************************/
 
 #include "EmptyTexture.h"
+#include "EmptyDevice.h"
 #include "gfx-base/GFXDef.h"
 
 namespace cc {
 namespace gfx {
 
 void EmptyTexture::doInit(const TextureInfo &info) {
+    EmptyDevice::getInstance()->getMemoryStatus().textureSize += _size;
 }
 
 void EmptyTexture::doInit(const TextureViewInfo &info) {
@@ -39,9 +41,17 @@ void EmptyTexture::doInit(const SwapchainTextureInfo &info) {
 }
 
 void EmptyTexture::doDestroy() {
+    if (!_isTextureView && !_swapchain) {
+        EmptyDevice::getInstance()->getMemoryStatus().textureSize -= _size;
+    }
 }
 
 void EmptyTexture::doResize(uint32_t width, uint32_t height, uint32_t size) {
+    if (!_isTextureView && !_swapchain) {
+        auto &status = EmptyDevice::getInstance()->getMemoryStatus();
+        status.textureSize -= _size;
+        status.textureSize += size;
+    }
 }
 
 } // namespace gfx
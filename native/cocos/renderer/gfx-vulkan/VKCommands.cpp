@@ -939,12 +939,12 @@ void cmdFuncCCVKCreateComputePipelineState(CCVKDevice *device, CCVKGPUPipelineSt
 }
 
 void cmdFuncCCVKCreateGraphicsPipelineState(CCVKDevice *device, CCVKGPUPipelineState *gpuPipelineState) {
-    static ccstd::vector<VkPipelineShaderStageCreateInfo> stageInfos;
-    static ccstd::vector<VkVertexInputBindingDescription> bindingDescriptions;
-    static ccstd::vector<VkVertexInputAttributeDescription> attributeDescriptions;
-    static ccstd::vector<uint32_t> offsets;
-    static ccstd::vector<VkDynamicState> dynamicStates;
-    static ccstd::vector<VkPipelineColorBlendAttachmentState> blendTargets;
+    thread_local ccstd::vector<VkPipelineShaderStageCreateInfo> stageInfos;
+    thread_local ccstd::vector<VkVertexInputBindingDescription> bindingDescriptions;
+    thread_local ccstd::vector<VkVertexInputAttributeDescription> attributeDescriptions;
+    thread_local ccstd::vector<uint32_t> offsets;
+    thread_local ccstd::vector<VkDynamicState> dynamicStates;
+    thread_local ccstd::vector<VkPipelineColorBlendAttachmentState> blendTargets;
 
     VkGraphicsPipelineCreateInfo createInfo{VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO};
 
@@ -65,6 +65,7 @@ void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx, gfx::Sh
     auto *lightingMap = descriptorSet->getTexture(LIGHTMAPTEXTURE::BINDING);
     auto *reflectionProbeCubemap = descriptorSet->getTexture(REFLECTIONPROBECUBEMAP::BINDING);
     auto *reflectionProbePlanarMap = descriptorSet->getTexture(REFLECTIONPROBEPLANARMAP::BINDING);
+    auto *jointTexture = descriptorSet->getTexture(JOINTTEXTURE::BINDING);
     uint32_t reflectionProbeType = subModel->getReflectionProbeType();
     auto *shader = shaderImplant;
     if (!shader) {
@@ -90,6 +91,9 @@ void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx, gfx::Sh
         if (instance.reflectionProbePlanarMap != reflectionProbePlanarMap) {
             continue;
         }
+        if (instance.jointTexture != jointTexture) {
+            continue;
+        }
 
         if (instance.stride != stride) {
             continue;
@@ -140,7 +144,7 @@ void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx, gfx::Sh
     const gfx::InputAssemblerInfo iaInfo = {attributes, vertexBuffers, indexBuffer};
     auto *ia = _device->createInputAssembler(iaInfo);
     InstancedItem item = {1, INITIAL_CAPACITY, vb, data, ia, stride, shader, descriptorSet,
-                          lightingMap, reflectionProbeCubemap, reflectionProbePlanarMap, reflectionProbeType};
+                          lightingMap, reflectionProbeCubemap, reflectionProbePlanarMap, reflectionProbeType, jointTexture};
     _instances.emplace_back(item);
     _hasPendingModels = true;
 }
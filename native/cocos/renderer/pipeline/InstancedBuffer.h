@@ -51,6 +51,7 @@ struct CC_DLL InstancedItem {
     gfx::Texture *reflectionProbeCubemap = nullptr;
     gfx::Texture *reflectionProbePlanarMap = nullptr;
     uint32_t reflectionProbeType = 0;
+    gfx::Texture *jointTexture = nullptr; // baked skinning models share a draw only if they sample the same joint texture
 };
 using InstancedItemList = ccstd::vector<InstancedItem>;
 using DynamicOffsetList = ccstd::vector<uint32_t>;
@@ -25,6 +25,8 @@
 
 #include "LODModelsUtil.h"
 
+#include <algorithm>
+#include "core/Root.h"
 #include "scene/Camera.h"
 #include "scene/LODGroup.h"
 #include "scene/Model.h"
@@ -33,23 +35,83 @@
 namespace cc {
 namespace pipeline {
 
+namespace {
+
 /**
- * @zh LOD所有级别中存储的model集合；包含多个LODGroup的所有LOD
- * @en The collection of models stored in all levels of LOD, All LODs containing multiple LODGroups.
+ * @zh LOD所有级别中存储的model集合；包含多个LODGroup的所有LOD，按 model 在场景中的 slot 存为位集
+ * @en The collection of models stored in all levels of LOD, All LODs containing multiple LODGroups, a bit per scene slot of the models.
  */
-ccstd::unordered_map<const scene::Model *, bool> modelsInAnyLODGroup;
+ccstd::vector<uint32_t> modelsInAnyLODGroup;
 
 /**
- * @zh 指定相机下，某一级LOD使用的model集合；可能包含多个LODGroup的某一级LOD
- * @en Specify the model set used by a level of LOD under the camera, LOD of a level that may contain multiple LODGroups.
+ * @zh 指定相机下，某一级LOD使用的model集合；可能包含多个LODGroup的某一级LOD，按 model 在场景中的 slot 存为位集
+ * @en Specify the model set used by a level of LOD under the camera, LOD of a level that may contain multiple LODGroups, a bit per scene slot of the models.
  */
-ccstd::unordered_map<const scene::Model *, bool> visibleModelsByAnyLODGroup;
+ccstd::vector<uint32_t> visibleModelsByAnyLODGroup;
+
+ccstd::vector<const scene::LODGroup *> lodGroups;
+ccstd::vector<int8_t> lodLevels;
+
+// the adaptive bias moves by these factors per frame, so it takes about a second to drop or to recover
+constexpr float LOD_BIAS_DECREASE{0.95F};
+constexpr float LOD_BIAS_INCREASE{1.02F};
+constexpr float MIN_ADAPTIVE_LOD_BIAS{0.25F};
+
+float lodBias{1.F};
+float frameTimeBudget{0.F};
+float adaptiveLODBias{1.F};
+float lastAdaptedTime{-1.F};
+
+inline void setSlot(ccstd::vector<uint32_t> &bits, uint32_t slot) {
+    bits[slot >> 5] |= 1U << (slot & 31);
+}
+
+inline bool testSlot(const ccstd::vector<uint32_t> &bits, uint32_t slot) {
+    return (slot >> 5) < bits.size() && ((bits[slot >> 5] >> (slot & 31)) & 1U);
+}
+
+void addModel(ccstd::vector<uint32_t> &bits, const scene::Model *model) {
+    // models which aren't in the scene are never culled
+    const uint32_t slot = model->getSceneSlot();
+    if ((slot >> 5) < bits.size()) {
+        setSlot(bits, slot);
+    }
+}
+
+void updateAdaptiveLODBias() {
+    auto *root = Root::getInstance();
+    if (frameTimeBudget <= 0.F || !root) {
+        adaptiveLODBias = 1.F;
+        return;
+    }
+    // adapt once per frame, there may be several cameras
+    const float time = root->getCumulativeTime();
+    if (time == lastAdaptedTime) {
+        return;
+    }
+    lastAdaptedTime = time;
+
+    const float frameTime = root->getFrameTime();
+    if (frameTime > frameTimeBudget) {
+        adaptiveLODBias = std::max(adaptiveLODBias * LOD_BIAS_DECREASE, MIN_ADAPTIVE_LOD_BIAS);
+    } else if (frameTime < frameTimeBudget * 0.9F) {
+        adaptiveLODBias = std::min(adaptiveLODBias * LOD_BIAS_INCREASE, 1.F);
+    }
+}
+
+} // namespace
 
 void LODModelsCachedUtils::updateCachedLODModels(const scene::RenderScene *scene, const scene::Camera *camera) {
+    const uint32_t slotWords = (scene->getWorldBoundsSoA().getCapacity() + 31) / 32;
+    modelsInAnyLODGroup.assign(slotWords, 0U);
+    visibleModelsByAnyLODGroup.assign(slotWords, 0U);
+    updateAdaptiveLODBias();
+
+    lodGroups.clear();
     for (const auto &lodGroup : scene->getLODGroups()) {
         if (lodGroup->isEnabled()) {
-            const auto &lodLevels = lodGroup->getLockedLODLevels();
-            uint8_t count = lodLevels.size();
+            const auto &lockedLevels = lodGroup->getLockedLODLevels();
+            uint8_t count = lockedLevels.size();
             // count == 0 will return to standard LOD processing.
             if (count > 0) {
                 for (auto index = 0; index < lodGroup->getLodCount(); index++) {
@@ -57,42 +119,73 @@ void LODModelsCachedUtils::updateCachedLODModels(const scene::RenderScene *scene
                     for (const auto &model : lod->getModels()) {
                         for (auto i = 0; i < count; i++) {
                             // The LOD level to use.
-                            if (lodLevels[i] == index) {
+                            if (lockedLevels[i] == index) {
                                 auto *node = model->getNode();
                                 if (node && node->isActive()) {
-                                    visibleModelsByAnyLODGroup[model] = true;
+                                    addModel(visibleModelsByAnyLODGroup, model);
                                     break;
                                 }
                             }
                         }
-                        modelsInAnyLODGroup[model] = true;
+                        addModel(modelsInAnyLODGroup, model);
                     }
                 }
                 continue;
             }
+            lodGroups.emplace_back(lodGroup);
+        }
+    }
 
-            int8_t visIndex = lodGroup->getVisibleLODLevel(camera);
-            for (auto index = 0; index < lodGroup->getLodCount(); index++) {
-                const auto &lod = lodGroup->getLodDataArray()[index];
-                for (const auto &model : lod->getModels()) {
-                    auto *node = model->getNode();
-                    if (visIndex == index && node && node->isActive()) {
-                        visibleModelsByAnyLODGroup[model] = true;
-                    }
-                    modelsInAnyLODGroup[model] = true;
+    scene::LODGroup::getVisibleLODLevels(lodGroups, camera, getEffectiveLODBias(), lodLevels);
+    for (size_t g = 0; g < lodGroups.size(); ++g) {
+        const auto *lodGroup = lodGroups[g];
+        const int8_t visIndex = lodLevels[g];
+        for (auto index = 0; index < lodGroup->getLodCount(); index++) {
+            const auto &lod = lodGroup->getLodDataArray()[index];
+            for (const auto &model : lod->getModels()) {
+                auto *node = model->getNode();
+                if (visIndex == index && node && node->isActive()) {
+                    addModel(visibleModelsByAnyLODGroup, model);
                 }
+                addModel(modelsInAnyLODGroup, model);
             }
         }
     }
 }
 
 bool LODModelsCachedUtils::isLODModelCulled(const scene::Model *model) {
-    return modelsInAnyLODGroup[model] && !visibleModelsByAnyLODGroup[model];
+    const uint32_t slot = model->getSceneSlot();
+    return testSlot(modelsInAnyLODGroup, slot) && !testSlot(visibleModelsByAnyLODGroup, slot);
 }
 
 void LODModelsCachedUtils::clearCachedLODModels() {
+    // keep the capacity, the bit sets are refilled for the next camera
     modelsInAnyLODGroup.clear();
     visibleModelsByAnyLODGroup.clear();
 }
+
+void LODModelsCachedUtils::setLODBias(float bias) {
+    lodBias = std::max(bias, 0.F);
+}
+
+float LODModelsCachedUtils::getLODBias() {
+    return lodBias;
+}
+
+void LODModelsCachedUtils::setFrameTimeBudget(float seconds) {
+    frameTimeBudget = seconds;
+    if (seconds <= 0.F) {
+        adaptiveLODBias = 1.F;
+    }
+}
+
+float LODModelsCachedUtils::getFrameTimeBudget() {
+    return frameTimeBudget;
+}
+
+float LODModelsCachedUtils::getEffectiveLODBias() {
+    return lodBias * adaptiveLODBias;
+}
+
 } // namespace pipeline
 } // namespace cc
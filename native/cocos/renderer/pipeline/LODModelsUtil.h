@@ -39,6 +39,24 @@ public:
     static void updateCachedLODModels(const scene::RenderScene *scene, const scene::Camera *camera);
     static bool isLODModelCulled(const scene::Model *model);
     static void clearCachedLODModels();
+
+    /**
+     * @en Scales the screen usage of all the LOD groups, values below 1 select coarser LOD levels.
+     * @zh 缩放所有 LOD 组的屏幕占比，小于 1 时选用更粗糙的 LOD 级别。
+     */
+    static void setLODBias(float bias);
+    static float getLODBias();
+
+    /**
+     * @en The frame time in seconds to keep under by lowering the LOD bias automatically, 0 disables it.
+     * The bias recovers gradually once the frames are fast enough again.
+     * @zh 自动降低 LOD 偏移以保持的帧时间（秒），为 0 时关闭。帧时间恢复后偏移会逐渐恢复。
+     */
+    static void setFrameTimeBudget(float seconds);
+    static float getFrameTimeBudget();
+
+    // the bias actually used, the product of the LOD bias and the frame time adaptation
+    static float getEffectiveLODBias();
 };
 } // namespace pipeline
 } // namespace cc
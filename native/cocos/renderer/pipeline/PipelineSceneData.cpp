@@ -25,6 +25,7 @@
 
 #include "PipelineSceneData.h"
 #include <sstream>
+#include "SceneCulling.h"
 #include "core/ArrayBuffer.h"
 #include "core/assets/Material.h"
 #include "gfx-base/GFXDef-common.h"
@@ -47,6 +48,7 @@ PipelineSceneData::PipelineSceneData() {
     _skybox = ccnew scene::Skybox();
     _shadow = ccnew scene::Shadows();
     _csmLayers = ccnew CSMLayers();
+    _sceneCullingData = ccnew SceneCullingData();
     _octree = ccnew scene::Octree();
     _lightProbes = ccnew gi::LightProbes();
 }
@@ -58,6 +60,7 @@ PipelineSceneData::~PipelineSceneData() {
     CC_SAFE_DELETE(_shadow);
     CC_SAFE_DELETE(_octree);
     CC_SAFE_DELETE(_csmLayers);
+    CC_SAFE_DELETE(_sceneCullingData);
     CC_SAFE_DELETE(_lightProbes);
 }
 
@@ -80,12 +83,26 @@ void PipelineSceneData::activate(gfx::Device *device) {
 void PipelineSceneData::destroy() {
     _shadowFrameBufferMap.clear();
     _validPunctualLights.clear();
+    _punctualLightShadowObjects.clear();
 
     _occlusionQueryInputAssembler = nullptr;
     _occlusionQueryVertexBuffer = nullptr;
     _occlusionQueryIndicesBuffer = nullptr;
 }
 
+const RenderObjectList *PipelineSceneData::getPunctualLightShadowObjects(const scene::Light *light) const {
+    const auto iter = std::find(_validPunctualLights.begin(), _validPunctualLights.end(), light);
+    const auto index = static_cast<size_t>(iter - _validPunctualLights.begin());
+    return index < _punctualLightShadowObjects.size() ? &_punctualLightShadowObjects[index] : nullptr;
+}
+
+void PipelineSceneData::resizePunctualLightShadowObjects(size_t count) {
+    for (auto &objects : _punctualLightShadowObjects) {
+        objects.clear();
+    }
+    _punctualLightShadowObjects.resize(count);
+}
+
 void PipelineSceneData::initOcclusionQuery() {
     CC_ASSERT(!_occlusionQueryInputAssembler);
     _occlusionQueryInputAssembler = createOcclusionQueryIA();
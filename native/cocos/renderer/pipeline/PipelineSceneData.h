@@ -51,6 +51,8 @@ class LightProbes;
 
 namespace pipeline {
 
+struct SceneCullingData;
+
 class CC_DLL PipelineSceneData : public RefCounted {
 public:
     PipelineSceneData();
@@ -69,6 +71,7 @@ public:
     inline void setHDR(bool val) { _isHDR = val; }
     inline scene::Shadows *getShadows() const { return _shadow; }
     inline CSMLayers *getCSMLayers() const { return _csmLayers; }
+    inline SceneCullingData *getSceneCullingData() const { return _sceneCullingData; }
     inline scene::Ambient *getAmbient() const { return _ambient; }
     inline scene::Skybox *getSkybox() const { return _skybox; }
     inline scene::Fog *getFog() const { return _fog; }
@@ -86,6 +89,10 @@ public:
     inline void clearRenderObjects() { _renderObjects.clear(); }
     inline void addValidPunctualLight(scene::Light *light) { _validPunctualLights.emplace_back(light); }
     inline void clearValidPunctualLights() { _validPunctualLights.clear(); }
+    // shadow casters of the valid punctual lights, indexed as the valid punctual lights
+    inline RenderObjectList *getPunctualLightShadowObjects(size_t index) { return &_punctualLightShadowObjects[index]; }
+    const RenderObjectList *getPunctualLightShadowObjects(const scene::Light *light) const;
+    void resizePunctualLightShadowObjects(size_t count);
     inline float getShadingScale() const { return _shadingScale; }
     inline void setShadingScale(float val) { _shadingScale = val; }
     inline bool getCSMSupported() const { return _csmSupported; }
@@ -124,6 +131,8 @@ protected:
     gi::LightProbes *_lightProbes{nullptr};
 
     CSMLayers *_csmLayers{nullptr};
+    // manage memory manually
+    SceneCullingData *_sceneCullingData{nullptr};
 
     bool _isHDR{true};
     bool _csmSupported{true};
@@ -135,6 +144,7 @@ protected:
     ccstd::vector<IntrusivePtr<Material>> _geometryRendererMaterials;
     // `scene::Light *`: weak reference
     ccstd::vector<const scene::Light *> _validPunctualLights;
+    ccstd::vector<RenderObjectList> _punctualLightShadowObjects;
     ccstd::vector<scene::Pass *> _geometryRendererPasses;  // weak reference
     ccstd::vector<gfx::Shader *> _geometryRendererShaders; // weak reference
 
@@ -24,56 +24,403 @@
 ****************************************************************************/
 
 #include "PipelineStateManager.h"
+#include <future>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include "base/Log.h"
+#include "base/job-system/JobSystem.h"
+#include "base/std/container/list.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/unordered_set.h"
+#include "base/std/hash/hash.h"
+#include "gfx-agent/DeviceAgent.h"
 #include "gfx-base/GFXDef-common.h"
 #include "gfx-base/GFXDevice.h"
+#include "gfx-validator/DeviceValidator.h"
+#include "platform/FileUtils.h"
+#include "renderer/core/ProgramLib.h"
 #include "scene/Pass.h"
 
 namespace cc {
 namespace pipeline {
 
-ccstd::unordered_map<ccstd::hash_t, IntrusivePtr<gfx::PipelineState>> PipelineStateManager::psoHashMap;
+namespace {
+
+// Pipeline states unused for fewer frames may still be referenced by the command buffers of the frames in flight.
+constexpr uint32_t EVICTION_FRAME_DELAY{4};
+constexpr uint32_t WARM_UP_LIST_VERSION{2};
+// Distinct pipeline states recorded at most, a bound for materials generating variants at runtime.
+constexpr size_t MAX_WARM_UP_RECORDS{4096};
+// Sanity bound for the attribute count read from a warm-up list.
+constexpr size_t MAX_ATTRIBUTE_COUNT{64};
+
+struct PipelineStateKey {
+    ccstd::hash_t passHash{0};
+    ccstd::hash_t renderPassHash{0};
+    ccstd::hash_t iaHash{0};
+    uint32_t shaderID{0};
+    uint32_t subpass{0};
+
+    bool operator==(const PipelineStateKey &rhs) const {
+        return passHash == rhs.passHash && renderPassHash == rhs.renderPassHash &&
+               iaHash == rhs.iaHash && shaderID == rhs.shaderID && subpass == rhs.subpass;
+    }
+};
+
+struct PipelineStateKeyHasher {
+    ccstd::hash_t operator()(const PipelineStateKey &key) const {
+        ccstd::hash_t seed = 0;
+        ccstd::hash_combine(seed, key.passHash);
+        ccstd::hash_combine(seed, key.renderPassHash);
+        ccstd::hash_combine(seed, key.iaHash);
+        ccstd::hash_combine(seed, key.shaderID);
+        ccstd::hash_combine(seed, key.subpass);
+        return seed;
+    }
+};
+
+struct CachedPipelineState {
+    IntrusivePtr<gfx::PipelineState> pso;
+    uint32_t lastUsedFrame{0};
+    ccstd::list<PipelineStateKey>::iterator lruIter;
+};
+
+struct PendingCreation {
+    // keep the resources alive until the worker is done, released on the render thread
+    IntrusivePtr<gfx::Shader> shader;
+    IntrusivePtr<gfx::PipelineLayout> pipelineLayout;
+    IntrusivePtr<gfx::RenderPass> renderPass;
+    std::future<gfx::PipelineState *> result;
+};
+
+struct WarmUpRecord {
+    ccstd::hash_t passHash{0};
+    ccstd::hash_t renderPassHash{0};
+    ccstd::hash_t iaHash{0};
+    uint32_t subpass{0};
+    ccstd::string shaderName;
+    gfx::AttributeList attributes;
+};
+
+// Most calls come from the render thread, but nothing prevents scripts or other threads from using the cache,
+// so every entry point locks. Worker threads only touch the futures, never the cache.
+struct PipelineStateCache {
+    std::mutex mutex;
+    ccstd::unordered_map<PipelineStateKey, CachedPipelineState, PipelineStateKeyHasher> states;
+    ccstd::list<PipelineStateKey> lru; // most recently used first
+    ccstd::unordered_map<PipelineStateKey, PendingCreation, PipelineStateKeyHasher> pending;
+    uint32_t capacity{0};
+    uint32_t frame{0};
+    bool asyncCreationEnabled{false};
+
+    ccstd::vector<WarmUpRecord> warmUpRecords;
+    ccstd::unordered_set<ccstd::hash_t> warmUpRecordHashes;
+};
+
+PipelineStateCache cache;
+
+uint32_t getCurrentFrame() {
+    return cache.frame;
+}
+
+bool canCreateAsync() {
+    // only the Vulkan backend creates pipeline states without touching any per-thread context,
+    // the device agent and the validator keep per-call state on the calling thread.
+    auto *device = gfx::Device::getInstance();
+    return cache.asyncCreationEnabled && device->getGfxAPI() == gfx::API::VULKAN &&
+           !gfx::DeviceAgent::getInstance() && !gfx::DeviceValidator::getInstance();
+}
+
+gfx::PipelineStateInfo makePipelineStateInfo(const scene::Pass *pass, gfx::Shader *shader,
+                                             const gfx::AttributeList &attributes,
+                                             gfx::RenderPass *renderPass, uint32_t subpass) {
+    return {shader,
+            pass->getPipelineLayout(),
+            renderPass,
+            {attributes},
+            *(pass->getRasterizerState()),
+            *(pass->getDepthStencilState()),
+            *(pass->getBlendState()),
+            pass->getPrimitive(),
+            pass->getDynamicStates(),
+            gfx::PipelineBindPoint::GRAPHICS,
+            subpass};
+}
+
+void addWarmUpRecord(WarmUpRecord &&record) {
+    if (cache.warmUpRecords.size() >= MAX_WARM_UP_RECORDS) return;
+
+    ccstd::hash_t hash = 0;
+    ccstd::hash_combine(hash, record.passHash);
+    ccstd::hash_combine(hash, record.renderPassHash);
+    ccstd::hash_combine(hash, record.iaHash);
+    ccstd::hash_combine(hash, record.subpass);
+    ccstd::hash_combine(hash, record.shaderName);
+    if (!cache.warmUpRecordHashes.insert(hash).second) return;
+
+    cache.warmUpRecords.push_back(std::move(record));
+    if (cache.warmUpRecords.size() == MAX_WARM_UP_RECORDS) {
+        CC_LOG_WARNING("Pipeline state warm-up list is full, further pipeline states are not recorded");
+    }
+}
+
+void recordWarmUp(const PipelineStateKey &key, const gfx::Shader *shader, const gfx::AttributeList &attributes) {
+    addWarmUpRecord({key.passHash, key.renderPassHash, key.iaHash, key.subpass, shader->getName(), attributes});
+}
+
+// Strings are written length-prefixed, i.e. `<size>:<bytes>`, so they may contain any character.
+void writeString(std::ostream &out, const ccstd::string &str) {
+    out << str.size() << ':' << str;
+}
+
+bool readString(std::istream &in, ccstd::string &str) {
+    size_t size = 0;
+    char separator = 0;
+    if (!(in >> size) || !in.get(separator) || separator != ':') {
+        in.setstate(std::ios::failbit);
+        return false;
+    }
+    str.resize(size);
+    return size == 0 || in.read(&str[0], static_cast<std::streamsize>(size));
+}
+
+void evictUnused() {
+    if (!cache.capacity || cache.states.size() <= cache.capacity) return;
+
+    const uint32_t frame = getCurrentFrame();
+    while (cache.states.size() > cache.capacity) {
+        auto iter = cache.states.find(cache.lru.back());
+        if (iter->second.lastUsedFrame + EVICTION_FRAME_DELAY > frame) break;
+
+        // only the reference of the cache is dropped, the pipeline state is destroyed with the last one,
+        // e.g. after the script objects wrapping it are collected
+        cache.states.erase(iter);
+        cache.lru.pop_back();
+    }
+}
+
+gfx::PipelineState *insert(const PipelineStateKey &key, gfx::PipelineState *pso) {
+    cache.lru.push_front(key);
+    cache.states[key] = {pso, getCurrentFrame(), cache.lru.begin()};
+    return pso;
+}
+
+gfx::PipelineState *find(const PipelineStateKey &key) {
+    auto iter = cache.states.find(key);
+    if (iter == cache.states.end()) return nullptr;
+
+    auto &state = iter->second;
+    if (cache.capacity) {
+        state.lastUsedFrame = getCurrentFrame();
+        cache.lru.splice(cache.lru.begin(), cache.lru, state.lruIter);
+    }
+    return state.pso;
+}
+
+// Returns the pipeline state if the pending creation is done, waits for it if `wait` is set.
+gfx::PipelineState *resolvePending(const PipelineStateKey &key, bool wait) {
+    auto iter = cache.pending.find(key);
+    if (iter == cache.pending.end()) return nullptr;
+
+    auto &result = iter->second.result;
+    if (!wait && result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return nullptr;
+
+    auto *pso = result.get();
+    cache.pending.erase(iter);
+    return insert(key, pso);
+}
+
+void createAsync(const PipelineStateKey &key, gfx::PipelineStateInfo &&info) {
+    PendingCreation creation;
+    creation.shader = info.shader;
+    creation.pipelineLayout = info.pipelineLayout;
+    creation.renderPass = info.renderPass;
+    auto task = std::make_shared<std::packaged_task<gfx::PipelineState *()>>([info = std::move(info)]() {
+        return gfx::Device::getInstance()->createPipelineState(info);
+    });
+    creation.result = task->get_future();
+    JobSystem::getInstance()->dispatchBackground([task]() { (*task)(); });
+    cache.pending.emplace(key, std::move(creation));
+}
+
+gfx::PipelineState *getOrCreate(const scene::Pass *pass, gfx::Shader *shader, gfx::InputAssembler *inputAssembler,
+                                gfx::RenderPass *renderPass, uint32_t subpass, bool async) {
+    const PipelineStateKey key{pass->getHash(), renderPass->getHash(), inputAssembler->getAttributesHash(), shader->getTypedID(), subpass};
+
+    if (auto *pso = find(key)) return pso;
+    if (!cache.pending.empty() && cache.pending.count(key)) {
+        return resolvePending(key, !async);
+    }
+
+    recordWarmUp(key, shader, inputAssembler->getAttributes());
+    auto info = makePipelineStateInfo(pass, shader, inputAssembler->getAttributes(), renderPass, subpass);
+    if (async && canCreateAsync()) {
+        createAsync(key, std::move(info));
+        return nullptr;
+    }
+    return insert(key, gfx::Device::getInstance()->createPipelineState(info));
+}
+
+} // namespace
 
 gfx::PipelineState *PipelineStateManager::getOrCreatePipelineState(const scene::Pass *pass,
                                                                    gfx::Shader *shader,
                                                                    gfx::InputAssembler *inputAssembler,
                                                                    gfx::RenderPass *renderPass,
                                                                    uint32_t subpass) {
-    const auto passHash = pass->getHash();
-    const auto renderPassHash = renderPass->getHash();
-    const auto iaHash = inputAssembler->getAttributesHash();
-    const auto shaderID = shader->getTypedID();
-    auto hash = passHash ^ renderPassHash ^ iaHash ^ shaderID;
-    if (subpass != 0) {
-        hash = hash << subpass;
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return getOrCreate(pass, shader, inputAssembler, renderPass, subpass, false);
+}
+
+gfx::PipelineState *PipelineStateManager::getOrCreatePipelineStateAsync(const scene::Pass *pass,
+                                                                        gfx::Shader *shader,
+                                                                        gfx::InputAssembler *inputAssembler,
+                                                                        gfx::RenderPass *renderPass,
+                                                                        uint32_t subpass) {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return getOrCreate(pass, shader, inputAssembler, renderPass, subpass, true);
+}
+
+void PipelineStateManager::setAsyncCreationEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.asyncCreationEnabled = enabled;
+}
+
+bool PipelineStateManager::isAsyncCreationEnabled() {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return cache.asyncCreationEnabled;
+}
+
+void PipelineStateManager::setCapacity(uint32_t capacity) {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (capacity && !cache.capacity) {
+        // usage isn't tracked without a capacity, assume everything is in use
+        const uint32_t frame = getCurrentFrame();
+        for (auto &pair : cache.states) pair.second.lastUsedFrame = frame;
     }
+    cache.capacity = capacity;
+    evictUnused();
+}
+
+void PipelineStateManager::onFrameEnd() {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    ++cache.frame;
+    evictUnused();
+}
 
-    auto *pso = psoHashMap[static_cast<ccstd::hash_t>(hash)].get();
-    if (!pso) {
-        auto *pipelineLayout = pass->getPipelineLayout();
-
-        pso = gfx::Device::getInstance()->createPipelineState({shader,
-                                                               pipelineLayout,
-                                                               renderPass,
-                                                               {inputAssembler->getAttributes()},
-                                                               *(pass->getRasterizerState()),
-                                                               *(pass->getDepthStencilState()),
-                                                               *(pass->getBlendState()),
-                                                               pass->getPrimitive(),
-                                                               pass->getDynamicStates(),
-                                                               gfx::PipelineBindPoint::GRAPHICS,
-                                                               subpass});
-
-        psoHashMap[static_cast<ccstd::hash_t>(hash)] = pso;
+uint32_t PipelineStateManager::getCapacity() {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return cache.capacity;
+}
+
+uint32_t PipelineStateManager::getPipelineStateCount() {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return static_cast<uint32_t>(cache.states.size());
+}
+
+bool PipelineStateManager::saveWarmUpList(const ccstd::string &path) {
+    std::ostringstream out;
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        out << WARM_UP_LIST_VERSION << '\n';
+        for (const auto &record : cache.warmUpRecords) {
+            out << record.passHash << ' ' << record.renderPassHash << ' ' << record.iaHash << ' ' << record.subpass << ' ';
+            writeString(out, record.shaderName);
+            out << ' ' << record.attributes.size();
+            for (const auto &attr : record.attributes) {
+                out << ' ';
+                writeString(out, attr.name);
+                out << ' ' << static_cast<uint32_t>(attr.format) << ' ' << attr.isNormalized << ' '
+                    << attr.stream << ' ' << attr.isInstanced << ' ' << attr.location;
+            }
+            out << '\n';
+        }
     }
+    return FileUtils::getInstance()->writeStringToFile(out.str(), path);
+}
 
-    return pso;
+bool PipelineStateManager::loadWarmUpList(const ccstd::string &path) {
+    const auto content = FileUtils::getInstance()->getStringFromFile(path);
+    if (content.empty()) return false;
+
+    std::istringstream in(content);
+    uint32_t version = 0;
+    if (!(in >> version) || version != WARM_UP_LIST_VERSION) {
+        CC_LOG_WARNING("Unsupported pipeline state warm-up list: %s", path.c_str());
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    WarmUpRecord record;
+    size_t attributeCount = 0;
+    while (in >> record.passHash >> record.renderPassHash >> record.iaHash >> record.subpass &&
+           readString(in, record.shaderName) && in >> attributeCount) {
+        if (attributeCount > MAX_ATTRIBUTE_COUNT) break;
+
+        record.attributes.resize(attributeCount);
+        for (auto &attr : record.attributes) {
+            uint32_t format = 0;
+            if (!readString(in, attr.name)) break;
+            in >> format >> attr.isNormalized >> attr.stream >> attr.isInstanced >> attr.location;
+            attr.format = static_cast<gfx::Format>(format);
+        }
+        if (!in) break;
+
+        addWarmUpRecord(WarmUpRecord{record});
+    }
+    return true;
+}
+
+uint32_t PipelineStateManager::warmUp(const ccstd::vector<const scene::Pass *> &passes, const ccstd::vector<gfx::RenderPass *> &renderPasses) {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    ccstd::unordered_map<ccstd::hash_t, const scene::Pass *> passMap;
+    for (const auto *pass : passes) passMap.emplace(pass->getHash(), pass);
+    ccstd::unordered_map<ccstd::hash_t, gfx::RenderPass *> renderPassMap;
+    for (auto *renderPass : renderPasses) renderPassMap.emplace(renderPass->getHash(), renderPass);
+    ccstd::unordered_map<ccstd::string, gfx::Shader *> shaderMap;
+
+    const bool async = canCreateAsync();
+    uint32_t count = 0;
+    for (const auto &record : cache.warmUpRecords) {
+        auto passIter = passMap.find(record.passHash);
+        auto renderPassIter = renderPassMap.find(record.renderPassHash);
+        if (passIter == passMap.end() || renderPassIter == renderPassMap.end()) continue;
+
+        auto shaderIter = shaderMap.find(record.shaderName);
+        if (shaderIter == shaderMap.end()) {
+            shaderIter = shaderMap.emplace(record.shaderName, ProgramLib::getInstance()->findGFXShader(record.shaderName)).first;
+        }
+        auto *shader = shaderIter->second;
+        if (!shader) continue;
+
+        const PipelineStateKey key{record.passHash, record.renderPassHash, record.iaHash, shader->getTypedID(), record.subpass};
+        if (cache.states.count(key) || cache.pending.count(key)) continue;
+
+        auto info = makePipelineStateInfo(passIter->second, shader, record.attributes, renderPassIter->second, record.subpass);
+        if (async) {
+            createAsync(key, std::move(info));
+        } else {
+            insert(key, gfx::Device::getInstance()->createPipelineState(info));
+        }
+        ++count;
+    }
+    return count;
 }
 
 void PipelineStateManager::destroyAll() {
-    for (auto &pair : psoHashMap) {
-        CC_SAFE_DESTROY_NULL(pair.second);
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    for (auto &pair : cache.pending) {
+        auto *pso = pair.second.result.get();
+        CC_SAFE_DESTROY_AND_DELETE(pso);
+    }
+    cache.pending.clear();
+
+    for (auto &pair : cache.states) {
+        CC_SAFE_DESTROY_NULL(pair.second.pso);
     }
-    psoHashMap.clear();
+    cache.states.clear();
+    cache.lru.clear();
 }
 
 } // namespace pipeline
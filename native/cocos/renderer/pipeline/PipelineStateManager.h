@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include "base/std/container/string.h"
+#include "base/std/container/vector.h"
 #include "cocos/base/Ptr.h"
 #include "gfx-base/GFXDef.h"
 
@@ -34,6 +36,12 @@ class Pass;
 }
 namespace pipeline {
 
+/**
+ * Caches the pipeline states by pass, shader, input layout, render pass and subpass.
+ * Pipeline states can be evicted in least recently used order once a capacity is set,
+ * created on worker threads on backends supporting it, and precompiled from a list recorded in a previous run.
+ * All functions may be called from any thread.
+ */
 class CC_DLL PipelineStateManager {
 public:
     static gfx::PipelineState *getOrCreatePipelineState(const scene::Pass *pass,
@@ -41,10 +49,51 @@ public:
                                                         gfx::InputAssembler *inputAssembler,
                                                         gfx::RenderPass *renderPass,
                                                         uint32_t subpass = 0);
-    static void destroyAll();
 
-private:
-    static ccstd::unordered_map<ccstd::hash_t, IntrusivePtr<gfx::PipelineState>> psoHashMap;
+    /**
+     * Same as getOrCreatePipelineState, but if async creation is enabled a missing pipeline state is created
+     * on a worker thread and nullptr is returned until it's ready, the caller should skip the draw then.
+     */
+    static gfx::PipelineState *getOrCreatePipelineStateAsync(const scene::Pass *pass,
+                                                             gfx::Shader *shader,
+                                                             gfx::InputAssembler *inputAssembler,
+                                                             gfx::RenderPass *renderPass,
+                                                             uint32_t subpass = 0);
+
+    /**
+     * Async creation only takes effect on backends which can create pipeline states off the render thread,
+     * i.e. Vulkan without the multithreaded device agent or the validator.
+     */
+    static void setAsyncCreationEnabled(bool enabled);
+    static bool isAsyncCreationEnabled();
+
+    /**
+     * Once there are more than `capacity` pipeline states, the least recently used ones which haven't been
+     * used for a few frames are released by the cache at the end of a frame, and destroyed once nothing
+     * else references them. 0 means no limit, which is the default.
+     */
+    static void setCapacity(uint32_t capacity);
+    static uint32_t getCapacity();
+    static uint32_t getPipelineStateCount();
+
+    // Counts the frames for the eviction, called by Root once the frame is submitted.
+    static void onFrameEnd();
+
+    /**
+     * Every created pipeline state is recorded to a warm-up list, which can be saved and loaded back in the next run.
+     * The list keeps distinct pipeline states only and stops growing after a few thousand records.
+     */
+    static bool saveWarmUpList(const ccstd::string &path);
+    static bool loadWarmUpList(const ccstd::string &path);
+
+    /**
+     * Precompiles the pipeline states of the warm-up list which use one of the given passes and render passes,
+     * asynchronously if enabled. Call it e.g. behind a loading screen once the materials are loaded.
+     * Returns the count of pipeline states created or scheduled.
+     */
+    static uint32_t warmUp(const ccstd::vector<const scene::Pass *> &passes, const ccstd::vector<gfx::RenderPass *> &renderPasses);
+
+    static void destroyAll();
 };
 
 } // namespace pipeline
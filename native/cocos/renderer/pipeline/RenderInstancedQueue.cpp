@@ -72,7 +72,10 @@ void RenderInstancedQueue::recordCommandBuffer(gfx::Device * /*device*/, gfx::Re
                 if (!instance.count) {
                     continue;
                 }
-                auto *pso = PipelineStateManager::getOrCreatePipelineState(pass, instance.shader, instance.ia, renderPass);
+                auto *pso = PipelineStateManager::getOrCreatePipelineStateAsync(pass, instance.shader, instance.ia, renderPass);
+                if (!pso) {
+                    continue;
+                }
                 if (lastPSO != pso) {
                     cmdBuffer->bindPipelineState(pso);
                     lastPSO = pso;
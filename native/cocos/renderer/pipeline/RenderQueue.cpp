@@ -29,6 +29,7 @@
 #include "PipelineSceneData.h"
 #include "PipelineStateManager.h"
 #include "RenderPipeline.h"
+#include "SceneCulling.h"
 #include "gfx-base/GFXCommandBuffer.h"
 #include "gfx-base/GFXDevice.h"
 #include "gfx-base/GFXShader.h"
@@ -84,33 +85,47 @@ void RenderQueue::recordCommandBuffer(gfx::Device * /*device*/, scene::Camera *c
     auto *queryPool = _pipeline->getQueryPools()[0];
     for (auto &i : _queue) {
         const auto *subModel = i.subModel;
+        const bool occluded = enableOcclusionQuery && _pipeline->isOccluded(camera, subModel);
+        gfx::PipelineState *pso = nullptr;
+        if (!occluded) {
+            // skipped until the pipeline state is compiled if async creation is enabled, and so is the query:
+            // nothing drawn in it would mark the model as occluded in the next frames
+            pso = PipelineStateManager::getOrCreatePipelineStateAsync(subModel->getPass(i.passIndex), subModel->getShader(i.passIndex),
+                                                                      subModel->getInputAssembler(), renderPass, subpassIndex);
+            if (!pso) {
+                continue;
+            }
+        }
+
         if (enableOcclusionQuery) {
             cmdBuff->beginQuery(queryPool, subModel->getId());
         }
 
-        if (enableOcclusionQuery && _pipeline->isOccluded(camera, subModel)) {
+        if (occluded) {
             gfx::InputAssembler *inputAssembler = sceneData->getOcclusionQueryInputAssembler();
             const scene::Pass *pass = sceneData->getOcclusionQueryPass();
             gfx::Shader *shader = sceneData->getOcclusionQueryShader();
-            auto *pso = PipelineStateManager::getOrCreatePipelineState(pass, shader, inputAssembler, renderPass, subpassIndex);
+            auto *occlusionPso = PipelineStateManager::getOrCreatePipelineState(pass, shader, inputAssembler, renderPass, subpassIndex);
 
-            cmdBuff->bindPipelineState(pso);
+            cmdBuff->bindPipelineState(occlusionPso);
             cmdBuff->bindDescriptorSet(materialSet, pass->getDescriptorSet());
             cmdBuff->bindDescriptorSet(localSet, subModel->getWorldBoundDescriptorSet());
             cmdBuff->bindInputAssembler(inputAssembler);
             cmdBuff->draw(inputAssembler);
         } else {
-            const auto passIdx = i.passIndex;
             auto *inputAssembler = subModel->getInputAssembler();
-            const auto *pass = subModel->getPass(passIdx);
-            auto *shader = subModel->getShader(passIdx);
-            auto *pso = PipelineStateManager::getOrCreatePipelineState(pass, shader, inputAssembler, renderPass, subpassIndex);
-
+            const auto *pass = subModel->getPass(i.passIndex);
             cmdBuff->bindPipelineState(pso);
             cmdBuff->bindDescriptorSet(materialSet, pass->getDescriptorSet());
             cmdBuff->bindDescriptorSet(localSet, subModel->getDescriptorSet());
             cmdBuff->bindInputAssembler(inputAssembler);
-            cmdBuff->draw(inputAssembler);
+            if (clusterCulling(camera, subModel, pass, _clusterDrawInfos)) {
+                for (const auto &drawInfo : _clusterDrawInfos) {
+                    cmdBuff->draw(drawInfo);
+                }
+            } else {
+                cmdBuff->draw(inputAssembler);
+            }
         }
 
         if (enableOcclusionQuery) {
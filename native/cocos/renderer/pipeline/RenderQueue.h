@@ -51,6 +51,7 @@ private:
     RenderPassList _queue;
     RenderQueueCreateInfo _passDesc;
     bool _useOcclusionQuery{false};
+    ccstd::vector<gfx::DrawInfo> _clusterDrawInfos;
 };
 
 } // namespace pipeline
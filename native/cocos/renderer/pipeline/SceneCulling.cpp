@@ -23,6 +23,7 @@
  THE SOFTWARE.
 ****************************************************************************/
 
+#include "base/job-system/JobSystem.h"
 #include "base/std/container/array.h"
 
 #include "Define.h"
@@ -37,17 +38,21 @@
 #include "core/geometry/Sphere.h"
 #include "core/platform/Debug.h"
 #include "core/scene-graph/Node.h"
+#include "math/MathUtil.h"
 #include "math/Quaternion.h"
 #include "profiler/Profiler.h"
 #include "scene/Camera.h"
 #include "scene/DirectionalLight.h"
 #include "scene/LODGroup.h"
 #include "scene/Light.h"
+#include "scene/Model.h"
 #include "scene/Octree.h"
+#include "scene/Pass.h"
 #include "scene/RenderScene.h"
 #include "scene/Shadow.h"
 #include "scene/Skybox.h"
 #include "scene/SpotLight.h"
+#include "scene/SubModel.h"
 #include "shadow/CSMLayers.h"
 
 namespace cc {
@@ -97,55 +102,139 @@ void validPunctualLightsCulling(const RenderPipeline *pipeline, const scene::Cam
     }
 }
 
-// Todo If you want to optimize the cutting efficiency, you can get it from the octree
-void shadowCulling(const RenderPipeline *pipeline, const scene::Camera *camera, ShadowTransformInfo *layer) {
-    const auto *sceneData = pipeline->getPipelineSceneData();
-    auto *csmLayers = sceneData->getCSMLayers();
-    const auto *const scene = camera->getScene();
-    const auto *mainLight = scene->getMainLight();
-    const uint32_t visibility = camera->getVisibility();
+namespace {
+
+inline void setSlot(ccstd::vector<uint32_t> &bits, uint32_t slot) {
+    bits[slot >> 5] |= 1U << (slot & 31);
+}
 
-    layer->clearShadowObjects();
+inline bool testSlot(const ccstd::vector<uint32_t> &bits, uint32_t slot) {
+    return scene::WorldBoundsSoA::isVisible(bits, slot);
+}
 
-    for (size_t i = 0; i < csmLayers->getLayerObjects().size(); ++i) {
-        const auto *model = csmLayers->getLayerObjects()[i].model;
-        if (!model || !model->isEnabled() || !model->getNode()) {
-            continue;
+void cameraCulling(PipelineSceneData *sceneData, SceneCullingData &cullingData, const scene::Camera *camera) {
+    const scene::RenderScene *const scene = camera->getScene();
+    auto &cameraOctreeResults = cullingData.cameraOctreeResults;
+    const auto &candidateModels = cullingData.candidateModels;
+    const scene::Octree *octree = scene->getOctree();
+    if (octree && octree->isEnabled()) {
+        cameraOctreeResults.clear();
+        octree->queryVisibility(camera, camera->getFrustum(), false, cameraOctreeResults);
+        for (const auto &model : cameraOctreeResults) {
+            if (!testSlot(candidateModels, model->getSceneSlot())) {
+                continue;
+            }
+            sceneData->addRenderObject(genRenderObject(model, camera));
         }
-        const auto *node = model->getNode();
-        if (((visibility & node->getLayer()) != node->getLayer()) && !(visibility & static_cast<uint32_t>(model->getVisFlags()))) {
+        return;
+    }
+
+    auto &cameraVisibilities = cullingData.cameraVisibilities;
+    scene->getWorldBoundsSoA().cull(camera->getFrustum(), cameraVisibilities);
+    const auto visibility = camera->getVisibility();
+    for (const auto &model : scene->getModels()) {
+        // filter model by view visibility
+        if (!testSlot(candidateModels, model->getSceneSlot())) {
             continue;
         }
-        if (!model->getWorldBounds() || !model->isCastShadow()) {
-            continue;
+        const auto *const node = model->getNode();
+        if ((node && ((visibility & node->getLayer()) == node->getLayer())) ||
+            (visibility & static_cast<uint32_t>(model->getVisFlags()))) {
+            const auto *modelWorldBounds = model->getWorldBounds();
+            if (!modelWorldBounds) {
+                sceneData->addRenderObject(genRenderObject(model, camera));
+                continue;
+            }
+
+            // frustum culling
+            if (testSlot(cameraVisibilities, model->getSceneSlot())) {
+                sceneData->addRenderObject(genRenderObject(model, camera));
+            }
         }
+    }
+}
 
-        // frustum culling
-        const bool accurate = model->getWorldBounds()->aabbFrustum(layer->getValidFrustum());
-        if (!accurate) {
-            continue;
+void shadowLayerCulling(ShadowLayerCulling &culling, const SceneCullingData &cullingData, CSMLayers *csmLayers, const scene::Camera *camera) {
+    const scene::RenderScene *const scene = camera->getScene();
+    const scene::Octree *octree = scene->getOctree();
+    const auto &frustum = culling.layer->getValidFrustum();
+    const uint32_t visibility = camera->getVisibility();
+
+    culling.visibleObjects.clear();
+    if (octree && octree->isEnabled()) {
+        culling.octreeResults.clear();
+        // runs as a job, the octree must not wait on a nested job graph here
+        octree->queryVisibilitySerial(camera, frustum, true, culling.octreeResults);
+        for (const auto &model : culling.octreeResults) {
+            if (!model->getNode() || !testSlot(cullingData.shadowCasterModels, model->getSceneSlot())) {
+                continue;
+            }
+            culling.visibleObjects.emplace_back(genRenderObject(model, camera));
         }
-        layer->addShadowObject(genRenderObject(model, camera));
-        if (layer->getLevel() < static_cast<uint32_t>(mainLight->getCSMLevel())) {
-            if (mainLight->getCSMOptimizationMode() == scene::CSMOptimizationMode::REMOVE_DUPLICATES &&
-                aabbFrustumCompletelyInside(*model->getWorldBounds(), layer->getValidFrustum())) {
-                csmLayers->getLayerObjects().erase(csmLayers->getLayerObjects().begin() + static_cast<uint32_t>(i));
-                i--;
+    } else {
+        scene->getWorldBoundsSoA().cull(frustum, culling.visibilities);
+        for (const auto &ro : csmLayers->getLayerObjects()) {
+            const auto *model = ro.model;
+            if (!model || !model->isEnabled() || !model->getNode()) {
+                continue;
+            }
+            const auto *node = model->getNode();
+            if (((visibility & node->getLayer()) != node->getLayer()) && !(visibility & static_cast<uint32_t>(model->getVisFlags()))) {
+                continue;
+            }
+            if (!model->getWorldBounds() || !model->isCastShadow()) {
+                continue;
+            }
+
+            // frustum culling
+            if (testSlot(culling.visibilities, model->getSceneSlot())) {
+                culling.visibleObjects.emplace_back(genRenderObject(model, camera));
+            }
+        }
+    }
+
+    if (culling.removeDuplicates) {
+        culling.insideModels.assign(cullingData.candidateModels.size(), 0U);
+        for (const auto &ro : culling.visibleObjects) {
+            if (aabbFrustumCompletelyInside(*ro.model->getWorldBounds(), frustum)) {
+                setSlot(culling.insideModels, ro.model->getSceneSlot());
             }
         }
     }
 }
 
+void spotLightCulling(SpotLightCulling &culling, const CSMLayers *csmLayers, const scene::Camera *camera) {
+    const scene::RenderScene *const scene = camera->getScene();
+    const auto visibility = culling.light->getVisibility();
+
+    culling.shadowObjects->clear();
+    scene->getWorldBoundsSoA().cull(culling.light->getFrustum(), culling.visibilities);
+    for (const auto &ro : csmLayers->getCastShadowObjects()) {
+        const auto *model = ro.model;
+        if (!model->getNode() || (visibility & model->getNode()->getLayer()) != model->getNode()->getLayer() ||
+            !model->isEnabled() || !model->isCastShadow()) {
+            continue;
+        }
+        if (model->getWorldBounds() && testSlot(culling.visibilities, model->getSceneSlot())) {
+            culling.shadowObjects->emplace_back(ro);
+        }
+    }
+}
+
+} // namespace
+
 void sceneCulling(const RenderPipeline *pipeline, scene::Camera *camera) {
     CC_PROFILE(SceneCulling);
     PipelineSceneData *const sceneData = pipeline->getPipelineSceneData();
     const scene::Shadows *shadowInfo = sceneData->getShadows();
     CSMLayers *csmLayers = sceneData->getCSMLayers();
     const scene::Skybox *skyBox = sceneData->getSkybox();
+    SceneCullingData &cullingData = *sceneData->getSceneCullingData();
     const scene::RenderScene *const scene = camera->getScene();
     scene::DirectionalLight *mainLight = scene->getMainLight();
 
-    if (shadowInfo != nullptr && shadowInfo->isEnabled() && shadowInfo->getType() == scene::ShadowType::SHADOW_MAP) {
+    const bool shadowMapEnabled = shadowInfo != nullptr && shadowInfo->isEnabled() && shadowInfo->getType() == scene::ShadowType::SHADOW_MAP;
+    if (shadowMapEnabled) {
         // update dirLightFrustum
         if (mainLight && mainLight->getNode()) {
             csmLayers->update(sceneData, camera);
@@ -167,79 +256,206 @@ void sceneCulling(const RenderPipeline *pipeline, scene::Camera *camera) {
 
     LODModelsCachedUtils::updateCachedLODModels(scene, camera);
 
-    const scene::Octree *octree = scene->getOctree();
-    if (octree && octree->isEnabled()) {
-        for (const auto &model : scene->getModels()) {
-            // filter model by view visibility
-            if (model->isEnabled()) {
-                if (LODModelsCachedUtils::isLODModelCulled(model)) {
-                    continue;
-                }
-
-                if (model->isCastShadow()) {
-                    csmLayers->addCastShadowObject(genRenderObject(model, camera));
-                    csmLayers->addLayerObject(genRenderObject(model, camera));
-                }
+    // Gather the candidates on this thread, the culling jobs below only read the shared state.
+    const uint32_t slotWords = (scene->getWorldBoundsSoA().getCapacity() + 31) / 32;
+    auto &candidateModels = cullingData.candidateModels;
+    auto &shadowCasterModels = cullingData.shadowCasterModels;
+    candidateModels.assign(slotWords, 0U);
+    shadowCasterModels.assign(slotWords, 0U);
 
-                const auto visibility = camera->getVisibility();
-                const auto *const node = model->getNode();
+    const scene::Octree *octree = scene->getOctree();
+    const bool octreeEnabled = octree && octree->isEnabled();
+    const auto visibility = camera->getVisibility();
+    for (const auto &model : scene->getModels()) {
+        // filter model by view visibility
+        if (!model->isEnabled() || LODModelsCachedUtils::isLODModelCulled(model)) {
+            continue;
+        }
+        // render objects are generated on the workers, make sure they only read the world transforms
+        if (model->getTransform()) {
+            model->getTransform()->updateWorldTransform();
+        }
+        setSlot(candidateModels, model->getSceneSlot());
 
-                if ((model->getNode() && ((visibility & node->getLayer()) == node->getLayer())) ||
-                    (visibility & static_cast<uint32_t>(model->getVisFlags()))) {
-                    const auto *modelWorldBounds = model->getWorldBounds();
+        // cast shadow render Object
+        if (model->isCastShadow()) {
+            setSlot(shadowCasterModels, model->getSceneSlot());
+            csmLayers->addCastShadowObject(genRenderObject(model, camera));
+            csmLayers->addLayerObject(genRenderObject(model, camera));
+        }
 
-                    if (!modelWorldBounds && (skyBox == nullptr || skyBox->getModel() != model)) {
-                        sceneData->addRenderObject(genRenderObject(model, camera));
-                    }
+        // models without bounds are never culled, the octree does not contain them
+        if (octreeEnabled) {
+            const auto *const node = model->getNode();
+            if ((node && ((visibility & node->getLayer()) == node->getLayer())) ||
+                (visibility & static_cast<uint32_t>(model->getVisFlags()))) {
+                if (!model->getWorldBounds() && (skyBox == nullptr || skyBox->getModel() != model)) {
+                    sceneData->addRenderObject(genRenderObject(model, camera));
                 }
             }
         }
+    }
+
+    // one culling job per shadow view, the camera view is culled on this thread meanwhile
+    JobGraph g(JobSystem::getInstance());
+
+    uint32_t csmLayerCount = 0;
+    const bool dirShadowEnabled = shadowMapEnabled && mainLight && mainLight->getNode() && mainLight->isShadowEnabled();
+    if (dirShadowEnabled) {
+        if (mainLight->isShadowFixedArea()) {
+            auto &culling = cullingData.specialLayerCulling;
+            culling.layer = csmLayers->getSpecialLayer();
+            culling.removeDuplicates = false;
+            g.createJob([&culling, &cullingData, csmLayers, camera]() {
+                shadowLayerCulling(culling, cullingData, csmLayers, camera);
+            });
+        } else {
+            csmLayerCount = sceneData->getCSMSupported() ? static_cast<uint32_t>(mainLight->getCSMLevel()) : 1U;
+            const bool removeDuplicates = mainLight->getCSMOptimizationMode() == scene::CSMOptimizationMode::REMOVE_DUPLICATES;
+            for (uint32_t level = 0; level < csmLayerCount; ++level) {
+                auto &culling = cullingData.csmLayerCullings[level];
+                culling.layer = csmLayers->getLayers()[level];
+                // the last layer has nobody to remove duplicates for
+                culling.removeDuplicates = removeDuplicates && level + 1 < csmLayerCount;
+                g.createJob([&culling, &cullingData, csmLayers, camera]() {
+                    shadowLayerCulling(culling, cullingData, csmLayers, camera);
+                });
+            }
+        }
+    }
 
-        ccstd::vector<scene::Model *> models;
-        models.reserve(scene->getModels().size() / 4);
-        octree->queryVisibility(camera, camera->getFrustum(), false, models);
-        for (const auto &model : models) {
-            if (LODModelsCachedUtils::isLODModelCulled(model)) {
+    const auto &validPunctualLights = sceneData->getValidPunctualLights();
+    sceneData->resizePunctualLightShadowObjects(validPunctualLights.size());
+    auto &spotLightCullings = cullingData.spotLightCullings;
+    spotLightCullings.resize(validPunctualLights.size());
+    if (shadowMapEnabled) {
+        for (size_t i = 0; i < validPunctualLights.size(); ++i) {
+            const auto *light = validPunctualLights[i];
+            if (light->getType() != scene::LightType::SPOT || !static_cast<const scene::SpotLight *>(light)->isShadowEnabled()) {
                 continue;
             }
-            sceneData->addRenderObject(genRenderObject(model, camera));
+            auto &culling = spotLightCullings[i];
+            culling.light = static_cast<const scene::SpotLight *>(light);
+            culling.shadowObjects = sceneData->getPunctualLightShadowObjects(i);
+            g.createJob([&culling, csmLayers, camera]() {
+                spotLightCulling(culling, csmLayers, camera);
+            });
         }
-    } else {
-        for (const auto &model : scene->getModels()) {
-            // filter model by view visibility
-            if (model->isEnabled()) {
-                if (LODModelsCachedUtils::isLODModelCulled(model)) {
-                    continue;
-                }
-                const auto visibility = camera->getVisibility();
-                const auto *const node = model->getNode();
+    }
 
-                // cast shadow render Object
-                if (model->isCastShadow()) {
-                    csmLayers->addCastShadowObject(genRenderObject(model, camera));
-                    csmLayers->addLayerObject(genRenderObject(model, camera));
-                }
+    g.run();
+    cameraCulling(sceneData, cullingData, camera);
+    g.waitForAll();
 
-                if ((model->getNode() && ((visibility & node->getLayer()) == node->getLayer())) ||
-                    (visibility & static_cast<uint32_t>(model->getVisFlags()))) {
-                    const auto *modelWorldBounds = model->getWorldBounds();
-                    if (!modelWorldBounds) {
-                        sceneData->addRenderObject(genRenderObject(model, camera));
-                        continue;
-                    }
-
-                    // frustum culling
-                    if (modelWorldBounds->aabbFrustum(camera->getFrustum())) {
-                        sceneData->addRenderObject(genRenderObject(model, camera));
-                    }
-                }
+    // merge the cascades in level order, which is where duplicates are removed
+    if (dirShadowEnabled && mainLight->isShadowFixedArea()) {
+        auto &culling = cullingData.specialLayerCulling;
+        culling.layer->setShadowObjects(std::move(culling.visibleObjects));
+    }
+    for (uint32_t level = 0; level < csmLayerCount; ++level) {
+        auto &culling = cullingData.csmLayerCullings[level];
+        culling.layer->clearShadowObjects();
+        for (auto &ro : culling.visibleObjects) {
+            bool duplicated = false;
+            for (uint32_t prev = 0; prev < level && !duplicated; ++prev) {
+                const auto &prevCulling = cullingData.csmLayerCullings[prev];
+                duplicated = prevCulling.removeDuplicates && testSlot(prevCulling.insideModels, ro.model->getSceneSlot());
+            }
+            if (!duplicated) {
+                culling.layer->addShadowObject(std::move(ro));
             }
         }
     }
+
     LODModelsCachedUtils::clearCachedLODModels();
 
     csmLayers = nullptr;
 }
 
+uint32_t clusterCulling(const ccstd::vector<IMeshCluster> &clusters, const ccstd::array<ccstd::vector<float>, 6> &bounds,
+                        const Mat4 &worldMatrix, const geometry::Frustum &frustum, const Vec3 *eye,
+                        const gfx::DrawInfo &whole, ccstd::vector<gfx::DrawInfo> &drawInfos) {
+    // bring the frustum planes into model space instead of transforming every cluster, exact for affine matrices
+    const auto &m = worldMatrix.m;
+    float planes[6 * 4];
+    for (uint32_t i = 0; i < 6; ++i) {
+        const auto &n = frustum.planes[i]->n;
+        float *plane = planes + i * 4;
+        plane[0] = m[0] * n.x + m[1] * n.y + m[2] * n.z;
+        plane[1] = m[4] * n.x + m[5] * n.y + m[6] * n.z;
+        plane[2] = m[8] * n.x + m[9] * n.y + m[10] * n.z;
+        plane[3] = frustum.planes[i]->d - (m[12] * n.x + m[13] * n.y + m[14] * n.z);
+    }
+
+    const float *boxes[6];
+    for (uint32_t i = 0; i < 6; ++i) {
+        boxes[i] = bounds[i].data();
+    }
+    const auto capacity = static_cast<uint32_t>(bounds[0].size());
+    thread_local ccstd::vector<uint32_t> visibility;
+    visibility.assign((capacity + 31) / 32, 0U);
+    MathUtil::aabbPlanesSoA(boxes, capacity, planes, 6, visibility.data());
+
+    drawInfos.clear();
+    uint32_t visibleCount = 0;
+    for (uint32_t i = 0; i < clusters.size(); ++i) {
+        if (!(visibility[i >> 5] & (1U << (i & 31)))) {
+            continue;
+        }
+        const auto &cluster = clusters[i];
+        if (eye) {
+            const Vec3 toCenter = cluster.center - *eye;
+            if (toCenter.dot(cluster.coneAxis) >= cluster.coneCutoff * toCenter.length() + cluster.radius) {
+                continue;
+            }
+        }
+        ++visibleCount;
+        if (!drawInfos.empty() && drawInfos.back().firstIndex + drawInfos.back().indexCount == cluster.firstIndex) {
+            drawInfos.back().indexCount += cluster.indexCount;
+        } else {
+            gfx::DrawInfo info = whole;
+            info.firstIndex = cluster.firstIndex;
+            info.indexCount = cluster.indexCount;
+            drawInfos.emplace_back(info);
+        }
+    }
+    return visibleCount;
+}
+
+bool clusterCulling(const scene::Camera *camera, const scene::SubModel *subModel, const scene::Pass *pass, ccstd::vector<gfx::DrawInfo> &drawInfos) {
+    const auto *subMesh = subModel->getSubMesh();
+    const auto *model = subModel->getOwner();
+    // deformed vertices may leave the cluster bounds
+    if (!subMesh || subMesh->getClusters().empty() || !model || !model->getNode() || model->getType() != scene::Model::Type::DEFAULT) {
+        return false;
+    }
+    const auto &clusters = subMesh->getClusters();
+    const gfx::DrawInfo &whole = subModel->getInputAssembler()->getDrawInfo();
+    if (whole.firstIndex != 0 || whole.indexCount < clusters.back().firstIndex + clusters.back().indexCount) {
+        return false;
+    }
+
+    // the cones are tested in model space, which keeps their angles only if the scale is uniform and not mirrored
+    const Mat4 &world = model->getTransform()->getWorldMatrix();
+    const auto *rs = pass->getRasterizerState();
+    bool coneCulling = rs->cullMode == gfx::CullMode::BACK && rs->isFrontFaceCCW &&
+                       camera->getProjectionType() == scene::CameraProjection::PERSPECTIVE;
+    Vec3 eye;
+    if (coneCulling) {
+        const Vec3 &scale = model->getTransform()->getWorldScale();
+        const float tolerance = 1e-3F * std::abs(scale.x);
+        coneCulling = world.determinant() > 0.F &&
+                      std::abs(std::abs(scale.x) - std::abs(scale.y)) <= tolerance &&
+                      std::abs(std::abs(scale.x) - std::abs(scale.z)) <= tolerance;
+        if (coneCulling) {
+            Vec3::transformMat4(camera->getPosition(), world.getInversed(), &eye);
+        }
+    }
+
+    const uint32_t visibleCount = clusterCulling(clusters, subMesh->getClusterBounds(), world, camera->getFrustum(),
+                                                 coneCulling ? &eye : nullptr, whole, drawInfos);
+    return visibleCount < clusters.size();
+}
+
 } // namespace pipeline
 } // namespace cc
@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include "base/std/container/array.h"
+#include "base/std/container/vector.h"
 #include "core/geometry/Frustum.h"
 #include "core/geometry/Sphere.h"
 #include "pipeline/Define.h"
@@ -34,10 +36,14 @@ namespace cc {
 class Mat4;
 class Vec4;
 class Vec3;
+struct IMeshCluster;
 namespace scene {
 class Camera;
 class Shadows;
 class Light;
+class Pass;
+class SubModel;
+class SpotLight;
 } // namespace scene
 namespace pipeline {
 
@@ -45,9 +51,48 @@ struct RenderObject;
 class RenderPipeline;
 class ShadowTransformInfo;
 
+struct ShadowLayerCulling {
+    ShadowTransformInfo *layer{nullptr};
+    RenderObjectList visibleObjects;
+    ccstd::vector<scene::Model *> octreeResults;
+    ccstd::vector<uint32_t> visibilities;
+    // models completely inside the layer, they are skipped by the next layers with REMOVE_DUPLICATES
+    ccstd::vector<uint32_t> insideModels;
+    bool removeDuplicates{false};
+};
+
+struct SpotLightCulling {
+    const scene::SpotLight *light{nullptr};
+    RenderObjectList *shadowObjects{nullptr};
+    ccstd::vector<uint32_t> visibilities;
+};
+
+// Storage shared by the culling jobs of a camera, kept by PipelineSceneData so it is reused from frame to frame.
+// Bitsets are indexed by the scene slots of the models.
+struct SceneCullingData {
+    ccstd::vector<uint32_t> candidateModels;    // enabled and not culled by any LOD group
+    ccstd::vector<uint32_t> shadowCasterModels; // candidates casting shadows
+    ccstd::vector<uint32_t> cameraVisibilities;
+    ccstd::vector<scene::Model *> cameraOctreeResults;
+    ccstd::array<ShadowLayerCulling, 4> csmLayerCullings;
+    ShadowLayerCulling specialLayerCulling;
+    ccstd::vector<SpotLightCulling> spotLightCullings;
+};
+
 RenderObject genRenderObject(const scene::Model *, const scene::Camera *);
 void validPunctualLightsCulling(const RenderPipeline *pipeline, const scene::Camera *camera);
-void shadowCulling(const RenderPipeline *, const scene::Camera *, ShadowTransformInfo *);
+// Culls the camera and its shadow views (CSM layers and spot lights) on the job system,
+// results are stored in PipelineSceneData, CSMLayers and the shadow layers.
 void sceneCulling(const RenderPipeline *, scene::Camera *);
+// Culls the clusters of a clustered sub model against the camera frustum, and their normal cones for back face culled passes.
+// Returns false if the sub model should be drawn as a whole, otherwise drawInfos receives the merged
+// index ranges to draw, which may be empty.
+bool clusterCulling(const scene::Camera *camera, const scene::SubModel *subModel, const scene::Pass *pass, ccstd::vector<gfx::DrawInfo> &drawInfos);
+// The culling of clusterCulling above, for clusters and their bounds as stored by RenderingSubMesh.
+// eye is the camera position in model space, the normal cones are not tested if it is null.
+// drawInfos receives the index ranges of the visible clusters, as copies of whole; returns the visible cluster count.
+uint32_t clusterCulling(const ccstd::vector<IMeshCluster> &clusters, const ccstd::array<ccstd::vector<float>, 6> &bounds,
+                        const Mat4 &worldMatrix, const geometry::Frustum &frustum, const Vec3 *eye,
+                        const gfx::DrawInfo &whole, ccstd::vector<gfx::DrawInfo> &drawInfos);
 } // namespace pipeline
 } // namespace cc
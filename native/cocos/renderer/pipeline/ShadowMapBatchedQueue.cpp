@@ -71,7 +71,7 @@ void ShadowMapBatchedQueue::gatherLightPasses(const scene::Camera *camera, const
                         } else {
                             layer = csmLayers->getLayers()[level];
                         }
-                        shadowCulling(_pipeline, camera, layer);
+                        // culled in sceneCulling along with the camera
                         const RenderObjectList &dirShadowObjects = layer->getShadowObjects();
                         for (const auto &ro : dirShadowObjects) {
                             add(ro.model);
@@ -81,21 +81,10 @@ void ShadowMapBatchedQueue::gatherLightPasses(const scene::Camera *camera, const
             } break;
             case scene::LightType::SPOT: {
                 const auto *spotLight = static_cast<const scene::SpotLight *>(light);
-                const RenderObjectList &castShadowObjects = csmLayers->getCastShadowObjects();
-                if (spotLight->isShadowEnabled()) {
-                    const auto visibility = spotLight->getVisibility();
-                    geometry::AABB ab;
-                    for (const auto &ro : castShadowObjects) {
-                        const auto *model = ro.model;
-                        if ((visibility & model->getNode()->getLayer()) != model->getNode()->getLayer()
-                            || !model->isEnabled() || !model->isCastShadow() || !model->getNode()) {
-                            continue;
-                        }
-                        if (model->getWorldBounds()) {
-                            if (model->getWorldBounds()->aabbFrustum(spotLight->getFrustum())) {
-                                add(model);
-                            }
-                        }
+                const RenderObjectList *shadowObjects = sceneData->getPunctualLightShadowObjects(light);
+                if (spotLight->isShadowEnabled() && shadowObjects) {
+                    for (const auto &ro : *shadowObjects) {
+                        add(ro.model);
                     }
                 }
             } break;
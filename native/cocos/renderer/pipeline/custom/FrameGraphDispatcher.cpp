@@ -54,6 +54,7 @@
 #include "pipeline/custom/GslUtils.h"
 #include "pipeline/custom/RenderCommonFwd.h"
 #include "pipeline/custom/RenderGraphTypes.h"
+#include "pipeline/custom/TransientAliasing.h"
 
 namespace cc {
 
@@ -62,16 +63,13 @@ namespace render {
 static constexpr bool ENABLE_BRANCH_CULLING = true;
 
 void passReorder(FrameGraphDispatcher &fgDispatcher);
-void memoryAliasing(FrameGraphDispatcher &fgDispatcher);
 void buildBarriers(FrameGraphDispatcher &fgDispatcher);
 
+// memory aliasing runs after the barriers are built, see aliasTransientResources
 void FrameGraphDispatcher::run() {
     if (_enablePassReorder) {
         passReorder(*this);
     }
-    if (_enableMemoryAliasing) {
-        memoryAliasing(*this);
-    }
     buildBarriers(*this);
 }
 
@@ -707,6 +705,31 @@ struct BarrierVisitor : public boost::bfs_visitor<> {
     ResourceLifeRecordMap &resourceLifeRecord;
 };
 
+gfx::GFXObject *createGFXBarrier(const ResourceGraph &resourceGraph, const Barrier &passBarrier, bool discardContents) {
+    const auto &desc = get(ResourceGraph::Desc, resourceGraph, passBarrier.resourceID);
+    if (desc.dimension == ResourceDimension::BUFFER) {
+        gfx::BufferBarrierInfo info;
+        info.prevAccesses = passBarrier.beginStatus.accessFlag;
+        info.nextAccesses = passBarrier.endStatus.accessFlag;
+        const auto &range = ccstd::get<BufferRange>(passBarrier.beginStatus.range);
+        info.offset = range.offset;
+        info.size = range.size;
+        info.type = passBarrier.type;
+        return gfx::Device::getInstance()->getBufferBarrier(info);
+    }
+    gfx::TextureBarrierInfo info;
+    info.prevAccesses = passBarrier.beginStatus.accessFlag;
+    info.nextAccesses = passBarrier.endStatus.accessFlag;
+    const auto &range = ccstd::get<TextureRange>(passBarrier.beginStatus.range);
+    info.baseMipLevel = range.mipLevel;
+    info.levelCount = range.levelCount;
+    info.baseSlice = range.firstSlice;
+    info.sliceCount = range.numSlices;
+    info.type = passBarrier.type;
+    info.discardContents = discardContents;
+    return gfx::Device::getInstance()->getTextureBarrier(info);
+}
+
 void buildBarriers(FrameGraphDispatcher &fgDispatcher) {
     auto *scratch = fgDispatcher.scratch;
     const auto &graph = fgDispatcher.graph;
@@ -782,31 +805,9 @@ void buildBarriers(FrameGraphDispatcher &fgDispatcher) {
         }
     }
 
-    const auto &resDescs = get(ResourceGraph::Desc, resourceGraph);
-    auto genGFXBarrier = [&resDescs](std::vector<Barrier> &barriers) {
+    auto genGFXBarrier = [&resourceGraph](std::vector<Barrier> &barriers) {
         for (auto &passBarrier : barriers) {
-            const auto &desc = get(resDescs, passBarrier.resourceID);
-            if (desc.dimension == ResourceDimension::BUFFER) {
-                gfx::BufferBarrierInfo info;
-                info.prevAccesses = passBarrier.beginStatus.accessFlag;
-                info.nextAccesses = passBarrier.endStatus.accessFlag;
-                const auto &range = ccstd::get<BufferRange>(passBarrier.beginStatus.range);
-                info.offset = range.offset;
-                info.size = range.size;
-                info.type = passBarrier.type;
-                passBarrier.barrier = gfx::Device::getInstance()->getBufferBarrier(info);
-            } else {
-                gfx::TextureBarrierInfo info;
-                info.prevAccesses = passBarrier.beginStatus.accessFlag;
-                info.nextAccesses = passBarrier.endStatus.accessFlag;
-                const auto &range = ccstd::get<TextureRange>(passBarrier.beginStatus.range);
-                info.baseMipLevel = range.mipLevel;
-                info.levelCount = range.levelCount;
-                info.baseSlice = range.firstSlice;
-                info.sliceCount = range.numSlices;
-                info.type = passBarrier.type;
-                passBarrier.barrier = gfx::Device::getInstance()->getTextureBarrier(info);
-            }
+            passBarrier.barrier = createGFXBarrier(resourceGraph, passBarrier, false);
         }
     };
 
@@ -820,6 +821,37 @@ void buildBarriers(FrameGraphDispatcher &fgDispatcher) {
         }
     }
 }
+
+// The first pass accessing an alias waits for the last access of the resource whose memory it takes over.
+// The contents of the previous resource are discarded, the layout transition starts from undefined.
+void buildAliasingBarriers(FrameGraphDispatcher &fgDispatcher, const TransientAliasing &aliasing) {
+    const auto &resourceGraph = fgDispatcher.resourceGraph;
+    const auto &rag = fgDispatcher.resourceAccessGraph;
+    auto &barrierMap = fgDispatcher.barrierMap;
+
+    auto getAccessStatus = [&rag](AccessVertex vertID, ResourceHandle resID) {
+        const auto &status = get(ResourceAccessGraph::AccessNode, rag, vertID).attachmentStatus;
+        auto iter = std::find_if(status.begin(), status.end(), [resID](const AccessStatus &access) {
+            return access.vertID == resID;
+        });
+        CC_ENSURES(iter != status.end());
+        auto access = *iter;
+        access.vertID = vertID;
+        return access;
+    };
+
+    for (const auto &handoff : aliasing.handoffs) {
+        Barrier barrier{
+            handoff.to,
+            gfx::BarrierType::FULL,
+            nullptr,
+            getAccessStatus(handoff.fromPass, handoff.from),
+            getAccessStatus(handoff.toPass, handoff.to),
+        };
+        barrier.barrier = createGFXBarrier(resourceGraph, barrier, true);
+        barrierMap[handoff.toPass].blockBarrier.frontBarriers.emplace_back(barrier);
+    }
+}
 #pragma endregion BUILD_BARRIERS
 
 #pragma region PASS_REORDER
@@ -1360,9 +1392,155 @@ void passReorder(FrameGraphDispatcher &fgDispatcher) {
 
 #pragma endregion PASS_REORDER
 
-void memoryAliasing(FrameGraphDispatcher &fgDispatcher) {
+#pragma region MEMORY_ALIASING
+
+bool isTransientResource(const ResourceGraph &resourceGraph, ResourceGraph::vertex_descriptor resID) {
+    const auto &traits = get(ResourceGraph::Traits, resourceGraph, resID);
+    if (traits.residency != ResourceResidency::MANAGED) {
+        return false;
+    }
+    return holds<ManagedTag>(resID, resourceGraph) ||
+           holds<ManagedTextureTag>(resID, resourceGraph) ||
+           holds<ManagedBufferTag>(resID, resourceGraph);
+}
+
+// gfx objects can only be shared when they are created from identical descriptions
+bool isAliasCompatible(const ResourceDesc &lhs, const ResourceDesc &rhs) {
+    return std::forward_as_tuple(lhs.dimension, lhs.alignment, lhs.width, lhs.height, lhs.depthOrArraySize,
+                                 lhs.mipLevels, lhs.format, lhs.sampleCount, lhs.textureFlags, lhs.flags) ==
+           std::forward_as_tuple(rhs.dimension, rhs.alignment, rhs.width, rhs.height, rhs.depthOrArraySize,
+                                 rhs.mipLevels, rhs.format, rhs.sampleCount, rhs.textureFlags, rhs.flags);
+}
+
+uint64_t getTransientSize(const ResourceDesc &desc) {
+    if (desc.dimension == ResourceDimension::BUFFER) {
+        return desc.width;
+    }
+    return gfx::formatSize(desc.format, desc.width, desc.height, desc.depthOrArraySize);
+}
+
+// attachment loaded by the pass, its content of the previous frame must be kept
+bool isAttachmentLoaded(const RenderGraph &graph, RenderGraph::vertex_descriptor passID, const PmrString &name) {
+    if (passID >= num_vertices(graph) || !holds<RasterTag>(passID, graph)) {
+        return false;
+    }
+    auto isLoaded = [&](const RasterViewsMap &rasterViews) {
+        auto iter = rasterViews.find(name);
+        return iter != rasterViews.end() && iter->second.loadOp == gfx::LoadOp::LOAD;
+    };
+    const auto &pass = get(RasterTag{}, passID, graph);
+    if (isLoaded(pass.rasterViews)) {
+        return true;
+    }
+    return std::any_of(pass.subpassGraph.subpasses.begin(), pass.subpassGraph.subpasses.end(),
+                       [&](const RasterSubpass &subpass) { return isLoaded(subpass.rasterViews); });
+}
+
+// Transient resources whose lifetimes (in execution order) do not overlap share one gfx object.
+// Aliasing is done at object granularity, so only resources with identical descriptions are merged.
+void aliasTransientResources(FrameGraphDispatcher &fgDispatcher, TransientAliasing &aliasing) {
+    auto *scratch = fgDispatcher.scratch;
+    const auto &graph = fgDispatcher.graph;
+    const auto &resourceGraph = fgDispatcher.resourceGraph;
+    const auto &rag = fgDispatcher.resourceAccessGraph;
+
+    aliasing.aliasedResources.clear();
+    aliasing.handoffs.clear();
+    aliasing.transientMemorySize = 0;
+    aliasing.aliasedTransientMemorySize = 0;
+
+    // resources renamed by move passes are not tracked in the access graph
+    if (!fgDispatcher._enableMemoryAliasing || !graph.movePasses.empty()) {
+        return;
+    }
+    CC_EXPECTS(fgDispatcher._accessGraphBuilt);
+
+    // lifetime of each transient resource
+    const auto &order = rag.topologicalOrder;
+    PmrFlatMap<ResourceHandle, ResourceLifeRecord> lifetimes(scratch);
+    PmrFlatSet<ResourceHandle> preserved(scratch);
+    for (uint32_t step = 0; step != static_cast<uint32_t>(order.size()); ++step) {
+        const auto ragVert = order[step];
+        const auto passID = get(ResourceAccessGraph::PassID, rag, ragVert);
+        const auto &node = get(RAG::AccessNode, rag, ragVert);
+        for (const auto &status : node.attachmentStatus) {
+            const auto resID = status.vertID;
+            if (!isTransientResource(resourceGraph, resID)) {
+                continue;
+            }
+            auto iter = lifetimes.find(resID);
+            if (iter == lifetimes.end()) {
+                iter = lifetimes.emplace(resID, ResourceLifeRecord{step, step}).first;
+            }
+            iter->second.end = step;
+            // content read before written in this frame, cannot be shared
+            if (iter->second.start == step &&
+                (gfx::hasFlag(status.access, gfx::MemoryAccessBit::READ_ONLY) ||
+                 isAttachmentLoaded(graph, passID, get(ResourceGraph::Name, resourceGraph, resID)))) {
+                preserved.emplace(resID);
+            }
+        }
+    }
+    if (lifetimes.empty()) {
+        return;
+    }
+
+    // greedy interval assignment, resources sorted by first use
+    ccstd::pmr::vector<ResourceHandle> candidates(scratch);
+    candidates.reserve(lifetimes.size());
+    for (const auto &[resID, lifetime] : lifetimes) {
+        candidates.emplace_back(resID);
+    }
+    std::stable_sort(candidates.begin(), candidates.end(), [&](ResourceHandle lhs, ResourceHandle rhs) {
+        return lifetimes.at(lhs).start < lifetimes.at(rhs).start;
+    });
+
+    struct PhysicalResource {
+        ResourceHandle owner{INVALID_ID};
+        ResourceHandle lastUser{INVALID_ID};
+        ResourceLifeRecord lifetime;
+        uint64_t size{0};
+    };
+    ccstd::pmr::vector<PhysicalResource> physicalResources(scratch);
+    for (const auto resID : candidates) {
+        const auto &lifetime = lifetimes.at(resID);
+        const auto &desc = get(ResourceGraph::Desc, resourceGraph, resID);
+        PhysicalResource *target = nullptr;
+        if (!preserved.count(resID)) {
+            for (auto &physical : physicalResources) {
+                // the latest released object keeps the others free for later resources
+                if (physical.lifetime.end < lifetime.start &&
+                    !preserved.count(physical.owner) &&
+                    isAliasCompatible(get(ResourceGraph::Desc, resourceGraph, physical.owner), desc) &&
+                    (!target || physical.lifetime.end > target->lifetime.end)) {
+                    target = &physical;
+                }
+            }
+        }
+        if (target) {
+            aliasing.aliasedResources.emplace(resID, target->owner);
+            aliasing.handoffs.emplace_back(AliasHandoff{
+                target->lastUser, resID, order[target->lifetime.end], order[lifetime.start]});
+            target->lastUser = resID;
+            target->lifetime.end = lifetime.end;
+        } else {
+            physicalResources.emplace_back(PhysicalResource{resID, resID, lifetime, getTransientSize(desc)});
+        }
+    }
+
+    // mounted objects are kept for the whole frame
+    for (const auto &[resID, lifetime] : lifetimes) {
+        aliasing.transientMemorySize += getTransientSize(get(ResourceGraph::Desc, resourceGraph, resID));
+    }
+    for (const auto &physical : physicalResources) {
+        aliasing.aliasedTransientMemorySize += physical.size;
+    }
+
+    buildAliasingBarriers(fgDispatcher, aliasing);
 }
 
+#pragma endregion MEMORY_ALIASING
+
 #pragma region assisstantFuncDefinition
 template <typename Graph>
 bool tryAddEdge(uint32_t srcVertex, uint32_t dstVertex, Graph &graph) {
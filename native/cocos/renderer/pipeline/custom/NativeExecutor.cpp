@@ -1,3 +1,4 @@
+#include <atomic>
 #include <boost/graph/depth_first_search.hpp>
 #include <boost/graph/filtered_graph.hpp>
 #include <variant>
@@ -5,6 +6,7 @@
 #include "GraphTypes.h"
 #include "GraphView.h"
 #include "GslUtils.h"
+#include "NativeExecutor.h"
 #include "NativePipelineFwd.h"
 #include "NativePipelineTypes.h"
 #include "Pmr.h"
@@ -13,6 +15,11 @@
 #include "RenderGraphGraphs.h"
 #include "RenderGraphTypes.h"
 #include "Set.h"
+#include "TransientAliasing.h"
+#include "cocos/base/job-system/JobSystem.h"
+#include "cocos/base/memory/Memory.h"
+#include "cocos/base/std/container/unordered_map.h"
+#include "cocos/renderer/gfx-agent/DeviceAgent.h"
 #include "cocos/renderer/gfx-base/GFXBarrier.h"
 #include "cocos/renderer/gfx-base/GFXDef-common.h"
 #include "cocos/renderer/gfx-base/GFXDevice.h"
@@ -30,6 +37,15 @@ namespace render {
 
 namespace {
 
+std::atomic<bool> passReorderEnabled{false};
+std::atomic<bool> memoryAliasingEnabled{false};
+
+constexpr size_t MIN_PASSES_PER_COMMAND_BUFFER = 2;
+
+// Extra primary command buffers of each pipeline, created on demand.
+// Owned here instead of the generated NativePipeline, released by releasePassCommandBuffers.
+ccstd::unordered_map<const NativePipeline*, ccstd::vector<gfx::CommandBuffer*>> passCommandBuffers;
+
 struct RenderGraphVisitorContext {
     RenderGraphVisitorContext(
         NativeRenderContext& contextIn,
@@ -37,6 +53,7 @@ struct RenderGraphVisitorContext {
         ResourceGraph& resgIn,
         const FrameGraphDispatcher& fgdIn,
         const FrameGraphDispatcher::BarrierMap& barrierMapIn,
+        const TransientAliasing& aliasingIn,
         const ccstd::pmr::vector<bool>& validPassesIn,
         gfx::Device* deviceIn,
         cc::gfx::CommandBuffer* cmdBuffIn,
@@ -50,6 +67,7 @@ struct RenderGraphVisitorContext {
       resourceGraph(resgIn),
       fgd(fgdIn),
       barrierMap(barrierMapIn),
+      aliasing(aliasingIn),
       validPasses(validPassesIn),
       device(deviceIn),
       cmdBuff(cmdBuffIn),
@@ -62,6 +80,7 @@ struct RenderGraphVisitorContext {
     ResourceGraph& resourceGraph;
     const FrameGraphDispatcher& fgd;
     const FrameGraphDispatcher::BarrierMap& barrierMap;
+    const TransientAliasing& aliasing;
     const ccstd::pmr::vector<bool>& validPasses;
     gfx::Device* device = nullptr;
     cc::gfx::CommandBuffer* cmdBuff = nullptr;
@@ -539,18 +558,33 @@ struct RenderGraphVisitor : boost::dfs_visitor<> {
     void end(const gfx::Viewport& pass) const {
     }
 
+    void mountResource(ResourceGraph::vertex_descriptor resID) const {
+        auto& resg = ctx.resourceGraph;
+        auto iter = ctx.aliasing.aliasedResources.find(resID);
+        if (iter != ctx.aliasing.aliasedResources.end()) {
+            mountAliasedResource(resg, ctx.device, resID, iter->second);
+        } else {
+            resg.mount(ctx.device, resID);
+        }
+    }
+
     void mountResources(const RasterPass& pass) const {
         auto& resg = ctx.resourceGraph;
+        const auto version = resg.version;
         // mount managed resources
         for (const auto& [name, view] : pass.rasterViews) {
             auto resID = findVertex(name, resg);
             CC_EXPECTS(resID != ResourceGraph::null_vertex());
-            resg.mount(ctx.device, resID);
+            mountResource(resID);
         }
         for (const auto& [name, views] : pass.computeViews) {
             auto resID = findVertex(name, resg);
             CC_EXPECTS(resID != ResourceGraph::null_vertex());
-            resg.mount(ctx.device, resID);
+            mountResource(resID);
+        }
+        // attachments changed, cached framebuffer is outdated
+        if (version != resg.version) {
+            ctx.context.renderPasses.erase(pass);
         }
     }
 
@@ -560,7 +594,7 @@ struct RenderGraphVisitor : boost::dfs_visitor<> {
         for (const auto& [name, views] : pass.computeViews) {
             auto resID = findVertex(name, resg);
             CC_EXPECTS(resID != ResourceGraph::null_vertex());
-            resg.mount(ctx.device, resID);
+            mountResource(resID);
         }
     }
 
@@ -570,7 +604,7 @@ struct RenderGraphVisitor : boost::dfs_visitor<> {
         for (const auto& [name, views] : pass.computeViews) {
             auto resID = findVertex(name, resg);
             CC_EXPECTS(resID != ResourceGraph::null_vertex());
-            resg.mount(ctx.device, resID);
+            mountResource(resID);
         }
     }
 
@@ -580,10 +614,10 @@ struct RenderGraphVisitor : boost::dfs_visitor<> {
         for (const auto& pair : pass.copyPairs) {
             const auto& srcID = findVertex(pair.source, resg);
             CC_EXPECTS(srcID != ResourceGraph::null_vertex());
-            resg.mount(ctx.device, srcID);
+            mountResource(srcID);
             const auto& dstID = findVertex(pair.target, resg);
             CC_EXPECTS(dstID != ResourceGraph::null_vertex());
-            resg.mount(ctx.device, dstID);
+            mountResource(dstID);
         }
     }
 
@@ -716,22 +750,54 @@ struct RenderGraphContextCleaner {
     uint64_t prevFenceValue = 0;
 };
 
+// Passes are still recorded on the calling thread. Only the device agent replays
+// several command buffers on the job system, so other devices use a single one.
+uint32_t getCommandBufferCount(size_t numPasses) {
+    if (!gfx::DeviceAgent::getInstance() || numPasses == 0) {
+        return 1;
+    }
+    const auto maxCount = static_cast<uint32_t>((numPasses - 1) / MIN_PASSES_PER_COMMAND_BUFFER + 1);
+    return std::min(JobSystem::getInstance()->threadCount() + 1, maxCount);
+}
+
 struct CommandSubmitter {
-    CommandSubmitter(gfx::Device* deviceIn, const std::vector<gfx::CommandBuffer*>& cmdBuffersIn)
-    : device(deviceIn), cmdBuffers(cmdBuffersIn) {
-        CC_EXPECTS(cmdBuffers.size() == 1);
-        primaryCommandBuffer = cmdBuffers.at(0);
-        primaryCommandBuffer->begin();
+    CommandSubmitter(
+        gfx::Device* deviceIn,
+        const std::vector<gfx::CommandBuffer*>& primaryCmdBuffers,
+        ccstd::vector<gfx::CommandBuffer*>& passCmdBuffers,
+        uint32_t count,
+        boost::container::pmr::memory_resource* scratch)
+    : device(deviceIn), cmdBuffers(scratch) {
+        CC_EXPECTS(primaryCmdBuffers.size() == 1);
+        CC_EXPECTS(count >= 1);
+        primaryCommandBuffer = primaryCmdBuffers.at(0);
+        while (passCmdBuffers.size() + 1 < count) {
+            passCmdBuffers.emplace_back(device->createCommandBuffer(
+                gfx::CommandBufferInfo{device->getQueue(), gfx::CommandBufferType::PRIMARY}));
+        }
+        cmdBuffers.reserve(count);
+        cmdBuffers.emplace_back(primaryCommandBuffer);
+        for (uint32_t i = 1; i < count; ++i) {
+            cmdBuffers.emplace_back(passCmdBuffers[i - 1]);
+        }
+        for (auto* cmdBuff : cmdBuffers) {
+            cmdBuff->begin();
+        }
     }
     CommandSubmitter(const CommandSubmitter&) = delete;
     CommandSubmitter& operator=(const CommandSubmitter&) = delete;
     ~CommandSubmitter() noexcept {
-        primaryCommandBuffer->end();
-        device->flushCommands(cmdBuffers);
-        device->getQueue()->submit(cmdBuffers);
+        for (auto* cmdBuff : cmdBuffers) {
+            cmdBuff->end();
+        }
+        const auto count = static_cast<uint32_t>(cmdBuffers.size());
+        // the agent replays the command buffers into the backend on the job system
+        device->flushCommands(cmdBuffers.data(), count);
+        // submitted in pass order
+        device->getQueue()->submit(cmdBuffers.data(), count);
     }
     gfx::Device* device = nullptr;
-    const std::vector<gfx::CommandBuffer*>& cmdBuffers;
+    ccstd::pmr::vector<gfx::CommandBuffer*> cmdBuffers;
     gfx::CommandBuffer* primaryCommandBuffer = nullptr;
 };
 
@@ -970,6 +1036,33 @@ void buildRenderQueues(
 
 } // namespace
 
+void enableRenderGraphPassReorder(bool enable) {
+    passReorderEnabled.store(enable, std::memory_order_relaxed);
+}
+
+bool isRenderGraphPassReorderEnabled() {
+    return passReorderEnabled.load(std::memory_order_relaxed);
+}
+
+void enableRenderGraphMemoryAliasing(bool enable) {
+    memoryAliasingEnabled.store(enable, std::memory_order_relaxed);
+}
+
+bool isRenderGraphMemoryAliasingEnabled() {
+    return memoryAliasingEnabled.load(std::memory_order_relaxed);
+}
+
+void releasePassCommandBuffers(const NativePipeline& ppl) {
+    auto iter = passCommandBuffers.find(&ppl);
+    if (iter == passCommandBuffers.end()) {
+        return;
+    }
+    for (auto* cmdBuff : iter->second) {
+        CC_SAFE_DESTROY_AND_DELETE(cmdBuff);
+    }
+    passCommandBuffers.erase(iter);
+}
+
 void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
     auto& ppl = *this;
     auto* scratch = &ppl.unsyncPool;
@@ -979,14 +1072,22 @@ void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
     RenderGraphContextCleaner contextCleaner(ppl.nativeContext);
     ResourceCleaner cleaner(ppl.resourceGraph);
 
+    // passes are executed in the reordered sequence, which does not track resources renamed by move passes
+    const bool passReorder = isRenderGraphPassReorderEnabled() && rg.movePasses.empty();
+
     FrameGraphDispatcher fgd(
         ppl.resourceGraph, rg,
         ppl.layoutGraph, &ppl.unsyncPool, scratch);
-    fgd.enableMemoryAliasing(false);
-    fgd.enablePassReorder(false);
+    fgd.enableMemoryAliasing(isRenderGraphMemoryAliasingEnabled());
+    fgd.enablePassReorder(passReorder);
+    // favor shorter resource lifetimes over parallel execution
     fgd.setParalellWeight(0);
     fgd.run();
 
+    TransientAliasing aliasing(scratch);
+    aliasTransientResources(fgd, aliasing);
+    detachStaleAliases(ppl.resourceGraph, aliasing, scratch);
+
     AddressableView<RenderGraph> graphView(rg);
     ccstd::pmr::vector<bool> validPasses(num_vertices(rg), true, scratch);
     auto colors = rg.colors(scratch);
@@ -1020,7 +1121,33 @@ void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
             boost::keep_all, RenderGraphFilter>
             fg(graphView, boost::keep_all{}, RenderGraphFilter{&validPasses});
 
-        CommandSubmitter submit(ppl.device, ppl.getCommandBuffers());
+        // top-level passes in execution order
+        ccstd::pmr::vector<RenderGraph::vertex_descriptor> passes(scratch);
+        {
+            ccstd::pmr::vector<bool> added(num_vertices(rg), false, scratch);
+            auto addPass = [&](RenderGraph::vertex_descriptor passID) {
+                if (passID >= num_vertices(rg) || !validPasses[passID] || added[passID] ||
+                    parent(passID, rg) != RenderGraph::null_vertex()) {
+                    return;
+                }
+                added[passID] = true;
+                passes.emplace_back(passID);
+            };
+            if (passReorder) {
+                const auto& rag = fgd.resourceAccessGraph;
+                for (const auto ragVert : rag.topologicalOrder) {
+                    addPass(get(ResourceAccessGraph::PassID, rag, ragVert));
+                }
+            }
+            // passes not in the access graph keep their recorded order
+            for (const auto vertID : makeRange(vertices(rg))) {
+                addPass(vertID);
+            }
+        }
+
+        CommandSubmitter submit(
+            ppl.device, ppl.getCommandBuffers(), passCommandBuffers[&ppl],
+            getCommandBufferCount(passes.size()), scratch);
 
         // upload buffers
         for (const auto& [scene, queues] : sceneQueues) {
@@ -1033,7 +1160,7 @@ void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
         // submit commands
         RenderGraphVisitorContext ctx(
             ppl.nativeContext, rg, ppl.resourceGraph,
-            fgd, fgd.barrierMap,
+            fgd, fgd.barrierMap, aliasing,
             validPasses,
             ppl.device, submit.primaryCommandBuffer,
             sceneQueues,
@@ -1041,7 +1168,13 @@ void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
             scratch);
 
         RenderGraphVisitor visitor{{}, ctx};
-        boost::depth_first_search(fg, visitor, get(colors, rg));
+        const auto& cmdBuffers = submit.cmdBuffers;
+        for (size_t i = 0; i != passes.size(); ++i) {
+            // consecutive passes share a command buffer, so barriers stay in order.
+            // recording is sequential, only the backend replay of the buffers runs in parallel
+            ctx.cmdBuff = cmdBuffers[i * cmdBuffers.size() / passes.size()];
+            boost::depth_first_visit(fg, passes[i], visitor, get(colors, rg));
+        }
     }
 }
 
@@ -36,6 +36,7 @@
 #include "LayoutGraphGraphs.h"
 #include "LayoutGraphNames.h"
 #include "LayoutGraphTypes.h"
+#include "NativeExecutor.h"
 #include "NativePipelineFwd.h"
 #include "NativePipelineTypes.h"
 #include "Pmr.h"
@@ -408,6 +409,7 @@ bool NativePipeline::activate(gfx::Swapchain *swapchainIn) {
 }
 
 bool NativePipeline::destroy() noexcept {
+    releasePassCommandBuffers(*this);
     if (globalDSManager) {
         globalDSManager->destroy();
         globalDSManager.reset();
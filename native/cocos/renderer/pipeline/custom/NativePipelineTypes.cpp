@@ -70,10 +70,12 @@ RenderDrawQueue::RenderDrawQueue(const allocator_type& alloc) noexcept
 : instances(alloc) {}
 
 RenderDrawQueue::RenderDrawQueue(RenderDrawQueue&& rhs, const allocator_type& alloc)
-: instances(std::move(rhs.instances), alloc) {}
+: instances(std::move(rhs.instances), alloc),
+  clusterDrawInfos(std::move(rhs.clusterDrawInfos)) {}
 
 RenderDrawQueue::RenderDrawQueue(RenderDrawQueue const& rhs, const allocator_type& alloc)
-: instances(rhs.instances, alloc) {}
+: instances(rhs.instances, alloc),
+  clusterDrawInfos(rhs.clusterDrawInfos) {}
 
 NativeRenderQueue::NativeRenderQueue(const allocator_type& alloc) noexcept
 : opaqueQueue(alloc),
@@ -328,6 +328,7 @@ struct RenderDrawQueue {
         uint32_t subpassIndex) const;
 
     ccstd::pmr::vector<DrawInstance> instances;
+    mutable ccstd::vector<gfx::DrawInfo> clusterDrawInfos;
 };
 
 struct NativeRenderQueue {
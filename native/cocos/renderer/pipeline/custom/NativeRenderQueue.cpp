@@ -4,6 +4,7 @@
 #include "NativePipelineTypes.h"
 #include "cocos/renderer/pipeline/Define.h"
 #include "cocos/renderer/pipeline/PipelineStateManager.h"
+#include "cocos/renderer/pipeline/SceneCulling.h"
 
 namespace cc {
 
@@ -38,7 +39,7 @@ void RenderDrawQueue::sortTransparent() {
 }
 
 void RenderDrawQueue::recordCommandBuffer(
-    gfx::Device * /*device*/, const scene::Camera * /*camera*/,
+    gfx::Device * /*device*/, const scene::Camera *camera,
     gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuff,
     uint32_t subpassIndex) const {
     for (const auto &instance : instances) {
@@ -48,13 +49,22 @@ void RenderDrawQueue::recordCommandBuffer(
         auto *inputAssembler = subModel->getInputAssembler();
         const auto *pass = subModel->getPass(passIdx);
         auto *shader = subModel->getShader(passIdx);
-        auto *pso = pipeline::PipelineStateManager::getOrCreatePipelineState(pass, shader, inputAssembler, renderPass, subpassIndex);
+        auto *pso = pipeline::PipelineStateManager::getOrCreatePipelineStateAsync(pass, shader, inputAssembler, renderPass, subpassIndex);
+        if (!pso) {
+            continue;
+        }
 
         cmdBuff->bindPipelineState(pso);
         cmdBuff->bindDescriptorSet(pipeline::materialSet, pass->getDescriptorSet());
         cmdBuff->bindDescriptorSet(pipeline::localSet, subModel->getDescriptorSet());
         cmdBuff->bindInputAssembler(inputAssembler);
-        cmdBuff->draw(inputAssembler);
+        if (camera && pipeline::clusterCulling(camera, subModel, pass, clusterDrawInfos)) {
+            for (const auto &drawInfo : clusterDrawInfos) {
+                cmdBuff->draw(drawInfo);
+            }
+        } else {
+            cmdBuff->draw(inputAssembler);
+        }
     }
 }
 
@@ -91,8 +101,11 @@ void RenderInstancingQueue::recordCommandBuffer(
             if (!instance.count) {
                 continue;
             }
-            auto *pso = pipeline::PipelineStateManager::getOrCreatePipelineState(
+            auto *pso = pipeline::PipelineStateManager::getOrCreatePipelineStateAsync(
                 drawPass, instance.shader, instance.ia, renderPass);
+            if (!pso) {
+                continue;
+            }
             if (lastPSO != pso) {
                 cmdBuffer->bindPipelineState(pso);
                 lastPSO = pso;
@@ -27,6 +27,8 @@
 #include "Range.h"
 #include "RenderGraphGraphs.h"
 #include "RenderGraphTypes.h"
+#include "Set.h"
+#include "TransientAliasing.h"
 #include "cocos/renderer/gfx-base/GFXDevice.h"
 #include "gfx-base/GFXDef-common.h"
 #include "pipeline/custom/RenderCommonFwd.h"
@@ -152,6 +154,7 @@ void ResourceGraph::mount(gfx::Device* device, vertex_descriptor vertID) {
             if (!buffer.buffer) {
                 auto info = getBufferInfo(desc);
                 buffer.buffer = device->createBuffer(info);
+                ++version;
             }
             CC_ENSURES(buffer.buffer);
             buffer.fenceValue = nextFenceValue;
@@ -160,6 +163,7 @@ void ResourceGraph::mount(gfx::Device* device, vertex_descriptor vertID) {
             if (!texture.texture) {
                 auto info = getTextureInfo(desc);
                 texture.texture = device->createTexture(info);
+                ++version;
             }
             CC_ENSURES(texture.texture);
             texture.fenceValue = nextFenceValue;
@@ -174,6 +178,64 @@ void ResourceGraph::mount(gfx::Device* device, vertex_descriptor vertID) {
         });
 }
 
+void mountAliasedResource(ResourceGraph& resg, gfx::Device* device, ResourceGraph::vertex_descriptor vertID, ResourceGraph::vertex_descriptor ownerID) {
+    CC_EXPECTS(vertID != ownerID);
+    resg.mount(device, ownerID);
+    visitObject(
+        vertID, resg,
+        [&](const ManagedResource& resource) {
+            // to be removed
+        },
+        [&](ManagedBuffer& buffer) {
+            const auto& owner = get(ManagedBufferTag{}, ownerID, resg);
+            if (buffer.buffer != owner.buffer) {
+                buffer.buffer = owner.buffer;
+                ++resg.version;
+            }
+            buffer.fenceValue = resg.nextFenceValue;
+        },
+        [&](ManagedTexture& texture) {
+            const auto& owner = get(ManagedTextureTag{}, ownerID, resg);
+            if (texture.texture != owner.texture) {
+                texture.texture = owner.texture;
+                ++resg.version;
+            }
+            texture.fenceValue = resg.nextFenceValue;
+        },
+        [&](const auto& /*res*/) {
+            // only managed resources are aliased
+            CC_EXPECTS(false);
+        });
+}
+
+void detachStaleAliases(ResourceGraph& resg, const TransientAliasing& aliasing, boost::container::pmr::memory_resource* scratch) {
+    PmrFlatSet<const gfx::GFXObject*> owned(scratch);
+    // the first resource keeps the shared object, the others create their own when mounted
+    auto detach = [&](auto& object) {
+        if (object && !owned.emplace(object.get()).second) {
+            object.reset();
+            ++resg.version;
+        }
+    };
+    for (const auto& vertID : makeRange(vertices(resg))) {
+        if (aliasing.aliasedResources.count(vertID)) {
+            // mounted on the object of its owner
+            continue;
+        }
+        visitObject(
+            vertID, resg,
+            [&](ManagedBuffer& buffer) {
+                detach(buffer.buffer);
+            },
+            [&](ManagedTexture& texture) {
+                detach(texture.texture);
+            },
+            [&](const auto& /*res*/) {
+                // not aliased
+            });
+    }
+}
+
 void ResourceGraph::unmount(uint64_t completedFenceValue) {
     auto& resg = *this;
     for (const auto& vertID : makeRange(vertices(resg))) {
@@ -0,0 +1,70 @@
+/****************************************************************************
+ Copyright (c) 2021-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+#include "cocos/base/std/container/vector.h"
+#include "cocos/renderer/pipeline/custom/FGDispatcherTypes.h"
+#include "cocos/renderer/pipeline/custom/Map.h"
+
+namespace cc {
+
+namespace render {
+
+// The memory of resource `from` is handed over to resource `to`, which shares its gfx object.
+struct AliasHandoff {
+    ResourceGraph::vertex_descriptor from{ResourceGraph::null_vertex()};
+    ResourceGraph::vertex_descriptor to{ResourceGraph::null_vertex()};
+    ResourceAccessGraph::vertex_descriptor fromPass{ResourceAccessGraph::null_vertex()}; // last access of `from`
+    ResourceAccessGraph::vertex_descriptor toPass{ResourceAccessGraph::null_vertex()};   // first access of `to`
+};
+
+struct TransientAliasing {
+    explicit TransientAliasing(boost::container::pmr::memory_resource* scratch) noexcept
+    : aliasedResources(scratch),
+      handoffs(scratch) {}
+
+    // transient resource -> resource owning the gfx object it shares
+    PmrFlatMap<ResourceGraph::vertex_descriptor, ResourceGraph::vertex_descriptor> aliasedResources;
+    // in execution order, an aliasing barrier is emitted for each of them
+    ccstd::pmr::vector<AliasHandoff> handoffs;
+    // size in bytes of the transient gfx objects mounted in the frame, without and with aliasing
+    uint64_t transientMemorySize{0};
+    uint64_t aliasedTransientMemorySize{0};
+};
+
+// Transient resources whose lifetimes do not overlap share one gfx object. Must be called after
+// FrameGraphDispatcher::run(), the barriers handing the memory over are added to its barrier map.
+// Does nothing unless memory aliasing is enabled on the dispatcher.
+void aliasTransientResources(FrameGraphDispatcher& fgDispatcher, TransientAliasing& aliasing);
+
+// Mounts the owner and shares its gfx object with the alias.
+void mountAliasedResource(ResourceGraph& resg, gfx::Device* device, ResourceGraph::vertex_descriptor vertID, ResourceGraph::vertex_descriptor ownerID);
+
+// Objects still shared by aliases of previous frames are only kept by one resource that is not aliased anymore.
+void detachStaleAliases(ResourceGraph& resg, const TransientAliasing& aliasing, boost::container::pmr::memory_resource* scratch);
+
+} // namespace render
+
+} // namespace cc
@@ -822,8 +822,9 @@ void LightingStage::fgSsprPass(scene::Camera *camera) {
         auto *cmdBuff = pipeline->getCommandBuffers()[0];
         auto &elem = _reflectionElems[_denoiseIndex];
 
-        // bind descriptor
-        cmdBuff->bindDescriptorSet(globalSet, pipeline->getDescriptorSet());
+        // bind descriptor, with the UBO of the camera the clusters are culled against
+        const ccstd::array<uint32_t, 1> globalOffsets = {pipeline->getPipelineUBO()->getCurrentCameraUBOOffset()};
+        cmdBuff->bindDescriptorSet(globalSet, pipeline->getDescriptorSet(), utils::toUint(globalOffsets.size()), globalOffsets.data());
 
         gfx::DescriptorSet *descLocal = elem.set; // sub model descriptor set
         auto *denoiseTex = static_cast<gfx::Texture *>(table.getRead(data.denoise));
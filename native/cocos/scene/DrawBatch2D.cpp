@@ -31,6 +31,23 @@
 namespace cc {
 namespace scene {
 
+namespace {
+
+// independent of the iteration order of the map
+ccstd::hash_t getDynamicsHash(const IPassDynamics &dynamics) {
+    ccstd::hash_t hash = 0;
+    for (const auto &[state, ds] : dynamics) {
+        ccstd::hash_t entry = 0;
+        ccstd::hash_combine(entry, state);
+        ccstd::hash_combine(entry, ds.value);
+        ccstd::hash_combine(entry, ds.dirty);
+        hash += entry;
+    }
+    return hash;
+}
+
+} // namespace
+
 void DrawBatch2D::clear() {
     _inputAssembler = nullptr;
     _descriptorSet = nullptr;
@@ -41,21 +58,29 @@ void DrawBatch2D::clear() {
 void DrawBatch2D::fillPass(Material *mat, const gfx::DepthStencilState *depthStencilState, ccstd::hash_t dsHash, const ccstd::vector<IMacroPatch> *patches) {
     const auto &passes = mat->getPasses();
     if (passes->empty()) return;
-    _shaders.clear();
     if (_passes.size() < passes->size()) {
         auto num = static_cast<uint32_t>(passes->size() - _passes.size());
         for (uint32_t i = 0; i < num; ++i) {
             _passes.emplace_back(ccnew scene::Pass(Root::getInstance()));
         }
     }
+    _shaders.resize(passes->size());
+    _passKeys.resize(passes->size());
 
     for (uint32_t i = 0; i < passes->size(); ++i) {
         auto &pass = passes->at(i);
         auto &passInUse = _passes[i];
         pass->update();
         if (!depthStencilState) depthStencilState = pass->getDepthStencilState();
-        passInUse->initPassFromTarget(pass, *depthStencilState, dsHash);
-        _shaders.push_back(patches ? passInUse->getShaderVariant(*patches) : passInUse->getShaderVariant());
+
+        // initPassFromTarget copies defines, properties and blocks, skip it if nothing changed since the last fill
+        PassKey key{pass, pass->getHash(), getDynamicsHash(pass->getDynamics()), static_cast<uint32_t>(pass->getPriority()), pass->getPhase(),
+                          pass->getDescriptorSet(), depthStencilState, dsHash};
+        if (patches || _passKeys[i] != key) {
+            passInUse->initPassFromTarget(pass, *depthStencilState, dsHash);
+            _shaders[i] = patches ? passInUse->getShaderVariant(*patches) : passInUse->getShaderVariant();
+            _passKeys[i] = patches ? PassKey{} : std::move(key);
+        }
     }
 }
 
@@ -62,11 +62,31 @@ public:
     inline Model *getModel() const { return _model; }
 
 protected:
+    // what a pass in use was initialized from, the batcher keeps refilling a batch with the same material frame after frame.
+    // The target is retained, so a new pass can't reuse its address and be mistaken for it.
+    struct PassKey {
+        IntrusivePtr<Pass> target;
+        ccstd::hash_t hash{0};
+        ccstd::hash_t dynamicsHash{0}; // values set by Pass::setDynamicState, not part of the pass hash
+        uint32_t priority{0};
+        uint32_t phase{0};
+        const gfx::DescriptorSet *descriptorSet{nullptr};
+        const gfx::DepthStencilState *depthStencilState{nullptr};
+        ccstd::hash_t dsHash{0};
+
+        inline bool operator==(const PassKey &rhs) const {
+            return target.get() == rhs.target.get() && hash == rhs.hash && dynamicsHash == rhs.dynamicsHash && priority == rhs.priority && phase == rhs.phase &&
+                   descriptorSet == rhs.descriptorSet && depthStencilState == rhs.depthStencilState && dsHash == rhs.dsHash;
+        }
+        inline bool operator!=(const PassKey &rhs) const { return !(*this == rhs); }
+    };
+
     gfx::InputAssembler *_inputAssembler{nullptr}; // IntrusivePtr ?
     gfx::DescriptorSet *_descriptorSet{nullptr};
     uint32_t _visFlags{0};
     ccstd::vector<IntrusivePtr<scene::Pass>> _passes;
     ccstd::vector<gfx::Shader *> _shaders;
+    ccstd::vector<PassKey> _passKeys;
 
     Model *_model{nullptr};
 
@@ -25,7 +25,9 @@
 
 #include "scene/LODGroup.h"
 #include <cmath>
+#include "base/std/container/array.h"
 #include "core/scene-graph/Node.h"
+#include "math/MathUtil.h"
 #include "scene/Camera.h"
 
 namespace cc {
@@ -44,8 +46,52 @@ LODGroup::~LODGroup() = default;
 
 
 int8_t LODGroup::getVisibleLODLevel(const Camera *camera) const {
-    float screenUsagePercentage = getScreenUsagePercentage(camera);
+    return getLODLevelByScreenUsage(getScreenUsagePercentage(camera));
+}
+
+void LODGroup::getVisibleLODLevels(const ccstd::vector<const LODGroup *> &groups, const Camera *camera, float lodBias, ccstd::vector<int8_t> &levels) {
+    const auto count = static_cast<uint32_t>(groups.size());
+    levels.resize(count);
+    if (!count) {
+        return;
+    }
+
+    // group centers in world space as structure of arrays, padded to a multiple of 4 for the SIMD kernel
+    thread_local ccstd::array<ccstd::vector<float>, 3> centers;
+    thread_local ccstd::vector<float> distances;
+    const uint32_t paddedCount = (count + 3) & ~3U;
+    for (auto &array : centers) {
+        array.resize(paddedCount);
+    }
+    distances.resize(paddedCount);
+
+    const bool perspective = camera->getProjectionType() == CameraProjection::PERSPECTIVE;
+    if (perspective) {
+        for (uint32_t i = 0; i < count; ++i) {
+            const auto *group = groups[i];
+            Vec3 center{group->_localBoundaryCenter};
+            if (group->_node) {
+                center.transformMat4(group->_node->getWorldMatrix());
+            }
+            centers[0][i] = center.x;
+            centers[1][i] = center.y;
+            centers[2][i] = center.z;
+        }
+        const float *const points[3] = {centers[0].data(), centers[1].data(), centers[2].data()};
+        MathUtil::distancesSoA(points, paddedCount, &camera->getNode()->getPosition().x, distances.data());
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const auto *group = groups[i];
+        float screenUsagePercentage = 0.F;
+        if (group->_node) {
+            screenUsagePercentage = distanceToScreenUsagePercentage(camera, perspective ? distances[i] : 0.F, group->getWorldSpaceSize());
+        }
+        levels[i] = group->getLODLevelByScreenUsage(screenUsagePercentage * lodBias);
+    }
+}
 
+int8_t LODGroup::getLODLevelByScreenUsage(float screenUsagePercentage) const {
     int8_t lodIndex = -1;
     for (auto i = 0; i < _vecLODData.size(); ++i) {
         const auto &lod = _vecLODData[i];
@@ -62,7 +108,7 @@ float LODGroup::getScreenUsagePercentage(const Camera *camera) const {
         return 0;
     }
 
-    auto distance = 0;
+    float distance = 0.F;
     if (camera->getProjectionType() == CameraProjection::PERSPECTIVE) {
         Vec3 tmp{_localBoundaryCenter};
         tmp.transformMat4(_node->getWorldMatrix());
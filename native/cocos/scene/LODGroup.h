@@ -83,6 +83,13 @@ public:
 
     int8_t getVisibleLODLevel(const Camera *camera) const;
 
+    /**
+     * Evaluates the visible LOD levels of a batch of groups at once, the distances to the camera are computed with SIMD.
+     * The screen usages are scaled by lodBias before being compared to the thresholds of the levels,
+     * so a bias below 1 selects coarser levels. With a bias of 1 the levels match getVisibleLODLevel.
+     */
+    static void getVisibleLODLevels(const ccstd::vector<const LODGroup *> &groups, const Camera *camera, float lodBias, ccstd::vector<int8_t> &levels);
+
     inline const ccstd::vector<uint8_t>& getLockedLODLevels() const { return _vecLockedLevels; }
     void lockLODLevels(ccstd::vector<int> &levels);
 
@@ -94,6 +101,7 @@ public:
 
 private:
     float getScreenUsagePercentage(const Camera *camera) const;
+    int8_t getLODLevelByScreenUsage(float screenUsagePercentage) const;
     static float distanceToScreenUsagePercentage(const Camera *camera, float distance, float size);
     float getWorldSpaceSize() const;
 
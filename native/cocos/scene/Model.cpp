@@ -96,6 +96,10 @@ void Model::destroy() {
 
     CC_SAFE_DESTROY_NULL(_localBuffer);
     CC_SAFE_DESTROY_NULL(_localSHBuffer);
+    if (auto *arena = UniformArena::getInstance()) {
+        arena->free(_localArenaHandle);
+        arena->free(_localSHArenaHandle);
+    }
     CC_SAFE_DESTROY_NULL(_worldBoundBuffer);
 
     _worldBounds = nullptr;
@@ -174,14 +178,37 @@ void Model::updateUBOs(uint32_t stamp) {
 
     updateSHUBOs();
 
-    const auto *pipeline = Root::getInstance()->getPipeline();
-    const auto *shadowInfo = pipeline->getPipelineSceneData()->getShadows();
-    const auto forceUpdateUBO = shadowInfo->isEnabled() && shadowInfo->getType() == ShadowType::PLANAR;
+    if (_localDataUpdated) {
+        _localDataUpdated = false;
+        _localUBOsPending = writeLocalUBOs();
+    }
+    if (!_localUBOsPending) {
+        return;
+    }
+    _localUBOsPending = false;
 
-    if (!_localDataUpdated) {
+    if (!_localArenaHandle.isValid()) {
+        _localBuffer->update();
+    }
+    const bool enableOcclusionQuery = Root::getInstance()->getPipeline()->isOcclusionQueryEnabled();
+    if (enableOcclusionQuery) {
+        updateWorldBoundUBOs();
+    }
+}
+
+void Model::prepareUBOs() {
+    if (isModelImplementedInJS() || !_localDataUpdated) {
         return;
     }
     _localDataUpdated = false;
+    _localUBOsPending = writeLocalUBOs();
+}
+
+bool Model::writeLocalUBOs() {
+    const auto *pipeline = Root::getInstance()->getPipeline();
+    const auto *shadowInfo = pipeline->getPipelineSceneData()->getShadows();
+    const auto forceUpdateUBO = shadowInfo->isEnabled() && shadowInfo->getType() == ShadowType::PLANAR;
+
     getTransform()->updateWorldTransform();
     const auto &worldMatrix = getTransform()->getWorldMatrix();
     bool hasNonInstancingPass = false;
@@ -199,21 +226,32 @@ void Model::updateUBOs(uint32_t stamp) {
         Mat4 mat4;
         Mat4::inverseTranspose(worldMatrix, &mat4);
 
+        if (_localArenaHandle.isValid()) {
+            auto *arena = UniformArena::getInstance();
+            arena->write(_localArenaHandle, worldMatrix, sizeof(float) * pipeline::UBOLocal::MAT_WORLD_OFFSET);
+            arena->write(_localArenaHandle, mat4, sizeof(float) * pipeline::UBOLocal::MAT_WORLD_IT_OFFSET);
+            arena->write(_localArenaHandle, _lightmapUVParam, sizeof(float) * pipeline::UBOLocal::LIGHTINGMAP_UVPARAM);
+            arena->write(_localArenaHandle, _shadowBias, sizeof(float) * (pipeline::UBOLocal::LOCAL_SHADOW_BIAS));
+            return true;
+        }
         _localBuffer->write(worldMatrix, sizeof(float) * pipeline::UBOLocal::MAT_WORLD_OFFSET);
         _localBuffer->write(mat4, sizeof(float) * pipeline::UBOLocal::MAT_WORLD_IT_OFFSET);
         _localBuffer->write(_lightmapUVParam, sizeof(float) * pipeline::UBOLocal::LIGHTINGMAP_UVPARAM);
         _localBuffer->write(_shadowBias, sizeof(float) * (pipeline::UBOLocal::LOCAL_SHADOW_BIAS));
-
-        _localBuffer->update();
-        const bool enableOcclusionQuery = Root::getInstance()->getPipeline()->isOcclusionQueryEnabled();
-        if (enableOcclusionQuery) {
-            updateWorldBoundUBOs();
-        }
+        return true;
     }
+    return false;
 }
 
 void Model::updateOctree() {
-    if (_scene && _worldBoundsDirty) {
+    if (!_scene) {
+        return;
+    }
+    // models implemented in JS may modify their bounds without marking them dirty
+    if (_worldBoundsDirty || isModelImplementedInJS()) {
+        _scene->updateWorldBounds(this);
+    }
+    if (_worldBoundsDirty) {
         _worldBoundsDirty = false;
         _scene->updateOctree(this);
     }
@@ -361,7 +399,9 @@ void Model::updateSHBuffer() {
         }
     }
 
-    if (hasNonInstancingPass && _localSHBuffer) {
+    if (hasNonInstancingPass && _localSHArenaHandle.isValid()) {
+        UniformArena::getInstance()->write(_localSHArenaHandle, _localSHData.buffer()->getData(), 0, pipeline::UBOSH::SIZE);
+    } else if (hasNonInstancingPass && _localSHBuffer) {
         _localSHBuffer->update(_localSHData.buffer()->getData());
     }
 }
@@ -488,6 +528,11 @@ void Model::updateInstancedAttributes(const ccstd::vector<gfx::Attribute> &attri
 
 void Model::initLocalDescriptors(index_t /*subModelIndex*/) {
     if (!_localBuffer) {
+        if (auto *arena = UniformArena::getInstance()) {
+            _localArenaHandle = arena->alloc(pipeline::UBOLocal::SIZE);
+            _localBuffer = arena->createBufferView(_localArenaHandle, 0, pipeline::UBOLocal::SIZE);
+            return;
+        }
         _localBuffer = _device->createBuffer({gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
                                               gfx::MemoryUsageBit::DEVICE,
                                               pipeline::UBOLocal::SIZE,
@@ -508,6 +553,11 @@ void Model::initLocalSHDescriptors(index_t /*subModelIndex*/) {
     }
 
     if (!_localSHBuffer) {
+        if (auto *arena = UniformArena::getInstance()) {
+            _localSHArenaHandle = arena->alloc(pipeline::UBOSH::SIZE);
+            _localSHBuffer = arena->createBufferView(_localSHArenaHandle, 0, pipeline::UBOSH::SIZE);
+            return;
+        }
         _localSHBuffer = _device->createBuffer({
             gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
             gfx::MemoryUsageBit::DEVICE,
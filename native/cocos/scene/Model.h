@@ -37,6 +37,7 @@
 #include "core/geometry/AABB.h"
 #include "core/scene-graph/Layers.h"
 #include "core/scene-graph/Node.h"
+#include "renderer/core/UniformArena.h"
 #include "renderer/gfx-base/GFXBuffer.h"
 #include "renderer/gfx-base/GFXDef-common.h"
 #include "renderer/gfx-base/GFXTexture.h"
@@ -53,7 +54,6 @@ namespace scene {
 class SubModel;
 // RenderScene.h <-> Model.h, so do not include RenderScene.h here.
 class RenderScene;
-class OctreeNode;
 class Octree;
 class Pass;
 struct IMacroPatch;
@@ -112,6 +112,9 @@ public:
     void clearSHUBOs();
     void updateSHUBOs();
     void updateOctree();
+    // Thread-safe part of updateUBOs, writes local uniforms into the CPU side of the buffers only.
+    // The actual upload is done by the next updateUBOs call.
+    void prepareUBOs();
     void updateWorldBoundUBOs();
     void updateLocalShadowBias();
     void updateReflctionProbeCubemap(TextureCube *texture);
@@ -142,7 +145,7 @@ public:
         _modelBounds->set(_worldBounds->getCenter(), _worldBounds->getHalfExtents());
         _worldBoundsDirty = true;
     }
-    inline void setOctreeNode(OctreeNode *node) { _octreeNode = node; }
+    inline void setOctreeSlot(uint32_t slot) { _octreeSlot = slot; }
     inline void setScene(RenderScene *scene) {
         _scene = scene;
         if (scene) _localDataUpdated = true;
@@ -180,7 +183,7 @@ public:
     inline geometry::AABB *getWorldBounds() const { return _worldBounds; }
     inline Type getType() const { return _type; };
     inline void setType(Type type) { _type = type; }
-    inline OctreeNode *getOctreeNode() const { return _octreeNode; }
+    inline uint32_t getOctreeSlot() const { return _octreeSlot; }
     inline RenderScene *getScene() const { return _scene; }
     inline void setDynamicBatching(bool val) { _isDynamicBatching = val; }
     inline bool isDynamicBatching() const { return _isDynamicBatching; }
@@ -188,6 +191,8 @@ public:
     inline float getShadowNormalBias() const { return _shadowBias.y; }
     inline uint32_t getPriority() const { return _priority; }
     inline void setPriority(uint32_t value) { _priority = value; }
+    inline uint32_t getSceneSlot() const { return _sceneSlot; }
+    inline void setSceneSlot(uint32_t slot) { _sceneSlot = slot; }
 
     // For JS
     inline void setCalledFromJS(bool v) { _isCalledFromJS = v; }
@@ -205,6 +210,7 @@ protected:
     void updateAttributesAndBinding(index_t subModelIndex);
     bool isLightProbeAvailable() const;
     void updateSHBuffer();
+    bool writeLocalUBOs();
 
     // Please declare variables in descending order of memory size occupied by variables.
     Type _type{Type::DEFAULT};
@@ -213,9 +219,10 @@ protected:
     uint32_t _descriptorSetCount{1};
     uint32_t _priority{0};
     uint32_t _updateStamp{0};
+    uint32_t _sceneSlot{0xFFFFFFFF};
+    uint32_t _octreeSlot{0xFFFFFFFF};
     Float32Array _localSHData;
 
-    OctreeNode *_octreeNode{nullptr};
     RenderScene *_scene{nullptr};
     gfx::Device *_device{nullptr};
 
@@ -223,6 +230,8 @@ protected:
     IntrusivePtr<Node> _node;
     IntrusivePtr<gfx::Buffer> _localBuffer;
     IntrusivePtr<gfx::Buffer> _localSHBuffer;
+    UniformArenaHandle _localArenaHandle; // valid if _localBuffer is a view of the uniform arena
+    UniformArenaHandle _localSHArenaHandle;
     IntrusivePtr<gfx::Buffer> _worldBoundBuffer;
     IntrusivePtr<geometry::AABB> _worldBounds;
     IntrusivePtr<geometry::AABB> _modelBounds;
@@ -241,6 +250,7 @@ protected:
     bool _isDynamicBatching{false};
     bool _inited{false};
     bool _localDataUpdated{false};
+    bool _localUBOsPending{false};
     bool _worldBoundsDirty{true};
     // For JS
     bool _isCalledFromJS{false};
@@ -24,8 +24,10 @@
  ****************************************************************************/
 
 #include "Octree.h"
-#include <future>
+#include <algorithm>
 #include <utility>
+#include "base/Log.h"
+#include "base/job-system/JobSystem.h"
 #include "scene/Camera.h"
 #include "scene/Model.h"
 
@@ -87,34 +89,29 @@ void OctreeInfo::activate(Octree *resource) {
 /**
  * OctreeNode class
  */
-OctreeNode::OctreeNode(Octree *owner, OctreeNode *parent)
-: _owner(owner), _parent(parent) {
+void OctreeNode::setBox(const BBox &box) {
+    aabb = box;
+    center = box.getCenter();
+    halfExtents = (box.max - box.min) * 0.5F;
 }
 
-OctreeNode::~OctreeNode() {
-    for (auto i = 0; i < OCTREE_CHILDREN_NUM; i++) {
-        deleteChild(i);
-    }
-}
+BBox OctreeNode::getChildBox(uint32_t childIndex) const {
+    cc::Vec3 min = aabb.min;
+    cc::Vec3 max = aabb.max;
 
-BBox OctreeNode::getChildBox(uint32_t index) const {
-    cc::Vec3 min = _aabb.min;
-    cc::Vec3 max = _aabb.max;
-    const cc::Vec3 center = _aabb.getCenter();
-
-    if (index & 0x1) {
+    if (childIndex & 0x1) {
         min.x = center.x;
     } else {
         max.x = center.x;
     }
 
-    if (index & 0x2) {
+    if (childIndex & 0x2) {
         min.y = center.y;
     } else {
         max.y = center.y;
     }
 
-    if (index & 0x4) {
+    if (childIndex & 0x4) {
         min.z = center.z;
     } else {
         max.z = center.z;
@@ -123,188 +120,84 @@ BBox OctreeNode::getChildBox(uint32_t index) const {
     return {min, max};
 }
 
-OctreeNode *OctreeNode::getOrCreateChild(uint32_t index) {
-    if (!_children[index]) {
-        BBox childBox = getChildBox(index);
-        auto *child = _children[index] = ccnew OctreeNode(_owner, this);
-        child->setBox(childBox);
-        child->setDepth(_depth + 1);
-        child->setIndex(index);
-    }
-
-    return _children[index];
-}
-
-void OctreeNode::deleteChild(uint32_t index) {
-    if (_children[index]) {
-        delete _children[index];
-        _children[index] = nullptr;
-    }
-}
-
-void OctreeNode::insert(Model *model) { // NOLINT(misc-no-recursion)
-    bool split = false;
-    if (_depth < _owner->getMaxDepth() - 1) {
-        BBox modelBox(*model->getWorldBounds());
-        const cc::Vec3 &modelCenter = modelBox.getCenter();
-        const cc::Vec3 &nodeCenter = _aabb.getCenter();
-
-        uint32_t index = modelCenter.x < nodeCenter.x ? 0 : 1;
-        index += modelCenter.y < nodeCenter.y ? 0 : 2;
-        index += modelCenter.z < nodeCenter.z ? 0 : 4;
-
-        BBox childBox = getChildBox(index);
-        if (childBox.contain(modelBox)) {
-            split = true;
-
-            // insert to child node recursively
-            OctreeNode *child = getOrCreateChild(index);
-            child->insert(model);
-        }
-    }
-
-    if (!split) {
-        // insert to this node
-        OctreeNode *lastNode = model->getOctreeNode();
-        if (lastNode != this) {
-            add(model);
-
-            if (lastNode) {
-                lastNode->remove(model);
-            }
-        }
-    }
-}
-
-void OctreeNode::add(Model *model) {
-    _models.push_back(model);
-    model->setOctreeNode(this);
-}
-
-void OctreeNode::remove(Model *model) {
-    auto iter = std::find(_models.begin(), _models.end(), model);
-    if (iter != _models.end()) {
-        _models.erase(iter);
-    }
-
-    onRemoved();
+bool OctreeNode::hasChildren() const {
+    return std::any_of(children.begin(), children.end(), [](int32_t child) { return child != INVALID_INDEX; });
 }
 
-void OctreeNode::onRemoved() { // NOLINT(misc-no-recursion)
-    // delete empty node
-    if (!_models.empty()) {
-        return;
-    }
+namespace {
 
-    for (auto *child : _children) {
-        if (child) {
-            return;
-        }
-    }
+constexpr uint32_t ALL_PLANES{0x3F};
+// Below this amount of models the cost of dispatching jobs outweighs the gain.
+constexpr uint32_t PARALLEL_QUERY_MIN_MODELS_PER_JOB{512};
 
-    // delete recursively
-    OctreeNode *parent = _parent;
-    if (parent) {
-        parent->deleteChild(_index);
-        parent->onRemoved();
-    }
-}
-
-void OctreeNode::gatherModels(ccstd::vector<Model *> &results) const { // NOLINT(misc-no-recursion)
-    for (auto *model : _models) {
-        results.push_back(model);
-    }
-
-    for (auto *child : _children) {
-        if (child) {
-            child->gatherModels(results);
-        }
-    }
-}
-
-void OctreeNode::doQueryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const {
-    const auto visibility = camera->getVisibility();
-    for (auto *model : _models) {
-        if (!model->isEnabled()) {
+/**
+ * Tests the box against the frustum planes in `planeMask`, returns false if it's outside of any of them.
+ * Otherwise clears the bits of the planes the box is completely inside of, their descendants needn't test them again.
+ */
+bool boxFrustum(const Vec3 &center, const Vec3 &halfExtents, const geometry::Frustum &frustum, uint32_t &planeMask) {
+    for (uint32_t i = 0; i < 6; ++i) {
+        if (!(planeMask & (1U << i))) {
             continue;
         }
-
-        const Node *node = model->getNode();
-        if ((node && ((visibility & node->getLayer()) == node->getLayer())) ||
-            (visibility & static_cast<uint32_t>(model->getVisFlags()))) {
-            const geometry::AABB *modelWorldBounds = model->getWorldBounds();
-            if (!modelWorldBounds) {
-                continue;
-            }
-
-            if (isShadow) {
-                if (model->isCastShadow() && modelWorldBounds->aabbFrustum(frustum)) {
-                    results.push_back(model);
-                }
-            } else {
-                if (modelWorldBounds->aabbFrustum(frustum)) {
-                    results.push_back(model);
-                }
-            }
+        // frustum plane normal points to the inside
+        const auto &plane = *frustum.planes[i];
+        const float r = halfExtents.x * std::abs(plane.n.x) +
+                        halfExtents.y * std::abs(plane.n.y) +
+                        halfExtents.z * std::abs(plane.n.z);
+        const float dot = Vec3::dot(plane.n, center);
+        if (dot + r < plane.d) {
+            return false;
+        }
+        if (dot - r > plane.d) {
+            planeMask &= ~(1U << i);
         }
     }
+    return true;
 }
 
-void OctreeNode::queryVisibilityParallelly(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const {
-    geometry::AABB box;
-    geometry::AABB::fromPoints(_aabb.min, _aabb.max, &box);
-    if (!box.aabbFrustum(frustum)) {
-        return;
+bool isModelVisible(const Model *model, uint32_t visibility, const geometry::Frustum &frustum, uint32_t planeMask, bool isShadow) {
+    if (!model->isEnabled()) {
+        return false;
     }
 
-    ccstd::array<std::future<ccstd::vector<Model *>>, OCTREE_CHILDREN_NUM> futures{};
-    for (auto i = 0; i < OCTREE_CHILDREN_NUM; i++) {
-        if (_children[i]) {
-            futures[i] = std::async(std::launch::async, [=, &frustum] {
-                ccstd::vector<Model *> models;
-                _children[i]->queryVisibilitySequentially(camera, frustum, isShadow, models);
-                return models;
-            });
+    const Node *node = model->getNode();
+    if ((node && ((visibility & node->getLayer()) == node->getLayer())) ||
+        (visibility & static_cast<uint32_t>(model->getVisFlags()))) {
+        const geometry::AABB *modelWorldBounds = model->getWorldBounds();
+        if (!modelWorldBounds) {
+            return false;
         }
-    }
-
-    doQueryVisibility(camera, frustum, isShadow, results);
-
-    for (auto i = 0; i < OCTREE_CHILDREN_NUM; i++) {
-        if (_children[i]) {
-            auto models = futures[i].get();
-            results.insert(results.end(), models.begin(), models.end());
+        if (isShadow && !model->isCastShadow()) {
+            return false;
         }
+        return boxFrustum(modelWorldBounds->getCenter(), modelWorldBounds->getHalfExtents(), frustum, planeMask);
     }
+    return false;
 }
 
-void OctreeNode::queryVisibilitySequentially(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const { // NOLINT(misc-no-recursion)
-    geometry::AABB box;
-    geometry::AABB::fromPoints(_aabb.min, _aabb.max, &box);
-    if (!box.aabbFrustum(frustum)) {
-        return;
-    }
+struct VisibleNode {
+    const OctreeNode *node{nullptr};
+    uint32_t planeMask{ALL_PLANES};
+    uint32_t firstModel{0}; // offset of the first model in all the visible models
+};
 
-    doQueryVisibility(camera, frustum, isShadow, results);
+// scratch buffers of the queries issued from each thread
+struct QueryContext {
+    ccstd::vector<VisibleNode> visibleNodes;
+    ccstd::vector<std::pair<int32_t, uint32_t>> stack;
+    ccstd::vector<ccstd::vector<Model *>> jobResults;
+};
 
-    // query recursively.
-    for (auto *child : _children) {
-        if (child) {
-            child->queryVisibilitySequentially(camera, frustum, isShadow, results);
-        }
-    }
-}
+} // namespace
 
 /**
  * Octree class
  */
 Octree::Octree() {
-    _root = ccnew OctreeNode(this, nullptr);
+    resetRoot({});
 }
 
-Octree::~Octree() {
-    delete _root;
-}
+Octree::~Octree() = default;
 
 void Octree::initialize(const OctreeInfo &info) {
     const Vec3 expand{OCTREE_BOX_EXPAND_SIZE, OCTREE_BOX_EXPAND_SIZE, OCTREE_BOX_EXPAND_SIZE};
@@ -312,9 +205,7 @@ void Octree::initialize(const OctreeInfo &info) {
     _maxPos = info.getMaxPos();
     _maxDepth = std::max(info.getDepth(), 1U);
     setEnabled(info.isEnabled());
-    _root->setBox(BBox{_minPos - expand, _maxPos});
-    _root->setDepth(0);
-    _root->setIndex(0);
+    _nodes[0].setBox(BBox{_minPos - expand, _maxPos});
 }
 
 void Octree::setEnabled(bool val) {
@@ -338,25 +229,26 @@ void Octree::setMaxDepth(uint32_t val) {
 
 void Octree::resize(const Vec3 &minPos, const Vec3 &maxPos, uint32_t maxDepth) {
     const Vec3 expand{OCTREE_BOX_EXPAND_SIZE, OCTREE_BOX_EXPAND_SIZE, OCTREE_BOX_EXPAND_SIZE};
-    BBox rootBox = _root->getBox();
+    const BBox &rootBox = _nodes[0].aabb;
     if ((minPos - expand) == rootBox.min && maxPos == rootBox.max && maxDepth == _maxDepth) {
         return;
     }
 
     ccstd::vector<Model *> models;
-    _root->gatherModels(models);
-
-    delete _root;
-    _root = ccnew OctreeNode(this, nullptr);
-    _root->setBox(BBox{minPos - expand, maxPos});
-    _root->setDepth(0);
-    _root->setIndex(0);
+    models.reserve(_totalCount);
+    for (const auto &node : _nodes) {
+        models.insert(models.end(), node.models.begin(), node.models.end());
+    }
 
+    resetRoot(BBox{minPos - expand, maxPos});
     _maxDepth = std::max(maxDepth, 1U);
 
     for (auto *model : models) {
-        model->setOctreeNode(nullptr);
+        _entries[model->getOctreeSlot()].node = OctreeNode::INVALID_INDEX;
         insert(model);
+        if (_entries[model->getOctreeSlot()].node == OctreeNode::INVALID_INDEX) {
+            freeSlot(model);
+        }
     }
 }
 
@@ -367,53 +259,262 @@ void Octree::insert(Model *model) {
         return;
     }
 
-    if (isOutside(model)) {
+    const BBox modelBox(*model->getWorldBounds());
+    if (isOutside(modelBox)) {
         CC_LOG_WARNING("Octree insert: model is outside of the scene bounding box, please modify DEFAULT_WORLD_MIN_POS and DEFAULT_WORLD_MAX_POS.");
         return;
     }
 
-    if (!model->getOctreeNode()) {
+    uint32_t slot = model->getOctreeSlot();
+    if (slot == INVALID_SLOT) {
+        if (_freeSlots.empty()) {
+            slot = static_cast<uint32_t>(_entries.size());
+            _entries.emplace_back();
+        } else {
+            slot = _freeSlots.back();
+            _freeSlots.pop_back();
+        }
+        model->setOctreeSlot(slot);
         _totalCount++;
     }
 
-    _root->insert(model);
+    place(model, slot, findOrCreateNode(0, modelBox));
 }
 
 void Octree::remove(Model *model) {
     CC_ASSERT(model);
 
-    OctreeNode *node = model->getOctreeNode();
-    if (node) {
-        node->remove(model);
-        model->setOctreeNode(nullptr);
-        _totalCount--;
+    const uint32_t slot = model->getOctreeSlot();
+    if (slot == INVALID_SLOT) {
+        return;
+    }
+
+    const int32_t node = _entries[slot].node;
+    if (node != OctreeNode::INVALID_INDEX) {
+        detach(slot);
+        pruneEmptyNodes(node);
     }
+    freeSlot(model);
 }
 
 void Octree::update(Model *model) {
-    insert(model);
+    CC_ASSERT(model);
+
+    const uint32_t slot = model->getOctreeSlot();
+    if (slot == INVALID_SLOT || !model->getWorldBounds()) {
+        insert(model);
+        return;
+    }
+
+    const BBox modelBox(*model->getWorldBounds());
+    if (isOutside(modelBox)) {
+        CC_LOG_WARNING("Octree insert: model is outside of the scene bounding box, please modify DEFAULT_WORLD_MIN_POS and DEFAULT_WORLD_MAX_POS.");
+        return;
+    }
+
+    // refit: walk up to the nearest node still containing the model, then down as insert does.
+    // Most moving models stay in their node, which costs a few box tests and no allocation.
+    int32_t node = _entries[slot].node;
+    while (node > 0 && !_nodes[node].aabb.contain(modelBox)) {
+        node = _nodes[node].parent;
+    }
+    place(model, slot, findOrCreateNode(std::max(node, 0), modelBox));
 }
 
 void Octree::queryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const {
-    if (_totalCount > USE_MULTI_THRESHOLD) {
-        _root->queryVisibilityParallelly(camera, frustum, isShadow, results);
+    query(camera, frustum, isShadow, !JobSystem::getInstance()->isWorkerThread(), results);
+}
+
+void Octree::queryVisibilitySerial(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const {
+    query(camera, frustum, isShadow, false, results);
+}
+
+void Octree::query(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, bool parallel, ccstd::vector<Model *> &results) const {
+    thread_local QueryContext context;
+    auto &visibleNodes = context.visibleNodes;
+    auto &stack = context.stack;
+    visibleNodes.clear();
+
+    // Cull the nodes serially in depth first order, so the results keep the order of the recursive traversal.
+    uint32_t modelCount = 0;
+    stack.emplace_back(0, ALL_PLANES);
+    while (!stack.empty()) {
+        auto [index, planeMask] = stack.back();
+        stack.pop_back();
+
+        const auto &node = _nodes[index];
+        if (planeMask && !boxFrustum(node.center, node.halfExtents, frustum, planeMask)) {
+            continue;
+        }
+
+        if (!node.models.empty()) {
+            // the models of the root may stick out of the scene bounding box
+            visibleNodes.push_back({&node, index ? planeMask : ALL_PLANES, modelCount});
+            modelCount += static_cast<uint32_t>(node.models.size());
+        }
+
+        for (auto i = OCTREE_CHILDREN_NUM - 1; i >= 0; i--) {
+            if (node.children[i] != OctreeNode::INVALID_INDEX) {
+                stack.emplace_back(node.children[i], planeMask);
+            }
+        }
+    }
+
+    const auto visibility = camera->getVisibility();
+    const uint32_t maxJobCount = modelCount ? (modelCount - 1) / PARALLEL_QUERY_MIN_MODELS_PER_JOB + 1 : 0;
+    const uint32_t jobCount = parallel && modelCount > USE_MULTI_THRESHOLD ? std::min(JobSystem::getInstance()->threadCount(), maxJobCount) : 1U;
+    if (jobCount <= 1) {
+        for (const auto &visibleNode : visibleNodes) {
+            for (auto *model : visibleNode.node->models) {
+                if (isModelVisible(model, visibility, frustum, visibleNode.planeMask, isShadow)) {
+                    results.push_back(model);
+                }
+            }
+        }
+        return;
+    }
+
+    // Split the models evenly, each job writes to its own buffer and the buffers are merged in order.
+    auto &jobResults = context.jobResults;
+    if (jobResults.size() < jobCount) {
+        jobResults.resize(jobCount);
+    }
+    const uint32_t modelsPerJob = (modelCount - 1) / jobCount + 1; // ceil(modelCount / jobCount)
+    const VisibleNode *nodes = visibleNodes.data();
+    const auto nodeCount = static_cast<uint32_t>(visibleNodes.size());
+    ccstd::vector<Model *> *buffers = jobResults.data();
+    auto queryModels = [=, &frustum](uint32_t job) {
+        auto &buffer = buffers[job];
+        buffer.clear();
+
+        const uint32_t begin = job * modelsPerJob;
+        const uint32_t end = std::min(modelCount, begin + modelsPerJob);
+        // the last visible node starting at or before `begin`
+        uint32_t n = static_cast<uint32_t>(std::upper_bound(nodes, nodes + nodeCount, begin, [](uint32_t offset, const VisibleNode &node) {
+                                               return offset < node.firstModel;
+                                           }) -
+                                           nodes) -
+                     1;
+        for (uint32_t i = begin; i < end; ++n) {
+            const auto &visibleNode = nodes[n];
+            const auto &models = visibleNode.node->models;
+            const uint32_t last = std::min(static_cast<uint32_t>(models.size()), end - visibleNode.firstModel);
+            for (uint32_t m = i - visibleNode.firstModel; m < last; ++m) {
+                if (isModelVisible(models[m], visibility, frustum, visibleNode.planeMask, isShadow)) {
+                    buffer.push_back(models[m]);
+                }
+            }
+            i = visibleNode.firstModel + last;
+        }
+    };
+
+    JobGraph g(JobSystem::getInstance());
+    g.createForEachIndexJob(1U, jobCount, 1U, queryModels);
+    g.run();
+    queryModels(0U);
+    g.waitForAll();
+
+    for (uint32_t i = 0; i < jobCount; ++i) {
+        results.insert(results.end(), jobResults[i].begin(), jobResults[i].end());
+    }
+}
+
+void Octree::resetRoot(const BBox &box) {
+    _nodes.clear();
+    _freeNodes.clear();
+    _nodes.emplace_back();
+    _nodes[0].setBox(box);
+}
+
+int32_t Octree::getOrCreateChild(int32_t node, uint32_t childIndex) {
+    if (_nodes[node].children[childIndex] != OctreeNode::INVALID_INDEX) {
+        return _nodes[node].children[childIndex];
+    }
+
+    int32_t child = 0;
+    if (_freeNodes.empty()) {
+        child = static_cast<int32_t>(_nodes.size());
+        _nodes.emplace_back(); // may reallocate the nodes, so no reference is kept above
     } else {
-        _root->queryVisibilitySequentially(camera, frustum, isShadow, results);
+        child = _freeNodes.back();
+        _freeNodes.pop_back();
+    }
+
+    auto &parent = _nodes[node];
+    auto &childNode = _nodes[child];
+    childNode.setBox(parent.getChildBox(childIndex));
+    childNode.parent = node;
+    childNode.depth = parent.depth + 1;
+    childNode.index = childIndex;
+    parent.children[childIndex] = child;
+    return child;
+}
+
+int32_t Octree::findOrCreateNode(int32_t node, const BBox &modelBox) {
+    const cc::Vec3 &modelCenter = modelBox.getCenter();
+    while (_nodes[node].depth < _maxDepth - 1) {
+        const auto &current = _nodes[node];
+        uint32_t index = modelCenter.x < current.center.x ? 0 : 1;
+        index += modelCenter.y < current.center.y ? 0 : 2;
+        index += modelCenter.z < current.center.z ? 0 : 4;
+
+        if (!current.getChildBox(index).contain(modelBox)) {
+            break;
+        }
+        node = getOrCreateChild(node, index);
     }
+    return node;
 }
 
-bool Octree::isInside(Model *model) const {
-    const BBox &rootBox = _root->getBox();
-    BBox modelBox = BBox(*model->getWorldBounds());
+void Octree::place(Model *model, uint32_t slot, int32_t node) {
+    const int32_t lastNode = _entries[slot].node;
+    if (lastNode == node) {
+        return;
+    }
+
+    if (lastNode != OctreeNode::INVALID_INDEX) {
+        detach(slot);
+    }
+    auto &models = _nodes[node].models;
+    _entries[slot] = {node, static_cast<uint32_t>(models.size())};
+    models.push_back(model);
 
-    return rootBox.contain(modelBox);
+    if (lastNode != OctreeNode::INVALID_INDEX) {
+        pruneEmptyNodes(lastNode);
+    }
+}
+
+void Octree::detach(uint32_t slot) {
+    auto &entry = _entries[slot];
+    auto &models = _nodes[entry.node].models;
+    // swap with the last one, the order of the models in a node doesn't matter
+    Model *last = models.back();
+    models[entry.indexInNode] = last;
+    _entries[last->getOctreeSlot()].indexInNode = entry.indexInNode;
+    models.pop_back();
+    entry.node = OctreeNode::INVALID_INDEX;
 }
 
-bool Octree::isOutside(Model *model) const {
-    const BBox &rootBox = _root->getBox();
-    BBox modelBox = BBox(*model->getWorldBounds());
+void Octree::pruneEmptyNodes(int32_t node) {
+    // the root is never freed
+    while (node > 0 && _nodes[node].models.empty() && !_nodes[node].hasChildren()) {
+        auto &current = _nodes[node];
+        const int32_t parent = current.parent;
+        _nodes[parent].children[current.index] = OctreeNode::INVALID_INDEX;
+        current.parent = OctreeNode::INVALID_INDEX;
+        _freeNodes.push_back(node);
+        node = parent;
+    }
+}
+
+void Octree::freeSlot(Model *model) {
+    _freeSlots.push_back(model->getOctreeSlot());
+    model->setOctreeSlot(INVALID_SLOT);
+    _totalCount--;
+}
 
-    return !rootBox.intersect(modelBox);
+bool Octree::isOutside(const BBox &modelBox) const {
+    return !_nodes[0].aabb.intersect(modelBox);
 }
 
 } // namespace scene
@@ -28,6 +28,7 @@
 #include "base/Macros.h"
 #include "base/RefCounted.h"
 #include "base/std/container/array.h"
+#include "base/std/container/vector.h"
 #include "core/geometry/AABB.h"
 #include "math/Vec3.h"
 
@@ -131,40 +132,25 @@ struct CC_DLL BBox final {
 };
 
 /**
- * OctreeNode class
+ * Node of the flattened octree. All the nodes of a tree are stored contiguously in the Octree and linked by index,
+ * empty leaves are recycled for the next allocation.
  */
-class CC_DLL OctreeNode final {
-private:
-    OctreeNode(Octree *owner, OctreeNode *parent);
-    ~OctreeNode();
-
-    inline void setBox(const BBox &aabb) { _aabb = aabb; }
-    inline void setDepth(uint32_t depth) { _depth = depth; }
-    inline void setIndex(uint32_t index) { _index = index; }
-
-    inline Octree *getOwner() const { return _owner; }
-    inline const BBox &getBox() const { return _aabb; }
-    BBox getChildBox(uint32_t index) const;
-    OctreeNode *getOrCreateChild(uint32_t index);
-    void deleteChild(uint32_t index);
-    void insert(Model *model);
-    void add(Model *model);
-    void remove(Model *model);
-    void onRemoved();
-    void gatherModels(ccstd::vector<Model *> &results) const;
-    void doQueryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const;
-    void queryVisibilityParallelly(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const;
-    void queryVisibilitySequentially(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const;
-
-    Octree *_owner{nullptr};
-    OctreeNode *_parent{nullptr};
-    ccstd::array<OctreeNode *, OCTREE_CHILDREN_NUM> _children{};
-    ccstd::vector<Model *> _models;
-    BBox _aabb{};
-    uint32_t _depth{0};
-    uint32_t _index{0};
-
-    friend class Octree;
+struct CC_DLL OctreeNode final {
+    static constexpr int32_t INVALID_INDEX{-1};
+
+    BBox aabb{};
+    Vec3 center;
+    Vec3 halfExtents;
+    ccstd::array<int32_t, OCTREE_CHILDREN_NUM> children{INVALID_INDEX, INVALID_INDEX, INVALID_INDEX, INVALID_INDEX,
+                                                        INVALID_INDEX, INVALID_INDEX, INVALID_INDEX, INVALID_INDEX};
+    ccstd::vector<Model *> models;
+    int32_t parent{INVALID_INDEX};
+    uint32_t depth{0};
+    uint32_t index{0}; // index in the children of the parent
+
+    void setBox(const BBox &box);
+    BBox getChildBox(uint32_t childIndex) const;
+    bool hasChildren() const;
 };
 
 /**
@@ -172,6 +158,8 @@ private:
  */
 class CC_DLL Octree final {
 public:
+    static constexpr uint32_t INVALID_SLOT{0xFFFFFFFF};
+
     Octree();
     ~Octree();
 
@@ -207,7 +195,7 @@ public:
     // remove a model from tree.
     void remove(Model *model);
 
-    // update model's location in the tree.
+    // update model's location in the tree, the model stays in its node if it still fits there.
     void update(Model *model);
 
     /**
@@ -218,14 +206,32 @@ public:
     // return octree depth
     inline uint32_t getMaxDepth() const { return _maxDepth; }
 
-    // view frustum culling
+    // view frustum culling, the models are tested on the job system once there are enough of them in the frustum.
+    // Called from a job, the query runs serially: a worker waiting on a nested graph may deadlock the job system.
     void queryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const;
+    // view frustum culling on the calling thread only, for callers already running as jobs
+    void queryVisibilitySerial(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const;
 
 private:
-    bool isInside(Model *model) const;
-    bool isOutside(Model *model) const;
-
-    OctreeNode *_root{nullptr};
+    struct ModelEntry {
+        int32_t node{OctreeNode::INVALID_INDEX};
+        uint32_t indexInNode{0};
+    };
+
+    void resetRoot(const BBox &box);
+    int32_t getOrCreateChild(int32_t node, uint32_t childIndex);
+    int32_t findOrCreateNode(int32_t node, const BBox &modelBox);
+    void place(Model *model, uint32_t slot, int32_t node);
+    void detach(uint32_t slot);
+    void pruneEmptyNodes(int32_t node);
+    void freeSlot(Model *model);
+    bool isOutside(const BBox &modelBox) const;
+    void query(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, bool parallel, ccstd::vector<Model *> &results) const;
+
+    ccstd::vector<OctreeNode> _nodes; // _nodes[0] is the root
+    ccstd::vector<int32_t> _freeNodes;
+    ccstd::vector<ModelEntry> _entries; // indexed by the octree slots of the models
+    ccstd::vector<uint32_t> _freeSlots;
     uint32_t _maxDepth{DEFAULT_OCTREE_DEPTH};
     uint32_t _totalCount{0};
 
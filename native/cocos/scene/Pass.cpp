@@ -267,7 +267,10 @@ void Pass::update() {
         return;
     }
 
-    if (_rootBufferDirty && _rootBuffer) {
+    if (_rootBufferDirty && _rootArenaHandle.isValid()) {
+        UniformArena::getInstance()->write(_rootArenaHandle, _rootBlock->getData(), 0, _rootBlock->byteLength());
+        _rootBufferDirty = false;
+    } else if (_rootBufferDirty && _rootBuffer) {
         _rootBuffer->update(_rootBlock->getData(), _rootBlock->byteLength());
         _rootBufferDirty = false;
     }
@@ -307,6 +310,9 @@ void Pass::destroy() {
         _rootBuffer->destroy();
         _rootBuffer = nullptr;
     }
+    if (auto *arena = UniformArena::getInstance()) {
+        arena->free(_rootArenaHandle);
+    }
 
     for (auto &ib : _instancedBuffers) {
         ib.second->destroy();
@@ -577,7 +583,12 @@ void Pass::doInit(const IPassInfoFull &info, bool /*copyDefines*/ /* = false */)
         bufferInfo.memUsage = gfx::MemoryUsageBit::DEVICE;
         // https://bugs.chromium.org/p/chromium/issues/detail?id=988988
         bufferInfo.size = static_cast<int32_t>(std::ceil(static_cast<float>(totalSize) / 16.F)) * 16;
-        _rootBuffer = device->createBuffer(bufferInfo);
+        if (auto *arena = UniformArena::getInstance()) {
+            arena->free(_rootArenaHandle);
+            _rootArenaHandle = arena->alloc(bufferInfo.size);
+        } else {
+            _rootBuffer = device->createBuffer(bufferInfo);
+        }
         _rootBlock = ccnew ArrayBuffer(totalSize);
     }
 
@@ -593,7 +604,9 @@ void Pass::doInit(const IPassInfoFull &info, bool /*copyDefines*/ /* = false */)
         if (binding >= _buffers.size()) {
             _buffers.resize(binding + 1);
         }
-        auto *bufferView = device->createBuffer(bufferViewInfo);
+        auto *bufferView = _rootArenaHandle.isValid()
+                               ? UniformArena::getInstance()->createBufferView(_rootArenaHandle, bufferViewInfo.offset, bufferViewInfo.range)
+                               : device->createBuffer(bufferViewInfo);
         _buffers[binding] = bufferView;
         // non-builtin UBO data pools, note that the effect compiler
         // guarantees these bindings to be consecutive, starting from 0 and non-array-typed
@@ -33,6 +33,7 @@
 #include "core/TypedArray.h"
 #include "core/assets/EffectAsset.h"
 #include "renderer/core/PassUtils.h"
+#include "renderer/core/UniformArena.h"
 #include "renderer/gfx-base/GFXBuffer.h"
 #include "renderer/gfx-base/GFXDef-common.h"
 #include "renderer/gfx-base/GFXDescriptorSet.h"
@@ -314,6 +315,7 @@ protected:
 
     // internal resources
     IntrusivePtr<gfx::Buffer> _rootBuffer;
+    UniformArenaHandle _rootArenaHandle; // used instead of _rootBuffer when the uniform arena is enabled
     ccstd::vector<IntrusivePtr<gfx::Buffer>> _buffers;
     IntrusivePtr<gfx::DescriptorSet> _descriptorSet;
     IntrusivePtr<gfx::PipelineLayout> _pipelineLayout;
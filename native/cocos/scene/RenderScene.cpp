@@ -30,6 +30,7 @@
 #include "3d/models/BakedSkinningModel.h"
 #include "3d/models/SkinningModel.h"
 #include "base/Log.h"
+#include "base/job-system/JobSystem.h"
 #include "core/Root.h"
 #include "core/scene-graph/Node.h"
 #include "profiler/Profiler.h"
@@ -46,6 +47,12 @@
 
 namespace cc {
 namespace scene {
+
+namespace {
+// Below this amount of models the cost of dispatching jobs outweighs the gain.
+constexpr uint32_t PARALLEL_UPDATE_MIN_MODELS_PER_JOB{128};
+} // namespace
+
 RenderScene::RenderScene() = default;
 
 RenderScene::~RenderScene() = default;
@@ -97,11 +104,16 @@ void RenderScene::update(uint32_t stamp) {
     for (const auto &spotLight : _spotLights) {
         spotLight->update();
     }
-    for (const auto &model : _models) {
-        if (model->isEnabled()) {
-            model->updateTransform(stamp);
-            model->updateUBOs(stamp);
-            model->updateOctree();
+    if (_parallelUpdateEnabled && JobSystem::getInstance()->threadCount() > 1 &&
+        _models.size() >= 2 * PARALLEL_UPDATE_MIN_MODELS_PER_JOB) {
+        updateModelsParallelly(stamp);
+    } else {
+        for (const auto &model : _models) {
+            if (model->isEnabled()) {
+                model->updateTransform(stamp);
+                model->updateUBOs(stamp);
+                model->updateOctree();
+            }
         }
     }
 
@@ -110,6 +122,70 @@ void RenderScene::update(uint32_t stamp) {
     CC_PROFILE_OBJECT_UPDATE(DrawBatch2D, _batches.size());
 }
 
+void RenderScene::updateModelsParallelly(uint32_t stamp) {
+    // Only native default and skinning models are updated on the worker threads, the others call back into JS.
+    // World transforms walk up the (shared) parent chain, and joint transforms may be shared between
+    // several skinning models, so both are flushed here beforehand.
+    _parallelModels.clear();
+    for (const auto &model : _models) {
+        if (!model->isEnabled()) {
+            continue;
+        }
+        if (model->getType() == Model::Type::DEFAULT) {
+            model->getTransform()->updateWorldTransform();
+            _parallelModels.emplace_back(model.get());
+        } else if (model->getType() == Model::Type::SKINNING) {
+            static_cast<SkinningModel *>(model.get())->updateJointTransforms(stamp);
+            _parallelModels.emplace_back(model.get());
+        } else {
+            model->updateTransform(stamp);
+            model->updateUBOs(stamp);
+        }
+    }
+
+    const auto count = static_cast<uint32_t>(_parallelModels.size());
+    if (count > 0) {
+        const uint32_t maxJobCount = (count - 1) / PARALLEL_UPDATE_MIN_MODELS_PER_JOB + 1;
+        const uint32_t jobCount = std::min(JobSystem::getInstance()->threadCount(), maxJobCount);
+        const uint32_t modelsPerJob = (count - 1) / jobCount + 1; // ceil(count / jobCount)
+
+        Model *const *models = _parallelModels.data();
+        auto updateModels = [models, count, modelsPerJob, stamp](uint32_t job) {
+            const uint32_t end = std::min(count, (job + 1) * modelsPerJob);
+            for (uint32_t i = job * modelsPerJob; i < end; ++i) {
+                if (models[i]->getType() == Model::Type::SKINNING) {
+                    static_cast<SkinningModel *>(models[i])->prepareJoints();
+                } else {
+                    models[i]->updateTransform(stamp);
+                }
+                models[i]->prepareUBOs();
+            }
+        };
+
+        if (jobCount > 1) {
+            JobGraph g(JobSystem::getInstance());
+            g.createForEachIndexJob(1U, jobCount, 1U, updateModels);
+            g.run();
+            updateModels(0U);
+            g.waitForAll();
+        } else {
+            updateModels(0U);
+        }
+
+        // gfx resources can only be touched from this thread
+        for (Model *model : _parallelModels) {
+            model->updateUBOs(stamp);
+        }
+    }
+
+    // Merge into the octree serially, in the same order as the serial path.
+    for (const auto &model : _models) {
+        if (model->isEnabled()) {
+            model->updateOctree();
+        }
+    }
+}
+
 void RenderScene::destroy() {
     removeCameras();
     removeSphereLights();
@@ -210,6 +286,8 @@ void RenderScene::removeSpotLights() {
 
 void RenderScene::addModel(Model *model) {
     model->attachToScene(this);
+    model->setSceneSlot(_worldBoundsSoA.allocate());
+    _worldBoundsSoA.update(model->getSceneSlot(), model->getWorldBounds());
     _models.emplace_back(model);
     if (_octree && _octree->isEnabled()) {
         _octree->insert(model);
@@ -222,6 +300,8 @@ void RenderScene::removeModel(Model *model) {
         if (_octree && _octree->isEnabled()) {
             _octree->remove(*iter);
         }
+        _worldBoundsSoA.free(model->getSceneSlot());
+        model->setSceneSlot(WorldBoundsSoA::INVALID_SLOT);
         model->detachFromScene();
         _models.erase(iter);
     } else {
@@ -234,10 +314,12 @@ void RenderScene::removeModels() {
         if (_octree && _octree->isEnabled()) {
             _octree->remove(model);
         }
+        model->setSceneSlot(WorldBoundsSoA::INVALID_SLOT);
         model->detachFromScene();
         CC_SAFE_DESTROY(model);
     }
     _models.clear();
+    _worldBoundsSoA.clear();
 }
 void RenderScene::addBatch(DrawBatch2D *drawBatch2D) {
     _batches.emplace_back(drawBatch2D);
@@ -262,6 +344,10 @@ void RenderScene::updateOctree(Model *model) {
     }
 }
 
+void RenderScene::updateWorldBounds(Model *model) {
+    _worldBoundsSoA.update(model->getSceneSlot(), model->getWorldBounds());
+}
+
 void RenderScene::onGlobalPipelineStateChanged() {
     for (const auto &model : _models) {
         model->onGlobalPipelineStateChanged();
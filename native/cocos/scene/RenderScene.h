@@ -30,6 +30,7 @@
 #include "base/RefCounted.h"
 #include "base/std/container/string.h"
 #include "base/std/container/vector.h"
+#include "scene/WorldBoundsSoA.h"
 
 namespace cc {
 
@@ -110,9 +111,21 @@ public:
     inline const ccstd::vector<IntrusivePtr<Model>> &getModels() const { return _models; }
     inline Octree *getOctree() const { return _octree; }
     void updateOctree(Model *model);
+    void updateWorldBounds(Model *model);
+    inline const WorldBoundsSoA &getWorldBoundsSoA() const { return _worldBoundsSoA; }
     inline const ccstd::vector<DrawBatch2D *> &getBatches() const { return _batches; }
 
+    /**
+     * @en Whether to update the transforms and local uniforms of the models on the job system workers.
+     * The result is identical to the serial update, octree updates are always merged on the calling thread.
+     * @zh 是否在 JobSystem 的工作线程上并行更新模型的变换与局部 UBO。
+     */
+    inline void setParallelUpdateEnabled(bool enabled) { _parallelUpdateEnabled = enabled; }
+    inline bool isParallelUpdateEnabled() const { return _parallelUpdateEnabled; }
+
 private:
+    void updateModelsParallelly(uint32_t stamp);
+
     ccstd::string _name;
     uint64_t _modelId{0};
     IntrusivePtr<DirectionalLight> _mainLight;
@@ -123,7 +136,10 @@ private:
     ccstd::vector<IntrusivePtr<SphereLight>> _sphereLights;
     ccstd::vector<IntrusivePtr<SpotLight>> _spotLights;
     ccstd::vector<DrawBatch2D *> _batches;
+    ccstd::vector<Model *> _parallelModels;
     Octree *_octree{nullptr};
+    WorldBoundsSoA _worldBoundsSoA;
+    bool _parallelUpdateEnabled{false};
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(RenderScene);
 };
@@ -0,0 +1,112 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "scene/WorldBoundsSoA.h"
+#include "core/geometry/AABB.h"
+#include "core/geometry/Frustum.h"
+#include "math/MathUtil.h"
+
+namespace cc {
+namespace scene {
+
+namespace {
+constexpr uint32_t SOA_LANE_COUNT{4}; // capacity is kept a multiple of the SIMD width
+constexpr uint32_t SOA_INITIAL_CAPACITY{256};
+} // namespace
+
+uint32_t WorldBoundsSoA::allocate() {
+    if (_freeSlots.empty()) {
+        grow();
+    }
+    const uint32_t slot = _freeSlots.back();
+    _freeSlots.pop_back();
+    return slot;
+}
+
+void WorldBoundsSoA::free(uint32_t slot) {
+    CC_ASSERT(slot < getCapacity());
+    update(slot, nullptr);
+    _freeSlots.emplace_back(slot);
+}
+
+void WorldBoundsSoA::update(uint32_t slot, const geometry::AABB *bounds) {
+    if (bounds) {
+        _data[0][slot] = bounds->center.x;
+        _data[1][slot] = bounds->center.y;
+        _data[2][slot] = bounds->center.z;
+        _data[3][slot] = bounds->halfExtents.x;
+        _data[4][slot] = bounds->halfExtents.y;
+        _data[5][slot] = bounds->halfExtents.z;
+    } else {
+        for (auto &data : _data) {
+            data[slot] = 0.0F;
+        }
+    }
+}
+
+void WorldBoundsSoA::clear() {
+    for (auto &data : _data) {
+        data.clear();
+    }
+    _freeSlots.clear();
+}
+
+void WorldBoundsSoA::cull(const geometry::Frustum &frustum, ccstd::vector<uint32_t> &visibility) const {
+    float planes[6 * 4];
+    for (uint32_t i = 0; i < 6; ++i) {
+        const auto *plane = frustum.planes[i];
+        planes[i * 4 + 0] = plane->n.x;
+        planes[i * 4 + 1] = plane->n.y;
+        planes[i * 4 + 2] = plane->n.z;
+        planes[i * 4 + 3] = plane->d;
+    }
+
+    const float *boxes[6];
+    for (uint32_t i = 0; i < 6; ++i) {
+        boxes[i] = _data[i].data();
+    }
+
+    const uint32_t capacity = getCapacity();
+    visibility.resize((capacity + 31) / 32);
+    if (capacity > 0) {
+        MathUtil::aabbPlanesSoA(boxes, capacity, planes, 6, visibility.data());
+    }
+}
+
+void WorldBoundsSoA::grow() {
+    const uint32_t capacity = getCapacity();
+    const uint32_t newCapacity = capacity ? capacity * 2 : SOA_INITIAL_CAPACITY;
+    static_assert(SOA_INITIAL_CAPACITY % SOA_LANE_COUNT == 0, "capacity must be a multiple of the SIMD width");
+    for (auto &data : _data) {
+        data.resize(newCapacity, 0.0F);
+    }
+    // hand out the lower slots first to keep the live range compact
+    for (uint32_t slot = newCapacity; slot > capacity; --slot) {
+        _freeSlots.emplace_back(slot - 1);
+    }
+}
+
+} // namespace scene
+} // namespace cc
@@ -0,0 +1,81 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/std/container/array.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+namespace geometry {
+class AABB;
+class Frustum;
+} // namespace geometry
+
+namespace scene {
+
+/**
+ * World bounds of the models in a render scene stored as structure of arrays,
+ * so that they can be culled in batches with the SIMD kernels of MathUtil.
+ * Each model owns a slot while it is attached to the scene.
+ */
+class CC_DLL WorldBoundsSoA final {
+public:
+    static constexpr uint32_t INVALID_SLOT{0xFFFFFFFF};
+
+    WorldBoundsSoA() = default;
+    ~WorldBoundsSoA() = default;
+
+    uint32_t allocate();
+    void free(uint32_t slot);
+    void update(uint32_t slot, const geometry::AABB *bounds);
+    void clear();
+
+    /**
+     * Tests all the slots against the frustum, bit `slot` of visibility is set if the bounds are visible.
+     * The result of a free slot or a slot without bounds is undefined.
+     */
+    void cull(const geometry::Frustum &frustum, ccstd::vector<uint32_t> &visibility) const;
+
+    static inline bool isVisible(const ccstd::vector<uint32_t> &visibility, uint32_t slot) {
+        return (visibility[slot >> 5] >> (slot & 31)) & 1U;
+    }
+
+    inline uint32_t getCapacity() const { return static_cast<uint32_t>(_data[0].size()); }
+
+private:
+    void grow();
+
+    // center x, y, z and half extents x, y, z
+    ccstd::array<ccstd::vector<float>, 6> _data;
+    ccstd::vector<uint32_t> _freeSlots;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(WorldBoundsSoA);
+};
+
+} // namespace scene
+} // namespace cc
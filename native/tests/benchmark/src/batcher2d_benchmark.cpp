@@ -0,0 +1,120 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <cmath>
+#include "2d/renderer/Batcher2d.h"
+#include "2d/renderer/RenderDrawInfo.h"
+#include "benchmark/benchmark.h"
+#include "core/Root.h"
+#include "core/scene-graph/Node.h"
+#include "math/MathUtil.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+void buildUITree(Node *parent, int64_t depth, int64_t branches) { // NOLINT(misc-no-recursion)
+    if (depth == 0) {
+        return;
+    }
+    for (int64_t i = 0; i < branches; ++i) {
+        auto *child = new Node();
+        child->setActiveInHierarchy(true);
+        child->setPosition(bench::randomVec3(-100.F, 100.F));
+        parent->addChild(child);
+        buildUITree(child, depth - 1, branches);
+    }
+}
+
+// Hierarchy traversal of Batcher2d::update. The render entities and draw infos are
+// created by the script side, so only the walk itself is measured here.
+void batcher2dWalk(benchmark::State &state) {
+    Batcher2d batcher{Root::getInstance()};
+    batcher.initialize();
+
+    IntrusivePtr<Node> root = new Node("canvas");
+    root->setActiveInHierarchy(true);
+    buildUITree(root, state.range(0), 6);
+    batcher.syncRootNodesToNative({root.get()});
+
+    for (auto _ : state) {
+        batcher.update();
+        batcher.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(std::pow(6, state.range(0))));
+}
+BENCHMARK(batcher2dWalk)->DenseRange(3, 5)->Unit(benchmark::kMicrosecond);
+
+// The per-vertex fill loops Batcher2d::fillVertexBuffers and fillColors used for quads.
+void batcher2dFillQuads(benchmark::State &state) {
+    constexpr uint32_t STRIDE = sizeof(Render2dLayout) / sizeof(float);
+    const auto quadCount = state.range(0);
+    const auto vertexCount = static_cast<uint32_t>(quadCount * 4);
+    ccstd::vector<float> vertices(vertexCount * STRIDE);
+    ccstd::vector<Vec3> localPositions(vertexCount);
+    for (auto &position : localPositions) {
+        position = bench::randomVec3(-50.F, 50.F);
+    }
+    const Mat4 worldMatrix = bench::randomMat4();
+    const Vec4 color{1.F, 0.5F, 0.25F, 0.8F};
+
+    for (auto _ : state) {
+        float *vbBuffer = vertices.data();
+        for (uint32_t i = 0; i < vertexCount; ++i) {
+            auto *layout = reinterpret_cast<Render2dLayout *>(vbBuffer + i * STRIDE);
+            layout->position.transformMat4(localPositions[i], worldMatrix);
+            layout->color = color;
+        }
+        benchmark::DoNotOptimize(vertices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * quadCount);
+}
+BENCHMARK(batcher2dFillQuads)->RangeMultiplier(8)->Range(64, 32768);
+
+// The same fills through the MathUtil batch kernels.
+void batcher2dFillQuadsBatched(benchmark::State &state) {
+    constexpr uint32_t STRIDE = sizeof(Render2dLayout) / sizeof(float);
+    const auto quadCount = state.range(0);
+    const auto vertexCount = static_cast<uint32_t>(quadCount * 4);
+    ccstd::vector<float> vertices(vertexCount * STRIDE);
+    ccstd::vector<Vec3> localPositions(vertexCount);
+    for (auto &position : localPositions) {
+        position = bench::randomVec3(-50.F, 50.F);
+    }
+    const Mat4 worldMatrix = bench::randomMat4();
+    const Vec4 color{1.F, 0.5F, 0.25F, 0.8F};
+
+    for (auto _ : state) {
+        float *vbBuffer = vertices.data();
+        MathUtil::transformPositions(worldMatrix.m, localPositions.data(), sizeof(Vec3), vbBuffer, STRIDE * sizeof(float), vertexCount);
+        MathUtil::fillStrided(&color.x, vbBuffer + 5, STRIDE * sizeof(float), vertexCount);
+        benchmark::DoNotOptimize(vertices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * quadCount);
+}
+BENCHMARK(batcher2dFillQuadsBatched)->RangeMultiplier(8)->Range(64, 32768);
+
+} // namespace
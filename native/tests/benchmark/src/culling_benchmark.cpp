@@ -0,0 +1,197 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "benchmark/benchmark.h"
+#include "core/Root.h"
+#include "core/assets/RenderingSubMesh.h"
+#include "core/scene-graph/Node.h"
+#include "renderer/pipeline/SceneCulling.h"
+#include "scene/Camera.h"
+#include "scene/Model.h"
+#include "scene/Octree.h"
+#include "scene/WorldBoundsSoA.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr float SCENE_EXTENT = 500.F;
+
+struct CullingScene {
+    explicit CullingScene(int64_t count) {
+        bench::createFrustum(&frustum, SCENE_EXTENT);
+        camera = ccnew scene::Camera(Root::getInstance()->getDevice());
+        camera->setVisibility(0xFFFFFFFF);
+
+        scene::OctreeInfo info;
+        info.setEnabled(true);
+        info.setMinPos({-SCENE_EXTENT, -SCENE_EXTENT, -SCENE_EXTENT});
+        info.setMaxPos({SCENE_EXTENT, SCENE_EXTENT, SCENE_EXTENT});
+        octree.initialize(info);
+
+        models.reserve(count);
+        for (int64_t i = 0; i < count; ++i) {
+            auto *node = new Node();
+            node->setPosition(bench::randomVec3(-SCENE_EXTENT * 0.9F, SCENE_EXTENT * 0.9F));
+            nodes.emplace_back(node);
+
+            auto *model = ccnew scene::Model();
+            model->initialize();
+            model->setNode(node);
+            model->setTransform(node);
+            const Vec3 halfExtents = bench::randomVec3(0.5F, 5.F);
+            model->createBoundingShape(-halfExtents, halfExtents);
+            model->updateTransform(0);
+            models.emplace_back(model);
+
+            octree.insert(model);
+            const auto slot = worldBounds.allocate();
+            worldBounds.update(slot, model->getWorldBounds());
+        }
+    }
+
+    ~CullingScene() {
+        for (auto &model : models) {
+            model->destroy();
+        }
+    }
+
+    geometry::Frustum frustum;
+    IntrusivePtr<scene::Camera> camera;
+    scene::Octree octree;
+    scene::WorldBoundsSoA worldBounds;
+    ccstd::vector<IntrusivePtr<Node>> nodes;
+    ccstd::vector<IntrusivePtr<scene::Model>> models;
+};
+
+void octreeQueryVisibility(benchmark::State &state) {
+    CullingScene scene{state.range(0)};
+    ccstd::vector<scene::Model *> results;
+    for (auto _ : state) {
+        results.clear();
+        scene.octree.queryVisibility(scene.camera, scene.frustum, false, results);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.counters["visible"] = static_cast<double>(results.size());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(octreeQueryVisibility)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
+
+void octreeUpdate(benchmark::State &state) {
+    CullingScene scene{state.range(0)};
+    for (auto _ : state) {
+        for (auto &model : scene.models) {
+            model->getTransform()->setPosition(bench::randomVec3(-SCENE_EXTENT * 0.9F, SCENE_EXTENT * 0.9F));
+            model->updateTransform(0);
+            scene.octree.update(model);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(octreeUpdate)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
+
+// Models moving a little every frame mostly stay in their nodes and are refit in place.
+void octreeUpdateSmallMoves(benchmark::State &state) {
+    CullingScene scene{state.range(0)};
+    for (auto _ : state) {
+        for (auto &model : scene.models) {
+            auto *transform = model->getTransform();
+            constexpr float LIMIT = SCENE_EXTENT * 0.9F;
+            Vec3 position = transform->getPosition() + bench::randomVec3(-0.5F, 0.5F);
+            position.clamp({-LIMIT, -LIMIT, -LIMIT}, {LIMIT, LIMIT, LIMIT});
+            transform->setPosition(position);
+            model->updateTransform(0);
+            scene.octree.update(model);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(octreeUpdateSmallMoves)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
+
+// The per model test sceneCulling falls back to without the octree.
+void sceneCullingPerModel(benchmark::State &state) {
+    CullingScene scene{state.range(0)};
+    ccstd::vector<scene::Model *> results;
+    for (auto _ : state) {
+        results.clear();
+        for (auto &model : scene.models) {
+            if (model->getWorldBounds()->aabbFrustum(scene.frustum)) {
+                results.emplace_back(model);
+            }
+        }
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.counters["visible"] = static_cast<double>(results.size());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(sceneCullingPerModel)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
+
+// The batched SoA test used by sceneCulling for the camera and the shadow casters.
+void sceneCullingSoA(benchmark::State &state) {
+    CullingScene scene{state.range(0)};
+    ccstd::vector<uint32_t> visibility;
+    for (auto _ : state) {
+        scene.worldBounds.cull(scene.frustum, visibility);
+        benchmark::DoNotOptimize(visibility.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(sceneCullingSoA)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
+
+// The per-cluster test of one clustered mesh spread over the scene, with cone culling.
+void clusterCulling(benchmark::State &state) {
+    const auto count = static_cast<uint32_t>(state.range(0));
+    ccstd::vector<IMeshCluster> clusters(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        auto &cluster = clusters[i];
+        cluster.firstIndex = i * 192;
+        cluster.indexCount = 192;
+        cluster.center = bench::randomVec3(-SCENE_EXTENT * 0.9F, SCENE_EXTENT * 0.9F);
+        cluster.halfExtents = bench::randomVec3(0.5F, 5.F);
+        cluster.radius = cluster.halfExtents.length();
+        cluster.coneAxis = bench::randomVec3(-1.F, 1.F).getNormalized();
+        cluster.coneCutoff = 0.5F;
+    }
+    IntrusivePtr<RenderingSubMesh> subMesh = ccnew RenderingSubMesh({}, {}, gfx::PrimitiveMode::TRIANGLE_LIST);
+    subMesh->setClusters(clusters);
+
+    geometry::Frustum frustum;
+    bench::createFrustum(&frustum, SCENE_EXTENT);
+    gfx::DrawInfo whole;
+    whole.indexCount = count * 192;
+    const Vec3 eye = Vec3::ZERO;
+    ccstd::vector<gfx::DrawInfo> drawInfos;
+    uint32_t visibleCount = 0;
+    for (auto _ : state) {
+        visibleCount = pipeline::clusterCulling(subMesh->getClusters(), subMesh->getClusterBounds(), Mat4::IDENTITY, frustum, &eye, whole, drawInfos);
+        benchmark::DoNotOptimize(drawInfos.data());
+    }
+    state.counters["visible"] = static_cast<double>(visibleCount);
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(clusterCulling)->RangeMultiplier(10)->Range(100, 10000)->Unit(benchmark::kMicrosecond);
+
+} // namespace
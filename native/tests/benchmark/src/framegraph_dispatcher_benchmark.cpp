@@ -0,0 +1,288 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "benchmark/benchmark.h"
+#include "cocos/renderer/pipeline/custom/TransientAliasing.h"
+#include "cocos/renderer/pipeline/custom/test/test.h"
+#include "gfx-base/GFXDef-common.h"
+#include "gfx-base/GFXDevice.h"
+#include "gfx-base/GFXTexture.h"
+
+using namespace cc::render;
+using cc::gfx::AccessFlagBit;
+using cc::gfx::Format;
+using cc::gfx::SampleCount;
+using cc::gfx::ShaderStageFlagBit;
+using cc::gfx::TextureFlagBit;
+using cc::gfx::TextureUsageBit;
+
+namespace {
+
+// `depth` layers of `width` raster passes, every pass reads two outputs of the previous layer.
+// The last layer is resolved into an external target which is presented.
+void fillSyntheticGraph(uint32_t width, uint32_t depth, RenderGraph &renderGraph, ResourceGraph &rescGraph, LayoutGraphData &layoutGraphData) {
+    const ResourceDesc desc{ResourceDimension::TEXTURE2D, 4, 960, 640, 1, 0, Format::RGBA8, SampleCount::ONE, TextureFlagBit::NONE, ResourceFlags::SAMPLED | ResourceFlags::COLOR_ATTACHMENT};
+    const ResourceStates states{AccessFlagBit::FRAGMENT_SHADER_READ_TEXTURE | AccessFlagBit::COLOR_ATTACHMENT_WRITE};
+
+    ResourceInfo resources;
+    ViewInfo rasterData;
+    LayoutInfo layoutInfo;
+    const auto resourceName = [width](uint32_t layer, uint32_t index) {
+        return string{std::to_string(layer * width + index)};
+    };
+    const auto nameID = [](const string &name) {
+        return static_cast<uint32_t>(std::stoul(name.c_str()));
+    };
+
+    for (uint32_t layer = 0; layer < depth; ++layer) {
+        for (uint32_t index = 0; index < width; ++index) {
+            const auto output = resourceName(layer, index);
+            resources.emplace_back(output, desc, ResourceTraits{ResourceResidency::MANAGED}, states);
+
+            vector<string> inputs;
+            if (layer > 0) {
+                inputs.emplace_back(resourceName(layer - 1, index));
+                inputs.emplace_back(resourceName(layer - 1, (index + 1) % width));
+            }
+            vector<LayoutUnit> layout;
+            for (const auto &input : inputs) {
+                layout.emplace_back(input, nameID(input), ShaderStageFlagBit::FRAGMENT);
+            }
+            layout.emplace_back(output, nameID(output), ShaderStageFlagBit::VERTEX);
+
+            rasterData.push_back({PassType::RASTER, {{inputs, {output}}}});
+            layoutInfo.emplace_back(std::move(layout));
+        }
+    }
+
+    const string target{std::to_string(width * depth)};
+    resources.emplace_back(target, desc, ResourceTraits{ResourceResidency::EXTERNAL}, states);
+    vector<string> lastLayer;
+    vector<LayoutUnit> resolveLayout;
+    for (uint32_t index = 0; index < width; ++index) {
+        lastLayer.emplace_back(resourceName(depth - 1, index));
+        resolveLayout.emplace_back(lastLayer.back(), nameID(lastLayer.back()), ShaderStageFlagBit::FRAGMENT);
+    }
+    resolveLayout.emplace_back(target, nameID(target), ShaderStageFlagBit::VERTEX);
+    rasterData.push_back({PassType::RASTER, {{lastLayer, {target}}}});
+    layoutInfo.emplace_back(std::move(resolveLayout));
+
+    rasterData.push_back({PassType::PRESENT, {{{target}, {}}}});
+    layoutInfo.push_back({{target, nameID(target), ShaderStageFlagBit::FRAGMENT}});
+
+    fillTestGraph(rasterData, resources, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+}
+
+void frameGraphDispatcherRun(benchmark::State &state) {
+    boost::container::pmr::memory_resource *resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+    fillSyntheticGraph(static_cast<uint32_t>(state.range(0)), static_cast<uint32_t>(state.range(1)), renderGraph, rescGraph, layoutGraphData);
+
+    for (auto _ : state) {
+        FrameGraphDispatcher fgDispatcher(rescGraph, renderGraph, layoutGraphData, resource, resource);
+        fgDispatcher.run();
+        benchmark::DoNotOptimize(fgDispatcher.getBarriers());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(num_vertices(renderGraph)));
+}
+BENCHMARK(frameGraphDispatcherRun)
+    ->Args({1, 8})
+    ->Args({4, 8})
+    ->Args({4, 32})
+    ->Args({16, 32})
+    ->Unit(benchmark::kMicrosecond);
+
+// The hand written graph of the dispatcher unit tests, subpasses and culled passes included.
+void frameGraphDispatcherRunTestCase(benchmark::State &state) {
+    TEST_CASE_4;
+
+    boost::container::pmr::memory_resource *resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+    fillTestGraph(rasterData, resources, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    for (auto _ : state) {
+        FrameGraphDispatcher fgDispatcher(rescGraph, renderGraph, layoutGraphData, resource, resource);
+        fgDispatcher.run();
+        benchmark::DoNotOptimize(fgDispatcher.getBarriers());
+    }
+}
+BENCHMARK(frameGraphDispatcherRunTestCase)->Unit(benchmark::kMicrosecond);
+
+// Render targets and passes described by name, each pass renders into its own targets.
+struct GraphDescription {
+    void addTarget(const char *name, Format format, uint32_t width, uint32_t height, ResourceResidency residency = ResourceResidency::MANAGED) {
+        const auto flags = format == Format::DEPTH_STENCIL ? ResourceFlags::DEPTH_STENCIL_ATTACHMENT : ResourceFlags::COLOR_ATTACHMENT;
+        const ResourceDesc desc{ResourceDimension::TEXTURE2D, 4, width, height, 1, 1, format, SampleCount::ONE, TextureFlagBit::NONE, flags | ResourceFlags::SAMPLED};
+        resources.emplace_back(string{name}, desc, ResourceTraits{residency}, ResourceStates{AccessFlagBit::FRAGMENT_SHADER_READ_TEXTURE | AccessFlagBit::COLOR_ATTACHMENT_WRITE});
+    }
+    void addPass(const vector<string> &inputs, const vector<string> &outputs) {
+        vector<LayoutUnit> layout;
+        for (const auto &name : inputs) {
+            layout.emplace_back(name, nameID(name), ShaderStageFlagBit::FRAGMENT);
+        }
+        for (const auto &name : outputs) {
+            layout.emplace_back(name, nameID(name), ShaderStageFlagBit::FRAGMENT);
+        }
+        rasterData.push_back({PassType::RASTER, {{inputs, outputs}}});
+        layoutInfo.emplace_back(std::move(layout));
+    }
+    void present(const string &name) {
+        rasterData.push_back({PassType::PRESENT, {{{name}, {}}}});
+        layoutInfo.push_back({{name, nameID(name), ShaderStageFlagBit::FRAGMENT}});
+    }
+    uint32_t nameID(const string &name) const {
+        auto iter = std::find_if(resources.begin(), resources.end(), [&](const auto &resource) {
+            return std::get<0>(resource) == name;
+        });
+        return static_cast<uint32_t>(iter - resources.begin());
+    }
+
+    ResourceInfo resources;
+    ViewInfo rasterData;
+    LayoutInfo layoutInfo;
+};
+
+constexpr uint32_t SCREEN_WIDTH = 1280;
+constexpr uint32_t SCREEN_HEIGHT = 720;
+constexpr uint32_t SHADOW_MAP_SIZE = 2048;
+constexpr uint32_t BLOOM_ITERATIONS = 3;
+
+// Same passes and targets as buildShadowPass, buildBloomPasses and buildPostprocessPass in define.ts
+void addShadowPass(GraphDescription &graph) {
+    graph.addTarget("ShadowMap", Format::RGBA8, SHADOW_MAP_SIZE, SHADOW_MAP_SIZE);
+    graph.addTarget("ShadowMapDepth", Format::DEPTH_STENCIL, SHADOW_MAP_SIZE, SHADOW_MAP_SIZE);
+    graph.addPass({}, {"ShadowMap", "ShadowMapDepth"});
+}
+
+void addPostprocessPasses(GraphDescription &graph, const string &input) {
+    uint32_t width = SCREEN_WIDTH >> 1;
+    uint32_t height = SCREEN_HEIGHT >> 1;
+    graph.addTarget("BloomPrefilter", Format::RGBA8, width, height);
+    graph.addTarget("BloomPrefilterDS", Format::DEPTH_STENCIL, width, height);
+    graph.addPass({input}, {"BloomPrefilter", "BloomPrefilterDS"});
+
+    string prev{"BloomPrefilter"};
+    for (uint32_t i = 0; i != BLOOM_ITERATIONS; ++i) {
+        width >>= 1;
+        height >>= 1;
+        const string name{("BloomDownSample" + std::to_string(i)).c_str()};
+        const string ds{(name + "DS").c_str()};
+        graph.addTarget(name.c_str(), Format::RGBA8, width, height);
+        graph.addTarget(ds.c_str(), Format::DEPTH_STENCIL, width, height);
+        graph.addPass({prev}, {name, ds});
+        prev = name;
+    }
+    for (uint32_t i = 0; i != BLOOM_ITERATIONS; ++i) {
+        width <<= 1;
+        height <<= 1;
+        const string name{("BloomUpSample" + std::to_string(BLOOM_ITERATIONS - 1 - i)).c_str()};
+        const string ds{(name + "DS").c_str()};
+        graph.addTarget(name.c_str(), Format::RGBA8, width, height);
+        graph.addTarget(ds.c_str(), Format::DEPTH_STENCIL, width, height);
+        graph.addPass({prev}, {name, ds});
+        prev = name;
+    }
+    graph.addTarget("BloomCombine", Format::RGBA8, SCREEN_WIDTH, SCREEN_HEIGHT);
+    graph.addTarget("BloomCombineDS", Format::DEPTH_STENCIL, SCREEN_WIDTH, SCREEN_HEIGHT);
+    graph.addPass({input, prev}, {"BloomCombine", "BloomCombineDS"});
+
+    graph.addTarget("Backbuffer", Format::RGBA8, SCREEN_WIDTH, SCREEN_HEIGHT, ResourceResidency::EXTERNAL);
+    graph.addTarget("PostprocessDS", Format::DEPTH_STENCIL, SCREEN_WIDTH, SCREEN_HEIGHT);
+    graph.addPass({"BloomCombine"}, {"Backbuffer", "PostprocessDS"});
+    graph.present("Backbuffer");
+}
+
+GraphDescription getForwardGraph() {
+    GraphDescription graph;
+    addShadowPass(graph);
+    graph.addTarget("ForwardColor", Format::RGBA16F, SCREEN_WIDTH, SCREEN_HEIGHT);
+    graph.addTarget("ForwardDS", Format::DEPTH_STENCIL, SCREEN_WIDTH, SCREEN_HEIGHT);
+    graph.addPass({"ShadowMap"}, {"ForwardColor", "ForwardDS"});
+    addPostprocessPasses(graph, "ForwardColor");
+    return graph;
+}
+
+GraphDescription getDeferredGraph() {
+    GraphDescription graph;
+    addShadowPass(graph);
+    graph.addTarget("GBufferAlbedo", Format::RGBA16F, SCREEN_WIDTH, SCREEN_HEIGHT);
+    graph.addTarget("GBufferNormal", Format::RGBA16F, SCREEN_WIDTH, SCREEN_HEIGHT);
+    graph.addTarget("GBufferEmissive", Format::RGBA16F, SCREEN_WIDTH, SCREEN_HEIGHT);
+    graph.addTarget("GBufferDS", Format::DEPTH_STENCIL, SCREEN_WIDTH, SCREEN_HEIGHT);
+    graph.addPass({}, {"GBufferAlbedo", "GBufferNormal", "GBufferEmissive", "GBufferDS"});
+    graph.addTarget("LightingColor", Format::RGBA8, SCREEN_WIDTH, SCREEN_HEIGHT);
+    graph.addTarget("LightingDS", Format::DEPTH_STENCIL, SCREEN_WIDTH, SCREEN_HEIGHT);
+    graph.addPass({"ShadowMap", "GBufferAlbedo", "GBufferNormal", "GBufferEmissive", "GBufferDS"}, {"LightingColor", "LightingDS"});
+    addPostprocessPasses(graph, "LightingColor");
+    return graph;
+}
+
+// Texture memory of the transient targets reported by the device (gfx-empty when run headless).
+uint32_t getMountedTextureSize(const ResourceGraph &rescGraph, const TransientAliasing &aliasing, bool aliased) {
+    auto *device = cc::gfx::Device::getInstance();
+    const auto before = device->getMemoryStatus().textureSize;
+    vector<cc::IntrusivePtr<cc::gfx::Texture>> textures;
+    for (const auto vertID : makeRange(vertices(rescGraph))) {
+        const auto &desc = get(ResourceGraph::DescTag{}, rescGraph, vertID);
+        if (get(ResourceGraph::TraitsTag{}, rescGraph, vertID).residency != ResourceResidency::MANAGED ||
+            (aliased && aliasing.aliasedResources.count(vertID))) {
+            continue;
+        }
+        const auto usage = desc.format == Format::DEPTH_STENCIL ? TextureUsageBit::DEPTH_STENCIL_ATTACHMENT : TextureUsageBit::COLOR_ATTACHMENT;
+        textures.emplace_back(device->createTexture({cc::gfx::TextureType::TEX2D, usage | TextureUsageBit::SAMPLED, desc.format, desc.width, desc.height}));
+    }
+    return device->getMemoryStatus().textureSize - before;
+}
+
+// Transient target memory of the builtin forward and deferred graphs, without and with aliasing.
+void frameGraphTransientMemory(benchmark::State &state, GraphDescription (*getGraph)()) {
+    boost::container::pmr::memory_resource *resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+    const auto graph = getGraph();
+    fillTestGraph(graph.rasterData, graph.resources, graph.layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    TransientAliasing aliasing(resource);
+    for (auto _ : state) {
+        FrameGraphDispatcher fgDispatcher(rescGraph, renderGraph, layoutGraphData, resource, resource);
+        fgDispatcher.enableMemoryAliasing(true);
+        fgDispatcher.run();
+        aliasTransientResources(fgDispatcher, aliasing);
+        benchmark::DoNotOptimize(fgDispatcher.getBarriers());
+    }
+    state.counters["transientBytes"] = static_cast<double>(aliasing.transientMemorySize);
+    state.counters["aliasedTransientBytes"] = static_cast<double>(aliasing.aliasedTransientMemorySize);
+    state.counters["textureSize"] = getMountedTextureSize(rescGraph, aliasing, false);
+    state.counters["aliasedTextureSize"] = getMountedTextureSize(rescGraph, aliasing, true);
+}
+BENCHMARK_CAPTURE(frameGraphTransientMemory, forward, &getForwardGraph)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(frameGraphTransientMemory, deferred, &getDeferredGraph)->Unit(benchmark::kMicrosecond);
+
+} // namespace
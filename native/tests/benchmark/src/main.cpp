@@ -0,0 +1,73 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <cstring>
+#include "benchmark/benchmark.h"
+#include "bindings/jswrapper/SeApi.h"
+#include "core/Root.h"
+#include "renderer/GFXDeviceManager.h"
+
+using namespace cc;
+using namespace cc::gfx;
+
+// Fix linking error of undefined symbol cocos_main
+int cocos_main(int argc, const char **argv) {
+    return 0;
+}
+
+int main(int argc, const char *argv[]) {
+    // Emit json by default so that the results can be compared between engine versions.
+    ccstd::vector<char *> args;
+    bool hasOutput = false;
+    for (int i = 0; i < argc; ++i) {
+        args.emplace_back(const_cast<char *>(argv[i]));
+        hasOutput |= strncmp(argv[i], "--benchmark_out=", 16) == 0;
+    }
+    char defaultOutput[] = "--benchmark_out=cocos_benchmarks.json";
+    char defaultFormat[] = "--benchmark_out_format=json";
+    if (!hasOutput) {
+        args.emplace_back(defaultOutput);
+        args.emplace_back(defaultFormat);
+    }
+    auto argCount = static_cast<int>(args.size());
+
+    ::benchmark::Initialize(&argCount, args.data());
+    if (::benchmark::ReportUnrecognizedArguments(argCount, args.data())) {
+        return 1;
+    }
+
+    Root *root = new Root(DeviceManager::create());
+    se::ScriptEngine *scriptEngine = new se::ScriptEngine();
+    scriptEngine->start();
+    {
+        se::AutoHandleScope hs;
+        ::benchmark::RunSpecifiedBenchmarks();
+        ::benchmark::Shutdown();
+    }
+    scriptEngine->cleanup();
+    delete root;
+    delete scriptEngine;
+    return 0;
+}
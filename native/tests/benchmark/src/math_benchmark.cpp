@@ -0,0 +1,231 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include "base/Utils.h"
+#include "benchmark/benchmark.h"
+#include "math/Mat4.h"
+#include "math/MathUtil.h"
+#include "math/Quaternion.h"
+#include "math/Vec3.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr int64_t MIN_COUNT = 64;
+constexpr int64_t MAX_COUNT = 4096;
+
+// Plain scalar reference, the baseline of the SIMD paths selected by MathUtil.
+void multiplyMatrixScalar(const float *m1, const float *m2, float *dst) {
+    float product[16];
+    for (int col = 0; col < 4; ++col) {
+        for (int row = 0; row < 4; ++row) {
+            product[col * 4 + row] = m1[row] * m2[col * 4] + m1[4 + row] * m2[col * 4 + 1] +
+                                     m1[8 + row] * m2[col * 4 + 2] + m1[12 + row] * m2[col * 4 + 3];
+        }
+    }
+    memcpy(dst, product, sizeof(product));
+}
+
+ccstd::vector<Mat4> randomMatrices(int64_t count) {
+    ccstd::vector<Mat4> matrices(count);
+    for (auto &mat : matrices) {
+        mat = bench::randomMat4();
+    }
+    return matrices;
+}
+
+void mat4Multiply(benchmark::State &state) {
+    const auto matrices = randomMatrices(state.range(0));
+    Mat4 result;
+    for (auto _ : state) {
+        for (const auto &mat : matrices) {
+            Mat4::multiply(result, mat, &result);
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(mat4Multiply)->RangeMultiplier(4)->Range(MIN_COUNT, MAX_COUNT);
+
+void mat4MultiplyScalar(benchmark::State &state) {
+    const auto matrices = randomMatrices(state.range(0));
+    Mat4 result;
+    for (auto _ : state) {
+        for (const auto &mat : matrices) {
+            multiplyMatrixScalar(result.m, mat.m, result.m);
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(mat4MultiplyScalar)->RangeMultiplier(4)->Range(MIN_COUNT, MAX_COUNT);
+
+void jointPalette(benchmark::State &state) {
+    const auto worlds = randomMatrices(state.range(0));
+    const auto bindposes = randomMatrices(state.range(0));
+    ccstd::vector<float> palette(state.range(0) * 12);
+    for (auto _ : state) {
+        MathUtil::multiplyAffine3x4(worlds[0].m, bindposes[0].m, static_cast<uint32_t>(state.range(0)), palette.data());
+        benchmark::DoNotOptimize(palette.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(jointPalette)->RangeMultiplier(4)->Range(MIN_COUNT, MAX_COUNT);
+
+void floatToHalf(benchmark::State &state) {
+    ccstd::vector<float> values(state.range(0) * 4);
+    for (auto &value : values) {
+        value = bench::randomFloat(-100.F, 100.F);
+    }
+    ccstd::vector<uint16_t> halves(values.size());
+    for (auto _ : state) {
+        MathUtil::floatToHalf(values.data(), static_cast<uint32_t>(values.size()), halves.data());
+        benchmark::DoNotOptimize(halves.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+}
+BENCHMARK(floatToHalf)->RangeMultiplier(4)->Range(MIN_COUNT, MAX_COUNT);
+
+void floatToHalfScalar(benchmark::State &state) {
+    ccstd::vector<float> values(state.range(0) * 4);
+    for (auto &value : values) {
+        value = bench::randomFloat(-100.F, 100.F);
+    }
+    ccstd::vector<uint16_t> halves(values.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < values.size(); ++i) {
+            halves[i] = utils::rawHalfAsUint16(utils::floatToHalf(values[i]));
+        }
+        benchmark::DoNotOptimize(halves.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+}
+BENCHMARK(floatToHalfScalar)->RangeMultiplier(4)->Range(MIN_COUNT, MAX_COUNT);
+
+// Not a timing, checks MathUtil::floatToHalf against the scalar conversion for all 2^32 float bit patterns.
+// Too slow for the unit tests, which only check a sample of them.
+void floatToHalfAllBitPatterns(benchmark::State &state) {
+    constexpr uint32_t batchSize = 4093; // odd, so that the SIMD loops and their scalar tails are all exercised
+    ccstd::vector<float> values(batchSize);
+    ccstd::vector<uint16_t> halves(batchSize);
+    uint64_t mismatches = 0;
+    for (auto _ : state) {
+        mismatches = 0;
+        for (uint64_t begin = 0; begin < (1ULL << 32); begin += batchSize) {
+            const auto count = static_cast<uint32_t>(std::min<uint64_t>(batchSize, (1ULL << 32) - begin));
+            for (uint32_t i = 0; i < count; ++i) {
+                const auto bits = static_cast<uint32_t>(begin + i);
+                memcpy(&values[i], &bits, sizeof(bits));
+            }
+            MathUtil::floatToHalf(values.data(), count, halves.data());
+            for (uint32_t i = 0; i < count; ++i) {
+                if (halves[i] != utils::rawHalfAsUint16(utils::floatToHalf(values[i]))) {
+                    ++mismatches;
+                }
+            }
+        }
+    }
+    state.counters["mismatches"] = static_cast<double>(mismatches);
+    if (mismatches != 0) {
+        state.SkipWithError("MathUtil::floatToHalf differs from utils::floatToHalf");
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(1ULL << 32));
+}
+BENCHMARK(floatToHalfAllBitPatterns)->Iterations(1)->Unit(benchmark::kMillisecond);
+
+void mat4Inverse(benchmark::State &state) {
+    const auto matrices = randomMatrices(state.range(0));
+    Mat4 result;
+    for (auto _ : state) {
+        for (const auto &mat : matrices) {
+            result = mat.getInversed();
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(mat4Inverse)->RangeMultiplier(4)->Range(MIN_COUNT, MAX_COUNT);
+
+void mat4FromRTS(benchmark::State &state) {
+    const auto count = state.range(0);
+    ccstd::vector<Quaternion> rotations(count);
+    ccstd::vector<Vec3> positions(count);
+    for (int64_t i = 0; i < count; ++i) {
+        Quaternion::fromEuler(bench::randomFloat(0.F, 360.F), bench::randomFloat(0.F, 360.F), bench::randomFloat(0.F, 360.F), &rotations[i]);
+        positions[i] = bench::randomVec3(-100.F, 100.F);
+    }
+    const Vec3 scale{1.F, 2.F, 3.F};
+    Mat4 result;
+    for (auto _ : state) {
+        for (int64_t i = 0; i < count; ++i) {
+            Mat4::fromRTS(rotations[i], positions[i], scale, &result);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(mat4FromRTS)->RangeMultiplier(4)->Range(MIN_COUNT, MAX_COUNT);
+
+void vec3TransformMat4(benchmark::State &state) {
+    const auto count = state.range(0);
+    ccstd::vector<Vec3> points(count);
+    for (auto &point : points) {
+        point = bench::randomVec3(-100.F, 100.F);
+    }
+    const Mat4 mat = bench::randomMat4();
+    Vec3 result;
+    for (auto _ : state) {
+        for (const auto &point : points) {
+            Vec3::transformMat4(point, mat, &result);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(vec3TransformMat4)->RangeMultiplier(4)->Range(MIN_COUNT, MAX_COUNT);
+
+void vec3Cross(benchmark::State &state) {
+    const auto count = state.range(0);
+    ccstd::vector<Vec3> vectors(count);
+    for (auto &vec : vectors) {
+        vec = bench::randomVec3(-1.F, 1.F);
+    }
+    Vec3 result{Vec3::UNIT_X};
+    for (auto _ : state) {
+        for (const auto &vec : vectors) {
+            Vec3::cross(result, vec, &result);
+            result.normalize();
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(vec3Cross)->RangeMultiplier(4)->Range(MIN_COUNT, MAX_COUNT);
+
+} // namespace
@@ -0,0 +1,123 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "3d/assets/Mesh.h"
+#include "3d/misc/CreateMesh.h"
+#include "benchmark/benchmark.h"
+#include "core/assets/RenderingSubMesh.h"
+#include "primitive/Sphere.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+// Static batching: merges `count` transformed spheres into one mesh.
+void meshMerge(benchmark::State &state) {
+    ISphereOptions options;
+    options.segments = static_cast<uint32_t>(state.range(1));
+    IntrusivePtr<Mesh> source = MeshUtils::createMesh(sphere(0.5F, options));
+
+    const auto count = state.range(0);
+    ccstd::vector<Mat4> worldMatrices(count);
+    for (auto &worldMatrix : worldMatrices) {
+        Mat4::fromRTS(Quaternion::identity(), bench::randomVec3(-100.F, 100.F), Vec3::ONE, &worldMatrix);
+    }
+
+    for (auto _ : state) {
+        IntrusivePtr<Mesh> merged = ccnew Mesh();
+        for (const auto &worldMatrix : worldMatrices) {
+            merged->merge(source, &worldMatrix);
+        }
+        benchmark::DoNotOptimize(merged->getData().buffer());
+        state.PauseTiming();
+        merged->destroy();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.SetBytesProcessed(state.iterations() * count * static_cast<int64_t>(source->getData().byteLength()));
+}
+BENCHMARK(meshMerge)
+    ->Args({16, 16})
+    ->Args({64, 16})
+    ->Args({256, 16})
+    ->Args({64, 64})
+    ->Unit(benchmark::kMillisecond);
+
+// Same as meshMerge, with a single mergeBatch call.
+void meshMergeBatch(benchmark::State &state) {
+    ISphereOptions options;
+    options.segments = static_cast<uint32_t>(state.range(1));
+    IntrusivePtr<Mesh> source = MeshUtils::createMesh(sphere(0.5F, options));
+
+    const auto count = state.range(0);
+    ccstd::vector<Mat4> worldMatrices(count);
+    for (auto &worldMatrix : worldMatrices) {
+        Mat4::fromRTS(Quaternion::identity(), bench::randomVec3(-100.F, 100.F), Vec3::ONE, &worldMatrix);
+    }
+    const ccstd::vector<Mesh *> meshes(count, source.get());
+    ccstd::vector<const Mat4 *> matrices;
+    for (const auto &worldMatrix : worldMatrices) {
+        matrices.emplace_back(&worldMatrix);
+    }
+
+    for (auto _ : state) {
+        IntrusivePtr<Mesh> merged = ccnew Mesh();
+        merged->mergeBatch(meshes, matrices);
+        benchmark::DoNotOptimize(merged->getData().buffer());
+        state.PauseTiming();
+        merged->destroy();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.SetBytesProcessed(state.iterations() * count * static_cast<int64_t>(source->getData().byteLength()));
+}
+BENCHMARK(meshMergeBatch)
+    ->Args({16, 16})
+    ->Args({64, 16})
+    ->Args({256, 16})
+    ->Args({64, 64})
+    ->Unit(benchmark::kMillisecond);
+
+// Reorders the indices of one sphere into clusters of at most 64 triangles.
+void meshBuildClusters(benchmark::State &state) {
+    ISphereOptions options;
+    options.segments = static_cast<uint32_t>(state.range(0));
+    const IGeometry geometry = sphere(0.5F, options);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        IntrusivePtr<Mesh> mesh = MeshUtils::createMesh(geometry);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(mesh->buildClusters(64));
+        state.PauseTiming();
+        mesh->destroy();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(geometry.indices->size() / 3));
+}
+BENCHMARK(meshBuildClusters)->Arg(16)->Arg(64)->Arg(256)->Unit(benchmark::kMicrosecond);
+
+} // namespace
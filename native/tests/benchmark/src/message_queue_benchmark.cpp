@@ -0,0 +1,95 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <cstring>
+#include "base/std/container/vector.h"
+#include "base/threading/MessageQueue.h"
+#include "benchmark/benchmark.h"
+
+using namespace cc;
+
+namespace {
+
+// Messages per frame, the consumer is drained at the end of every iteration like a frame boundary.
+void messageQueueThroughput(benchmark::State &state) {
+    auto *queue = ccnew MessageQueue;
+    queue->setImmediateMode(false);
+    queue->runConsumerThread();
+
+    const auto count = state.range(0);
+    uint64_t counter = 0;
+    uint64_t *const pCounter = &counter;
+    for (auto _ : state) {
+        for (int64_t i = 0; i < count; ++i) {
+            ENQUEUE_MESSAGE_1(
+                queue, BenchmarkIncrease,
+                pCounter, pCounter,
+                {
+                    ++(*pCounter);
+                });
+        }
+        queue->kickAndWait();
+    }
+    benchmark::DoNotOptimize(counter);
+
+    queue->terminateConsumerThread();
+    delete queue;
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(messageQueueThroughput)->RangeMultiplier(8)->Range(64, 32768)->UseRealTime();
+
+// Messages carrying a payload copied into the queue memory, like buffer updates.
+void messageQueuePayload(benchmark::State &state) {
+    auto *queue = ccnew MessageQueue;
+    queue->setImmediateMode(false);
+    queue->runConsumerThread();
+
+    const auto size = static_cast<uint32_t>(state.range(0));
+    ccstd::vector<uint8_t> source(size, 1);
+    ccstd::vector<uint8_t> destination(size);
+    uint8_t *const pDestination = destination.data();
+    constexpr int64_t MESSAGES_PER_FRAME = 256;
+    for (auto _ : state) {
+        for (int64_t i = 0; i < MESSAGES_PER_FRAME; ++i) {
+            const uint8_t *payload = queue->allocateAndCopy<uint8_t>(size, source.data());
+            ENQUEUE_MESSAGE_3(
+                queue, BenchmarkCopy,
+                dst, pDestination,
+                src, payload,
+                size, size,
+                {
+                    memcpy(dst, src, size);
+                });
+        }
+        queue->kickAndWait();
+    }
+
+    queue->terminateConsumerThread();
+    delete queue;
+    state.SetBytesProcessed(state.iterations() * MESSAGES_PER_FRAME * size);
+}
+BENCHMARK(messageQueuePayload)->RangeMultiplier(4)->Range(64, 16384)->UseRealTime();
+
+} // namespace
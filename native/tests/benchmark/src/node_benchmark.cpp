@@ -0,0 +1,99 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "benchmark/benchmark.h"
+#include "core/Root.h"
+#include "core/scene-graph/Node.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+void buildTree(Node *parent, int64_t depth, int64_t branches, ccstd::vector<Node *> &nodes) { // NOLINT(misc-no-recursion)
+    if (depth == 0) {
+        return;
+    }
+    for (int64_t i = 0; i < branches; ++i) {
+        auto *child = new Node();
+        child->setPosition(bench::randomVec3(-10.F, 10.F));
+        parent->addChild(child);
+        nodes.emplace_back(child);
+        buildTree(child, depth - 1, branches, nodes);
+    }
+}
+
+// Moves the root every frame and reads back every world matrix, leaves first which is
+// the worst case of the lazy update walking up the parent chain.
+void nodeLazyWorldTransform(benchmark::State &state) {
+    IntrusivePtr<Node> root = new Node("root");
+    ccstd::vector<Node *> nodes;
+    buildTree(root, state.range(0), 4, nodes);
+    float offset = 0.F;
+    for (auto _ : state) {
+        root->setPosition(offset, 0.F, 0.F);
+        offset += 1.F;
+        for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+            benchmark::DoNotOptimize((*it)->getWorldMatrix());
+        }
+    }
+    Root::getInstance()->getDirtyNodeList().flush();
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(nodes.size()));
+}
+BENCHMARK(nodeLazyWorldTransform)->DenseRange(3, 7, 2);
+
+void nodeFlushWorldTransforms(benchmark::State &state) {
+    IntrusivePtr<Node> root = new Node("root");
+    ccstd::vector<Node *> nodes;
+    buildTree(root, state.range(0), 4, nodes);
+    float offset = 0.F;
+    for (auto _ : state) {
+        root->setPosition(offset, 0.F, 0.F);
+        offset += 1.F;
+        Root::getInstance()->getDirtyNodeList().flush();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(nodes.size()));
+}
+BENCHMARK(nodeFlushWorldTransforms)->DenseRange(3, 7, 2);
+
+// Only a few leaves move, the propagation cost should not depend on the size of the tree.
+void nodeFlushSparseChanges(benchmark::State &state) {
+    IntrusivePtr<Node> root = new Node("root");
+    ccstd::vector<Node *> nodes;
+    buildTree(root, state.range(0), 4, nodes);
+    Root::getInstance()->getDirtyNodeList().flush();
+    float angle = 0.F;
+    for (auto _ : state) {
+        angle += 1.F;
+        for (size_t i = nodes.size() - 1; i > nodes.size() - 64; --i) {
+            nodes[i]->setRotationFromEuler(0.F, angle, 0.F);
+        }
+        Root::getInstance()->getDirtyNodeList().flush();
+    }
+    state.SetItemsProcessed(state.iterations() * 63);
+}
+BENCHMARK(nodeFlushSparseChanges)->DenseRange(3, 7, 2);
+
+} // namespace
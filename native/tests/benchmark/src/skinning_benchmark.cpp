@@ -0,0 +1,146 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "3d/assets/Mesh.h"
+#include "3d/assets/Skeleton.h"
+#include "3d/misc/CreateMesh.h"
+#include "3d/models/SkinningModel.h"
+#include "benchmark/benchmark.h"
+#include "core/assets/RenderingSubMesh.h"
+#include "core/scene-graph/Node.h"
+#include "renderer/pipeline/Define.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+// Matches the uniform capacity of a device with 128 vertex uniform vectors,
+// skeletons with more joints fall back to the real time joint texture.
+constexpr uint32_t JOINT_UNIFORM_CAPACITY = 30;
+
+struct SkinnedCharacter {
+    explicit SkinnedCharacter(uint32_t jointCount) {
+        if (pipeline::SkinningJointCapacity::jointUniformCapacity == 0) {
+            pipeline::SkinningJointCapacity::jointUniformCapacity = JOINT_UNIFORM_CAPACITY;
+            pipeline::UBOSkinning::initLayout(JOINT_UNIFORM_CAPACITY);
+        }
+
+        root = new Node("root");
+        ccstd::vector<ccstd::string> jointPaths;
+        ccstd::vector<Mat4> bindposes;
+        ccstd::string path;
+        Node *parent = root;
+        for (uint32_t i = 0; i < jointCount; ++i) {
+            // Short chains under the root, like the limbs of a humanoid.
+            if (i % 8 == 0) {
+                parent = root;
+                path.clear();
+            }
+            const ccstd::string name = "joint" + std::to_string(i);
+            auto *joint = new Node(name);
+            joint->setPosition(0.F, 0.1F, 0.F);
+            parent->addChild(joint);
+            parent = joint;
+            path = path.empty() ? name : path + "/" + name;
+            jointPaths.emplace_back(path);
+            joints.emplace_back(joint);
+
+            Mat4 bindpose;
+            Mat4::createTranslation(0.F, -0.1F * static_cast<float>(i % 8 + 1), 0.F, &bindpose);
+            bindposes.emplace_back(bindpose);
+        }
+        skeleton = ccnew Skeleton();
+        skeleton->setJoints(jointPaths);
+        skeleton->setBindposes(bindposes);
+        skeleton->setHash(jointCount);
+
+        // Four vertices bound to every joint.
+        IGeometry geometry;
+        ccstd::vector<float> jointIndices;
+        ccstd::vector<float> weights;
+        for (uint32_t i = 0; i < jointCount * 4; ++i) {
+            const Vec3 position = bench::randomVec3(-1.F, 1.F);
+            geometry.positions.insert(geometry.positions.end(), {position.x, position.y, position.z});
+            jointIndices.insert(jointIndices.end(), {static_cast<float>(i / 4), 0.F, 0.F, 0.F});
+            weights.insert(weights.end(), {1.F, 0.F, 0.F, 0.F});
+        }
+        geometry.customAttributes = ccstd::vector<CustomAttribute>{
+            {gfx::Attribute{gfx::ATTR_NAME_JOINTS, gfx::Format::RGBA32F}, jointIndices},
+            {gfx::Attribute{gfx::ATTR_NAME_WEIGHTS, gfx::Format::RGBA32F}, weights},
+        };
+        mesh = MeshUtils::createMesh(geometry);
+
+        model = ccnew SkinningModel();
+        model->initialize();
+        model->setNode(root);
+        model->bindSkeleton(skeleton, root, mesh);
+    }
+
+    ~SkinnedCharacter() {
+        model->destroy();
+    }
+
+    IntrusivePtr<Node> root;
+    ccstd::vector<Node *> joints;
+    IntrusivePtr<Skeleton> skeleton;
+    IntrusivePtr<Mesh> mesh;
+    IntrusivePtr<SkinningModel> model;
+};
+
+void skinningModelUpdate(benchmark::State &state) {
+    const auto characterCount = state.range(0);
+    const auto jointCount = static_cast<uint32_t>(state.range(1));
+    ccstd::vector<std::unique_ptr<SkinnedCharacter>> characters;
+    for (int64_t i = 0; i < characterCount; ++i) {
+        characters.emplace_back(std::make_unique<SkinnedCharacter>(jointCount));
+    }
+
+    uint32_t stamp = 0;
+    for (auto _ : state) {
+        ++stamp;
+        state.PauseTiming();
+        // Animation sampling is not part of the measurement.
+        for (auto &character : characters) {
+            for (auto *joint : character->joints) {
+                joint->setRotationFromEuler(0.F, static_cast<float>(stamp), 0.F);
+            }
+        }
+        state.ResumeTiming();
+        for (auto &character : characters) {
+            character->model->updateTransform(stamp);
+            character->model->updateUBOs(stamp);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * characterCount * jointCount);
+}
+BENCHMARK(skinningModelUpdate)
+    ->Args({1, 30})
+    ->Args({64, 30})
+    ->Args({64, 60})
+    ->Args({256, 30})
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
@@ -0,0 +1,146 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/std/container/vector.h"
+#include "benchmark/benchmark.h"
+#include "platform/CompressedTextureDecoder.h"
+#include "platform/MipmapGenerator.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr int64_t MIN_SIZE = 256;
+constexpr int64_t MAX_SIZE = 2048;
+
+ccstd::vector<uint8_t> randomBytes(size_t count) {
+    ccstd::vector<uint8_t> bytes(count);
+    for (auto &byte : bytes) {
+        byte = static_cast<uint8_t>(bench::rng()());
+    }
+    return bytes;
+}
+
+void setBits(uint8_t *block, uint32_t offset, uint32_t count, uint32_t value) {
+    for (uint32_t i = 0; i < count; ++i, ++offset) {
+        const auto mask = static_cast<uint8_t>(1U << (offset & 7));
+        block[offset >> 3] = static_cast<uint8_t>(((value >> i) & 1) ? block[offset >> 3] | mask : block[offset >> 3] & ~mask);
+    }
+}
+
+// Random ASTC blocks are mostly invalid, these keep a valid header: a 4x4 grid of 16 levels weights, with one RGBA
+// partition, or two RGB partitions of a random partitioning, and random weights and endpoints.
+ccstd::vector<uint8_t> randomAstcBlocks(size_t count, uint32_t partitionCount) {
+    constexpr uint32_t BLOCK_MODE = 0x242;
+    auto blocks = randomBytes(count * 16);
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t *block = blocks.data() + i * 16;
+        setBits(block, 0, 11, BLOCK_MODE);
+        setBits(block, 11, 2, partitionCount - 1);
+        if (partitionCount == 1) {
+            setBits(block, 13, 4, 12);
+        } else {
+            setBits(block, 23, 6, 8 << 2);
+        }
+    }
+    return blocks;
+}
+
+void decode(benchmark::State &state, gfx::Format format, const ccstd::vector<uint8_t> &blocks, uint32_t size) {
+    ccstd::vector<uint8_t> rgba(size * size * 4);
+    for (auto _ : state) {
+        CompressedTextureDecoder::decode(format, blocks.data(), size, size, rgba.data());
+        benchmark::DoNotOptimize(rgba.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(blocks.size()));
+}
+
+void etc2RGBDecode(benchmark::State &state) {
+    const auto size = static_cast<uint32_t>(state.range(0));
+    decode(state, gfx::Format::ETC2_RGB8, randomBytes(size * size / 2), size);
+}
+BENCHMARK(etc2RGBDecode)->RangeMultiplier(2)->Range(MIN_SIZE, MAX_SIZE)->Unit(benchmark::kMillisecond);
+
+void etc2RGBADecode(benchmark::State &state) {
+    const auto size = static_cast<uint32_t>(state.range(0));
+    decode(state, gfx::Format::ETC2_RGBA8, randomBytes(size * size), size);
+}
+BENCHMARK(etc2RGBADecode)->RangeMultiplier(2)->Range(MIN_SIZE, MAX_SIZE)->Unit(benchmark::kMillisecond);
+
+void astcDecode(benchmark::State &state, gfx::Format format, uint32_t blockSize) {
+    const auto size = static_cast<uint32_t>(state.range(0));
+    const auto partitionCount = static_cast<uint32_t>(state.range(1));
+    const uint32_t blocksPerRow = (size + blockSize - 1) / blockSize;
+    decode(state, format, randomAstcBlocks(blocksPerRow * blocksPerRow, partitionCount), size);
+}
+
+void astcArgs(benchmark::internal::Benchmark *b) {
+    for (int64_t size = MIN_SIZE; size <= MAX_SIZE; size *= 2) {
+        b->Args({size, 1})->Args({size, 2});
+    }
+}
+
+void astc4x4Decode(benchmark::State &state) {
+    astcDecode(state, gfx::Format::ASTC_RGBA_4X4, 4);
+}
+BENCHMARK(astc4x4Decode)->Apply(astcArgs)->Unit(benchmark::kMillisecond);
+
+void astc6x6Decode(benchmark::State &state) {
+    astcDecode(state, gfx::Format::ASTC_RGBA_6X6, 6);
+}
+BENCHMARK(astc6x6Decode)->Apply(astcArgs)->Unit(benchmark::kMillisecond);
+
+void astc8x8Decode(benchmark::State &state) {
+    astcDecode(state, gfx::Format::ASTC_RGBA_8X8, 8);
+}
+BENCHMARK(astc8x8Decode)->Apply(astcArgs)->Unit(benchmark::kMillisecond);
+
+void mipmapArgs(benchmark::internal::Benchmark *b) {
+    for (int64_t size = MIN_SIZE; size <= MAX_SIZE; size *= 2) {
+        for (auto filter : {MipmapGenerator::Filter::BOX, MipmapGenerator::Filter::KAISER, MipmapGenerator::Filter::LANCZOS}) {
+            b->Args({size, static_cast<int64_t>(filter)});
+        }
+    }
+}
+
+void mipmapGenerate(benchmark::State &state) {
+    const auto size = static_cast<uint32_t>(state.range(0));
+    uint32_t chainSize = 0;
+    for (auto levelSize : MipmapGenerator::getMipmapLevelDataSize(size, size)) {
+        chainSize += levelSize;
+    }
+    auto chain = randomBytes(chainSize);
+    const MipmapGenerator::Options options{static_cast<MipmapGenerator::Filter>(state.range(1)), true, false};
+    for (auto _ : state) {
+        MipmapGenerator::generate(chain.data(), size, size, options);
+        benchmark::DoNotOptimize(chain.data());
+    }
+    state.SetBytesProcessed(state.iterations() * size * size * 4);
+}
+BENCHMARK(mipmapGenerate)->Apply(mipmapArgs)->Unit(benchmark::kMillisecond);
+
+} // namespace
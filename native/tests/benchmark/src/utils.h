@@ -0,0 +1,71 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <random>
+#include "core/geometry/AABB.h"
+#include "core/geometry/Frustum.h"
+#include "math/Mat4.h"
+#include "math/Math.h"
+#include "math/Vec3.h"
+
+namespace bench {
+
+// Deterministic inputs so that runs of different engine versions are comparable.
+inline std::mt19937 &rng() {
+    static std::mt19937 engine{20221010};
+    return engine;
+}
+
+inline float randomFloat(float min, float max) {
+    return std::uniform_real_distribution<float>{min, max}(rng());
+}
+
+inline cc::Vec3 randomVec3(float min, float max) {
+    return {randomFloat(min, max), randomFloat(min, max), randomFloat(min, max)};
+}
+
+inline cc::Mat4 randomMat4() {
+    cc::Mat4 out;
+    for (float &value : out.m) {
+        value = randomFloat(-1.F, 1.F);
+    }
+    return out;
+}
+
+// A camera at the origin looking down -z, roughly half of a scene spread in [-extent, extent] is visible.
+inline void createFrustum(cc::geometry::Frustum *frustum, float extent) {
+    cc::Mat4 view;
+    cc::Mat4 proj;
+    cc::Mat4 viewProj;
+    cc::Mat4::createLookAt(cc::Vec3::ZERO, cc::Vec3{0.F, 0.F, -1.F}, cc::Vec3::UNIT_Y, &view);
+    cc::Mat4::createPerspective(cc::math::PI_DIV3, 16.F / 9.F, 0.1F, extent, &proj);
+    cc::Mat4::multiply(proj, view, &viewProj);
+    frustum->setAccurate(true);
+    frustum->update(viewProj, viewProj.getInversed());
+}
+
+} // namespace bench
@@ -0,0 +1,76 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <cstdio>
+#include "audio/common/decoder/AudioDecoder.h"
+#include "base/std/container/vector.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+
+namespace {
+
+AudioDecoder::MemorySource makeSource(const ccstd::vector<uint8_t> &data) {
+    AudioDecoder::MemorySource source;
+    source.data = data.data();
+    source.size = static_cast<uint32_t>(data.size());
+    return source;
+}
+
+} // namespace
+
+TEST(AudioDecoderMemoryTest, read) {
+    const ccstd::vector<uint8_t> data{1, 2, 3, 4, 5, 6, 7};
+    auto source = makeSource(data);
+
+    uint8_t buffer[4]{};
+    EXPECT_EQ(source.read(buffer, 4), 4);
+    EXPECT_EQ(buffer[0], 1);
+    EXPECT_EQ(buffer[3], 4);
+    EXPECT_EQ(source.read(buffer, 4), 3);
+    EXPECT_EQ(buffer[0], 5);
+    EXPECT_EQ(buffer[2], 7);
+    EXPECT_EQ(source.read(buffer, 4), 0);
+}
+
+TEST(AudioDecoderMemoryTest, seek) {
+    const ccstd::vector<uint8_t> data{1, 2, 3, 4, 5, 6, 7};
+    auto source = makeSource(data);
+
+    EXPECT_EQ(source.seek(2, SEEK_SET), 2);
+    EXPECT_EQ(source.seek(3, SEEK_CUR), 5);
+    EXPECT_EQ(source.seek(-1, SEEK_END), 6);
+    EXPECT_EQ(source.seek(0, SEEK_END), 7);
+
+    // Out of the data, the position doesn't change.
+    EXPECT_EQ(source.seek(1, SEEK_END), -1);
+    EXPECT_EQ(source.seek(-8, SEEK_CUR), -1);
+    EXPECT_EQ(source.position, 7);
+
+    uint8_t byte = 0;
+    source.seek(-7, SEEK_END);
+    EXPECT_EQ(source.read(&byte, 1), 1);
+    EXPECT_EQ(byte, 1);
+}
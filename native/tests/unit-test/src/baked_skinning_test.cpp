@@ -0,0 +1,153 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "3d/assets/Mesh.h"
+#include "3d/assets/Skeleton.h"
+#include "3d/misc/CreateMesh.h"
+#include "3d/models/BakedSkinningModel.h"
+#include "3d/skeletal-animation/SkeletalAnimationUtils.h"
+#include "core/Root.h"
+#include "core/scene-graph/Node.h"
+#include "gfx-base/GFXDevice.h"
+#include "gtest/gtest.h"
+#include "primitive/Box.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr uint32_t FLOATS_PER_JOINT{12};
+
+struct BakedSkinningFixture {
+    BakedSkinningFixture() {
+        skeleton = ccnew Skeleton();
+        skeleton->setJoints({"hips", "hips/spine", "hips/spine/head"});
+        ccstd::vector<Mat4> bindposes(3);
+        for (uint32_t j = 0; j < 3; ++j) {
+            Mat4::createTranslation(0.F, -static_cast<float>(j), 0.F, &bindposes[j]);
+        }
+        skeleton->setBindposes(bindposes);
+
+        root = ccnew Node("root");
+        auto *hips = ccnew Node("hips");
+        auto *spine = ccnew Node("spine");
+        spine->addChild(ccnew Node("head"));
+        hips->addChild(spine);
+        root->addChild(hips);
+
+        mesh = MeshUtils::createMesh(box());
+    }
+
+    // The head joint has no curve, it follows its node under the animated spine.
+    static IBakedClip createClip(ccstd::hash_t hash, uint32_t frames) {
+        IBakedClip clip;
+        clip.hash = hash;
+        clip.frames = frames;
+        for (const auto *path : {"hips", "hips/spine"}) {
+            auto &matrices = clip.joints[path];
+            matrices.resize(frames);
+            for (uint32_t f = 0; f < frames; ++f) {
+                Mat4::createTranslation(static_cast<float>(f), 0.F, 0.F, &matrices[f]);
+            }
+        }
+        return clip;
+    }
+
+    IntrusivePtr<Skeleton> skeleton;
+    IntrusivePtr<Node> root;
+    IntrusivePtr<Mesh> mesh;
+};
+
+} // namespace
+
+TEST(BakedSkinningTest, sequencePoseTextureLayout) {
+    logLabel = "a baked clip takes 12 floats per joint and frame in the joint texture";
+    BakedSkinningFixture fixture;
+    IntrusivePtr<JointTexturePool> pool = ccnew JointTexturePool(gfx::Device::getInstance());
+    const auto walk = BakedSkinningFixture::createClip(1U, 30);
+    auto texture = pool->getSequencePoseTexture(fixture.skeleton, walk, fixture.mesh, fixture.root);
+    ASSERT_TRUE(texture.has_value()) << "ERROR in: " << logLabel;
+    const auto *handle = texture.value();
+    ASSERT_NE(handle->handle.texture, nullptr) << "ERROR in: " << logLabel;
+    const uint32_t jointCount = static_cast<uint32_t>(fixture.skeleton->getJoints().size());
+    const uint32_t walkBytes = jointCount * FLOATS_PER_JOINT * walk.frames * static_cast<uint32_t>(sizeof(float));
+    EXPECT_GE(static_cast<uint32_t>(handle->handle.end - handle->handle.start), walkBytes) << "ERROR in: " << logLabel;
+
+    logLabel = "the pixel offset addresses the start of the clip in the joint texture";
+    const auto *joints = handle->handle.texture;
+    const uint32_t formatSize = gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(joints->getFormat())].size;
+    EXPECT_EQ(pool->getPixelsPerJoint() * formatSize, FLOATS_PER_JOINT * sizeof(float)) << "ERROR in: " << logLabel;
+    EXPECT_EQ(handle->pixelOffset * formatSize, static_cast<uint32_t>(handle->handle.start)) << "ERROR in: " << logLabel;
+    EXPECT_LE(static_cast<uint32_t>(handle->handle.end), joints->getWidth() * joints->getHeight() * formatSize) << "ERROR in: " << logLabel;
+
+    logLabel = "every frame of the clip gets its bounds";
+    const auto meshHash = static_cast<uint32_t>(fixture.mesh->getHash());
+    EXPECT_EQ(handle->bounds.at(meshHash).size(), walk.frames) << "ERROR in: " << logLabel;
+
+    logLabel = "another clip is baked after the first one";
+    const auto run = BakedSkinningFixture::createClip(2U, 10);
+    auto runTexture = pool->getSequencePoseTexture(fixture.skeleton, run, fixture.mesh, fixture.root);
+    ASSERT_TRUE(runTexture.has_value()) << "ERROR in: " << logLabel;
+    const auto &runHandle = runTexture.value()->handle;
+    if (runHandle.texture == joints) {
+        EXPECT_GE(runHandle.start, handle->handle.end) << "ERROR in: " << logLabel;
+    }
+
+    logLabel = "baking the same clip again shares the texture";
+    auto shared = pool->getSequencePoseTexture(fixture.skeleton, walk, fixture.mesh, fixture.root);
+    ASSERT_TRUE(shared.has_value()) << "ERROR in: " << logLabel;
+    EXPECT_EQ(shared.value(), handle) << "ERROR in: " << logLabel;
+    EXPECT_EQ(handle->refCount, 2U) << "ERROR in: " << logLabel;
+
+    pool->releaseHandle(shared.value());
+    pool->releaseHandle(texture.value());
+    pool->releaseHandle(runTexture.value());
+    pool->clear();
+}
+
+TEST(BakedSkinningTest, uploadBakedClip) {
+    logLabel = "a model uploading a baked clip holds the texture of the pool of Root";
+    BakedSkinningFixture fixture;
+    auto *pool = Root::getInstance()->getJointTexturePool();
+    const auto clip = BakedSkinningFixture::createClip(3U, 8);
+    IntrusivePtr<BakedSkinningModel> model = ccnew BakedSkinningModel();
+    model->bindSkeleton(fixture.skeleton, fixture.root, fixture.mesh);
+    model->uploadAnimation(pool, &clip);
+    model->setFrame(4.F);
+
+    auto texture = pool->getSequencePoseTexture(fixture.skeleton, clip, fixture.mesh, fixture.root);
+    ASSERT_TRUE(texture.has_value()) << "ERROR in: " << logLabel;
+    EXPECT_EQ(texture.value()->refCount, 2U) << "ERROR in: " << logLabel;
+
+    logLabel = "uploading the same clip again keeps the texture";
+    model->uploadAnimation(pool, &clip);
+    EXPECT_EQ(texture.value()->refCount, 2U) << "ERROR in: " << logLabel;
+
+    logLabel = "the texture is released with the model";
+    model->destroy();
+    EXPECT_EQ(texture.value()->refCount, 1U) << "ERROR in: " << logLabel;
+    pool->releaseHandle(texture.value());
+}
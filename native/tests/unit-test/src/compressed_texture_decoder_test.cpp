@@ -0,0 +1,96 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <array>
+#include "base/std/container/vector.h"
+#include "gtest/gtest.h"
+#include "platform/CompressedTextureDecoder.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+// Individual mode, base color (0x88, 0x44, 0xCC), codeword table 0, all texels at index 0 (+2).
+constexpr std::array<uint8_t, 8> ETC_SOLID_BLOCK{0x88, 0x44, 0xCC, 0x00, 0x00, 0x00, 0x00, 0x00};
+// EAC alpha of base 200 with a multiplier of 0.
+constexpr std::array<uint8_t, 8> EAC_SOLID_BLOCK{0xC8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+// LDR void extent of color (0x8000, 0xFFFF, 0x0000, 0xFFFF).
+constexpr std::array<uint8_t, 16> ASTC_VOID_EXTENT_BLOCK{0xFC, 0xFD, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                                                         0x00, 0x80, 0xFF, 0xFF, 0x00, 0x00, 0xFF, 0xFF};
+
+void expectTexels(const ccstd::vector<uint8_t> &rgba, std::array<uint8_t, 4> texel) {
+    for (size_t i = 0; i < rgba.size(); i += 4) {
+        EXPECT_EQ(rgba[i + 0], texel[0]) << "texel " << i / 4;
+        EXPECT_EQ(rgba[i + 1], texel[1]) << "texel " << i / 4;
+        EXPECT_EQ(rgba[i + 2], texel[2]) << "texel " << i / 4;
+        EXPECT_EQ(rgba[i + 3], texel[3]) << "texel " << i / 4;
+    }
+}
+
+} // namespace
+
+TEST(CompressedTextureDecoderTest, formats) {
+    EXPECT_TRUE(CompressedTextureDecoder::isSupported(gfx::Format::ETC_RGB8));
+    EXPECT_TRUE(CompressedTextureDecoder::isSupported(gfx::Format::ASTC_SRGBA_12X12));
+    EXPECT_FALSE(CompressedTextureDecoder::isSupported(gfx::Format::RGBA8));
+    EXPECT_FALSE(CompressedTextureDecoder::isSupported(gfx::Format::PVRTC_RGBA4));
+
+    EXPECT_EQ(CompressedTextureDecoder::getDecodedFormat(gfx::Format::ETC2_RGBA8), gfx::Format::RGBA8);
+    EXPECT_EQ(CompressedTextureDecoder::getDecodedFormat(gfx::Format::ETC2_SRGB8), gfx::Format::SRGB8_A8);
+    EXPECT_EQ(CompressedTextureDecoder::getDecodedFormat(gfx::Format::ASTC_SRGBA_4X4), gfx::Format::SRGB8_A8);
+    EXPECT_EQ(CompressedTextureDecoder::getDecodedFormat(gfx::Format::BC1), gfx::Format::UNKNOWN);
+
+    ccstd::vector<uint8_t> rgba(16 * 4);
+    EXPECT_FALSE(CompressedTextureDecoder::decode(gfx::Format::BC1, ETC_SOLID_BLOCK.data(), 4, 4, rgba.data()));
+}
+
+TEST(CompressedTextureDecoderTest, etc) {
+    ccstd::vector<uint8_t> rgba(16 * 4);
+    EXPECT_TRUE(CompressedTextureDecoder::decode(gfx::Format::ETC_RGB8, ETC_SOLID_BLOCK.data(), 4, 4, rgba.data()));
+    expectTexels(rgba, {138, 70, 206, 255});
+
+    ccstd::vector<uint8_t> blocks(EAC_SOLID_BLOCK.begin(), EAC_SOLID_BLOCK.end());
+    blocks.insert(blocks.end(), ETC_SOLID_BLOCK.begin(), ETC_SOLID_BLOCK.end());
+    EXPECT_TRUE(CompressedTextureDecoder::decode(gfx::Format::ETC2_RGBA8, blocks.data(), 4, 4, rgba.data()));
+    expectTexels(rgba, {138, 70, 206, 200});
+}
+
+TEST(CompressedTextureDecoderTest, astcPartialBlocks) {
+    // A 5x3 image of 4x4 blocks only keeps the texels inside the image.
+    ccstd::vector<uint8_t> blocks(ASTC_VOID_EXTENT_BLOCK.begin(), ASTC_VOID_EXTENT_BLOCK.end());
+    blocks.insert(blocks.end(), ASTC_VOID_EXTENT_BLOCK.begin(), ASTC_VOID_EXTENT_BLOCK.end());
+    ccstd::vector<uint8_t> rgba(5 * 3 * 4);
+    EXPECT_TRUE(CompressedTextureDecoder::decode(gfx::Format::ASTC_RGBA_4X4, blocks.data(), 5, 3, rgba.data()));
+    expectTexels(rgba, {128, 255, 0, 255});
+}
+
+TEST(CompressedTextureDecoderTest, astcErrorColor) {
+    // Block mode 0 is reserved.
+    ccstd::vector<uint8_t> blocks(16, 0);
+    ccstd::vector<uint8_t> rgba(8 * 8 * 4);
+    EXPECT_TRUE(CompressedTextureDecoder::decode(gfx::Format::ASTC_RGBA_8X8, blocks.data(), 8, 8, rgba.data()));
+    expectTexels(rgba, {255, 0, 255, 255});
+}
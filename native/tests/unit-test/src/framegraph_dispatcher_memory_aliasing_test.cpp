@@ -0,0 +1,167 @@
+/****************************************************************************
+Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "cocos/renderer/pipeline/custom/FGDispatcherGraphs.h"
+#include "cocos/renderer/pipeline/custom/TransientAliasing.h"
+#include "cocos/renderer/pipeline/custom/test/test.h"
+#include "gfx-base/GFXDef-common.h"
+#include "gfx-base/GFXDef.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+namespace {
+
+const cc::render::Barrier* findBarrier(const std::vector<cc::render::Barrier>& barriers, uint32_t resID) {
+    const cc::render::Barrier* found = nullptr;
+    for (const auto& barrier : barriers) {
+        if (barrier.resourceID == resID) {
+            EXPECT_EQ(found, nullptr) << "resource " << resID << " has more than one barrier";
+            found = &barrier;
+        }
+    }
+    return found;
+}
+
+} // namespace
+
+TEST(fgDispatherAliasing, test1) {
+    TEST_CASE_DEFINE;
+
+    // 0 -> 1 -> 2 -> 3 -> 19(external) -> present
+    ViewInfo rasterData = {
+        {PassType::RASTER, {{{}, {"0"}}}},
+        {PassType::RASTER, {{{"0"}, {"1"}}}},
+        {PassType::RASTER, {{{"1"}, {"2"}}}},
+        {PassType::RASTER, {{{"2"}, {"3"}}}},
+        {PassType::RASTER, {{{"3"}, {"19"}}}},
+        {PassType::PRESENT, {{{"19"}, {}}}},
+    };
+    LayoutInfo layoutInfo = {
+        {{"0", 0, ShaderStageFlagBit::FRAGMENT}},
+        {{"0", 0, ShaderStageFlagBit::FRAGMENT}, {"1", 1, ShaderStageFlagBit::FRAGMENT}},
+        {{"1", 1, ShaderStageFlagBit::FRAGMENT}, {"2", 2, ShaderStageFlagBit::FRAGMENT}},
+        {{"2", 2, ShaderStageFlagBit::FRAGMENT}, {"3", 3, ShaderStageFlagBit::FRAGMENT}},
+        {{"3", 3, ShaderStageFlagBit::FRAGMENT}, {"19", 19, ShaderStageFlagBit::FRAGMENT}},
+        {{"19", 19, ShaderStageFlagBit::FRAGMENT}},
+    };
+
+    boost::container::pmr::memory_resource* resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+
+    fillTestGraph(rasterData, resources, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    FrameGraphDispatcher fgDispatcher(rescGraph, renderGraph, layoutGraphData, resource, resource);
+    fgDispatcher.enableMemoryAliasing(true);
+    fgDispatcher.run();
+
+    TransientAliasing aliasing(resource);
+    aliasTransientResources(fgDispatcher, aliasing);
+
+    // access graph vertex of pass N is N + 1.
+    // 0 is released after pass 1 and 2 is first written in pass 2, 2 takes over the texture of 0.
+    // 1 is released after pass 2 and 3 is first written in pass 3, 3 takes over the texture of 1.
+    const auto& aliased = aliasing.aliasedResources;
+    ExpectEq(aliased.size() == 2, true);
+    ExpectEq(aliased.at(2) == 0, true);
+    ExpectEq(aliased.at(3) == 1, true);
+
+    const auto& handoffs = aliasing.handoffs;
+    ExpectEq(handoffs.size() == 2, true);
+    ExpectEq(handoffs[0].from == 0 && handoffs[0].to == 2, true);
+    ExpectEq(handoffs[0].fromPass == 2 && handoffs[0].toPass == 3, true);
+    ExpectEq(handoffs[1].from == 1 && handoffs[1].to == 3, true);
+    ExpectEq(handoffs[1].fromPass == 3 && handoffs[1].toPass == 4, true);
+
+    // the new owner waits for the last read of the previous one before it is written
+    const auto& barrierMap = fgDispatcher.getBarriers();
+    const auto* barrier2 = findBarrier(barrierMap.at(3).blockBarrier.frontBarriers, 2);
+    ExpectEq(barrier2 != nullptr, true);
+    ExpectEq(barrier2->type == BarrierType::FULL, true);
+    ExpectEq(barrier2->barrier != nullptr, true);
+    ExpectEq(barrier2->beginStatus.vertID == 2, true);
+    ExpectEq(barrier2->beginStatus.access == MemoryAccessBit::READ_ONLY, true);
+    ExpectEq(barrier2->endStatus.vertID == 3, true);
+    ExpectEq(barrier2->endStatus.access == MemoryAccessBit::WRITE_ONLY, true);
+
+    const auto* barrier3 = findBarrier(barrierMap.at(4).blockBarrier.frontBarriers, 3);
+    ExpectEq(barrier3 != nullptr, true);
+    ExpectEq(barrier3->type == BarrierType::FULL, true);
+    ExpectEq(barrier3->beginStatus.vertID == 3, true);
+    ExpectEq(barrier3->beginStatus.access == MemoryAccessBit::READ_ONLY, true);
+    ExpectEq(barrier3->endStatus.vertID == 4, true);
+    ExpectEq(barrier3->endStatus.access == MemoryAccessBit::WRITE_ONLY, true);
+
+    // no handoff for the owners and the external target
+    ExpectEq(findBarrier(barrierMap.at(1).blockBarrier.frontBarriers, 0) == nullptr, true);
+    ExpectEq(findBarrier(barrierMap.at(2).blockBarrier.frontBarriers, 1) == nullptr, true);
+    ExpectEq(findBarrier(barrierMap.at(5).blockBarrier.frontBarriers, 19) == nullptr, true);
+
+    const auto& desc = get(ResourceGraph::DescTag{}, rescGraph, 0);
+    const uint64_t size = cc::gfx::formatSize(desc.format, desc.width, desc.height, desc.depthOrArraySize);
+    ExpectEq(aliasing.transientMemorySize == 4 * size, true);
+    ExpectEq(aliasing.aliasedTransientMemorySize == 2 * size, true);
+}
+
+TEST(fgDispatherAliasing, test2) {
+    TEST_CASE_DEFINE;
+
+    // 1 is loaded before written, its content of the previous frame is kept
+    ViewInfo rasterData = {
+        {PassType::RASTER, {{{}, {"0"}}}},
+        {PassType::RASTER, {{{"0"}, {"19"}}}},
+        {PassType::RASTER, {{{"1"}, {"19"}}}},
+        {PassType::PRESENT, {{{"19"}, {}}}},
+    };
+    LayoutInfo layoutInfo = {
+        {{"0", 0, ShaderStageFlagBit::FRAGMENT}},
+        {{"0", 0, ShaderStageFlagBit::FRAGMENT}, {"19", 19, ShaderStageFlagBit::FRAGMENT}},
+        {{"1", 1, ShaderStageFlagBit::FRAGMENT}, {"19", 19, ShaderStageFlagBit::FRAGMENT}},
+        {{"19", 19, ShaderStageFlagBit::FRAGMENT}},
+    };
+
+    boost::container::pmr::memory_resource* resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+
+    fillTestGraph(rasterData, resources, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    FrameGraphDispatcher fgDispatcher(rescGraph, renderGraph, layoutGraphData, resource, resource);
+    fgDispatcher.enableMemoryAliasing(true);
+    fgDispatcher.run();
+
+    TransientAliasing aliasing(resource);
+    aliasTransientResources(fgDispatcher, aliasing);
+
+    ExpectEq(aliasing.aliasedResources.empty(), true);
+    ExpectEq(aliasing.handoffs.empty(), true);
+    ExpectEq(aliasing.aliasedTransientMemorySize == aliasing.transientMemorySize, true);
+
+    // nothing is aliased when disabled
+    FrameGraphDispatcher disabled(rescGraph, renderGraph, layoutGraphData, resource, resource);
+    disabled.run();
+    aliasTransientResources(disabled, aliasing);
+    ExpectEq(aliasing.transientMemorySize == 0, true);
+}
@@ -0,0 +1,202 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <zlib.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include "base/Scheduler.h"
+#include "gtest/gtest.h"
+#include "platform/Image.h"
+#include "platform/ImageDecodeQueue.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr uint32_t SIDE = 64;
+constexpr uint32_t DECODED_SIZE = SIDE * SIDE * 4;
+
+void appendUint32(ccstd::vector<unsigned char> &out, uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        out.emplace_back(static_cast<unsigned char>(value >> shift));
+    }
+}
+
+void appendChunk(ccstd::vector<unsigned char> &out, const char *type, const ccstd::vector<unsigned char> &data) {
+    appendUint32(out, static_cast<uint32_t>(data.size()));
+    const size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    appendUint32(out, static_cast<uint32_t>(crc32(0, out.data() + start, static_cast<uInt>(out.size() - start))));
+}
+
+// A SIDE x SIDE RGBA8 PNG allocated with malloc, as the queue takes it.
+unsigned char *createPng(uint32_t *size) {
+    ccstd::vector<unsigned char> rows;
+    for (uint32_t y = 0; y < SIDE; ++y) {
+        rows.emplace_back(0); // no filter
+        for (uint32_t x = 0; x < SIDE * 4; ++x) {
+            rows.emplace_back(static_cast<unsigned char>(x + y));
+        }
+    }
+    uLongf compressedSize = compressBound(static_cast<uLong>(rows.size()));
+    ccstd::vector<unsigned char> compressed(compressedSize);
+    compress(compressed.data(), &compressedSize, rows.data(), static_cast<uLong>(rows.size()));
+    compressed.resize(compressedSize);
+
+    ccstd::vector<unsigned char> header;
+    appendUint32(header, SIDE);
+    appendUint32(header, SIDE);
+    header.insert(header.end(), {8, 6, 0, 0, 0}); // 8 bits RGBA, no interlacing
+
+    ccstd::vector<unsigned char> png{0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    appendChunk(png, "IHDR", header);
+    appendChunk(png, "IDAT", compressed);
+    appendChunk(png, "IEND", {});
+
+    auto *data = static_cast<unsigned char *>(malloc(png.size()));
+    memcpy(data, png.data(), png.size());
+    *size = static_cast<uint32_t>(png.size());
+    return data;
+}
+
+// Runs the callbacks posted by the queue until done() holds, gives up after 10 seconds.
+template <typename Done>
+bool runUntil(Scheduler &scheduler, Done done) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        scheduler.update(0.F);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(ImageDecodeQueueTest, priority) {
+    logLabel = "requests start by priority, equal priorities in arrival order";
+    auto scheduler = std::make_shared<Scheduler>();
+    // without budget, nothing else starts until the first request is delivered
+    ImageDecodeQueue queue(1, 0, scheduler);
+    ccstd::vector<int32_t> order;
+    const auto load = [&](int32_t priority) {
+        uint32_t size = 0;
+        auto *png = createPng(&size);
+        queue.loadData(png, size, priority, [&order, priority](Image *image) {
+            EXPECT_NE(image, nullptr) << "ERROR in: " << logLabel;
+            if (image) {
+                EXPECT_EQ(static_cast<uint32_t>(image->getWidth()), SIDE) << "ERROR in: " << logLabel;
+                EXPECT_EQ(image->getDataLen(), DECODED_SIZE) << "ERROR in: " << logLabel;
+            }
+            order.emplace_back(priority);
+        });
+    };
+    load(0);
+    load(1);
+    load(5);
+    load(3);
+    load(5);
+    queue.setMemoryBudget(ImageDecodeQueue::DEFAULT_MEMORY_BUDGET);
+
+    ASSERT_TRUE(runUntil(*scheduler, [&]() { return order.size() == 5; })) << "ERROR in: " << logLabel;
+    EXPECT_EQ(order, (ccstd::vector<int32_t>{0, 5, 5, 3, 1})) << "ERROR in: " << logLabel;
+}
+
+TEST(ImageDecodeQueueTest, memoryBudget) {
+    logLabel = "the bytes held by the requests in flight stay under the budget";
+    auto scheduler = std::make_shared<Scheduler>();
+    // room for one decoded image only, the others wait after being read
+    const uint64_t budget = DECODED_SIZE + 4096;
+    ImageDecodeQueue queue(3, budget, scheduler);
+    uint32_t loaded = 0;
+    uint64_t peak = 0;
+    for (uint32_t i = 0; i < 6; ++i) {
+        uint32_t size = 0;
+        auto *png = createPng(&size);
+        queue.loadData(png, size, 0, [&](Image *image) {
+            EXPECT_NE(image, nullptr) << "ERROR in: " << logLabel;
+            peak = std::max(peak, queue.getMemoryInUse());
+            ++loaded;
+        });
+    }
+    const auto sampleUntilLoaded = [&]() {
+        peak = std::max(peak, queue.getMemoryInUse());
+        return loaded == 6;
+    };
+    ASSERT_TRUE(runUntil(*scheduler, sampleUntilLoaded)) << "ERROR in: " << logLabel;
+    EXPECT_LE(peak, budget) << "ERROR in: " << logLabel;
+    EXPECT_EQ(queue.getMemoryInUse(), 0U) << "ERROR in: " << logLabel;
+
+    logLabel = "a request larger than the budget still runs once nothing else is in flight";
+    queue.setMemoryBudget(16);
+    loaded = 0;
+    for (uint32_t i = 0; i < 3; ++i) {
+        uint32_t size = 0;
+        auto *png = createPng(&size);
+        queue.loadData(png, size, 0, [&](Image *image) {
+            EXPECT_NE(image, nullptr) << "ERROR in: " << logLabel;
+            ++loaded;
+        });
+    }
+    ASSERT_TRUE(runUntil(*scheduler, [&]() { return loaded == 3; })) << "ERROR in: " << logLabel;
+    EXPECT_EQ(queue.getMemoryInUse(), 0U) << "ERROR in: " << logLabel;
+}
+
+TEST(ImageDecodeQueueTest, cancel) {
+    logLabel = "the callbacks of cancelled requests are never invoked";
+    auto scheduler = std::make_shared<Scheduler>();
+    ImageDecodeQueue queue(1, 0, scheduler);
+    ccstd::vector<ImageDecodeQueue::RequestId> loaded;
+    const auto load = [&]() {
+        uint32_t size = 0;
+        auto *png = createPng(&size);
+        auto id = std::make_shared<ImageDecodeQueue::RequestId>(0);
+        *id = queue.loadData(png, size, 0, [&loaded, id](Image * /*image*/) {
+            loaded.emplace_back(*id);
+        });
+        return *id;
+    };
+    const auto running = load();
+    const auto pending = load();
+    const auto kept = load();
+
+    EXPECT_TRUE(queue.cancel(running)) << "ERROR in: " << logLabel;
+    EXPECT_TRUE(queue.cancel(pending)) << "ERROR in: " << logLabel;
+    EXPECT_FALSE(queue.cancel(pending)) << "ERROR in: " << logLabel;
+    EXPECT_FALSE(queue.cancel(kept + 1)) << "ERROR in: " << logLabel;
+
+    ASSERT_TRUE(runUntil(*scheduler, [&]() { return !loaded.empty(); })) << "ERROR in: " << logLabel;
+    EXPECT_EQ(loaded, ccstd::vector<ImageDecodeQueue::RequestId>{kept}) << "ERROR in: " << logLabel;
+
+    logLabel = "finished requests can't be cancelled, and cancelled ones release their memory";
+    EXPECT_FALSE(queue.cancel(kept)) << "ERROR in: " << logLabel;
+    EXPECT_EQ(queue.getMemoryInUse(), 0U) << "ERROR in: " << logLabel;
+}
@@ -25,8 +25,13 @@ THE SOFTWARE.
 #include "cocos/math/Vec2.h"
 #include "cocos/math/Math.h"
 #include "cocos/math/MathUtil.h"
+#include "cocos/core/geometry/AABB.h"
+#include "cocos/core/geometry/Plane.h"
+#include "cocos/base/Utils.h"
 #include "utils.h"
 #include <math.h>
+#include <algorithm>
+#include <cstring>
 #include <vector>
 
 TEST(mathUtilsTest, test9) {
@@ -41,4 +46,228 @@ TEST(mathUtilsTest, test9) {
     logLabel = "test the MathUtil lerp function";
     float res = cc::MathUtil::lerp(2, 15, 0.8);
     ExpectEq(IsEqualF(res, 12.3999996), true);
-}
\ No newline at end of file
+}
+
+TEST(mathUtilsTest, aabbPlanesSoA) {
+    logLabel = "test the MathUtil aabbPlanesSoA function";
+    constexpr uint32_t count = 40;
+    std::vector<float> data[6];
+    std::vector<cc::geometry::AABB> boxes;
+    for (uint32_t i = 0; i < count; ++i) {
+        const float offset = static_cast<float>(i) - 20.0F;
+        boxes.emplace_back(offset, offset * 0.5F, -offset, 1.0F + i % 3, 2.0F, 0.5F * (i % 5));
+    }
+    for (const auto &box : boxes) {
+        data[0].push_back(box.center.x);
+        data[1].push_back(box.center.y);
+        data[2].push_back(box.center.z);
+        data[3].push_back(box.halfExtents.x);
+        data[4].push_back(box.halfExtents.y);
+        data[5].push_back(box.halfExtents.z);
+    }
+    const float planes[] = {
+        1.0F, 0.0F, 0.0F, -10.0F,
+        -1.0F, 0.0F, 0.0F, -8.0F,
+        0.0F, 0.6F, 0.8F, -3.0F,
+    };
+    const float *arrays[6];
+    for (uint32_t i = 0; i < 6; ++i) {
+        arrays[i] = data[i].data();
+    }
+    uint32_t visibility[2] = {0xFFFFFFFF, 0xFFFFFFFF};
+    cc::MathUtil::aabbPlanesSoA(arrays, count, planes, 3, visibility);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        bool expected = true;
+        for (uint32_t p = 0; p < 3; ++p) {
+            cc::geometry::Plane plane(planes[p * 4], planes[p * 4 + 1], planes[p * 4 + 2], planes[p * 4 + 3]);
+            expected = expected && boxes[i].aabbPlane(plane) != -1;
+        }
+        ExpectEq(((visibility[i >> 5] >> (i & 31)) & 1U) != 0, expected);
+    }
+    ExpectEq((visibility[1] >> (count - 32)) == 0, true);
+}
+
+TEST(mathUtilsTest, transformPositions) {
+    logLabel = "test the MathUtil transformPositions and fillStrided functions";
+    constexpr uint32_t count = 13;
+    constexpr uint32_t stride = 9;
+    std::vector<float> src(count * stride);
+    for (uint32_t i = 0; i < src.size(); ++i) {
+        src[i] = static_cast<float>(i % 7) * 0.5F - 1.5F;
+    }
+    cc::Mat4 affine;
+    cc::Mat4::fromRTS(cc::Quaternion(0.1F, 0.2F, 0.3F, 0.9F), cc::Vec3(3.0F, -2.0F, 1.0F), cc::Vec3(2.0F, 0.5F, 1.5F), &affine);
+    cc::Mat4 projective;
+    cc::Mat4::createPerspective(60.0F, 1.5F, 0.1F, 100.0F, &projective);
+    cc::Mat4::multiply(projective, affine, &projective);
+
+    for (const auto *matrix : {&affine, &projective}) {
+        for (bool ignoreZ : {false, true}) {
+            std::vector<float> dst(count * stride, 42.0F);
+            cc::MathUtil::transformPositions(matrix->m, src.data(), stride * sizeof(float), dst.data(), stride * sizeof(float), count, ignoreZ);
+            std::vector<float> inPlace = src;
+            cc::MathUtil::transformPositions(matrix->m, inPlace.data(), stride * sizeof(float), inPlace.data(), stride * sizeof(float), count, ignoreZ);
+            for (uint32_t i = 0; i < count; ++i) {
+                const float *p = src.data() + i * stride;
+                cc::Vec3 expected;
+                expected.transformMat4(cc::Vec3(p[0], p[1], ignoreZ ? 0.0F : p[2]), *matrix);
+                const float *q = dst.data() + i * stride;
+                ExpectEq(IsEqualF(q[0], expected.x) && IsEqualF(q[1], expected.y) && IsEqualF(q[2], expected.z), true);
+                ExpectEq(q[3] == 42.0F, true);
+                ExpectEq(std::equal(q, q + 3, inPlace.data() + i * stride), true);
+                ExpectEq(inPlace[i * stride + 3] == src[i * stride + 3], true);
+            }
+        }
+    }
+
+    const float color[4] = {0.1F, 0.2F, 0.3F, 0.4F};
+    std::vector<float> vb(count * stride, 42.0F);
+    cc::MathUtil::fillStrided(color, vb.data() + 5, stride * sizeof(float), count);
+    for (uint32_t i = 0; i < count; ++i) {
+        ExpectEq(std::equal(color, color + 4, vb.data() + i * stride + 5), true);
+        ExpectEq(vb[i * stride + 4] == 42.0F, true);
+    }
+}
+
+TEST(mathUtilsTest, distancesSoA) {
+    logLabel = "test the MathUtil distancesSoA function";
+    constexpr uint32_t count = 12;
+    std::vector<float> xs(count);
+    std::vector<float> ys(count);
+    std::vector<float> zs(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        xs[i] = static_cast<float>(i) * 1.5F - 4.0F;
+        ys[i] = static_cast<float>(i % 5) * -2.0F;
+        zs[i] = static_cast<float>(i % 3) + 0.25F;
+    }
+    const float *const points[3] = {xs.data(), ys.data(), zs.data()};
+    const cc::Vec3 point{1.0F, -2.0F, 3.0F};
+    std::vector<float> distances(count);
+    cc::MathUtil::distancesSoA(points, count, &point.x, distances.data());
+    for (uint32_t i = 0; i < count; ++i) {
+        const float expected = cc::Vec3(xs[i], ys[i], zs[i]).distance(point);
+        ExpectEq(IsEqualF(distances[i], expected), true);
+    }
+}
+
+TEST(mathUtilsTest, multiplyAffine3x4) {
+    logLabel = "test the MathUtil multiplyAffine3x4 function";
+    constexpr uint32_t count = 5;
+    std::vector<cc::Mat4> worlds(count);
+    std::vector<cc::Mat4> bindposes(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const auto f = static_cast<float>(i);
+        cc::Quaternion rotation(0.1F * f, 0.2F, -0.3F, 0.9F);
+        rotation.normalize();
+        cc::Mat4::fromRTS(rotation, cc::Vec3(f, -2.0F, 1.0F + f), cc::Vec3(1.0F + f, 0.5F, 1.5F), &worlds[i]);
+        cc::Mat4::fromRTS(cc::Quaternion(0.0F, 0.6F, 0.0F, 0.8F), cc::Vec3(-f, 0.5F, 3.0F), cc::Vec3::ONE, &bindposes[i]);
+    }
+    std::vector<float> palette(count * 12);
+    cc::MathUtil::multiplyAffine3x4(worlds[0].m, bindposes[0].m, count, palette.data());
+    for (uint32_t i = 0; i < count; ++i) {
+        cc::Mat4 expected;
+        cc::Mat4::multiply(worlds[i], bindposes[i], &expected);
+        const float *p = palette.data() + i * 12;
+        for (uint32_t column = 0; column < 3; ++column) {
+            ExpectEq(IsEqualF(p[column * 4], expected.m[column * 4]) &&
+                         IsEqualF(p[column * 4 + 1], expected.m[column * 4 + 1]) &&
+                         IsEqualF(p[column * 4 + 2], expected.m[column * 4 + 2]) &&
+                         IsEqualF(p[column * 4 + 3], expected.m[12 + column]),
+                     true);
+        }
+    }
+}
+
+TEST(mathUtilsTest, floatToHalf) {
+    logLabel = "test the MathUtil floatToHalf function";
+    const std::vector<float> values{0.0F, -0.0F, 1.0F, -1.5F, 0.1F, 65504.0F, 65520.0F, 1e-5F, -6e-8F, 1e-9F,
+                                    3.14159F, 2049.0F, std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+                                    std::numeric_limits<float>::quiet_NaN(), 0.33333F, -1024.25F};
+    std::vector<uint16_t> halves(values.size());
+    cc::MathUtil::floatToHalf(values.data(), static_cast<uint32_t>(values.size()), halves.data());
+    for (size_t i = 0; i < values.size(); ++i) {
+        ExpectEq(halves[i] == cc::utils::rawHalfAsUint16(cc::utils::floatToHalf(values[i])), true);
+    }
+}
+
+TEST(mathUtilsTest, floatToHalfBitPatterns) {
+    logLabel = "compare the MathUtil floatToHalf function with the scalar conversion for special, boundary and sampled bit patterns";
+    std::vector<uint32_t> patterns{0x00000000U, 0x80000000U, 0x7F800000U, 0xFF800000U, // zeros and infinities
+                                   0x7FC00000U, 0xFFC00000U, 0x7F800001U, 0xFF800001U, // quiet and signalling NaNs
+                                   0x7FBFFFFFU, 0x7FFFFFFFU, 0xFFFFFFFFU, 0x7FC00001U, 0x7F802000U, 0x7F801FFFU};
+    // Every exponent with the mantissas around the rounding and overflow boundaries, which covers the
+    // largest half, the normal and subnormal half ranges and underflow to zero.
+    std::vector<uint32_t> mantissas{0x7FFFFFU, 0x7FFFFEU, 0x400000U};
+    for (uint32_t bit = 0; bit < 23; ++bit) {
+        mantissas.insert(mantissas.end(), {1U << bit, (1U << bit) - 1U, (1U << bit) + 1U, 0x7FFFFFU & ~((1U << bit) - 1U), (1U << bit) | 0x400000U});
+    }
+    for (uint32_t sign = 0; sign < 2; ++sign) {
+        for (uint32_t exponent = 0; exponent < 256; ++exponent) {
+            for (const auto mantissa : mantissas) {
+                patterns.emplace_back(sign << 31 | exponent << 23 | mantissa);
+            }
+        }
+    }
+    // A strided sweep over all the bit patterns, the stride is prime so that every mantissa bit varies.
+    constexpr uint64_t stride = 4093;
+    for (uint64_t bits = 0; bits < (1ULL << 32); bits += stride) {
+        patterns.emplace_back(static_cast<uint32_t>(bits));
+    }
+
+    // Batches of every size up to 17, so that the SIMD loops and their scalar tails are all exercised.
+    std::vector<float> values(patterns.size());
+    memcpy(values.data(), patterns.data(), patterns.size() * sizeof(float));
+    std::vector<uint16_t> halves(values.size());
+    uint32_t batchSize = 1;
+    for (size_t begin = 0; begin < values.size(); begin += batchSize, batchSize = batchSize % 17 + 1) {
+        const auto count = static_cast<uint32_t>(std::min<size_t>(batchSize, values.size() - begin));
+        cc::MathUtil::floatToHalf(values.data() + begin, count, halves.data() + begin);
+    }
+    uint32_t mismatches = 0;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (halves[i] != cc::utils::rawHalfAsUint16(cc::utils::floatToHalf(values[i]))) {
+            if (mismatches++ == 0) {
+                ADD_FAILURE() << "ERROR in: " << logLabel << ", first mismatch for bit pattern 0x" << std::hex << patterns[i];
+            }
+        }
+    }
+    EXPECT_EQ(mismatches, 0U) << "ERROR in: " << logLabel;
+}
+
+TEST(mathUtilsTest, weightedSum) {
+    logLabel = "test the MathUtil weightedSum function";
+    const std::vector<float> a{1.0F, 2.0F, 3.0F, 4.0F, -1.0F, 0.5F, 0.0F, 8.0F};
+    const std::vector<float> b{0.0F, 4.0F, -2.0F, 1.0F, 3.0F, 0.25F, 6.0F, -8.0F};
+    const float *rows[2]{a.data(), b.data()};
+    const float weights[2]{0.75F, 0.25F};
+    std::vector<float> sums(a.size());
+    cc::MathUtil::weightedSum(rows, weights, 2, static_cast<uint32_t>(sums.size()), sums.data());
+    for (size_t i = 0; i < sums.size(); ++i) {
+        EXPECT_FLOAT_EQ(sums[i], a[i] * 0.75F + b[i] * 0.25F) << "ERROR in: " << logLabel;
+    }
+}
+
+TEST(mathUtilsTest, unormConversions) {
+    logLabel = "test the MathUtil unormToFloat and floatToUnorm functions";
+    std::vector<uint8_t> bytes(259);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<uint8_t>(i);
+    }
+    std::vector<float> values(bytes.size());
+    cc::MathUtil::unormToFloat(bytes.data(), static_cast<uint32_t>(bytes.size()), values.data());
+    std::vector<uint8_t> roundTrip(bytes.size());
+    cc::MathUtil::floatToUnorm(values.data(), static_cast<uint32_t>(values.size()), roundTrip.data());
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        EXPECT_FLOAT_EQ(values[i], static_cast<float>(bytes[i]) / 255.0F) << "ERROR in: " << logLabel;
+        EXPECT_EQ(roundTrip[i], bytes[i]) << "ERROR in: " << logLabel;
+    }
+
+    const std::vector<float> outOfRange{-1.0F, 2.0F, 0.5F, 1.0F, -0.001F};
+    std::vector<uint8_t> clamped(outOfRange.size());
+    cc::MathUtil::floatToUnorm(outOfRange.data(), static_cast<uint32_t>(outOfRange.size()), clamped.data());
+    const std::vector<uint8_t> expected{0, 255, 128, 255, 0};
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(clamped[i], expected[i]) << "ERROR in: " << logLabel;
+    }
+}
@@ -0,0 +1,201 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include "3d/assets/Mesh.h"
+#include "3d/misc/CreateMesh.h"
+#include "core/assets/RenderingSubMesh.h"
+#include "gtest/gtest.h"
+#include "primitive/Sphere.h"
+#include "renderer/pipeline/SceneCulling.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+using Triangle = std::array<uint32_t, 3>;
+
+ccstd::vector<Triangle> readTriangles(Mesh *mesh) {
+    const auto &view = mesh->getStruct().primitives[0].indexView.value();
+    const auto &meshData = mesh->getData();
+    const uint8_t *data = meshData.buffer()->getData() + meshData.byteOffset() + view.offset;
+    ccstd::vector<Triangle> triangles(view.count / 3);
+    for (uint32_t i = 0; i < view.count; ++i) {
+        uint32_t index = 0;
+        memcpy(&index, data + i * view.stride, view.stride);
+        triangles[i / 3][i % 3] = index;
+    }
+    return triangles;
+}
+
+Vec3 getPosition(const IGeometry &geometry, uint32_t index) {
+    return {geometry.positions[index * 3], geometry.positions[index * 3 + 1], geometry.positions[index * 3 + 2]};
+}
+
+// One cluster per unit cube along x, facing +z if coneCutoff is less than 1.
+IMeshCluster createCluster(uint32_t i, float x, float coneCutoff = 1.F) {
+    IMeshCluster cluster;
+    cluster.firstIndex = i * 6;
+    cluster.indexCount = 6;
+    cluster.center = {x, 0.F, 0.F};
+    cluster.halfExtents = {0.5F, 0.5F, 0.5F};
+    cluster.radius = std::sqrt(0.75F);
+    cluster.coneAxis = {0.F, 0.F, 1.F};
+    cluster.coneCutoff = coneCutoff;
+    return cluster;
+}
+
+// An orthographic camera at z = 10 looking down -z, seeing x and y in [-5, 5].
+void createFrustum(geometry::Frustum *frustum) {
+    Mat4 view;
+    Mat4 proj;
+    Mat4 viewProj;
+    Mat4::createLookAt(Vec3{0.F, 0.F, 10.F}, Vec3::ZERO, Vec3::UNIT_Y, &view);
+    Mat4::createOrthographicOffCenter(-5.F, 5.F, -5.F, 5.F, 0.1F, 100.F, &proj);
+    Mat4::multiply(proj, view, &viewProj);
+    frustum->setAccurate(true);
+    frustum->update(viewProj, viewProj.getInversed());
+}
+
+ccstd::vector<gfx::DrawInfo> cull(const ccstd::vector<IMeshCluster> &clusters, const Mat4 &worldMatrix, const Vec3 *eye, uint32_t *visibleCount) {
+    IntrusivePtr<RenderingSubMesh> subMesh = ccnew RenderingSubMesh({}, {}, gfx::PrimitiveMode::TRIANGLE_LIST);
+    subMesh->setClusters(clusters);
+    gfx::DrawInfo whole;
+    whole.indexCount = static_cast<uint32_t>(clusters.size()) * 6;
+    geometry::Frustum frustum;
+    createFrustum(&frustum);
+    ccstd::vector<gfx::DrawInfo> drawInfos;
+    *visibleCount = pipeline::clusterCulling(subMesh->getClusters(), subMesh->getClusterBounds(), worldMatrix, frustum, eye, whole, drawInfos);
+    return drawInfos;
+}
+
+} // namespace
+
+TEST(meshClusterTest, buildClusters) {
+    logLabel = "buildClusters reorders the triangles into bounded clusters";
+    ISphereOptions options;
+    options.segments = 32;
+    const IGeometry geometry = sphere(1.F, options);
+    IntrusivePtr<Mesh> mesh = MeshUtils::createMesh(geometry);
+    const auto hash = mesh->getHash();
+    auto triangles = readTriangles(mesh);
+
+    constexpr uint32_t maxTriangles = 64;
+    ASSERT_TRUE(mesh->buildClusters(maxTriangles)) << "ERROR in: " << logLabel;
+    EXPECT_NE(mesh->getHash(), hash) << "ERROR in: " << logLabel;
+
+    // the same triangles, with the same winding
+    auto reordered = readTriangles(mesh);
+    EXPECT_NE(reordered, triangles) << "ERROR in: " << logLabel;
+    std::sort(triangles.begin(), triangles.end());
+    auto sortedReordered = reordered;
+    std::sort(sortedReordered.begin(), sortedReordered.end());
+    EXPECT_EQ(sortedReordered, triangles) << "ERROR in: " << logLabel;
+
+    const auto &clusters = mesh->getRenderingSubMeshes()[0]->getClusters();
+    ASSERT_FALSE(clusters.empty()) << "ERROR in: " << logLabel;
+    uint32_t nextIndex = 0;
+    for (const auto &cluster : clusters) {
+        EXPECT_EQ(cluster.firstIndex, nextIndex) << "ERROR in: " << logLabel;
+        EXPECT_EQ(cluster.indexCount % 3, 0U) << "ERROR in: " << logLabel;
+        EXPECT_LE(cluster.indexCount, maxTriangles * 3) << "ERROR in: " << logLabel;
+        nextIndex = cluster.firstIndex + cluster.indexCount;
+
+        const float minDot = cluster.coneCutoff < 1.F ? std::sqrt(1.F - cluster.coneCutoff * cluster.coneCutoff) : -1.F;
+        for (uint32_t t = cluster.firstIndex / 3; t < nextIndex / 3; ++t) {
+            const Vec3 a = getPosition(geometry, reordered[t][0]);
+            const Vec3 b = getPosition(geometry, reordered[t][1]);
+            const Vec3 c = getPosition(geometry, reordered[t][2]);
+            for (const auto &v : {a, b, c}) {
+                const Vec3 d = v - cluster.center;
+                EXPECT_LE(std::abs(d.x), cluster.halfExtents.x + 1e-5F) << "ERROR in: " << logLabel;
+                EXPECT_LE(std::abs(d.y), cluster.halfExtents.y + 1e-5F) << "ERROR in: " << logLabel;
+                EXPECT_LE(std::abs(d.z), cluster.halfExtents.z + 1e-5F) << "ERROR in: " << logLabel;
+                EXPECT_LE(d.length(), cluster.radius + 1e-5F) << "ERROR in: " << logLabel;
+            }
+            Vec3 normal;
+            Vec3::cross(b - a, c - a, &normal);
+            if (normal.length() > 0.F) {
+                normal.normalize();
+                EXPECT_GE(normal.dot(cluster.coneAxis), minDot - 1e-4F) << "ERROR in: " << logLabel;
+            }
+        }
+    }
+    EXPECT_EQ(nextIndex, mesh->getStruct().primitives[0].indexView->count) << "ERROR in: " << logLabel;
+    mesh->destroy();
+}
+
+TEST(meshClusterTest, clusterCullingFrustum) {
+    logLabel = "clusterCulling keeps the clusters inside the frustum and merges adjacent ranges";
+    // x = -20 and 20 are outside, the three in the middle are adjacent in the index buffer
+    const ccstd::vector<IMeshCluster> clusters{createCluster(0, -20.F), createCluster(1, -1.F), createCluster(2, 0.F),
+                                               createCluster(3, 1.F), createCluster(4, 20.F), createCluster(5, 4.F)};
+    uint32_t visibleCount = 0;
+    auto drawInfos = cull(clusters, Mat4::IDENTITY, nullptr, &visibleCount);
+    EXPECT_EQ(visibleCount, 4U) << "ERROR in: " << logLabel;
+    ASSERT_EQ(drawInfos.size(), 2U) << "ERROR in: " << logLabel;
+    EXPECT_EQ(drawInfos[0].firstIndex, 6U) << "ERROR in: " << logLabel;
+    EXPECT_EQ(drawInfos[0].indexCount, 18U) << "ERROR in: " << logLabel;
+    EXPECT_EQ(drawInfos[1].firstIndex, 30U) << "ERROR in: " << logLabel;
+    EXPECT_EQ(drawInfos[1].indexCount, 6U) << "ERROR in: " << logLabel;
+
+    logLabel = "clusterCulling tests the clusters transformed by the world matrix";
+    Mat4 worldMatrix;
+    Mat4::createTranslation(Vec3{-20.F, 0.F, 0.F}, &worldMatrix);
+    drawInfos = cull(clusters, worldMatrix, nullptr, &visibleCount);
+    EXPECT_EQ(visibleCount, 1U) << "ERROR in: " << logLabel;
+    ASSERT_EQ(drawInfos.size(), 1U) << "ERROR in: " << logLabel;
+    EXPECT_EQ(drawInfos[0].firstIndex, 24U) << "ERROR in: " << logLabel;
+
+    Mat4::createScale(Vec3{0.1F, 0.1F, 0.1F}, &worldMatrix);
+    drawInfos = cull(clusters, worldMatrix, nullptr, &visibleCount);
+    EXPECT_EQ(visibleCount, 6U) << "ERROR in: " << logLabel;
+    ASSERT_EQ(drawInfos.size(), 1U) << "ERROR in: " << logLabel;
+    EXPECT_EQ(drawInfos[0].indexCount, 36U) << "ERROR in: " << logLabel;
+}
+
+TEST(meshClusterTest, clusterCullingCones) {
+    logLabel = "clusterCulling culls the clusters facing away from the eye";
+    // all triangles of cluster 1 face +z within 60 degrees, the ones of cluster 0 may face anywhere
+    const ccstd::vector<IMeshCluster> clusters{createCluster(0, -1.F), createCluster(1, 1.F, std::sin(math::PI / 3.F))};
+    const Vec3 front{1.F, 0.F, 10.F};
+    const Vec3 back{1.F, 0.F, -10.F};
+    uint32_t visibleCount = 0;
+
+    cull(clusters, Mat4::IDENTITY, &front, &visibleCount);
+    EXPECT_EQ(visibleCount, 2U) << "ERROR in: " << logLabel;
+
+    auto drawInfos = cull(clusters, Mat4::IDENTITY, &back, &visibleCount);
+    EXPECT_EQ(visibleCount, 1U) << "ERROR in: " << logLabel;
+    ASSERT_EQ(drawInfos.size(), 1U) << "ERROR in: " << logLabel;
+    EXPECT_EQ(drawInfos[0].firstIndex, 0U) << "ERROR in: " << logLabel;
+
+    logLabel = "clusterCulling doesn't test the cones without an eye";
+    cull(clusters, Mat4::IDENTITY, nullptr, &visibleCount);
+    EXPECT_EQ(visibleCount, 2U) << "ERROR in: " << logLabel;
+}
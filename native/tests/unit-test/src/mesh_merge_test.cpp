@@ -0,0 +1,183 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <cstring>
+#include "3d/assets/Mesh.h"
+#include "3d/misc/CreateMesh.h"
+#include "gtest/gtest.h"
+#include "primitive/Sphere.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+// `vertexCount` vertices on a line, indexed by a triangle at each end.
+IGeometry lineGeometry(uint32_t vertexCount, bool indexed) {
+    IGeometry geometry;
+    for (uint32_t i = 0; i < vertexCount; ++i) {
+        const auto x = static_cast<float>(i);
+        geometry.positions.insert(geometry.positions.end(), {x, x * 0.5F, -x});
+    }
+    geometry.normals = ccstd::vector<float>(vertexCount * 3, 0.F);
+    geometry.uvs = ccstd::vector<float>(vertexCount * 2, 0.25F);
+    for (uint32_t i = 0; i < vertexCount; ++i) {
+        (*geometry.normals)[i * 3 + 1] = 1.F;
+    }
+    geometry.minPos = Vec3{0.F, 0.F, -static_cast<float>(vertexCount - 1)};
+    geometry.maxPos = Vec3{static_cast<float>(vertexCount - 1), static_cast<float>(vertexCount - 1) * 0.5F, 0.F};
+    if (indexed) {
+        geometry.indices = ccstd::vector<uint32_t>{0, 1, 2, vertexCount - 3, vertexCount - 2, vertexCount - 1};
+    }
+    return geometry;
+}
+
+ccstd::vector<Mat4> createWorldMatrices(uint32_t count) {
+    ccstd::vector<Mat4> worldMatrices(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const auto f = static_cast<float>(i);
+        Quaternion rotation;
+        Quaternion::fromEuler(f * 10.F, f * 25.F, f * 40.F, &rotation);
+        Mat4::fromRTS(rotation, Vec3{f * 3.F, -f, f * 0.5F}, Vec3{1.F + f * 0.1F, 1.F, 2.F}, &worldMatrices[i]);
+    }
+    return worldMatrices;
+}
+
+void expectSameBufferView(const Mesh::IBufferView &a, const Mesh::IBufferView &b) {
+    EXPECT_EQ(a.offset, b.offset) << "ERROR in: " << logLabel;
+    EXPECT_EQ(a.length, b.length) << "ERROR in: " << logLabel;
+    EXPECT_EQ(a.count, b.count) << "ERROR in: " << logLabel;
+    EXPECT_EQ(a.stride, b.stride) << "ERROR in: " << logLabel;
+}
+
+void expectSameOptionalVec3(const ccstd::optional<Vec3> &a, const ccstd::optional<Vec3> &b) {
+    ASSERT_EQ(a.has_value(), b.has_value()) << "ERROR in: " << logLabel;
+    if (a.has_value()) {
+        EXPECT_EQ(memcmp(&a->x, &b->x, 3 * sizeof(float)), 0) << "ERROR in: " << logLabel;
+    }
+}
+
+// The struct and the data must be the same, byte for byte.
+void expectSameMesh(Mesh *a, Mesh *b) {
+    const auto &structA = a->getStruct();
+    const auto &structB = b->getStruct();
+    ASSERT_EQ(structA.vertexBundles.size(), structB.vertexBundles.size()) << "ERROR in: " << logLabel;
+    for (size_t i = 0; i < structA.vertexBundles.size(); ++i) {
+        expectSameBufferView(structA.vertexBundles[i].view, structB.vertexBundles[i].view);
+        const auto &attributesA = structA.vertexBundles[i].attributes;
+        const auto &attributesB = structB.vertexBundles[i].attributes;
+        ASSERT_EQ(attributesA.size(), attributesB.size()) << "ERROR in: " << logLabel;
+        for (size_t j = 0; j < attributesA.size(); ++j) {
+            EXPECT_EQ(attributesA[j].name, attributesB[j].name) << "ERROR in: " << logLabel;
+            EXPECT_EQ(attributesA[j].format, attributesB[j].format) << "ERROR in: " << logLabel;
+        }
+    }
+    ASSERT_EQ(structA.primitives.size(), structB.primitives.size()) << "ERROR in: " << logLabel;
+    for (size_t i = 0; i < structA.primitives.size(); ++i) {
+        const auto &primA = structA.primitives[i];
+        const auto &primB = structB.primitives[i];
+        EXPECT_EQ(primA.vertexBundelIndices, primB.vertexBundelIndices) << "ERROR in: " << logLabel;
+        ASSERT_EQ(primA.indexView.has_value(), primB.indexView.has_value()) << "ERROR in: " << logLabel;
+        if (primA.indexView.has_value()) {
+            expectSameBufferView(primA.indexView.value(), primB.indexView.value());
+        }
+    }
+    expectSameOptionalVec3(structA.minPosition, structB.minPosition);
+    expectSameOptionalVec3(structA.maxPosition, structB.maxPosition);
+
+    const auto &dataA = a->getData();
+    const auto &dataB = b->getData();
+    ASSERT_EQ(dataA.byteLength(), dataB.byteLength()) << "ERROR in: " << logLabel;
+    EXPECT_EQ(memcmp(dataA.buffer()->getData() + dataA.byteOffset(), dataB.buffer()->getData() + dataB.byteOffset(), dataA.byteLength()), 0) << "ERROR in: " << logLabel;
+}
+
+// Merges the meshes one by one and with mergeBatch, into new meshes or into a copy of `target`.
+void expectMergeBatchSameAsMerge(const ccstd::vector<IntrusivePtr<Mesh>> &meshes, const ccstd::vector<Mat4> &worldMatrices, Mesh *target = nullptr) {
+    IntrusivePtr<Mesh> sequential = ccnew Mesh();
+    IntrusivePtr<Mesh> batched = ccnew Mesh();
+    if (target != nullptr) {
+        sequential->merge(target);
+        batched->merge(target);
+    }
+
+    ccstd::vector<Mesh *> sources;
+    ccstd::vector<const Mat4 *> matrices;
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        const Mat4 *worldMatrix = i < worldMatrices.size() ? &worldMatrices[i] : nullptr;
+        sequential->merge(meshes[i], worldMatrix);
+        sources.emplace_back(meshes[i]);
+        matrices.emplace_back(worldMatrix);
+    }
+    EXPECT_TRUE(batched->mergeBatch(sources, matrices)) << "ERROR in: " << logLabel;
+
+    expectSameMesh(sequential, batched);
+    sequential->destroy();
+    batched->destroy();
+}
+
+} // namespace
+
+TEST(meshMergeTest, mergeBatchTransformed) {
+    logLabel = "mergeBatch of transformed spheres is the same as merging them one by one";
+    ccstd::vector<IntrusivePtr<Mesh>> meshes;
+    for (uint32_t segments : {8U, 16U, 4U, 32U, 16U, 8U}) {
+        ISphereOptions options;
+        options.segments = segments;
+        meshes.emplace_back(MeshUtils::createMesh(sphere(0.5F, options)));
+    }
+    expectMergeBatchSameAsMerge(meshes, createWorldMatrices(static_cast<uint32_t>(meshes.size())));
+
+    logLabel = "mergeBatch into an initialized mesh is the same as merging one by one";
+    IntrusivePtr<Mesh> target = MeshUtils::createMesh(sphere(1.F));
+    expectMergeBatchSameAsMerge(meshes, createWorldMatrices(static_cast<uint32_t>(meshes.size())), target);
+
+    logLabel = "mergeBatch without world matrices is the same as merging one by one";
+    expectMergeBatchSameAsMerge(meshes, {});
+}
+
+TEST(meshMergeTest, mergeBatchIndexNarrowing) {
+    logLabel = "mergeBatch narrows the rebased indices as merging one by one does";
+    // Few indices into many vertices: the first steps use 8 bits indices, which the rebased indices overflow.
+    ccstd::vector<IntrusivePtr<Mesh>> meshes;
+    for (uint32_t i = 0; i < 50; ++i) {
+        meshes.emplace_back(MeshUtils::createMesh(lineGeometry(300 + i * 7, true)));
+    }
+    expectMergeBatchSameAsMerge(meshes, createWorldMatrices(static_cast<uint32_t>(meshes.size())));
+}
+
+TEST(meshMergeTest, mergeBatchDroppedIndices) {
+    logLabel = "mergeBatch drops the indices of a primitive once a merged mesh has none, as merging one by one does";
+    ccstd::vector<IntrusivePtr<Mesh>> meshes;
+    meshes.emplace_back(MeshUtils::createMesh(lineGeometry(12, true)));
+    meshes.emplace_back(MeshUtils::createMesh(lineGeometry(20, true)));
+    meshes.emplace_back(MeshUtils::createMesh(lineGeometry(8, false)));
+    meshes.emplace_back(MeshUtils::createMesh(lineGeometry(16, true)));
+    expectMergeBatchSameAsMerge(meshes, createWorldMatrices(static_cast<uint32_t>(meshes.size())));
+
+    IntrusivePtr<Mesh> batched = ccnew Mesh();
+    batched->mergeBatch({meshes[0], meshes[1], meshes[2], meshes[3]}, {});
+    EXPECT_FALSE(batched->getStruct().primitives[0].indexView.has_value()) << "ERROR in: " << logLabel;
+    batched->destroy();
+}
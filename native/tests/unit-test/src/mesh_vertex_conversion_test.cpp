@@ -0,0 +1,135 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <cstring>
+#include "3d/assets/Mesh.h"
+#include "3d/misc/CreateMesh.h"
+#include "gtest/gtest.h"
+#include "math/MathUtil.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr uint32_t VERTEX_COUNT = 37;
+
+IGeometry quadStripGeometry() {
+    IGeometry geometry;
+    ccstd::vector<float> uvs;
+    ccstd::vector<float> tangents;
+    for (uint32_t i = 0; i < VERTEX_COUNT; ++i) {
+        const auto x = static_cast<float>(i);
+        geometry.positions.insert(geometry.positions.end(), {x * 0.5F, static_cast<float>(i % 2), 0.F});
+        uvs.insert(uvs.end(), {x / 3.F, 1.F - x / 7.F});
+        tangents.insert(tangents.end(), {1.F / (x + 1.F), -0.1F * x, 0.33333F, i % 2 ? 1.F : -1.F});
+    }
+    geometry.uvs = uvs;
+    geometry.tangents = tangents;
+    geometry.minPos = Vec3{0.F, 0.F, 0.F};
+    geometry.maxPos = Vec3{static_cast<float>(VERTEX_COUNT - 1) * 0.5F, 1.F, 0.F};
+    ccstd::vector<uint32_t> indices;
+    for (uint32_t i = 0; i + 2 < VERTEX_COUNT; ++i) {
+        indices.insert(indices.end(), {i, i + 1, i + 2});
+    }
+    geometry.indices = indices;
+    return geometry;
+}
+
+// Byte offset of the attribute in its vertex bundle, or -1 if the bundle doesn't have it.
+int32_t findAttribute(const Mesh::IVertexBundle &bundle, const char *name, gfx::Format *format) {
+    uint32_t offset = 0;
+    for (const auto &attribute : bundle.attributes) {
+        if (attribute.name == name) {
+            *format = attribute.format;
+            return static_cast<int32_t>(offset);
+        }
+        offset += gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(attribute.format)].size;
+    }
+    return -1;
+}
+
+} // namespace
+
+TEST(meshVertexConversionTest, dataOptimization) {
+    logLabel = "the vertex data is kept as is without data optimization";
+    const IGeometry geometry = quadStripGeometry();
+    ASSERT_FALSE(Mesh::isDataOptimizationEnabled()) << "ERROR in: " << logLabel;
+    IntrusivePtr<Mesh> original = MeshUtils::createMesh(geometry);
+    const auto &originalBundle = original->getStruct().vertexBundles[0];
+    const uint32_t originalStride = originalBundle.view.stride;
+    gfx::Format format{gfx::Format::UNKNOWN};
+    ASSERT_GE(findAttribute(originalBundle, gfx::ATTR_NAME_TEX_COORD, &format), 0) << "ERROR in: " << logLabel;
+    EXPECT_EQ(format, gfx::Format::RG32F) << "ERROR in: " << logLabel;
+    ASSERT_GE(findAttribute(originalBundle, gfx::ATTR_NAME_TANGENT, &format), 0) << "ERROR in: " << logLabel;
+    EXPECT_EQ(format, gfx::Format::RGBA32F) << "ERROR in: " << logLabel;
+    original->destroy();
+
+    if (!hasFlag(gfx::Device::getInstance()->getFormatFeatures(gfx::Format::RG16F), gfx::FormatFeature::VERTEX_ATTRIBUTE)) {
+        GTEST_SKIP() << "half float vertex attributes are not supported by the device";
+    }
+
+    logLabel = "the texture coordinates and tangents are converted to half floats with data optimization";
+    Mesh::setDataOptimizationEnabled(true);
+    IntrusivePtr<Mesh> mesh = MeshUtils::createMesh(geometry);
+    Mesh::setDataOptimizationEnabled(false);
+    ASSERT_EQ(mesh->getRenderingSubMeshes().size(), 1U) << "ERROR in: " << logLabel;
+
+    const auto &bundle = mesh->getStruct().vertexBundles[0];
+    EXPECT_EQ(bundle.view.stride, originalStride - 4 - 8) << "ERROR in: " << logLabel;
+    EXPECT_EQ(bundle.view.count, VERTEX_COUNT) << "ERROR in: " << logLabel;
+    const int32_t positionOffset = findAttribute(bundle, gfx::ATTR_NAME_POSITION, &format);
+    ASSERT_GE(positionOffset, 0) << "ERROR in: " << logLabel;
+    EXPECT_EQ(format, gfx::Format::RGB32F) << "ERROR in: " << logLabel;
+    const int32_t uvOffset = findAttribute(bundle, gfx::ATTR_NAME_TEX_COORD, &format);
+    ASSERT_GE(uvOffset, 0) << "ERROR in: " << logLabel;
+    EXPECT_EQ(format, gfx::Format::RG16F) << "ERROR in: " << logLabel;
+    const int32_t tangentOffset = findAttribute(bundle, gfx::ATTR_NAME_TANGENT, &format);
+    ASSERT_GE(tangentOffset, 0) << "ERROR in: " << logLabel;
+    EXPECT_EQ(format, gfx::Format::RGBA16F) << "ERROR in: " << logLabel;
+
+    const auto &meshData = mesh->getData();
+    const uint8_t *vertices = meshData.buffer()->getData() + meshData.byteOffset() + bundle.view.offset;
+    uint16_t expected[4];
+    for (uint32_t i = 0; i < VERTEX_COUNT; ++i) {
+        const uint8_t *vertex = vertices + i * bundle.view.stride;
+        float position[3];
+        memcpy(position, vertex + positionOffset, sizeof(position));
+        EXPECT_EQ(memcmp(position, geometry.positions.data() + i * 3, sizeof(position)), 0) << "ERROR in: " << logLabel;
+
+        uint16_t uv[2];
+        memcpy(uv, vertex + uvOffset, sizeof(uv));
+        MathUtil::floatToHalf(geometry.uvs->data() + i * 2, 2, expected);
+        EXPECT_EQ(memcmp(uv, expected, sizeof(uv)), 0) << "ERROR in: " << logLabel;
+
+        uint16_t tangent[4];
+        memcpy(tangent, vertex + tangentOffset, sizeof(tangent));
+        MathUtil::floatToHalf(geometry.tangents->data() + i * 4, 4, expected);
+        EXPECT_EQ(memcmp(tangent, expected, sizeof(tangent)), 0) << "ERROR in: " << logLabel;
+    }
+
+    mesh->destroy();
+}
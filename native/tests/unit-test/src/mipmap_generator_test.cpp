@@ -0,0 +1,107 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/std/container/vector.h"
+#include "gtest/gtest.h"
+#include "platform/MipmapGenerator.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+ccstd::vector<uint8_t> makeChain(uint32_t width, uint32_t height, const ccstd::vector<uint8_t> &base) {
+    uint32_t size = 0;
+    for (auto levelSize : MipmapGenerator::getMipmapLevelDataSize(width, height)) {
+        size += levelSize;
+    }
+    ccstd::vector<uint8_t> chain(size);
+    std::copy(base.begin(), base.end(), chain.begin());
+    return chain;
+}
+
+} // namespace
+
+TEST(MipmapGeneratorTest, layout) {
+    EXPECT_EQ(MipmapGenerator::getLevelCount(1, 1), 1U);
+    EXPECT_EQ(MipmapGenerator::getLevelCount(256, 256), 9U);
+    EXPECT_EQ(MipmapGenerator::getLevelCount(8, 2), 4U);
+    EXPECT_EQ(MipmapGenerator::getMipmapLevelDataSize(8, 2), (ccstd::vector<uint32_t>{64, 16, 8, 4}));
+}
+
+TEST(MipmapGeneratorTest, solidColor) {
+    const uint32_t width = 16;
+    const uint32_t height = 4;
+    ccstd::vector<uint8_t> base(width * height * 4);
+    for (size_t i = 0; i < base.size(); i += 4) {
+        base[i + 0] = 80;
+        base[i + 1] = 40;
+        base[i + 2] = 7;
+        base[i + 3] = 90;
+    }
+    for (auto filter : {MipmapGenerator::Filter::BOX, MipmapGenerator::Filter::KAISER, MipmapGenerator::Filter::LANCZOS}) {
+        for (bool srgb : {false, true}) {
+            for (bool premultipliedAlpha : {false, true}) {
+                auto chain = makeChain(width, height, base);
+                MipmapGenerator::generate(chain.data(), width, height, {filter, srgb, premultipliedAlpha});
+                for (size_t i = 0; i < chain.size(); ++i) {
+                    EXPECT_NEAR(chain[i], base[i % 4], 1) << "filter " << static_cast<int>(filter) << " srgb " << srgb << " premultiplied " << premultipliedAlpha << " byte " << i;
+                }
+            }
+        }
+    }
+}
+
+TEST(MipmapGeneratorTest, box) {
+    const ccstd::vector<uint8_t> base{
+        0, 0, 0, 255, 255, 255, 255, 255,
+        0, 0, 0, 255, 255, 255, 255, 255};
+
+    auto chain = makeChain(2, 2, base);
+    MipmapGenerator::generate(chain.data(), 2, 2, {});
+    EXPECT_EQ(chain[16], 128);
+    EXPECT_EQ(chain[19], 255);
+
+    // half of the light in linear space
+    MipmapGenerator::generate(chain.data(), 2, 2, {MipmapGenerator::Filter::BOX, true, false});
+    EXPECT_EQ(chain[16], 188);
+}
+
+TEST(MipmapGeneratorTest, alpha) {
+    // transparent green next to opaque red
+    const ccstd::vector<uint8_t> base{255, 0, 0, 255, 0, 255, 0, 0};
+
+    auto chain = makeChain(2, 1, base);
+    MipmapGenerator::generate(chain.data(), 2, 1, {});
+    EXPECT_EQ(chain[8], 255);
+    EXPECT_EQ(chain[9], 0);
+    EXPECT_EQ(chain[11], 128);
+
+    chain = makeChain(2, 1, base);
+    MipmapGenerator::generate(chain.data(), 2, 1, {MipmapGenerator::Filter::BOX, false, true});
+    EXPECT_EQ(chain[8], 128);
+    EXPECT_EQ(chain[9], 128);
+    EXPECT_EQ(chain[11], 128);
+}
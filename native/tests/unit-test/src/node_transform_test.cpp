@@ -0,0 +1,163 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "core/Root.h"
+#include "core/scene-graph/Node.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+Mat4 localMatrix(const Node *node) {
+    Mat4 out;
+    Mat4::fromRTS(node->getRotation(), node->getPosition(), node->getScale(), &out);
+    return out;
+}
+
+bool isEqualMat4(const Mat4 &a, const Mat4 &b) {
+    for (int i = 0; i < 16; ++i) {
+        if (!math::isEqualF(a.m[i], b.m[i], 1e-4F)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void buildTree(Node *parent, uint32_t depth, uint32_t branches, ccstd::vector<Node *> &nodes) {
+    if (depth == 0) {
+        return;
+    }
+    for (uint32_t i = 0; i < branches; ++i) {
+        auto *child = new Node();
+        parent->addChild(child);
+        nodes.emplace_back(child);
+        buildTree(child, depth - 1, branches, nodes);
+    }
+}
+
+} // namespace
+
+TEST(NodeTransformTest, flushDirtyNodeList) {
+    logLabel = "flush computes the same world matrices as the lazy path";
+    IntrusivePtr<Node> root = new Node("root");
+    ccstd::vector<Node *> nodes;
+    buildTree(root, 3, 3, nodes);
+
+    Root::getInstance()->getDirtyNodeList().flush();
+    root->setPosition(1.F, 2.F, 3.F);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        auto f = static_cast<float>(i);
+        nodes[i]->setPosition(f, -f, 0.5F * f);
+        nodes[i]->setRotationFromEuler(10.F * f, 5.F, -f);
+        nodes[i]->setScale(1.F + 0.01F * f, 1.F, 2.F);
+    }
+    ExpectEq(root->getDirtyFlag() != 0, true);
+
+    Root::getInstance()->getDirtyNodeList().flush();
+    ExpectEq(root->getDirtyFlag() == 0, true);
+    for (const auto *node : nodes) {
+        ExpectEq(node->getDirtyFlag() == 0, true);
+        Mat4 expected;
+        Mat4::multiply(node->getParent()->getWorldMatrix(), localMatrix(node), &expected);
+        ExpectEq(isEqualMat4(node->getWorldMatrix(), expected), true);
+    }
+
+    logLabel = "flush after a partial lazy update";
+    nodes[1]->setPosition(7.F, 8.F, 9.F);
+    nodes[0]->setScale(3.F, 3.F, 3.F);
+    const Mat4 lazy = nodes[2]->getWorldMatrix();
+    Root::getInstance()->getDirtyNodeList().flush();
+    ExpectEq(isEqualMat4(nodes[2]->getWorldMatrix(), lazy), true);
+    for (const auto *node : nodes) {
+        ExpectEq(node->getDirtyFlag() == 0, true);
+    }
+
+    logLabel = "flush releases recorded nodes dropped by their owner";
+    IntrusivePtr<Node> orphan = new Node("orphan");
+    orphan->setPosition(1.F, 1.F, 1.F);
+    orphan = nullptr;
+    Root::getInstance()->getDirtyNodeList().flush();
+}
+
+TEST(NodeTransformTest, flushReparentedNodes) {
+    logLabel = "flush updates a recorded node moved deeper after its new ancestors";
+    IntrusivePtr<Node> root = new Node("root");
+    ccstd::vector<Node *> nodes;
+    buildTree(root, 3, 2, nodes);
+    IntrusivePtr<Node> moved = new Node("moved");
+    root->addChild(moved);
+    Root::getInstance()->getDirtyNodeList().flush();
+
+    moved->setPosition(1.F, 2.F, 3.F);
+    nodes.back()->setScale(2.F, 2.F, 2.F);
+    moved->setParent(nodes.back());
+    nodes.back()->setRotationFromEuler(0.F, 30.F, 0.F);
+    Root::getInstance()->getDirtyNodeList().flush();
+    ExpectEq(moved->getDirtyFlag() == 0, true);
+    Mat4 expected;
+    Mat4::multiply(nodes.back()->getWorldMatrix(), localMatrix(moved), &expected);
+    ExpectEq(isEqualMat4(moved->getWorldMatrix(), expected), true);
+
+    logLabel = "flush reaches the dirty children of a recorded node updated lazily";
+    nodes[0]->setPosition(4.F, 5.F, 6.F);
+    nodes[1]->getWorldMatrix();
+    Root::getInstance()->getDirtyNodeList().flush();
+    for (const auto *node : nodes) {
+        ExpectEq(node->getDirtyFlag() == 0, true);
+    }
+}
+
+TEST(NodeTransformTest, clearDirtyNodeList) {
+    logLabel = "clear leaves the dirty nodes to the lazy path";
+    IntrusivePtr<Node> root = new Node("root");
+    ccstd::vector<Node *> nodes;
+    buildTree(root, 3, 3, nodes);
+    Root::getInstance()->getDirtyNodeList().flush();
+
+    root->setPosition(1.F, 2.F, 3.F);
+    Root::getInstance()->getDirtyNodeList().clear();
+    Root::getInstance()->getDirtyNodeList().flush();
+    for (const auto *node : nodes) {
+        ExpectEq(node->getDirtyFlag() != 0, true);
+    }
+
+    logLabel = "nodes left dirty by clear are flushed again once invalidated in a later frame";
+    Node::resetChangedFlags();
+    root->setScale(2.F, 2.F, 2.F);
+    Root::getInstance()->getDirtyNodeList().flush();
+    for (const auto *node : nodes) {
+        ExpectEq(node->getDirtyFlag() == 0, true);
+        Mat4 expected;
+        Mat4::multiply(node->getParent()->getWorldMatrix(), localMatrix(node), &expected);
+        ExpectEq(isEqualMat4(node->getWorldMatrix(), expected), true);
+    }
+
+    logLabel = "getWorldMatrix on a clean node does not recompute";
+    const auto *leaf = nodes.back();
+    const Mat4 &worldMatrix = leaf->getWorldMatrix();
+    ExpectEq(&worldMatrix == &leaf->getWorldMatrix() && leaf->getDirtyFlag() == 0, true);
+}
@@ -0,0 +1,112 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "gfx-base/GFXDevice.h"
+#include "gtest/gtest.h"
+#include "renderer/pipeline/PipelineStateManager.h"
+#include "scene/Pass.h"
+#include "utils.h"
+
+using namespace cc;
+using pipeline::PipelineStateManager;
+
+namespace {
+
+struct PipelineStateFixture {
+    PipelineStateFixture() {
+        PipelineStateManager::destroyAll();
+        auto *device = gfx::Device::getInstance();
+        pass = ccnew scene::Pass();
+        for (uint32_t i = 0; i < 3; ++i) {
+            gfx::ShaderInfo info;
+            info.name = "shader";
+            info.name.push_back(static_cast<char>('0' + i));
+            shaders.emplace_back(device->createShader(info));
+        }
+        gfx::InputAssemblerInfo iaInfo;
+        iaInfo.attributes.push_back({"a_position", gfx::Format::RGB32F});
+        inputAssembler = device->createInputAssembler(iaInfo);
+        renderPass = device->createRenderPass(gfx::RenderPassInfo{});
+    }
+
+    ~PipelineStateFixture() {
+        PipelineStateManager::setCapacity(0);
+        PipelineStateManager::destroyAll();
+    }
+
+    gfx::PipelineState *get(uint32_t shader) const {
+        return PipelineStateManager::getOrCreatePipelineState(pass, shaders[shader], inputAssembler, renderPass);
+    }
+
+    IntrusivePtr<scene::Pass> pass;
+    ccstd::vector<IntrusivePtr<gfx::Shader>> shaders;
+    IntrusivePtr<gfx::InputAssembler> inputAssembler;
+    IntrusivePtr<gfx::RenderPass> renderPass;
+};
+
+} // namespace
+
+TEST(PipelineStateManagerTest, cache) {
+    logLabel = "pipeline states are created once per key";
+    PipelineStateFixture fixture;
+    auto *pso = fixture.get(0);
+    ASSERT_NE(pso, nullptr) << "ERROR in: " << logLabel;
+    EXPECT_EQ(fixture.get(0), pso) << "ERROR in: " << logLabel;
+    EXPECT_NE(fixture.get(1), pso) << "ERROR in: " << logLabel;
+    EXPECT_EQ(PipelineStateManager::getPipelineStateCount(), 2U) << "ERROR in: " << logLabel;
+    EXPECT_NE(PipelineStateManager::getOrCreatePipelineState(fixture.pass, fixture.shaders[0], fixture.inputAssembler, fixture.renderPass, 1), pso)
+        << "ERROR in: " << logLabel;
+    EXPECT_EQ(PipelineStateManager::getPipelineStateCount(), 3U) << "ERROR in: " << logLabel;
+
+    logLabel = "async creation falls back to a synchronous one on backends not supporting it";
+    PipelineStateManager::setAsyncCreationEnabled(true);
+    EXPECT_NE(PipelineStateManager::getOrCreatePipelineStateAsync(fixture.pass, fixture.shaders[2], fixture.inputAssembler, fixture.renderPass), nullptr)
+        << "ERROR in: " << logLabel;
+    PipelineStateManager::setAsyncCreationEnabled(false);
+}
+
+TEST(PipelineStateManagerTest, eviction) {
+    logLabel = "pipeline states used in the last frames are not evicted";
+    PipelineStateFixture fixture;
+    PipelineStateManager::setCapacity(2);
+    IntrusivePtr<gfx::PipelineState> held = fixture.get(0);
+    fixture.get(1);
+    fixture.get(2);
+    for (int i = 0; i < 3; ++i) {
+        PipelineStateManager::onFrameEnd();
+    }
+    EXPECT_EQ(PipelineStateManager::getPipelineStateCount(), 3U) << "ERROR in: " << logLabel;
+
+    logLabel = "the least recently used pipeline state is evicted above the capacity";
+    fixture.get(2);
+    fixture.get(1);
+    PipelineStateManager::onFrameEnd();
+    EXPECT_EQ(PipelineStateManager::getPipelineStateCount(), 2U) << "ERROR in: " << logLabel;
+
+    logLabel = "an evicted pipeline state still referenced elsewhere is not destroyed";
+    EXPECT_EQ(held->getRefCount(), 1U) << "ERROR in: " << logLabel;
+    EXPECT_EQ(held->getShader(), fixture.shaders[0].get()) << "ERROR in: " << logLabel;
+    EXPECT_NE(fixture.get(0), held.get()) << "ERROR in: " << logLabel;
+}
@@ -0,0 +1,148 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include "base/ThreadPool.h"
+#include "base/job-system/JobSystem.h"
+#include "base/threading/TaskScheduler.h"
+#if CC_USE_JOB_SYSTEM_SCHEDULER
+    #include "base/job-system/job-system-scheduler/SchedulerJobGraph.h"
+#endif
+#include "gtest/gtest.h"
+#include "utils.h"
+
+using namespace cc;
+
+TEST(TaskSchedulerTest, nestedFrameTasks) {
+    TaskScheduler scheduler(4, 2);
+    std::atomic<uint32_t> count{0};
+    for (uint32_t i = 0; i < 256; ++i) {
+        scheduler.schedule([&]() {
+            for (uint32_t j = 0; j < 8; ++j) {
+                scheduler.schedule([&]() { ++count; });
+            }
+            ++count;
+        });
+    }
+    scheduler.helpUntil([&]() { return count.load() == 256 * 9; });
+
+    ccstd::vector<TaskScheduler::WorkerStats> stats;
+    scheduler.collectWorkerStats(stats);
+    EXPECT_EQ(stats.size(), 5U); // 4 workers and the IO lane
+}
+
+TEST(TaskSchedulerTest, priorityLanes) {
+    TaskScheduler scheduler(2, 2);
+    auto background = scheduler.dispatchTask(TaskPriority::BACKGROUND, [](int v) { return v * 2; }, 21);
+    auto io = scheduler.dispatchTask(TaskPriority::IO, []() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return true;
+    });
+    auto frame = scheduler.dispatchTask(TaskPriority::FRAME, [&]() { return scheduler.getCurrentWorkerIndex(); });
+
+    EXPECT_EQ(background.get(), 42);
+    EXPECT_TRUE(io.get());
+    EXPECT_GE(frame.get(), 0);
+    EXPECT_EQ(scheduler.getCurrentWorkerIndex(), -1);
+}
+
+TEST(TaskSchedulerTest, ioReservation) {
+    // the tasks wait for each other, they only finish if the reserved threads let them all run at once
+    TaskScheduler scheduler(1, 1);
+    scheduler.reserveIOWorkers(2);
+    EXPECT_EQ(scheduler.getMaxIOWorkerCount(), 3U);
+
+    std::atomic<uint32_t> started{0};
+    ccstd::vector<std::future<bool>> results;
+    for (uint32_t i = 0; i < 3; ++i) {
+        results.emplace_back(scheduler.dispatchTask(TaskPriority::IO, [&]() {
+            ++started;
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+            while (started.load() < 3 && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::yield();
+            }
+            return started.load() == 3;
+        }));
+    }
+    for (auto &result : results) {
+        EXPECT_TRUE(result.get());
+    }
+
+    scheduler.reserveIOWorkers(-2);
+    EXPECT_EQ(scheduler.getMaxIOWorkerCount(), 1U);
+}
+
+TEST(TaskSchedulerTest, jobSystemDispatch) {
+    std::promise<int> background;
+    std::promise<int> io;
+    JobSystem::getInstance()->dispatchBackground([&]() { background.set_value(1); });
+    JobSystem::getInstance()->dispatchIO([&]() { io.set_value(2); });
+    EXPECT_EQ(background.get_future().get(), 1);
+    EXPECT_EQ(io.get_future().get(), 2);
+}
+
+#if CC_USE_JOB_SYSTEM_SCHEDULER
+TEST(TaskSchedulerTest, jobGraph) {
+    SchedulerJobSystem jobSystem(3);
+    ccstd::vector<uint32_t> values(1000, 0);
+    std::atomic<uint32_t> order{0};
+    uint32_t first = 0;
+    uint32_t last = 0;
+
+    SchedulerJobGraph g(&jobSystem);
+    auto j0 = g.createJob([&]() { first = order++; });
+    auto j1 = g.createForEachIndexJob(0, 1000, 1, [&](uint32_t i) { values[i] = first + 1; });
+    auto j2 = g.createForEachIndexJob(1, 1000, 3, [&](uint32_t i) { values[i] += 1; });
+    auto j3 = g.createJob([&]() { last = order++; });
+    g.makeEdge(j0, j1);
+    g.makeEdge(j1, j2);
+    g.makeEdge(j2, j3);
+    g.run();
+    g.waitForAll();
+
+    for (uint32_t i = 0; i < 1000; ++i) {
+        EXPECT_EQ(values[i], i % 3 == 1 ? 2 : 1);
+    }
+    EXPECT_EQ(first, 0);
+    EXPECT_EQ(last, 1);
+}
+#endif
+
+TEST(TaskSchedulerTest, legacyThreadPool) {
+    // a single thread pool has to keep executing its tasks in order
+    auto *pool = LegacyThreadPool::newSingleThreadPool();
+    ccstd::vector<int> order;
+    for (int i = 0; i < 100; ++i) {
+        pool->pushTask([&order, i](int /*tid*/) { order.emplace_back(i); });
+    }
+    delete pool;
+
+    ASSERT_EQ(order.size(), 100U);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(order[i], i);
+    }
+}
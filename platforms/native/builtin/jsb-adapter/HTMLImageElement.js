@@ -14,9 +14,23 @@ class HTMLImageElement extends HTMLElement {
         this._src = null;
         this.complete = false;
         this.crossOrigin = null;
+        // 'high', 'low' or 'auto', images with higher priorities are decoded first
+        this.fetchPriority = 'auto';
+        // e.g. { filter: 'kaiser', srgb: true, premultipliedAlpha: false } to generate the mip chain while decoding,
+        // only images with power of two sizes get one
+        this.mipmaps = null;
+        this._loadId = 0;
+    }
+
+    _cancelLoad() {
+        if (this._loadId) {
+            jsb.cancelLoadImage(this._loadId);
+            this._loadId = 0;
+        }
     }
 
     destroy() {
+        this._cancelLoad();
         if (this._data) {
             jsb.destroyImage(this._data);
             this._data = null;
@@ -25,9 +39,12 @@ class HTMLImageElement extends HTMLElement {
     }
 
     set src(src) {
+        this._cancelLoad();
         this._src = src;
         if (src === '') return;
-        jsb.loadImage(src, (info) => {
+        const priority = this.fetchPriority === 'high' ? 1 : (this.fetchPriority === 'low' ? -1 : 0);
+        this._loadId = jsb.loadImage(src, (info) => {
+            this._loadId = 0;
             if (!info) {
                 this._data = null;
                 var event = new Event('error');
@@ -42,7 +59,7 @@ class HTMLImageElement extends HTMLElement {
 
             var event = new Event('load');
             this.dispatchEvent(event);
-        });
+        }, priority, this.mipmaps || undefined);
     }
 
     get src() {